@@ -65,10 +65,10 @@ function(cadet_choose_ad_lib TARGET)
 		target_compile_definitions(${TARGET} PRIVATE -DACTIVE_ADOLC)
 		target_include_directories(${TARGET} PRIVATE "${CMAKE_SOURCE_DIR}/ThirdParty/ADOL-C/include")
 	elseif (ADLIB STREQUAL "sfad")
-		target_compile_definitions(${TARGET} PRIVATE -DACTIVE_SFAD)
+		target_compile_definitions(${TARGET} PRIVATE -DACTIVE_SFAD -DSFAD_DEFAULT_DIR=${AD_MAX_DIRECTIONS})
 		target_include_directories(${TARGET} PRIVATE "${CMAKE_SOURCE_DIR}/include/ad")
 	elseif (ADLIB STREQUAL "setfad")
-		target_compile_definitions(${TARGET} PRIVATE -DACTIVE_SETFAD)
+		target_compile_definitions(${TARGET} PRIVATE -DACTIVE_SETFAD -DSFAD_DEFAULT_DIR=${AD_MAX_DIRECTIONS})
 		target_include_directories(${TARGET} PRIVATE "${CMAKE_SOURCE_DIR}/include/ad")
 	endif ()
 endfunction()
@@ -198,6 +198,9 @@ namespace sfad
 		// Multiplication
 		inline FwdET<real_t, storage_t>& operator*=(const real_t v)
 		{
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+				storage_t<real_t>::_grad[i] *= v;
+
 			_val *= v;
 			return *this;
 		}
@@ -214,6 +217,9 @@ namespace sfad
 		// Division
 		inline FwdET<real_t, storage_t>& operator/=(const real_t v)
 		{
+			for (idx_t i = 0; i < detail::globalGradSize; ++i)
+				storage_t<real_t>::_grad[i] /= v;
+
 			_val /= v;
 			return *this;
 		}
@@ -18,6 +18,14 @@
 	#define SFAD_DEFAULT_DIR 80
 #endif
 
+// Select vector instruction set of the gradient kernels at compile time
+// Define SFAD_SIMD_DISABLE to force the scalar implementation
+#if !defined(SFAD_SIMD_DISABLE) && defined(__AVX512F__)
+	#define SFAD_SIMD_AVX512 1
+#elif !defined(SFAD_SIMD_DISABLE) && defined(__AVX__)
+	#define SFAD_SIMD_AVX 1
+#endif
+
 #ifndef SFAD_GLOBAL_GRAD_SIZE
 	#define SFAD_GLOBAL_GRAD_SIZE std::size_t sfad::detail::globalGradSize = SFAD_DEFAULT_DIR;
 #endif
@@ -0,0 +1,237 @@
+// =============================================================================
+//  SFAD - Simple Forward Automatic Differentiation
+//
+//  Copyright © 2015-2017: Samuel Leweke¹
+//
+//    ¹ Forschungszentrum Juelich GmbH, IBG-1, Juelich, Germany.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#ifndef _SFAD_SIMD_HPP_
+#define _SFAD_SIMD_HPP_
+
+#include <cstddef>
+
+#include "sfad-common.hpp"
+
+#if defined(SFAD_SIMD_AVX512) || defined(SFAD_SIMD_AVX)
+	#include <immintrin.h>
+#endif
+
+namespace sfad
+{
+	namespace detail
+	{
+		/**
+		 * Kernels operating on gradient arrays of length @c n
+		 *
+		 * All kernels allow the output array to coincide with one of the input arrays.
+		 * The arithmetic operations are performed in the same order as in the scalar
+		 * loops. Results may still differ in the last bits from the scalar ones if the
+		 * compiler contracts multiplications and additions to fused multiply-adds.
+		 */
+		namespace scalar
+		{
+			// res = a + b
+			template <typename real_t>
+			inline void add(real_t* res, real_t const* a, real_t const* b, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					res[i] = a[i] + b[i];
+			}
+
+			// res = a - b
+			template <typename real_t>
+			inline void sub(real_t* res, real_t const* a, real_t const* b, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					res[i] = a[i] - b[i];
+			}
+
+			// res = -a
+			template <typename real_t>
+			inline void neg(real_t* res, real_t const* a, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					res[i] = -a[i];
+			}
+
+			// res = s * a
+			template <typename real_t>
+			inline void scale(real_t* res, real_t s, real_t const* a, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					res[i] = s * a[i];
+			}
+
+			// res = a / d
+			template <typename real_t>
+			inline void div(real_t* res, real_t const* a, real_t d, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					res[i] = a[i] / d;
+			}
+
+			// res = s * a / d
+			template <typename real_t>
+			inline void scaleDiv(real_t* res, real_t s, real_t const* a, real_t d, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					res[i] = s * a[i] / d;
+			}
+
+			// res = alpha * a + beta * b
+			template <typename real_t>
+			inline void linComb(real_t* res, real_t alpha, real_t const* a, real_t beta, real_t const* b, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					res[i] = alpha * a[i] + beta * b[i];
+			}
+
+			// res = (alpha * a + beta * b) / d
+			template <typename real_t>
+			inline void linCombDiv(real_t* res, real_t alpha, real_t const* a, real_t beta, real_t const* b, real_t d, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					res[i] = (alpha * a[i] + beta * b[i]) / d;
+			}
+		}
+
+		namespace vectorized
+		{
+			// Generic types are handled by the scalar implementation
+			using scalar::add;
+			using scalar::sub;
+			using scalar::neg;
+			using scalar::scale;
+			using scalar::div;
+			using scalar::scaleDiv;
+			using scalar::linComb;
+			using scalar::linCombDiv;
+
+#if defined(SFAD_SIMD_AVX512) || defined(SFAD_SIMD_AVX)
+
+	#if defined(SFAD_SIMD_AVX512)
+			typedef __m512d vec_t;
+			const std::size_t vecWidth = 8;
+			inline vec_t vecLoad(double const* p) { return _mm512_loadu_pd(p); }
+			inline void vecStore(double* p, vec_t v) { _mm512_storeu_pd(p, v); }
+			inline vec_t vecSet(double v) { return _mm512_set1_pd(v); }
+			inline vec_t vecAdd(vec_t a, vec_t b) { return _mm512_add_pd(a, b); }
+			inline vec_t vecSub(vec_t a, vec_t b) { return _mm512_sub_pd(a, b); }
+			inline vec_t vecMul(vec_t a, vec_t b) { return _mm512_mul_pd(a, b); }
+			inline vec_t vecDiv(vec_t a, vec_t b) { return _mm512_div_pd(a, b); }
+	#else
+			typedef __m256d vec_t;
+			const std::size_t vecWidth = 4;
+			inline vec_t vecLoad(double const* p) { return _mm256_loadu_pd(p); }
+			inline void vecStore(double* p, vec_t v) { _mm256_storeu_pd(p, v); }
+			inline vec_t vecSet(double v) { return _mm256_set1_pd(v); }
+			inline vec_t vecAdd(vec_t a, vec_t b) { return _mm256_add_pd(a, b); }
+			inline vec_t vecSub(vec_t a, vec_t b) { return _mm256_sub_pd(a, b); }
+			inline vec_t vecMul(vec_t a, vec_t b) { return _mm256_mul_pd(a, b); }
+			inline vec_t vecDiv(vec_t a, vec_t b) { return _mm256_div_pd(a, b); }
+	#endif
+
+			// The remainder that does not fill a vector register is handled by the scalar kernels
+
+			inline void add(double* res, double const* a, double const* b, std::size_t n)
+			{
+				std::size_t i = 0;
+				for (; i + vecWidth <= n; i += vecWidth)
+					vecStore(res + i, vecAdd(vecLoad(a + i), vecLoad(b + i)));
+				scalar::add(res + i, a + i, b + i, n - i);
+			}
+
+			inline void sub(double* res, double const* a, double const* b, std::size_t n)
+			{
+				std::size_t i = 0;
+				for (; i + vecWidth <= n; i += vecWidth)
+					vecStore(res + i, vecSub(vecLoad(a + i), vecLoad(b + i)));
+				scalar::sub(res + i, a + i, b + i, n - i);
+			}
+
+			inline void neg(double* res, double const* a, std::size_t n)
+			{
+				// Subtraction from -0.0 only flips the sign bit, which is identical to unary minus
+				const vec_t z = vecSet(-0.0);
+				std::size_t i = 0;
+				for (; i + vecWidth <= n; i += vecWidth)
+					vecStore(res + i, vecSub(z, vecLoad(a + i)));
+				scalar::neg(res + i, a + i, n - i);
+			}
+
+			inline void scale(double* res, double s, double const* a, std::size_t n)
+			{
+				const vec_t vs = vecSet(s);
+				std::size_t i = 0;
+				for (; i + vecWidth <= n; i += vecWidth)
+					vecStore(res + i, vecMul(vs, vecLoad(a + i)));
+				scalar::scale(res + i, s, a + i, n - i);
+			}
+
+			inline void div(double* res, double const* a, double d, std::size_t n)
+			{
+				const vec_t vd = vecSet(d);
+				std::size_t i = 0;
+				for (; i + vecWidth <= n; i += vecWidth)
+					vecStore(res + i, vecDiv(vecLoad(a + i), vd));
+				scalar::div(res + i, a + i, d, n - i);
+			}
+
+			inline void scaleDiv(double* res, double s, double const* a, double d, std::size_t n)
+			{
+				const vec_t vs = vecSet(s);
+				const vec_t vd = vecSet(d);
+				std::size_t i = 0;
+				for (; i + vecWidth <= n; i += vecWidth)
+					vecStore(res + i, vecDiv(vecMul(vs, vecLoad(a + i)), vd));
+				scalar::scaleDiv(res + i, s, a + i, d, n - i);
+			}
+
+			inline void linComb(double* res, double alpha, double const* a, double beta, double const* b, std::size_t n)
+			{
+				const vec_t va = vecSet(alpha);
+				const vec_t vb = vecSet(beta);
+				std::size_t i = 0;
+				for (; i + vecWidth <= n; i += vecWidth)
+					vecStore(res + i, vecAdd(vecMul(va, vecLoad(a + i)), vecMul(vb, vecLoad(b + i))));
+				scalar::linComb(res + i, alpha, a + i, beta, b + i, n - i);
+			}
+
+			inline void linCombDiv(double* res, double alpha, double const* a, double beta, double const* b, double d, std::size_t n)
+			{
+				const vec_t va = vecSet(alpha);
+				const vec_t vb = vecSet(beta);
+				const vec_t vd = vecSet(d);
+				std::size_t i = 0;
+				for (; i + vecWidth <= n; i += vecWidth)
+					vecStore(res + i, vecDiv(vecAdd(vecMul(va, vecLoad(a + i)), vecMul(vb, vecLoad(b + i))), vd));
+				scalar::linCombDiv(res + i, alpha, a + i, beta, b + i, d, n - i);
+			}
+
+#endif
+		}
+	}
+
+	/**
+	 * @brief Returns the name of the instruction set used by the gradient kernels
+	 * @return Name of the instruction set
+	 */
+	inline const char* simdInstructionSet() SFAD_NOEXCEPT
+	{
+#if defined(SFAD_SIMD_AVX512)
+		return "AVX-512";
+#elif defined(SFAD_SIMD_AVX)
+		return "AVX";
+#else
+		return "scalar";
+#endif
+	}
+}
+
+#endif
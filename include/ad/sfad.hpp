@@ -20,6 +20,7 @@
 #include <utility>
 
 #include "sfad-common.hpp"
+#include "sfad-simd.hpp"
 
 namespace sfad
 {
@@ -124,8 +125,7 @@ namespace sfad
 		inline Fwd<real_t, storage_t>& operator+=(const Fwd<real_t, storage_t>& a)
 		{
 			_val += a._val;
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-				storage_t<real_t>::_grad[i] += a._grad[i];
+			detail::vectorized::add(storage_t<real_t>::_grad, storage_t<real_t>::_grad, a._grad, detail::globalGradSize);
 
 			return *this;
 		}
@@ -140,8 +140,7 @@ namespace sfad
 		inline Fwd<real_t, storage_t>& operator-=(const Fwd<real_t, storage_t>& a)
 		{
 			_val -= a._val;
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-				storage_t<real_t>::_grad[i] -= a._grad[i];
+			detail::vectorized::sub(storage_t<real_t>::_grad, storage_t<real_t>::_grad, a._grad, detail::globalGradSize);
 
 			return *this;
 		}
@@ -149,14 +148,15 @@ namespace sfad
 		// Multiplication
 		inline Fwd<real_t, storage_t>& operator*=(const real_t v)
 		{
+			detail::vectorized::scale(storage_t<real_t>::_grad, v, storage_t<real_t>::_grad, detail::globalGradSize);
+
 			_val *= v;
 			return *this;
 		}
 
 		inline Fwd<real_t, storage_t>& operator*=(const Fwd<real_t, storage_t>& a)
 		{
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-				storage_t<real_t>::_grad[i] = a._val * storage_t<real_t>::_grad[i] + _val * a._grad[i];
+			detail::vectorized::linComb(storage_t<real_t>::_grad, a._val, storage_t<real_t>::_grad, _val, a._grad, detail::globalGradSize);
 
 			_val *= a._val;
 			return *this;
@@ -165,15 +165,16 @@ namespace sfad
 		// Division
 		inline Fwd<real_t, storage_t>& operator/=(const real_t v)
 		{
+			detail::vectorized::div(storage_t<real_t>::_grad, storage_t<real_t>::_grad, v, detail::globalGradSize);
+
 			_val /= v;
 			return *this;
 		}
 
 		inline Fwd<real_t, storage_t>& operator/=(const Fwd<real_t, storage_t>& a)
 		{
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-//				_grad[i] = (_grad[i] - _val / a._val * a._grad[i]) / a._val;
-				storage_t<real_t>::_grad[i] = (storage_t<real_t>::_grad[i] * a._val - _val * a._grad[i]) / (a._val * a._val);
+//			_grad[i] = (_grad[i] - _val / a._val * a._grad[i]) / a._val;
+			detail::vectorized::linCombDiv(storage_t<real_t>::_grad, a._val, storage_t<real_t>::_grad, -_val, a._grad, a._val * a._val, detail::globalGradSize);
 
 			_val /= a._val;
 			return *this;
@@ -210,8 +211,7 @@ namespace sfad
 		inline Fwd<real_t, storage_t> operator-() const
 		{
 			Fwd<real_t, storage_t> cpy(-_val, false);
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-				cpy._grad[i] = -storage_t<real_t>::_grad[i];
+			detail::vectorized::neg(cpy._grad, storage_t<real_t>::_grad, detail::globalGradSize);
 
 			return cpy;
 		}
@@ -227,8 +227,7 @@ namespace sfad
 		inline Fwd<real_t, storage_t> operator+(const Fwd<real_t, storage_t>& a) const
 		{
 			Fwd<real_t, storage_t> cpy(_val + a._val, false);
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-				cpy._grad[i] = storage_t<real_t>::_grad[i] + a._grad[i];
+			detail::vectorized::add(cpy._grad, storage_t<real_t>::_grad, a._grad, detail::globalGradSize);
 			return cpy;
 		}
 
@@ -246,41 +245,36 @@ namespace sfad
 		inline Fwd<real_t, storage_t> operator-(const Fwd<real_t, storage_t>& a) const
 		{
 			Fwd<real_t, storage_t> cpy(_val - a._val, false);
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-				cpy._grad[i] = storage_t<real_t>::_grad[i] - a._grad[i];
+			detail::vectorized::sub(cpy._grad, storage_t<real_t>::_grad, a._grad, detail::globalGradSize);
 			return cpy;
 		}
 
 		inline friend Fwd<real_t, storage_t> operator-(const real_t v, const Fwd<real_t, storage_t>& a)
 		{
 			Fwd<real_t, storage_t> res(v - a._val, false);
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-				res._grad[i] = -a._grad[i];
+			detail::vectorized::neg(res._grad, a._grad, detail::globalGradSize);
 			return res;
 		}
 		
 		// Multiplication
 		inline Fwd<real_t, storage_t> operator*(const real_t v) const
 		{
-			Fwd<real_t, storage_t> res(_val * v);
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-				res._grad[i] = v * storage_t<real_t>::_grad[i];
+			Fwd<real_t, storage_t> res(_val * v, false);
+			detail::vectorized::scale(res._grad, v, storage_t<real_t>::_grad, detail::globalGradSize);
 			return res;
 		}
 
 		inline Fwd<real_t, storage_t> operator*(const Fwd<real_t, storage_t>& a) const
 		{
 			Fwd<real_t, storage_t> cpy(_val * a._val, false);
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-				cpy._grad[i] = a._val * storage_t<real_t>::_grad[i] + _val * a._grad[i];
+			detail::vectorized::linComb(cpy._grad, a._val, storage_t<real_t>::_grad, _val, a._grad, detail::globalGradSize);
 			return cpy;
 		}
 
 		inline friend Fwd<real_t, storage_t> operator*(const real_t v, const Fwd<real_t, storage_t>& a)
 		{
 			Fwd<real_t, storage_t> res(v * a._val, false);
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-				res._grad[i] = v * a._grad[i];
+			detail::vectorized::scale(res._grad, v, a._grad, detail::globalGradSize);
 			return res;
 		}
 	
@@ -288,26 +282,23 @@ namespace sfad
 		inline Fwd<real_t, storage_t> operator/(const real_t v) const
 		{
 			Fwd<real_t, storage_t> res(_val / v, false);
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-				res._grad[i] = storage_t<real_t>::_grad[i] / v;
+			detail::vectorized::div(res._grad, storage_t<real_t>::_grad, v, detail::globalGradSize);
 			return res;
 		}
 
 		inline Fwd<real_t, storage_t> operator/(const Fwd<real_t, storage_t>& a) const
 		{
 			Fwd<real_t, storage_t> res(_val / a._val, false);
-			for (idx_t i = 0; i < detail::globalGradSize; ++i)
-//				res._grad[i] = (storage_t<real_t>::_grad[i] - _val / a._val * a._grad[i]) / a._val;
-				res._grad[i] = (storage_t<real_t>::_grad[i] * a._val - _val * a._grad[i]) / (a._val * a._val);
+//			res._grad[i] = (storage_t<real_t>::_grad[i] - _val / a._val * a._grad[i]) / a._val;
+			detail::vectorized::linCombDiv(res._grad, a._val, storage_t<real_t>::_grad, -_val, a._grad, a._val * a._val, detail::globalGradSize);
 			return res;
 		}
 
 		inline friend Fwd<real_t, storage_t> operator/(const real_t v, const Fwd<real_t, storage_t>& a)
 		{
 			Fwd<real_t, storage_t> res(v / a._val, false);
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-//				res._grad[i] = -(v / (a._val * a._val) * a._grad[i]);
-				res._grad[i] = -v * a._grad[i] / (a._val * a._val);
+//			res._grad[i] = -(v / (a._val * a._val) * a._grad[i]);
+			detail::vectorized::scaleDiv(res._grad, -v, a._grad, a._val * a._val, detail::globalGradSize);
 			return res;
 		}
 
@@ -356,8 +347,7 @@ namespace sfad
 	inline Fwd<real_t, storage_t> exp(const Fwd<real_t, storage_t> &a)
 	{
 		Fwd<real_t, storage_t> res(std::exp(a._val), false);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * res._val;
+		detail::vectorized::scale(res._grad, res._val, a._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -369,8 +359,7 @@ namespace sfad
 		Fwd<real_t, storage_t> res(std::log(a._val), false);
 		if (sfad_likely(a._val > real_t(0)))
 		{
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-				res._grad[i] = a._grad[i] / a._val;
+			detail::vectorized::div(res._grad, a._grad, a._val, detail::globalGradSize);
 		}
 		else if (a._val == real_t(0))
 		{
@@ -397,8 +386,7 @@ namespace sfad
 		if (sfad_likely(a._val > real_t(0)))
 		{
 			const real_t tmp = std::log(real_t(10)) * a._val;
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-				res._grad[i] = a._grad[i] / tmp;
+			detail::vectorized::div(res._grad, a._grad, tmp, detail::globalGradSize);
 		}
 		else if (a._val == real_t(0))
 		{
@@ -425,8 +413,7 @@ namespace sfad
 		if (sfad_likely(a._val > real_t(0)))
 		{
 			const real_t tmp = real_t(2) * res._val;
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-				res._grad[i] = a._grad[i] / tmp;
+			detail::vectorized::div(res._grad, a._grad, tmp, detail::globalGradSize);
 		}
 		else if (a._val == real_t(0))
 		{
@@ -449,8 +436,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(a._val * a._val, false);
 		const real_t tmp = real_t(2) * a._val;
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = tmp * a._grad[i];
+		detail::vectorized::scale(res._grad, tmp, a._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -459,8 +445,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::sin(a._val), false);
 		const real_t tmp = std::cos(a._val);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * tmp;
+		detail::vectorized::scale(res._grad, tmp, a._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -469,8 +454,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::cos(a._val), false);
 		const real_t tmp = -std::sin(a._val);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * tmp;
+		detail::vectorized::scale(res._grad, tmp, a._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -481,8 +465,7 @@ namespace sfad
 
 		const real_t tmpCos = std::cos(a._val);
 		const real_t tmp = tmpCos * tmpCos;
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] / tmp;
+		detail::vectorized::div(res._grad, a._grad, tmp, detail::globalGradSize);
 		return res;
 	}
 
@@ -491,8 +474,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::asin(a._val), false);
 		const real_t tmp = std::sqrt(real_t(1) - a._val * a._val);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] / tmp;
+		detail::vectorized::div(res._grad, a._grad, tmp, detail::globalGradSize);
 		return res;
 	}
 
@@ -501,8 +483,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::acos(a._val), false);
 		const real_t tmp = std::sqrt(real_t(1) - a._val * a._val);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = -a._grad[i] / tmp;
+		detail::vectorized::div(res._grad, a._grad, -tmp, detail::globalGradSize);
 		return res;
 	}
 
@@ -511,8 +492,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::atan(a._val), false);
 		const real_t tmp = real_t(1) + a._val * a._val;
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] / tmp;
+		detail::vectorized::div(res._grad, a._grad, tmp, detail::globalGradSize);
 		return res;
 	}
 
@@ -521,8 +501,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::pow(a._val, v), false);
 		const real_t tmp = v * std::pow(a._val, v - real_t(1));
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * tmp;
+		detail::vectorized::scale(res._grad, tmp, a._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -531,8 +510,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::pow(v, a._val), false);
 		const real_t tmp = res._val * std::log(v);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * tmp;
+		detail::vectorized::scale(res._grad, tmp, a._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -542,8 +520,7 @@ namespace sfad
 		Fwd<real_t, storage_t> res(std::pow(a._val, b._val), false);
 		const real_t tmp1 = b._val * std::pow(a._val, b._val - real_t(1));
 		const real_t tmp2 = res._val * std::log(a._val);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * tmp1 + b._grad[i] * tmp2;
+		detail::vectorized::linComb(res._grad, tmp1, a._grad, tmp2, b._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -552,8 +529,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::sinh(a._val), false);
 		const real_t tmp = std::cosh(a._val);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * tmp;
+		detail::vectorized::scale(res._grad, tmp, a._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -562,8 +538,7 @@ namespace sfad
 	{
 		Fwd<real_t, storage_t> res(std::cosh(a._val), false);
 		const real_t tmp = std::sinh(a._val);
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * tmp;
+		detail::vectorized::scale(res._grad, tmp, a._grad, detail::globalGradSize);
 		return res;
 	}
 
@@ -573,13 +548,11 @@ namespace sfad
 		Fwd<real_t, storage_t> res(std::tanh(a._val), false);
 /*
 		const real_t tmp = real_t(1) - res._val * res._val;
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] * tmp;
+		detail::vectorized::scale(res._grad, tmp, a._grad, detail::globalGradSize);
 */
 		const real_t tmp = std::cosh(a._val);
 		const real_t tmp2 = tmp * tmp;
-		for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-			res._grad[i] = a._grad[i] / tmp2;
+		detail::vectorized::div(res._grad, a._grad, tmp2, detail::globalGradSize);
 		return res;
 	}
 
@@ -595,8 +568,7 @@ namespace sfad
 		}
 		else if (a._val < real_t(0))
 		{
-			for (typename Fwd<real_t, storage_t>::idx_t i = 0; i < detail::globalGradSize; ++i)
-				res._grad[i] = -a._grad[i];
+			detail::vectorized::neg(res._grad, a._grad, detail::globalGradSize);
 		}
 		else
 		{
@@ -0,0 +1,58 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Defines the interface that receives checkpoints of the simulator state.
+ */
+
+#ifndef LIBCADET_CHECKPOINTWRITER_HPP_
+#define LIBCADET_CHECKPOINTWRITER_HPP_
+
+#include "cadet/LibExportImport.hpp"
+#include "cadet/cadetCompilerInfo.hpp"
+
+namespace cadet
+{
+
+/**
+ * @brief Interface for persisting checkpoints of the simulator state in the user space
+ * @details During time integration, the cadet::ISimulator periodically takes checkpoints that
+ *          contain everything required to resume the time integration later on (see
+ *          ISimulator::resumeFromCheckpoint()). This includes the state vector, its time derivative,
+ *          the forward sensitivities, the current section, and the results recorded so far.
+ *
+ *          Checkpoints are handed over to the writer by a background thread of the simulator
+ *          such that the time integration continues while a checkpoint is written.
+ */
+class CADET_API ICheckpointWriter
+{
+public:
+
+	virtual ~ICheckpointWriter() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Writes a checkpoint
+	 * @details This function is called from a background thread of the simulator. At most one
+	 *          checkpoint is written at a time. The checkpoint data is opaque to the user and
+	 *          only valid during the call.
+	 *
+	 * @param [in] t Simulation time of the checkpoint
+	 * @param [in] data Checkpoint data
+	 * @param [in] len Number of elements in @p data
+	 */
+	virtual void writeCheckpoint(double t, double const* data, unsigned int len) = 0;
+};
+
+} // namespace cadet
+
+#endif  // LIBCADET_CHECKPOINTWRITER_HPP_
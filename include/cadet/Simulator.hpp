@@ -32,6 +32,7 @@ namespace cadet
 
 class IModelSystem;
 class ISolutionRecorder;
+class ICheckpointWriter;
 class IParameterProvider;
 
 enum class ConsistentInitialization : int
@@ -160,6 +161,40 @@ inline bool isValidConsistentInitialization(int ci) CADET_NOEXCEPT
 		&& (ci <= static_cast<typename std::underlying_type<ConsistentInitialization>::type>(ConsistentInitialization::Lean));
 }
 
+/**
+ * @brief Quantity monitored by a stop condition of the time integration
+ */
+enum class StopConditionType : int
+{
+	/**
+	 * @brief Concentration of a component at the outlet of a unit operation
+	 */
+	OutletConcentration = 0,
+	/**
+	 * @brief Total amount of a component bound in a unit operation
+	 */
+	BoundMass = 1,
+	/**
+	 * @brief Time elapsed since the beginning of the current section
+	 */
+	SectionTime = 2,
+};
+
+/**
+ * @brief Action taken when a stop condition of the time integration is hit
+ */
+enum class StopConditionAction : int
+{
+	/**
+	 * @brief End the time integration
+	 */
+	Stop = 0,
+	/**
+	 * @brief Skip the remainder of the current section and continue with the next one
+	 */
+	NextSection = 1,
+};
+
 /**
  * @brief Provides functionality to simulate a model using a time integrator
  */
@@ -425,6 +460,42 @@ public:
 	 */
 	virtual void setSolutionRecorder(ISolutionRecorder* recorder) = 0;
 
+	/**
+	 * @brief Sets the checkpoint writer which receives checkpoints of the simulator state
+	 * @details Checkpoints are taken during #integrate at most every @c interval time units of
+	 *          simulated time (see #setCheckpointInterval) and are handed over to the writer by a
+	 *          background thread. If the previous checkpoint is still being written, the current
+	 *          one is skipped such that the time integration is never stalled. Setting the writer
+	 *          to @c NULL disables checkpoints.
+	 *
+	 *          Checkpoints are not taken in adjoint mode and in cyclic steady state mode.
+	 * 
+	 * @param [in] writer Implementation of the cadet::ICheckpointWriter interface
+	 */
+	virtual void setCheckpointWriter(ICheckpointWriter* writer) = 0;
+
+	/**
+	 * @brief Sets the minimum simulated time between two checkpoints
+	 * @param [in] interval Minimum time between two checkpoints, @c 0 disables checkpoints
+	 */
+	virtual void setCheckpointInterval(double interval) = 0;
+
+	/**
+	 * @brief Resumes the next time integration from a checkpoint
+	 * @details The next call to #integrate continues the time integration from the given
+	 *          checkpoint instead of starting from the initial condition. The state, its time
+	 *          derivative, and the forward sensitivities are taken from the checkpoint without
+	 *          consistent initialization. The results recorded before the checkpoint are restored
+	 *          in the solution recorder (see ISolutionRecorder::restoreCheckpoint()).
+	 *
+	 *          The simulator has to be configured exactly as in the run that created the
+	 *          checkpoint. Resuming is not supported in adjoint mode and in cyclic steady state mode.
+	 * 
+	 * @param [in] data Checkpoint data as passed to ICheckpointWriter::writeCheckpoint()
+	 * @param [in] len Number of elements in @p data
+	 */
+	virtual void resumeFromCheckpoint(double const* data, unsigned int len) = 0;
+
 	/**
 	 * @brief Starts the solution of the system specified for this simulator object
 	 * @details Checks all model parameters to lie inside their possible bounds and then runs the time integration
@@ -434,6 +505,20 @@ public:
 	 */
 	virtual void integrate() = 0;
 
+	/**
+	 * @brief Runs the time integration again from the initial state of the last call to #integrate
+	 * @details Restores the state vectors (and sensitivities) that were present when #integrate was
+	 *          last called and integrates again. This is intended for repeatedly solving the same
+	 *          model with different parameter values (e.g., during parameter estimation). All memory
+	 *          of the simulator and the model is reused and the time integrator is only reinitialized,
+	 *          such that no heap allocations are performed in the time stepping loop.
+	 *
+	 *          The saved initial state is discarded by setting new initial conditions or reinitializing
+	 *          the sensitivities. In that case, or if #integrate has not been called yet, this function
+	 *          behaves like #integrate.
+	 */
+	virtual void reintegrate() = 0;
+
 
 	/**
 	 * @brief Returns the bare state vector for the last timepoint
@@ -477,6 +562,34 @@ public:
 	 */
 	virtual const std::vector<double const*> getLastSensitivityDerivatives(unsigned int& len) const = 0;
 
+	/**
+	 * @brief Returns the gradient of the output functional computed in adjoint mode
+	 * @details The i-th element is the derivative of the functional set by #setAdjointObjective
+	 *          with respect to the i-th sensitive parameter. Returns @c nullptr if the adjoint
+	 *          mode is disabled.
+	 * @param [out] len Number of elements of the gradient
+	 * @return Gradient of the output functional of the last simulation
+	 */
+	virtual double const* getAdjointGradient(unsigned int& len) const = 0;
+
+	/**
+	 * @brief Returns the times at which stop conditions have been hit in the last simulation
+	 * @details Times are in ascending order. If several conditions are hit at the same time,
+	 *          the time is repeated for each of them.
+	 * @param [out] len Number of hits
+	 * @return Pointer to the first element of the hit times or @c nullptr if no condition has been hit
+	 */
+	virtual double const* getStopConditionHitTimes(unsigned int& len) const = 0;
+
+	/**
+	 * @brief Returns the indices of the stop conditions that have been hit in the last simulation
+	 * @details The i-th element is the index of the condition (in order of #addStopCondition)
+	 *          hit at the i-th time returned by #getStopConditionHitTimes.
+	 * @param [out] len Number of hits
+	 * @return Pointer to the first element of the condition indices or @c nullptr if no condition has been hit
+	 */
+	virtual unsigned int const* getStopConditionHitIndices(unsigned int& len) const = 0;
+
 	/**
 	 * @brief Returns the simulated model
 	 * @return Simulated model or @c NULL
@@ -554,6 +667,124 @@ public:
 	 */
 	virtual void setNumThreads(unsigned int nThreads) CADET_NOEXCEPT = 0;
 
+	/**
+	 * @brief Sets the queue depth of the asynchronous solution output
+	 * @details If @p depth is positive, the solution recorder is invoked by a separate thread
+	 *          on snapshots of the solution while the time integration continues. At most
+	 *          @p depth snapshots are pending at any time. Solutions are still recorded in
+	 *          chronological order. A @p depth of @c 0 disables asynchronous output.
+	 * @param [in] depth Maximum number of pending solution snapshots
+	 */
+	virtual void setAsyncSolutionOutput(unsigned int depth) CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Enables or disables dense output
+	 * @details If enabled, solutions at user specified solution times are interpolated
+	 *          from the internal steps of the time integrator. Otherwise, the integrator
+	 *          is stopped at each solution time, which restricts its step size control.
+	 *          Dense output has no effect if solutions are written at internal integrator steps.
+	 * @param [in] enabled Determines whether dense output is enabled
+	 */
+	virtual void setDenseOutput(bool enabled) CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Enables or disables the cyclic steady state mode
+	 * @details In cyclic steady state mode, the section times describe one cycle of a periodic
+	 *          process (e.g., simulated moving bed). Instead of integrating the whole process,
+	 *          #integrate solves for the fixed point of the map from the state at the beginning
+	 *          of a cycle to the state at its end. Cycles are repeated without recording the
+	 *          solution until the cyclic steady state is reached or @p maxCycles cycles have been
+	 *          integrated. Afterwards, a final cycle is integrated and recorded.
+	 *
+	 *          The cyclic steady state is reached if the change of each element @f$ y_i @f$ of
+	 *          the state (and sensitivity) vector over one cycle weighted by the error weights of
+	 *          the time integrator @f[ \frac{1}{\text{relTol} \left|y_i\right| + \text{absTol}_i} @f]
+	 *          does not exceed @p tol. The iteration is accelerated by Anderson mixing of the last
+	 *          @p andersonDepth cycles.
+	 * @param [in] maxCycles Maximum number of cycles, @c 0 disables the cyclic steady state mode
+	 * @param [in] tol Maximum weighted change of the state over one cycle
+	 * @param [in] andersonDepth Number of previous cycles used for acceleration, @c 0 disables acceleration
+	 */
+	virtual void setCyclicSteadyState(unsigned int maxCycles, double tol, unsigned int andersonDepth) = 0;
+
+	/**
+	 * @brief Enables the adjoint sensitivity mode for the given output functional
+	 * @details In adjoint mode, #integrate computes the gradient of the least squares functional
+	 *          @f[ G = \int_{t_0}^{t_{\text{end}}} \frac{1}{2} \sum_{i} w_i \left( c_{\text{out},i}(t) - r_i(t) \right)^2 \, \mathrm{d}t @f]
+	 *          with respect to all sensitive parameters instead of solving the forward sensitivity
+	 *          systems. Here, @f$ c_{\text{out},i} @f$ is the outlet concentration of component @f$ i @f$
+	 *          of the given unit operation and @f$ r_i @f$ is the reference, which is linearly interpolated
+	 *          between the given time points and held constant outside. After the forward integration,
+	 *          the adjoint system is integrated backwards in time by IDAS, which requires only one
+	 *          backward pass regardless of the number of sensitive parameters.
+	 *
+	 *          The unit operation has to possess an inlet and an outlet. Sensitivities with respect to
+	 *          SECTION_TIMES are not supported. The gradient is obtained from #getAdjointGradient.
+	 * @param [in] unitOp Index of the unit operation whose outlet enters the functional
+	 * @param [in] weights Weights @f$ w_i @f$ of the components (length is the number of components of the unit operation)
+	 * @param [in] time Strictly increasing time points of the reference
+	 * @param [in] reference Reference concentrations in time-major order, i.e., @c reference[j * nComp + i] is the
+	 *             reference of component @c i at time point @c j
+	 */
+	virtual void setAdjointObjective(UnitOpIdx unitOp, const std::vector<double>& weights, const std::vector<double>& time, const std::vector<double>& reference) = 0;
+
+	/**
+	 * @brief Disables the adjoint sensitivity mode
+	 * @details Forward sensitivities are computed again in subsequent calls to #integrate.
+	 */
+	virtual void clearAdjointObjective() = 0;
+
+	/**
+	 * @brief Sets the number of integration steps between two checkpoints of the forward solution in adjoint mode
+	 * @details The forward solution is recomputed from the checkpoints during the backward integration.
+	 *          More steps between checkpoints require less memory but more work per recomputation.
+	 *          Defaults to 100.
+	 * @param [in] steps Number of integration steps between two checkpoints (at least 1)
+	 */
+	virtual void setAdjointCheckpointSteps(unsigned int steps) = 0;
+
+	/**
+	 * @brief Adds a stop condition to the time integration
+	 * @details Stop conditions are monitored by the root finding of IDAS during #integrate. A condition
+	 *          is hit when the monitored quantity crosses @p threshold in the given @p direction. The
+	 *          hit time is located to the accuracy of the time integrator and recorded (see
+	 *          #getStopConditionHitTimes). Afterwards, the time integration is either ended or the
+	 *          remainder of the current section is skipped. In the former case, no solution is recorded
+	 *          after the hit time. In the latter case, the state at the hit time becomes the initial
+	 *          state of the next section and is recorded at all user specified solution times in the
+	 *          skipped remainder. If the condition is hit in the last section, the time integration
+	 *          is ended after recording the remaining solution times.
+	 *
+	 *          Forward sensitivities are continued from their values at the hit time. The dependence
+	 *          of the hit time on the parameters is neglected, that is, the sensitivities do not
+	 *          contain the correction term arising from the derivative of the hit time with respect
+	 *          to the parameters.
+	 *
+	 *          The monitored quantity depends on the @p type of the condition:
+	 *          <ul>
+	 *            <li>StopConditionType::OutletConcentration: Outlet concentration of component @p comp
+	 *                of unit operation @p unitOp</li>
+	 *            <li>StopConditionType::BoundMass: Total amount of component @p comp bound in unit
+	 *                operation @p unitOp (summed over all bound states)</li>
+	 *            <li>StopConditionType::SectionTime: Time elapsed since the beginning of the current section,
+	 *                @p unitOp and @p comp are ignored and the condition is hit once in each section</li>
+	 *          </ul>
+	 *
+	 *          Stop conditions are not supported in cyclic steady state and adjoint mode.
+	 * @param [in] type Quantity monitored by the condition
+	 * @param [in] unitOp Index of the unit operation
+	 * @param [in] comp Index of the component
+	 * @param [in] threshold Value of the monitored quantity at which the condition is hit
+	 * @param [in] direction Only hit if the quantity is increasing (@c 1), decreasing (@c -1), or in both cases (@c 0)
+	 * @param [in] action Action taken when the condition is hit
+	 */
+	virtual void addStopCondition(StopConditionType type, UnitOpIdx unitOp, unsigned int comp, double threshold, int direction, StopConditionAction action) = 0;
+
+	/**
+	 * @brief Removes all stop conditions
+	 */
+	virtual void clearStopConditions() = 0;
+
 	/**
 	 * @brief Sets the relative error tolerance of the time integrator
 	 * @details This tolerance is used for all elements of the state vector.
@@ -639,6 +870,33 @@ public:
 	 * @return Accumulated time of all calls of integrate() in seconds
 	 */
 	virtual double totalSimulationDuration() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the number of time steps taken by the time integrator in the last simulation run
+	 * @return Number of internal integrator steps of the last call of integrate() summed over all sections
+	 */
+	virtual unsigned int lastNumTimeSteps() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the number of cycles integrated in the last simulation run in cyclic steady state mode
+	 * @details The final recorded cycle is not included. Returns @c 0 if the cyclic steady state mode is disabled.
+	 * @return Number of cycles required to reach the cyclic steady state
+	 */
+	virtual unsigned int lastNumCycles() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the weighted change of the state over the last cycle in cyclic steady state mode
+	 * @details The cyclic steady state has been reached if this value does not exceed the tolerance
+	 *          set by #setCyclicSteadyState.
+	 * @return Maximum weighted change of the state over the last cycle
+	 */
+	virtual double lastCyclicSteadyStateError() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the value of the output functional of the last simulation in adjoint mode
+	 * @return Value of the functional set by #setAdjointObjective
+	 */
+	virtual double lastObjectiveValue() const CADET_NOEXCEPT = 0;
 };
 
 } // namespace cadet
@@ -18,6 +18,8 @@
 #ifndef LIBCADET_SOLUTIONRECORDER_HPP_
 #define LIBCADET_SOLUTIONRECORDER_HPP_
 
+#include <vector>
+
 #include "cadet/LibExportImport.hpp"
 #include "cadet/cadetCompilerInfo.hpp"
 #include "cadet/ParameterId.hpp"
@@ -28,6 +30,32 @@ namespace cadet
 class ISolutionExporter;
 class IModel;
 
+/**
+ * @brief Flags describing the parts of the solution of a unit operation that are recorded
+ * @details Field flags select parts of the solution of a unit operation (e.g., outlet or
+ *          particle). System flags select the solution of the original system, the forward
+ *          sensitivity systems, and their time derivatives. Flags are combined by bitwise OR.
+ */
+namespace RecordedField
+{
+	const unsigned int None = 0u;
+
+	const unsigned int Inlet = 1u << 0;
+	const unsigned int Outlet = 1u << 1;
+	const unsigned int Column = 1u << 2;
+	const unsigned int Particle = 1u << 3;
+	const unsigned int Flux = 1u << 4;
+	const unsigned int AllFields = Inlet | Outlet | Column | Particle | Flux;
+
+	const unsigned int Solution = 1u << 5;
+	const unsigned int SolutionDerivative = 1u << 6;
+	const unsigned int Sensitivity = 1u << 7;
+	const unsigned int SensitivityDerivative = 1u << 8;
+	const unsigned int AllSystems = Solution | SolutionDerivative | Sensitivity | SensitivityDerivative;
+
+	const unsigned int All = AllFields | AllSystems;
+}
+
 /**
  * @brief Interface providing functionality for recording the solution in the user space
  * @details Library users implement this interface which is then used by the cadet::ISimulator
@@ -82,6 +110,24 @@ public:
 	 */
 	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter) = 0;
 
+	/**
+	 * @brief Returns the parts of the solution of the given unit operation that are recorded
+	 * @details This function is called after all unit operations have reported their structure
+	 *          via unitOperationStructure() and before the solution of the first timestep is
+	 *          reported. The returned flags must not change until the time integration has finished.
+	 *          
+	 *          Unit operations for which RecordedField::None is returned are not reported via
+	 *          beginUnitOperation(). If no unit operation requests a system (e.g., the time derivative
+	 *          of the solution), the calls signaling its export (e.g., beginSolutionDerivative()) are
+	 *          skipped, too. For UnitOpIndep, the union of the flags of all unit operations is returned.
+	 *          
+	 *          The default implementation records everything.
+	 * 
+	 * @param [in] idx Index of the unit operation or UnitOpIndep
+	 * @return Combination of RecordedField flags
+	 */
+	virtual unsigned int recordedFields(UnitOpIdx idx) const CADET_NOEXCEPT { return RecordedField::All; }
+
 	/**
 	 * @brief Signals the beginning of a new timestep solution export
 	 * @details After a timestep has been finished, the solution is exported to the user space.
@@ -184,6 +230,41 @@ public:
 	 * @param [in] sensIdx Index of the sensitive parameter (among all sensitive parameters)
 	 */
 	virtual void endSensitivityDerivative(const ParameterId& pId, unsigned int sensIdx) = 0;
+
+	/**
+	 * @brief Appends the results recorded so far to a checkpoint
+	 * @details This function is called by the asynchronous solution output thread when the
+	 *          simulator takes a checkpoint (see ISimulator::setCheckpointWriter()). The call is
+	 *          ordered with the queued solutions, that is, the recorder has received exactly the
+	 *          solutions up to the time of the checkpoint. Solutions taken afterwards are queued
+	 *          until the call has returned.
+	 *
+	 *          Since checkpoints enable the asynchronous output, the solutions are then passed to
+	 *          the recorder by the output thread instead of the time integration thread. The calls
+	 *          of the output thread never overlap with each other. However, implementations have
+	 *          to synchronize if the recorded data is accessed by other threads during the time
+	 *          integration.
+	 *
+	 *          The default implementation does not save anything. Hence, the results recorded
+	 *          before a checkpoint are lost when resuming from it.
+	 * 
+	 * @param [in,out] buffer Checkpoint data the recorded results are appended to
+	 */
+	virtual void saveCheckpoint(std::vector<double>& buffer) const { }
+
+	/**
+	 * @brief Restores the results recorded before a checkpoint
+	 * @details This function is called when the time integration is resumed from a checkpoint
+	 *          (see ISimulator::resumeFromCheckpoint()) after notifyIntegrationStart() and
+	 *          unitOperationStructure() have been called. The data has been created by
+	 *          saveCheckpoint().
+	 *
+	 *          The default implementation ignores the data.
+	 * 
+	 * @param [in] data Recorded results saved in the checkpoint
+	 * @param [in] len Number of elements in @p data
+	 */
+	virtual void restoreCheckpoint(double const* data, unsigned int len) { }
 };
 
 } // namespace cadet
@@ -0,0 +1,124 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides an implementation of ICheckpointWriter that stores checkpoints in a binary file.
+ */
+
+#ifndef CADET_CHECKPOINTFILE_HPP_
+#define CADET_CHECKPOINTFILE_HPP_
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+
+#include "cadet/CheckpointWriter.hpp"
+#include "io/IOException.hpp"
+
+namespace cadet
+{
+
+namespace detail
+{
+	/**
+	 * @brief Signature at the beginning of a checkpoint file
+	 */
+	const char checkpointSignature[8] = {'C', 'A', 'D', 'E', 'T', 'C', 'K', 'P'};
+}
+
+/**
+ * @brief Writes checkpoints to a binary file
+ * @details The file starts with a signature followed by the number of elements of the
+ *          checkpoint (unsigned 64 bit integer), the time of the checkpoint, and the
+ *          checkpoint data (doubles in native byte order).
+ *
+ *          Each checkpoint replaces the previous one. It is first written to a temporary
+ *          file, which is renamed afterwards. This ensures that a valid checkpoint is
+ *          available even if the program is terminated while writing.
+ */
+class CheckpointFileWriter : public ICheckpointWriter
+{
+public:
+
+	CheckpointFileWriter() { }
+	CheckpointFileWriter(const std::string& fileName) : _fileName(fileName) { }
+
+	virtual ~CheckpointFileWriter() CADET_NOEXCEPT { }
+
+	virtual void writeCheckpoint(double t, double const* data, unsigned int len)
+	{
+		const std::string tempFile = _fileName + ".tmp";
+		{
+			std::ofstream fs(tempFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!fs)
+				throw io::IOException("Cannot open checkpoint file " + tempFile);
+
+			const std::uint64_t n = len;
+			fs.write(detail::checkpointSignature, sizeof(detail::checkpointSignature));
+			fs.write(reinterpret_cast<char const*>(&n), sizeof(n));
+			fs.write(reinterpret_cast<char const*>(&t), sizeof(t));
+			fs.write(reinterpret_cast<char const*>(data), sizeof(double) * len);
+
+			if (!fs)
+				throw io::IOException("Error while writing checkpoint file " + tempFile);
+		}
+
+#ifdef _WIN32
+		// Renaming does not replace existing files on Windows
+		std::remove(_fileName.c_str());
+#endif
+		if (std::rename(tempFile.c_str(), _fileName.c_str()) != 0)
+			throw io::IOException("Cannot move checkpoint to file " + _fileName);
+	}
+
+	inline const std::string& fileName() const CADET_NOEXCEPT { return _fileName; }
+	inline void fileName(const std::string& fileName) { _fileName = fileName; }
+
+protected:
+	std::string _fileName; //!< Name of the checkpoint file
+};
+
+/**
+ * @brief Reads a checkpoint written by CheckpointFileWriter
+ * @param [in] fileName Name of the checkpoint file
+ * @param [out] t Time of the checkpoint
+ * @return Checkpoint data
+ */
+inline std::vector<double> readCheckpointFile(const std::string& fileName, double& t)
+{
+	std::ifstream fs(fileName.c_str(), std::ios::in | std::ios::binary);
+	if (!fs)
+		throw io::IOException("Cannot open checkpoint file " + fileName);
+
+	char signature[sizeof(detail::checkpointSignature)];
+	std::uint64_t n = 0;
+	fs.read(signature, sizeof(signature));
+	fs.read(reinterpret_cast<char*>(&n), sizeof(n));
+	fs.read(reinterpret_cast<char*>(&t), sizeof(t));
+	if (!fs || (std::memcmp(signature, detail::checkpointSignature, sizeof(signature)) != 0))
+		throw io::IOException("File " + fileName + " is not a valid checkpoint");
+
+	std::vector<double> data(n);
+	fs.read(reinterpret_cast<char*>(data.data()), sizeof(double) * n);
+	if (!fs)
+		throw io::IOException("Checkpoint file " + fileName + " is truncated");
+
+	return data;
+}
+
+} // namespace cadet
+
+#endif  // CADET_CHECKPOINTFILE_HPP_
@@ -22,10 +22,16 @@
 #include <vector>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
+#include <memory>
+#include <cstdio>
+#include <map>
 
 #include "cadet/cadet.hpp"
 
 #include "common/SolutionRecorderImpl.hpp"
+#include "common/StreamingSolutionRecorder.hpp"
+#include "common/CheckpointFile.hpp"
 
 
 namespace cadet
@@ -142,6 +148,176 @@ void readSensitivityInitialState(ParamProvider_t& pp, const char* prefix, std::v
 	}
 }
 
+template <class ParamProvider_t>
+void readParameterSweep(ParamProvider_t& pp, std::vector<cadet::ParameterId>& params, std::vector<double>& values, unsigned int& numVariants)
+{
+	pp.pushScope("sweep");
+
+	numVariants = static_cast<unsigned int>(pp.getInt("NVARIANTS"));
+
+	const std::vector<std::string> sweepName = pp.getStringArray("SWEEP_NAME");
+	const std::vector<int> sweepUnit = pp.getIntArray("SWEEP_UNIT");
+	const std::vector<int> sweepComp = pp.getIntArray("SWEEP_COMP");
+	const std::vector<int> sweepReaction = pp.getIntArray("SWEEP_REACTION");
+	const std::vector<int> sweepSection = pp.getIntArray("SWEEP_SECTION");
+	const std::vector<int> sweepBoundPhase = pp.getIntArray("SWEEP_BOUNDPHASE");
+
+	// Convert to ParameterIds
+	params.clear();
+	params.reserve(sweepName.size());
+	for (unsigned int i = 0; i < sweepName.size(); ++i)
+		params.push_back(cadet::makeParamId(sweepName[i], sweepUnit[i], sweepComp[i], sweepBoundPhase[i], sweepReaction[i], sweepSection[i]));
+
+	// Values are stored in row-major ordering, that is, one row per variant
+	values = pp.getDoubleArray("SWEEP_VALUES");
+	if (values.size() < numVariants * params.size())
+		throw std::invalid_argument("SWEEP_VALUES has to contain NVARIANTS * len(SWEEP_NAME) elements");
+
+	pp.popScope(); // scope sweep
+}
+
+/**
+ * @brief Parameter provider that serves the initial conditions of unit operations from memory
+ * @details Parameter sweeps change initial conditions (@c INIT_C, @c INIT_CP, @c INIT_Q) after the
+ *          input file has been closed. The initial conditions of the base configuration are kept in
+ *          this provider, modified for each variant, and applied by ISimulator::setInitialCondition().
+ *          Only double arrays are supported.
+ */
+class InitialConditionProvider : public cadet::IParameterProvider
+{
+public:
+
+	InitialConditionProvider() { }
+	virtual ~InitialConditionProvider() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Removes all stored arrays
+	 */
+	void clear()
+	{
+		_arrays.clear();
+		_scopes.clear();
+	}
+
+	/**
+	 * @brief Stores an array in the current scope
+	 * @param [in] paramName Name of the array
+	 * @param [in] values Values of the array
+	 */
+	void set(const std::string& paramName, const std::vector<double>& values)
+	{
+		_arrays[path(paramName)] = values;
+	}
+
+	/**
+	 * @brief Returns a stored array of the current scope
+	 * @param [in] paramName Name of the array
+	 * @return Stored array or @c nullptr if it does not exist
+	 */
+	std::vector<double>* array(const std::string& paramName)
+	{
+		const auto it = _arrays.find(path(paramName));
+		if (it == _arrays.end())
+			return nullptr;
+		return &it->second;
+	}
+
+	virtual double getDouble(const std::string& paramName) { throw std::invalid_argument("Scalar " + path(paramName) + " is not available"); }
+	virtual int getInt(const std::string& paramName) { throw std::invalid_argument("Scalar " + path(paramName) + " is not available"); }
+	virtual uint64_t getUint64(const std::string& paramName) { throw std::invalid_argument("Scalar " + path(paramName) + " is not available"); }
+	virtual bool getBool(const std::string& paramName) { throw std::invalid_argument("Scalar " + path(paramName) + " is not available"); }
+	virtual std::string getString(const std::string& paramName) { throw std::invalid_argument("Scalar " + path(paramName) + " is not available"); }
+
+	virtual std::vector<double> getDoubleArray(const std::string& paramName)
+	{
+		std::vector<double> const* const values = array(paramName);
+		if (!values)
+			throw std::invalid_argument("Array " + path(paramName) + " is not available");
+		return *values;
+	}
+
+	virtual std::vector<int> getIntArray(const std::string& paramName) { throw std::invalid_argument("Array " + path(paramName) + " is not available"); }
+	virtual std::vector<uint64_t> getUint64Array(const std::string& paramName) { throw std::invalid_argument("Array " + path(paramName) + " is not available"); }
+	virtual std::vector<bool> getBoolArray(const std::string& paramName) { throw std::invalid_argument("Array " + path(paramName) + " is not available"); }
+	virtual std::vector<std::string> getStringArray(const std::string& paramName) { throw std::invalid_argument("Array " + path(paramName) + " is not available"); }
+
+	virtual bool exists(const std::string& paramName) { return _arrays.find(path(paramName)) != _arrays.end(); }
+	virtual bool isArray(const std::string& paramName) { return exists(paramName); }
+
+	virtual void pushScope(const std::string& scope) { _scopes.push_back(scope); }
+	virtual void popScope() { _scopes.pop_back(); }
+
+protected:
+
+	std::string path(const std::string& paramName) const
+	{
+		std::string p;
+		for (const std::string& s : _scopes)
+			p += s + "/";
+		return p + paramName;
+	}
+
+	std::map<std::string, std::vector<double>> _arrays; //!< Stored arrays indexed by their full path
+	std::vector<std::string> _scopes; //!< Stack of scopes
+};
+
+template <class ParamProvider_t>
+void readStopConditions(ParamProvider_t& pp, cadet::ISimulator& sim)
+{
+	pp.pushScope("stop_conditions");
+
+	const int numConditions = pp.getInt("NCONDITIONS");
+
+	std::ostringstream oss;
+	for (int i = 0; i < numConditions; ++i)
+	{
+		oss.str("");
+		oss << "cond_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+
+		pp.pushScope(oss.str());
+
+		const std::string typeName = pp.getString("TYPE");
+		cadet::StopConditionType type = cadet::StopConditionType::OutletConcentration;
+		if (typeName == "OUTLET")
+			type = cadet::StopConditionType::OutletConcentration;
+		else if (typeName == "BOUND_MASS")
+			type = cadet::StopConditionType::BoundMass;
+		else if (typeName == "SECTION_TIME")
+			type = cadet::StopConditionType::SectionTime;
+		else
+			throw std::invalid_argument("Unknown TYPE " + typeName + " of stop condition " + oss.str());
+
+		int unitOp = 0;
+		int comp = 0;
+		if (type != cadet::StopConditionType::SectionTime)
+		{
+			unitOp = pp.getInt("UNIT");
+			comp = pp.getInt("COMP");
+			if ((unitOp < 0) || (comp < 0))
+				throw std::invalid_argument("UNIT and COMP of stop condition " + oss.str() + " have to be non-negative");
+		}
+
+		int direction = 0;
+		if (pp.exists("DIRECTION"))
+			direction = pp.getInt("DIRECTION");
+
+		cadet::StopConditionAction action = cadet::StopConditionAction::Stop;
+		if (pp.exists("ACTION"))
+		{
+			const std::string actionName = pp.getString("ACTION");
+			if (actionName == "NEXT_SECTION")
+				action = cadet::StopConditionAction::NextSection;
+			else if (actionName != "STOP")
+				throw std::invalid_argument("Unknown ACTION " + actionName + " of stop condition " + oss.str());
+		}
+
+		sim.addStopCondition(type, unitOp, comp, pp.getDouble("THRESHOLD"), direction, action);
+		pp.popScope();
+	}
+
+	pp.popScope(); // scope stop_conditions
+}
+
 } // namespace detail
 
 /**
@@ -152,13 +328,16 @@ void readSensitivityInitialState(ParamProvider_t& pp, const char* prefix, std::v
 class Driver
 {
 public:
-	Driver() : _sim(nullptr), _builder(nullptr), _storage(nullptr), _writeLastState(false), _writeLastStateSens(false)
+	Driver() : _sim(nullptr), _builder(nullptr), _storage(nullptr), _writeLastState(false), _writeLastStateSens(false),
+		_streamSolution(false), _streamBlockSize(100), _streamNumBlocks(4), _streaming(nullptr), _streamedOutput(false), _numStreamedPoints(0),
+		_initCondFromState(false)
 	{
 		_builder = cadetCreateModelBuilder();
 	}
 
 	~Driver() CADET_NOEXCEPT
 	{
+		delete _streaming;
 		delete _storage;
 
 		if (_sim)
@@ -176,6 +355,10 @@ public:
 	 */
 	void clear()
 	{
+		delete _streaming;
+		_streaming = nullptr;
+		_streamedOutput = false;
+
 		delete _storage;
 		_storage = nullptr;
 
@@ -201,6 +384,10 @@ public:
 	void configure(ParamProvider_t& pp)
 	{
 		// Create storage
+		delete _streaming;
+		_streaming = nullptr;
+		_streamedOutput = false;
+
 		delete _storage;
 		_storage = new cadet::InternalStorageSystemRecorder();
 
@@ -213,6 +400,13 @@ public:
 		// Configure main solver parameters
 		pp.pushScope("solver");
 		_sim->configure(pp);
+
+		if (pp.exists("CHECKPOINT_FILE"))
+			_checkpointWriter.fileName(pp.getString("CHECKPOINT_FILE"));
+		else
+			_checkpointWriter.fileName("");
+
+		const bool takeCheckpoints = pp.exists("CHECKPOINT_INTERVAL") && (pp.getDouble("CHECKPOINT_INTERVAL") > 0.0);
 		
 		// Configure section times
 		std::vector<double> secTimes;
@@ -258,9 +452,20 @@ public:
 
 		pp.popScope(); // scope model
 
+		// Stop conditions refer to unit operations and require the model
+		pp.pushScope("solver");
+		if (pp.exists("stop_conditions"))
+			detail::readStopConditions(pp, *_sim);
+		pp.popScope(); // solver scope
+
 		// Configure data output (wait for sensitivities before sending storage to simulator)
 		setReturnConfiguration(pp, false);
 
+		// Checkpoints do not contain the results that have already been streamed to the output,
+		// which would be lost when resuming
+		if (_streamSolution && takeCheckpoints)
+			throw std::invalid_argument("STREAM_SOLUTION cannot be combined with a positive CHECKPOINT_INTERVAL");
+
 		// Model should be fully configured and ready to run at this point
 
 		// Read and configure parameters
@@ -308,6 +513,31 @@ public:
 				pp.popScope();
 			}
 
+			if (sensMethod == "adjoint")
+			{
+				pp.pushScope("adjoint");
+
+				const int unitOp = pp.getInt("UNIT");
+				if (unitOp < 0)
+					throw std::invalid_argument("UNIT of adjoint objective has to be non-negative");
+
+				_sim->setAdjointObjective(unitOp, pp.getDoubleArray("WEIGHTS"), pp.getDoubleArray("TIME"), pp.getDoubleArray("REFERENCE"));
+
+				if (pp.exists("CHECKPOINT_STEPS"))
+				{
+					const int steps = pp.getInt("CHECKPOINT_STEPS");
+					if (steps <= 0)
+						throw std::invalid_argument("CHECKPOINT_STEPS of adjoint mode has to be positive");
+					_sim->setAdjointCheckpointSteps(steps);
+				}
+				else
+					_sim->setAdjointCheckpointSteps(100);
+
+				pp.popScope(); // scope adjoint
+			}
+			else
+				_sim->clearAdjointObjective();
+
 			pp.popScope(); // scope sensitivity
 
 			if (numSens > 0)
@@ -323,6 +553,118 @@ public:
 		_sim->setSolutionRecorder(_storage);
 	}
 
+	/**
+	 * @brief Saves the current initial state of the simulator for later reuse
+	 * @details A parameter sweep reuses one configured simulator for many parameter variants.
+	 *          The initial state, which is overwritten by time integration, is restored from
+	 *          this copy before each variant. Call this function right after configure().
+	 *          
+	 *          Since initial conditions (@c INIT_C, @c INIT_CP, @c INIT_Q) are not model parameters,
+	 *          the initial conditions of all unit operations are kept as well. Variants that
+	 *          change them rebuild the initial state from these values.
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input for configure()
+	 * @tparam ParamProvider_t Type of the parameter provider
+	 */
+	template <typename ParamProvider_t>
+	void saveInitialState(ParamProvider_t& pp)
+	{
+		if (!_sim)
+			return;
+
+		unsigned int len = 0;
+		double const* const y = _sim->getLastSolution(len);
+		_initStateY.assign(y, y + len);
+
+		double const* const yDot = _sim->getLastSolutionDerivative(len);
+		_initStateYdot.assign(yDot, yDot + len);
+
+		_initCond.clear();
+		_initCondNumBound.clear();
+
+		pp.pushScope("model");
+
+		// A given full initial state takes precedence over the initial conditions of the unit operations
+		_initCondFromState = pp.exists("INIT_STATE_Y");
+
+		std::ostringstream oss;
+		const unsigned int maxUnitOpId = _sim->model()->maxUnitOperationId();
+		for (unsigned int i = 0; i <= maxUnitOpId; ++i)
+		{
+			oss.str("");
+			oss << "unit_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+			if (!pp.exists(oss.str()))
+				continue;
+
+			pp.pushScope(oss.str());
+			_initCond.pushScope(oss.str());
+
+			for (const char* name : { "INIT_STATE", "INIT_C", "INIT_CP", "INIT_Q" })
+			{
+				if (pp.exists(name))
+					_initCond.set(name, pp.getDoubleArray(name));
+			}
+
+			if (pp.exists("discretization"))
+			{
+				pp.pushScope("discretization");
+				if (pp.exists("NBOUND"))
+					_initCondNumBound[i] = pp.getIntArray("NBOUND");
+				pp.popScope();
+			}
+
+			_initCond.popScope();
+			pp.popScope();
+		}
+
+		pp.popScope(); // scope model
+	}
+
+	/**
+	 * @brief Prepares the configured simulator for running the given parameter variant
+	 * @details Applies the initial conditions first, either by restoring the initial state saved
+	 *          by saveInitialState() or, if the variant changes @c INIT_C, @c INIT_CP, or @c INIT_Q,
+	 *          by rebuilding it from the initial conditions of the unit operations. Afterwards, the
+	 *          parameter values are set and all stored results are removed. The model and its memory
+	 *          are reused as is. Sensitivities are reset to zero and initialized consistently since
+	 *          given initial sensitivities are not valid for other parameter values.
+	 * @param [in] params Array with IDs of the parameters to set
+	 * @param [in] values Array with parameter values
+	 * @param [in] numParams Number of elements in @p params and @p values
+	 */
+	void applyParameterVariant(cadet::ParameterId const* params, double const* values, unsigned int numParams)
+	{
+		bool changesInitCond = false;
+		for (unsigned int i = 0; i < numParams; ++i)
+			changesInitCond = changesInitCond || isInitialConditionParameter(params[i]);
+
+		if (changesInitCond)
+		{
+			if (_initCondFromState)
+				throw std::invalid_argument("Cannot sweep initial conditions of unit operations if INIT_STATE_Y is given");
+
+			detail::InitialConditionProvider initCond(_initCond);
+			for (unsigned int i = 0; i < numParams; ++i)
+			{
+				if (isInitialConditionParameter(params[i]))
+					setInitialConditionValue(initCond, params[i], values[i]);
+			}
+			_sim->setInitialCondition(initCond);
+		}
+		else if (!_initStateY.empty())
+			_sim->setInitialCondition(_initStateY.data(), _initStateYdot.data());
+
+		for (unsigned int i = 0; i < numParams; ++i)
+		{
+			if (!isInitialConditionParameter(params[i]))
+				_sim->setParameterValue(params[i], values[i]);
+		}
+
+		if (_sim->numSensParams() > 0)
+			_sim->setInitialConditionFwdSensitivities(nullptr, nullptr);
+
+		clearResults();
+	}
+
 	/**
 	 * @brief Sets initial conditions from the given parameter provider
 	 * @details Assumes that the simulator is already configured
@@ -413,6 +755,21 @@ public:
 			_writeLastStateSens = pp.getBool("WRITE_SENS_LAST");
 		else
 			_writeLastStateSens = false;
+
+		if (pp.exists("STREAM_SOLUTION"))
+			_streamSolution = pp.getBool("STREAM_SOLUTION");
+		else
+			_streamSolution = false;
+
+		if (pp.exists("STREAM_BLOCK_SIZE"))
+			_streamBlockSize = static_cast<unsigned int>(pp.getInt("STREAM_BLOCK_SIZE"));
+		else
+			_streamBlockSize = 100;
+
+		if (pp.exists("STREAM_NUM_BLOCKS"))
+			_streamNumBlocks = static_cast<unsigned int>(pp.getInt("STREAM_NUM_BLOCKS"));
+		else
+			_streamNumBlocks = 4;
 		
 		pp.popScope(); // scope return
 
@@ -426,12 +783,99 @@ public:
 	 */
 	void run()
 	{
+		// Checkpoints are only taken if the solver has a positive CHECKPOINT_INTERVAL
+		if (_checkpointWriter.fileName().empty())
+			_sim->setCheckpointWriter(nullptr);
+		else
+			_sim->setCheckpointWriter(&_checkpointWriter);
+
 		// Run simulation
 		_sim->integrate();
 	}
 
+	/**
+	 * @brief Lets the next run() continue from the checkpoint file
+	 * @details The simulator has to be configured exactly as in the run that wrote the checkpoint.
+	 * @return Simulation time of the checkpoint
+	 */
+	double resumeFromCheckpoint()
+	{
+		double t = 0.0;
+		const std::vector<double> data = cadet::readCheckpointFile(_checkpointWriter.fileName(), t);
+		_sim->resumeFromCheckpoint(data.data(), data.size());
+		return t;
+	}
+
+	/**
+	 * @brief Removes the checkpoint file if it exists
+	 */
+	void removeCheckpoint()
+	{
+		if (!_checkpointWriter.fileName().empty())
+			std::remove(_checkpointWriter.fileName().c_str());
+	}
+
+	/**
+	 * @brief Performs time integration again from the initial state of the last run()
+	 * @details The simulator has to be setup and configured for time integration. All memory
+	 *          of the simulator and the model is reused (see ISimulator::reintegrate()).
+	 */
+	void rerun()
+	{
+		_sim->reintegrate();
+	}
+
+	/**
+	 * @brief Streams the solution of the next run() to the given writer
+	 * @details Replaces the internal storage of the simulator by a StreamingSystemRecorder that
+	 *          appends blocks of time steps to the output group of @p writer during time integration.
+	 *          Existing output is removed. The writer has to stay open and must not be used until
+	 *          endStreaming() has returned. The remaining results (e.g., last state, meta data) are
+	 *          written by a subsequent call to write().
+	 * @param [in] writer Writer to stream to, has to support appending to datasets
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void beginStreaming(Writer_t& writer)
+	{
+		if (!_sim || !_storage)
+			return;
+
+		delete _streaming;
+
+		writer.unlinkGroup("output");
+
+		_streaming = new cadet::StreamingSystemRecorder<Writer_t>(writer, _streamBlockSize, _streamNumBlocks);
+		_streaming->configure(*_storage);
+		_streamedOutput = false;
+		_numStreamedPoints = 0;
+
+		_sim->setSolutionRecorder(_streaming);
+	}
+
+	/**
+	 * @brief Writes all pending blocks of a streamed run and detaches the streaming recorder
+	 * @details Rethrows errors that occurred while writing in the background.
+	 */
+	void endStreaming()
+	{
+		if (!_streaming)
+			return;
+
+		// Destroy recorder even if writing failed
+		std::unique_ptr<cadet::StreamingSystemRecorderBase> rec(_streaming);
+		_streaming = nullptr;
+		_sim->setSolutionRecorder(nullptr);
+
+		rec->finish();
+		_numStreamedPoints = rec->numDataPoints();
+		_streamedOutput = true;
+	}
+
 	/**
 	 * @brief Writes the current results to the given writer
+	 * @details If the solution has been streamed (see beginStreaming()), only the results that
+	 *          are not streamed are written and the existing output is kept.
 	 * @param [in] writer Writer to write to
 	 * @tparam Writer_t Type of the writer
 	 */
@@ -441,6 +885,20 @@ public:
 		if (!_sim || !_storage)
 			return;
 
+		if (_streamedOutput)
+		{
+			LOG(Debug) << "Streamed " << _numStreamedPoints << " data points to file";
+
+			writer.pushGroup("output");
+			writeAdjointGradient(writer);
+			writeLastStates(writer);
+			writeStopConditionHits(writer);
+			writer.popGroup();
+
+			writeMeta(writer, _sim->lastSimulationDuration());
+			return;
+		}
+
 		LOG(Debug) << "Writing " << _storage->numDataPoints() << " data points to file";
 
 		writer.unlinkGroup("output");
@@ -449,50 +907,49 @@ public:
 		writer.compressFields(true);
 
 		writer.pushGroup("output");
-		
-		writer.pushGroup("solution");
-		_storage->writeSolution(writer);
+		writeResults(writer);
 		writer.popGroup();
 
-		if (_sim->numSensParams() > 0)
-		{
-			writer.pushGroup("sensitivity");
-			_storage->writeSensitivity(writer);
-			writer.popGroup();
-		}
-
-		if (_writeLastState)
-		{
-			unsigned int len = 0;
-			double const* const lastY = _sim->getLastSolution(len);
-			double const* const lastYdot = _sim->getLastSolutionDerivative(len);
-
-			writer.vector("LAST_STATE_Y", len, lastY);
-			writer.vector("LAST_STATE_YDOT", len, lastYdot);
-		}
-
-		if (_writeLastStateSens)
-		{
+		writeMeta(writer, _sim->lastSimulationDuration());
+	}
 
-			unsigned int len = 0;
-			const std::vector<double const*> lastY = _sim->getLastSensitivities(len);
-			const std::vector<double const*> lastYdot = _sim->getLastSensitivityDerivatives(len);
+	/**
+	 * @brief Writes the current results to a subgroup of the output group
+	 * @details Used for parameter sweeps, where each variant is written to its own
+	 *          group @c /output/<groupName>. Does not touch the meta group and does
+	 *          not remove any existing output.
+	 * @param [in] writer Writer to write to
+	 * @param [in] groupName Name of the subgroup in the output group
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void writeVariant(Writer_t& writer, const std::string& groupName)
+	{
+		if (!_sim || !_storage)
+			return;
 
-			std::ostringstream oss;
-			for (unsigned int i = 0; i < lastY.size(); ++i)
-			{
-				oss.str("");
-				oss << "LAST_STATE_SENSY_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
-				writer.vector(oss.str(), len, lastY[i]);
+		LOG(Debug) << "Writing " << _storage->numDataPoints() << " data points of " << groupName << " to file";
 
-				oss.str("");
-				oss << "LAST_STATE_SENSYDOT_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
-				writer.vector(oss.str(), len, lastYdot[i]);
-			}
-		}
+		writer.extendibleFields(false);
+		writer.compressFields(true);
 
+		writer.pushGroup("output");
+		writer.pushGroup(groupName);
+		writeResults(writer);
+		writer.scalar("TIME_SIM", _sim->lastSimulationDuration());
+		writer.popGroup();
 		writer.popGroup();
+	}
 
+	/**
+	 * @brief Writes version information and simulation time to the meta group
+	 * @param [in] writer Writer to write to
+	 * @param [in] simTime Simulation time in seconds
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void writeMeta(Writer_t& writer, double simTime)
+	{
 		if (writer.exists("meta"))
 		{
 			writer.pushGroup("meta");
@@ -512,7 +969,7 @@ public:
 		writer.scalar("CADET_VERSION", std::string(cadet::getLibraryVersion()));
 		writer.scalar("CADET_COMMIT", std::string(cadet::getLibraryCommitHash()));
 		writer.scalar("CADET_BRANCH", std::string(cadet::getLibraryBranchRefspec()));
-		writer.scalar("TIME_SIM", _sim->lastSimulationDuration());
+		writer.scalar("TIME_SIM", simTime);
 
 		if (!writer.exists("FILE_FORMAT"))
 			writer.scalar("FILE_FORMAT", std::string("3.0"));
@@ -533,6 +990,12 @@ public:
 	inline cadet::IModelBuilder* modelBuilder() const CADET_NOEXCEPT { return _builder; }
 	inline cadet::IModelSystem* model() const { return _sim->model(); }
 
+	inline bool streamSolution() const CADET_NOEXCEPT { return _streamSolution; }
+
+	inline const std::string& checkpointFile() const CADET_NOEXCEPT { return _checkpointWriter.fileName(); }
+	inline void setCheckpointFile(const std::string& fileName) { _checkpointWriter.fileName(fileName); }
+	inline void setStreamSolution(bool stream) CADET_NOEXCEPT { _streamSolution = stream; }
+
 	inline void setWriteLastState(bool writeLastState) CADET_NOEXCEPT { _writeLastState = writeLastState; }
 	inline void setWriteLastStateSens(bool writeLastState) CADET_NOEXCEPT { _writeLastStateSens = writeLastState; }
 	inline void setWriteSolutionTimes(bool solTimes) CADET_NOEXCEPT
@@ -552,6 +1015,186 @@ protected:
 	bool _writeLastState;
 	bool _writeLastStateSens;
 
+	bool _streamSolution; //!< Determines whether the solution is streamed to the output during time integration
+	unsigned int _streamBlockSize; //!< Number of time steps per streamed block
+	unsigned int _streamNumBlocks; //!< Number of blocks in the ring buffer of the streaming recorder
+	cadet::StreamingSystemRecorderBase* _streaming; //!< Streaming recorder of the current run, owned by this driver
+	bool _streamedOutput; //!< Determines whether the solution of the last run has been streamed
+	unsigned int _numStreamedPoints; //!< Number of time steps streamed in the last run
+
+	cadet::CheckpointFileWriter _checkpointWriter; //!< Writes checkpoints of the simulator to CHECKPOINT_FILE
+
+	std::vector<double> _initStateY; //!< Initial state saved for reuse in parameter sweeps
+	std::vector<double> _initStateYdot; //!< Initial time derivative state saved for reuse in parameter sweeps
+	detail::InitialConditionProvider _initCond; //!< Initial conditions of the unit operations saved for parameter sweeps
+	std::map<unsigned int, std::vector<int>> _initCondNumBound; //!< Number of bound states of each component indexed by unit operation
+	bool _initCondFromState; //!< Determines whether the initial state is given by INIT_STATE_Y instead of the unit operations
+
+	/**
+	 * @brief Checks whether the given parameter refers to an initial condition of a unit operation
+	 * @param [in] param Parameter ID
+	 * @return @c true if the parameter is @c INIT_C, @c INIT_CP, or @c INIT_Q, otherwise @c false
+	 */
+	static bool isInitialConditionParameter(const cadet::ParameterId& param)
+	{
+		return (param.name == cadet::hashStringRuntime("INIT_C")) || (param.name == cadet::hashStringRuntime("INIT_CP"))
+			|| (param.name == cadet::hashStringRuntime("INIT_Q"));
+	}
+
+	/**
+	 * @brief Changes one value of the initial conditions of a unit operation
+	 * @details Components of @c INIT_C and @c INIT_CP are selected by the component index. Bound states
+	 *          of @c INIT_Q are selected by component and bound phase index. If @c INIT_CP is not given,
+	 *          it is initialized with @c INIT_C before it is changed.
+	 * @param [in,out] initCond Initial conditions of all unit operations
+	 * @param [in] param Parameter ID of the initial condition
+	 * @param [in] value New value
+	 */
+	void setInitialConditionValue(detail::InitialConditionProvider& initCond, const cadet::ParameterId& param, double value)
+	{
+		std::ostringstream oss;
+		oss << "unit_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << static_cast<int>(param.unitOperation);
+		initCond.pushScope(oss.str());
+
+		std::vector<double>* const initC = initCond.array("INIT_C");
+		if (!initC || initCond.exists("INIT_STATE"))
+			throw std::invalid_argument("Cannot sweep initial conditions of unit operation " + std::to_string(param.unitOperation) + " since it does not use INIT_C and INIT_Q");
+
+		unsigned int idx = param.component;
+		std::vector<double>* target = initC;
+		if (param.name == cadet::hashStringRuntime("INIT_CP"))
+		{
+			if (!initCond.exists("INIT_CP"))
+				initCond.set("INIT_CP", *initC);
+			target = initCond.array("INIT_CP");
+		}
+		else if (param.name == cadet::hashStringRuntime("INIT_Q"))
+		{
+			target = initCond.array("INIT_Q");
+
+			const auto it = _initCondNumBound.find(param.unitOperation);
+			if ((it == _initCondNumBound.end()) || (param.component >= it->second.size()) || (param.boundPhase >= it->second[param.component]))
+				throw std::invalid_argument("Invalid component or bound phase of INIT_Q in unit operation " + std::to_string(param.unitOperation));
+
+			idx = param.boundPhase;
+			for (unsigned int comp = 0; comp < param.component; ++comp)
+				idx += it->second[comp];
+		}
+
+		if (!target || (idx >= target->size()))
+			throw std::invalid_argument("Invalid component of initial condition in unit operation " + std::to_string(param.unitOperation));
+
+		(*target)[idx] = value;
+		initCond.popScope();
+	}
+
+	/**
+	 * @brief Writes the stored results to the currently selected group of the given writer
+	 * @param [in] writer Writer to write to
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void writeResults(Writer_t& writer)
+	{
+		writer.pushGroup("solution");
+		_storage->writeSolution(writer);
+		writer.popGroup();
+
+		unsigned int lenGradient = 0;
+		if (_sim->getAdjointGradient(lenGradient))
+			writeAdjointGradient(writer);
+		else if (_sim->numSensParams() > 0)
+		{
+			writer.pushGroup("sensitivity");
+			_storage->writeSensitivity(writer);
+			writer.popGroup();
+		}
+
+		writeLastStates(writer);
+		writeStopConditionHits(writer);
+	}
+
+	/**
+	 * @brief Writes the times and indices of the stop conditions hit in the last run
+	 * @details Does nothing if no stop condition has been hit.
+	 * @param [in] writer Writer to write to
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void writeStopConditionHits(Writer_t& writer)
+	{
+		unsigned int len = 0;
+		double const* const times = _sim->getStopConditionHitTimes(len);
+		if (!times)
+			return;
+
+		unsigned int const* const idx = _sim->getStopConditionHitIndices(len);
+		const std::vector<int> indices(idx, idx + len);
+
+		writer.vector("STOP_CONDITION_TIMES", len, times);
+		writer.vector("STOP_CONDITION_INDICES", indices);
+	}
+
+	/**
+	 * @brief Writes the gradient and value of the output functional computed in adjoint mode
+	 * @details Does nothing if the adjoint mode is disabled.
+	 * @param [in] writer Writer to write to
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void writeAdjointGradient(Writer_t& writer)
+	{
+		unsigned int len = 0;
+		double const* const gradient = _sim->getAdjointGradient(len);
+		if (!gradient)
+			return;
+
+		writer.pushGroup("sensitivity");
+		writer.vector("ADJOINT_GRADIENT", len, gradient);
+		writer.scalar("ADJOINT_OBJECTIVE", _sim->lastObjectiveValue());
+		writer.popGroup();
+	}
+
+	/**
+	 * @brief Writes the last state and sensitivities to the currently selected group of the given writer
+	 * @details Only writes the states requested in the return configuration.
+	 * @param [in] writer Writer to write to
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void writeLastStates(Writer_t& writer)
+	{
+		if (_writeLastState)
+		{
+			unsigned int len = 0;
+			double const* const lastY = _sim->getLastSolution(len);
+			double const* const lastYdot = _sim->getLastSolutionDerivative(len);
+
+			writer.vector("LAST_STATE_Y", len, lastY);
+			writer.vector("LAST_STATE_YDOT", len, lastYdot);
+		}
+
+		if (_writeLastStateSens)
+		{
+
+			unsigned int len = 0;
+			const std::vector<double const*> lastY = _sim->getLastSensitivities(len);
+			const std::vector<double const*> lastYdot = _sim->getLastSensitivityDerivatives(len);
+
+			std::ostringstream oss;
+			for (unsigned int i = 0; i < lastY.size(); ++i)
+			{
+				oss.str("");
+				oss << "LAST_STATE_SENSY_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+				writer.vector(oss.str(), len, lastY[i]);
+
+				oss.str("");
+				oss << "LAST_STATE_SENSYDOT_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+				writer.vector(oss.str(), len, lastYdot[i]);
+			}
+		}
+	}
+
 	/**
 	 * @brief Sets section times and section continuity from the given parameter provider
 	 * @details Assumes that the simulator is already configured
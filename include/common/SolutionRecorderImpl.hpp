@@ -20,12 +20,58 @@
 
 #include <vector>
 #include <sstream>
+#include <algorithm>
+#include <stdexcept>
 
 #include "cadet/SolutionRecorder.hpp"
 
 namespace cadet
 {
 
+namespace detail
+{
+	/**
+	 * @brief Appends a vector preceded by its length to checkpoint data
+	 * @param [in,out] buffer Checkpoint data
+	 * @param [in] vec Vector to append
+	 */
+	inline void appendToCheckpoint(std::vector<double>& buffer, const std::vector<double>& vec)
+	{
+		buffer.push_back(static_cast<double>(vec.size()));
+		buffer.insert(buffer.end(), vec.begin(), vec.end());
+	}
+
+	/**
+	 * @brief Reads a single value from checkpoint data
+	 * @param [in,out] data Current position in the checkpoint data, advanced past the value
+	 * @param [in] end End of the checkpoint data
+	 * @return Value read from the checkpoint
+	 */
+	inline double readFromCheckpoint(double const*& data, double const* const end)
+	{
+		if (data >= end)
+			throw std::invalid_argument("Recorded results in checkpoint are truncated");
+
+		return *(data++);
+	}
+
+	/**
+	 * @brief Reads a vector preceded by its length from checkpoint data
+	 * @param [in,out] data Current position in the checkpoint data, advanced past the vector
+	 * @param [in] end End of the checkpoint data
+	 * @param [out] vec Vector read from the checkpoint
+	 */
+	inline void readFromCheckpoint(double const*& data, double const* const end, std::vector<double>& vec)
+	{
+		const std::size_t n = static_cast<std::size_t>(readFromCheckpoint(data, end));
+		if (static_cast<std::size_t>(end - data) < n)
+			throw std::invalid_argument("Recorded results in checkpoint are truncated");
+
+		vec.assign(data, data + n);
+		data += n;
+	}
+}
+
 /**
  * @brief Stores pieces of the solution of one single unit operation in internal buffers
  * @details The pieces of stored solutions are selectable at runtime.
@@ -102,6 +148,8 @@ public:
 			_sensParticleDot[i]->clear();
 			_sensFluxDot[i]->clear();
 		}
+
+		_numTimesteps = 0;
 	}
 
 	virtual void prepare(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
@@ -315,6 +363,16 @@ public:
 		_numTimesteps = 0;
 	}
 
+	virtual unsigned int recordedFields(UnitOpIdx idx) const CADET_NOEXCEPT
+	{
+		// Only record one unit operation
+		if ((idx != _unitOp) && (idx != UnitOpIndep))
+			return RecordedField::None;
+
+		return recordedFields(_cfgSolution, RecordedField::Solution) | recordedFields(_cfgSolutionDot, RecordedField::SolutionDerivative)
+			| recordedFields(_cfgSensitivity, RecordedField::Sensitivity) | recordedFields(_cfgSensitivityDot, RecordedField::SensitivityDerivative);
+	}
+
 	virtual void beginTimestep(double t)
 	{
 		++_numTimesteps;
@@ -419,6 +477,78 @@ public:
 		endSolution();
 	}
 
+	virtual void saveCheckpoint(std::vector<double>& buffer) const
+	{
+		buffer.push_back(static_cast<double>(_numTimesteps));
+		buffer.push_back(static_cast<double>(_sensOutlet.size()));
+
+		detail::appendToCheckpoint(buffer, _time);
+		detail::appendToCheckpoint(buffer, _outlet);
+		detail::appendToCheckpoint(buffer, _inlet);
+		detail::appendToCheckpoint(buffer, _column);
+		detail::appendToCheckpoint(buffer, _particle);
+		detail::appendToCheckpoint(buffer, _flux);
+
+		detail::appendToCheckpoint(buffer, _outletDot);
+		detail::appendToCheckpoint(buffer, _inletDot);
+		detail::appendToCheckpoint(buffer, _columnDot);
+		detail::appendToCheckpoint(buffer, _particleDot);
+		detail::appendToCheckpoint(buffer, _fluxDot);
+
+		for (unsigned int i = 0; i < _sensOutlet.size(); ++i)
+		{
+			detail::appendToCheckpoint(buffer, *_sensOutlet[i]);
+			detail::appendToCheckpoint(buffer, *_sensInlet[i]);
+			detail::appendToCheckpoint(buffer, *_sensColumn[i]);
+			detail::appendToCheckpoint(buffer, *_sensParticle[i]);
+			detail::appendToCheckpoint(buffer, *_sensFlux[i]);
+
+			detail::appendToCheckpoint(buffer, *_sensOutletDot[i]);
+			detail::appendToCheckpoint(buffer, *_sensInletDot[i]);
+			detail::appendToCheckpoint(buffer, *_sensColumnDot[i]);
+			detail::appendToCheckpoint(buffer, *_sensParticleDot[i]);
+			detail::appendToCheckpoint(buffer, *_sensFluxDot[i]);
+		}
+	}
+
+	virtual void restoreCheckpoint(double const* data, unsigned int len)
+	{
+		double const* const end = data + len;
+		const unsigned int numTimesteps = static_cast<unsigned int>(detail::readFromCheckpoint(data, end));
+		if (static_cast<unsigned int>(detail::readFromCheckpoint(data, end)) != _sensOutlet.size())
+			throw std::invalid_argument("Number of sensitivities in checkpoint does not match recorder");
+
+		detail::readFromCheckpoint(data, end, _time);
+		detail::readFromCheckpoint(data, end, _outlet);
+		detail::readFromCheckpoint(data, end, _inlet);
+		detail::readFromCheckpoint(data, end, _column);
+		detail::readFromCheckpoint(data, end, _particle);
+		detail::readFromCheckpoint(data, end, _flux);
+
+		detail::readFromCheckpoint(data, end, _outletDot);
+		detail::readFromCheckpoint(data, end, _inletDot);
+		detail::readFromCheckpoint(data, end, _columnDot);
+		detail::readFromCheckpoint(data, end, _particleDot);
+		detail::readFromCheckpoint(data, end, _fluxDot);
+
+		for (unsigned int i = 0; i < _sensOutlet.size(); ++i)
+		{
+			detail::readFromCheckpoint(data, end, *_sensOutlet[i]);
+			detail::readFromCheckpoint(data, end, *_sensInlet[i]);
+			detail::readFromCheckpoint(data, end, *_sensColumn[i]);
+			detail::readFromCheckpoint(data, end, *_sensParticle[i]);
+			detail::readFromCheckpoint(data, end, *_sensFlux[i]);
+
+			detail::readFromCheckpoint(data, end, *_sensOutletDot[i]);
+			detail::readFromCheckpoint(data, end, *_sensInletDot[i]);
+			detail::readFromCheckpoint(data, end, *_sensColumnDot[i]);
+			detail::readFromCheckpoint(data, end, *_sensParticleDot[i]);
+			detail::readFromCheckpoint(data, end, *_sensFluxDot[i]);
+		}
+
+		_numTimesteps = numTimesteps;
+	}
+
 	template <typename Writer_t>
 	void writeSolution(Writer_t& writer)
 	{
@@ -524,6 +654,32 @@ public:
 	inline double const* sensFluxDot(unsigned int idx) const CADET_NOEXCEPT { return _sensFluxDot[idx]->data(); }
 protected:
 
+	/**
+	 * @brief Converts a storage configuration to RecordedField flags
+	 * @param [in] cfg Storage configuration of a system
+	 * @param [in] system RecordedField flag of the system
+	 * @return Field flags of @p cfg combined with @p system, or RecordedField::None if nothing is stored
+	 */
+	static inline unsigned int recordedFields(const StorageConfig& cfg, unsigned int system) CADET_NOEXCEPT
+	{
+		unsigned int fields = RecordedField::None;
+		if (cfg.storeInlet)
+			fields |= RecordedField::Inlet;
+		if (cfg.storeOutlet)
+			fields |= RecordedField::Outlet;
+		if (cfg.storeColumn)
+			fields |= RecordedField::Column;
+		if (cfg.storeParticle)
+			fields |= RecordedField::Particle;
+		if (cfg.storeFlux)
+			fields |= RecordedField::Flux;
+
+		if (fields == RecordedField::None)
+			return RecordedField::None;
+
+		return fields | system;
+	}
+
 	inline void beginSensitivity(unsigned int sensIdx)
 	{
 		_curCfg = &_cfgSensitivity;
@@ -690,7 +846,7 @@ class InternalStorageSystemRecorder : public ISolutionRecorder
 {
 public:
 
-	InternalStorageSystemRecorder() : _numTimesteps(0), _numSens(0), _storeTime(true)
+	InternalStorageSystemRecorder() : _allFields(RecordedField::None), _curUnitOp(UnitOpIndep), _numTimesteps(0), _numSens(0), _storeTime(true)
 	{
 	}
 
@@ -702,6 +858,7 @@ public:
 	virtual void clear()
 	{
 		_time.clear();
+		_numTimesteps = 0;
 
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->clear();
@@ -714,6 +871,8 @@ public:
 
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->prepare(numDofs, numSens, numTimesteps);
+
+		updateUnitOpLookup();
 	}
 
 	virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
@@ -724,6 +883,19 @@ public:
 
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->notifyIntegrationStart(numDofs, numSens, numTimesteps);
+
+		updateUnitOpLookup();
+	}
+
+	virtual unsigned int recordedFields(UnitOpIdx idx) const CADET_NOEXCEPT
+	{
+		if (idx == UnitOpIndep)
+			return _allFields;
+
+		if (idx < _unitOpFields.size())
+			return _unitOpFields[idx];
+
+		return RecordedField::None;
 	}
 
 	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
@@ -747,14 +919,24 @@ public:
 
 	virtual void beginUnitOperation(cadet::UnitOpIdx idx, const cadet::IModel& model, const cadet::ISolutionExporter& exporter)
 	{
-		for (InternalStorageUnitOpRecorder* rec : _recorders)
+		// Only forward to the recorders of this unit operation
+		if (idx >= _unitOpRecorders.size())
+			return;
+
+		_curUnitOp = idx;
+		for (InternalStorageUnitOpRecorder* rec : _unitOpRecorders[idx])
 			rec->beginUnitOperation(idx, model, exporter);
 	}
 
 	virtual void endUnitOperation()
 	{
-		for (InternalStorageUnitOpRecorder* rec : _recorders)
+		if (_curUnitOp >= _unitOpRecorders.size())
+			return;
+
+		for (InternalStorageUnitOpRecorder* rec : _unitOpRecorders[_curUnitOp])
 			rec->endUnitOperation();
+
+		_curUnitOp = UnitOpIndep;
 	}
 
 	virtual void endTimestep()
@@ -811,6 +993,44 @@ public:
 			rec->endSensitivityDerivative(pId, sensIdx);
 	}
 	
+	virtual void saveCheckpoint(std::vector<double>& buffer) const
+	{
+		buffer.push_back(static_cast<double>(_numTimesteps));
+		buffer.push_back(static_cast<double>(_recorders.size()));
+		detail::appendToCheckpoint(buffer, _time);
+
+		// Prefix the results of each unit operation recorder with their length
+		for (InternalStorageUnitOpRecorder const* rec : _recorders)
+		{
+			const std::size_t lenPos = buffer.size();
+			buffer.push_back(0.0);
+			rec->saveCheckpoint(buffer);
+			buffer[lenPos] = static_cast<double>(buffer.size() - lenPos - 1);
+		}
+	}
+
+	virtual void restoreCheckpoint(double const* data, unsigned int len)
+	{
+		double const* const end = data + len;
+		const unsigned int numTimesteps = static_cast<unsigned int>(detail::readFromCheckpoint(data, end));
+		if (static_cast<unsigned int>(detail::readFromCheckpoint(data, end)) != _recorders.size())
+			throw std::invalid_argument("Number of unit operation recorders in checkpoint does not match");
+
+		detail::readFromCheckpoint(data, end, _time);
+
+		for (InternalStorageUnitOpRecorder* rec : _recorders)
+		{
+			const unsigned int recLen = static_cast<unsigned int>(detail::readFromCheckpoint(data, end));
+			if (static_cast<unsigned int>(end - data) < recLen)
+				throw std::invalid_argument("Recorded results in checkpoint are truncated");
+
+			rec->restoreCheckpoint(data, recLen);
+			data += recLen;
+		}
+
+		_numTimesteps = numTimesteps;
+	}
+
 	template <typename Writer_t>
 	void writeSolution(Writer_t& writer)
 	{
@@ -859,10 +1079,12 @@ public:
 	inline void storeTime(bool st) CADET_NOEXCEPT { _storeTime = st; }
 
 	inline unsigned int numDataPoints() const CADET_NOEXCEPT { return _numTimesteps; }
+	inline double const* time() const CADET_NOEXCEPT { return _time.data(); }
 
 	inline void addRecorder(InternalStorageUnitOpRecorder* rec)
 	{
 		_recorders.push_back(rec);
+		updateUnitOpLookup();
 	}
 
 	inline unsigned int numRecorders() const CADET_NOEXCEPT { return _recorders.size(); }
@@ -893,11 +1115,48 @@ public:
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			delete rec;
 		_recorders.clear();
+		updateUnitOpLookup();
 	}
 
 protected:
 
+	/**
+	 * @brief Builds the tables that map unit operation indices to recorders and recorded fields
+	 * @details Has to be called whenever the recorders or their storage configuration change.
+	 */
+	inline void updateUnitOpLookup()
+	{
+		UnitOpIdx maxIdx = 0;
+		for (InternalStorageUnitOpRecorder const* rec : _recorders)
+		{
+			if (rec->unitOperation() != UnitOpIndep)
+				maxIdx = std::max(maxIdx, static_cast<UnitOpIdx>(rec->unitOperation() + 1));
+		}
+
+		for (std::vector<InternalStorageUnitOpRecorder*>& recs : _unitOpRecorders)
+			recs.clear();
+		_unitOpRecorders.resize(maxIdx);
+		_unitOpFields.clear();
+		_unitOpFields.resize(maxIdx, RecordedField::None);
+		_allFields = RecordedField::None;
+
+		for (InternalStorageUnitOpRecorder* rec : _recorders)
+		{
+			const UnitOpIdx idx = rec->unitOperation();
+			if (idx == UnitOpIndep)
+				continue;
+
+			_unitOpRecorders[idx].push_back(rec);
+			_unitOpFields[idx] |= rec->recordedFields(idx);
+			_allFields |= _unitOpFields[idx];
+		}
+	}
+
 	std::vector<InternalStorageUnitOpRecorder*> _recorders;
+	std::vector<std::vector<InternalStorageUnitOpRecorder*>> _unitOpRecorders; //!< Recorders of each unit operation
+	std::vector<unsigned int> _unitOpFields; //!< Recorded fields of each unit operation
+	unsigned int _allFields; //!< Union of the recorded fields of all unit operations
+	UnitOpIdx _curUnitOp; //!< Index of the unit operation that is currently reported
 	unsigned int _numTimesteps;
 	unsigned int _numSens;
 	std::vector<double> _time;
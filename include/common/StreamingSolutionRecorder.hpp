@@ -0,0 +1,436 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides an implementation of ISolutionRecorder that streams the solution to a writer during time integration.
+ */
+
+#ifndef CADET_STREAMINGSOLUTIONRECORDER_HPP_
+#define CADET_STREAMINGSOLUTIONRECORDER_HPP_
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+
+#include "common/SolutionRecorderImpl.hpp"
+
+namespace cadet
+{
+
+namespace detail
+{
+
+/**
+ * @brief Turns writes of complete datasets into appends along the first (time) dimension
+ * @details The InternalStorageUnitOpRecorder writes its data as vectors, matrices, and tensors
+ *          whose first dimension is time. This adapter forwards these calls to the @c append()
+ *          function of the underlying writer, which extends existing datasets by the given
+ *          number of time steps.
+ * @tparam Writer_t Type of the underlying writer
+ */
+template <typename Writer_t>
+class AppendingWriter
+{
+public:
+	AppendingWriter(Writer_t& writer) : _writer(writer) { }
+
+	inline void pushGroup(const std::string& groupName) { _writer.pushGroup(groupName); }
+	inline void popGroup() { _writer.popGroup(); }
+
+	template <typename T>
+	void vector(const std::string& dataSetName, const std::size_t length, const T* buffer, const std::size_t stride = 1)
+	{
+		_writer.template append<T>(dataSetName, 1, &length, buffer, stride);
+	}
+
+	template <typename T>
+	void matrix(const std::string& dataSetName, const std::size_t rows, const std::size_t cols, const T* buffer, const std::size_t stride = 1)
+	{
+		const std::size_t dims[2] = {rows, cols};
+		_writer.template append<T>(dataSetName, 2, dims, buffer, stride);
+	}
+
+	template <typename T>
+	void tensor(const std::string& dataSetName, const std::size_t rank, const std::size_t* dims, const T* buffer, const std::size_t stride = 1)
+	{
+		_writer.template append<T>(dataSetName, rank, dims, buffer, stride);
+	}
+
+protected:
+	Writer_t& _writer;
+};
+
+} // namespace detail
+
+
+/**
+ * @brief Streams the solution of the model system in blocks of time steps during time integration
+ * @details Instead of accumulating all time steps in memory, the solution is collected in a
+ *          ring of InternalStorageSystemRecorder objects (blocks), each of which holds a fixed
+ *          number of time steps. A full block is handed over to a background thread that appends
+ *          it to the output, while the time integrator continues to fill the next free block.
+ *          The time integrator only waits if all blocks of the ring are pending to be written.
+ *          Hence, memory consumption is bounded by the number of blocks times the block size.
+ *
+ *          The pieces of the solution that are recorded are taken from a template recorder
+ *          (see configure()). After time integration, finish() has to be called in order to
+ *          write the last (partially filled) block and wait for all pending writes.
+ *
+ *          The output is written by the derived class in writeBlock(), which is only called
+ *          from the background thread.
+ *
+ *          Checkpoints are not supported, since the results that have already been written
+ *          cannot be restored. The Driver rejects configurations that combine streaming with
+ *          checkpoints.
+ */
+class StreamingSystemRecorderBase : public ISolutionRecorder
+{
+public:
+
+	/**
+	 * @brief Creates a streaming recorder
+	 * @param [in] blockSize Number of time steps per block
+	 * @param [in] numBlocks Number of blocks in the ring buffer (at least 2)
+	 */
+	StreamingSystemRecorderBase(unsigned int blockSize, unsigned int numBlocks) : _blockSize(std::max(blockSize, 1u)),
+		_numBlocks(std::max(numBlocks, 2u)), _active(nullptr), _numTimesteps(0), _numSens(0), _busy(false), _stop(false)
+	{
+	}
+
+	virtual ~StreamingSystemRecorderBase() CADET_NOEXCEPT
+	{
+		stopWriter();
+	}
+
+	/**
+	 * @brief Sets up the blocks of the ring buffer from a template recorder
+	 * @details Each block records the same unit operations and pieces of the solution as the template.
+	 * @param [in] tmpl Template recorder that determines what is recorded
+	 */
+	void configure(const InternalStorageSystemRecorder& tmpl)
+	{
+		waitIdle();
+
+		_blocks.clear();
+		_freeBlocks.clear();
+		for (unsigned int i = 0; i < _numBlocks; ++i)
+		{
+			InternalStorageSystemRecorder* const block = new InternalStorageSystemRecorder();
+			block->storeTime(tmpl.storeTime());
+
+			for (unsigned int j = 0; j < tmpl.numRecorders(); ++j)
+			{
+				InternalStorageUnitOpRecorder const* const rec = tmpl.recorder(j);
+				InternalStorageUnitOpRecorder* const subRec = new InternalStorageUnitOpRecorder(rec->unitOperation());
+
+				subRec->solutionConfig(rec->solutionConfig());
+				subRec->solutionDotConfig(rec->solutionDotConfig());
+				subRec->sensitivityConfig(rec->sensitivityConfig());
+				subRec->sensitivityDotConfig(rec->sensitivityDotConfig());
+				subRec->splitComponents(rec->splitComponents());
+				subRec->storeTime(rec->storeTime());
+
+				block->addRecorder(subRec);
+			}
+
+			_blocks.push_back(std::unique_ptr<InternalStorageSystemRecorder>(block));
+			_freeBlocks.push_back(block);
+		}
+
+		_active = _freeBlocks.front();
+		_freeBlocks.pop_front();
+	}
+
+	/**
+	 * @brief Writes the current block and waits for all pending writes to finish
+	 * @details Rethrows the first exception that occurred while writing.
+	 */
+	void finish()
+	{
+		if (_active && (_active->numDataPoints() > 0))
+			submitActiveBlock();
+
+		waitIdle();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_error)
+		{
+			std::exception_ptr e = _error;
+			_error = nullptr;
+			std::rethrow_exception(e);
+		}
+	}
+
+	virtual void clear()
+	{
+		waitIdle();
+		for (std::unique_ptr<InternalStorageSystemRecorder>& block : _blocks)
+			block->clear();
+		_numTimesteps = 0;
+	}
+
+	virtual void prepare(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		waitIdle();
+		_numSens = numSens;
+
+		// Blocks never hold more than _blockSize time steps
+		for (std::unique_ptr<InternalStorageSystemRecorder>& block : _blocks)
+			block->prepare(numDofs, numSens, std::min(numTimesteps, _blockSize));
+	}
+
+	virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		waitIdle();
+		_numSens = numSens;
+		_numTimesteps = 0;
+
+		for (std::unique_ptr<InternalStorageSystemRecorder>& block : _blocks)
+			block->notifyIntegrationStart(numDofs, numSens, std::min(numTimesteps, _blockSize));
+
+		startWriter();
+	}
+
+	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
+	{
+		for (std::unique_ptr<InternalStorageSystemRecorder>& block : _blocks)
+			block->unitOperationStructure(idx, model, exporter);
+	}
+
+	virtual unsigned int recordedFields(UnitOpIdx idx) const CADET_NOEXCEPT
+	{
+		// All blocks share the same configuration
+		return _active->recordedFields(idx);
+	}
+
+	virtual void beginTimestep(double t)
+	{
+		++_numTimesteps;
+		_active->beginTimestep(t);
+	}
+
+	virtual void beginUnitOperation(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
+	{
+		_active->beginUnitOperation(idx, model, exporter);
+	}
+
+	virtual void endUnitOperation() { _active->endUnitOperation(); }
+
+	virtual void endTimestep()
+	{
+		_active->endTimestep();
+
+		// Hand over full block to the writer
+		if (_active->numDataPoints() >= _blockSize)
+			submitActiveBlock();
+	}
+
+	virtual void beginSolution() { _active->beginSolution(); }
+	virtual void endSolution() { _active->endSolution(); }
+	virtual void beginSolutionDerivative() { _active->beginSolutionDerivative(); }
+	virtual void endSolutionDerivative() { _active->endSolutionDerivative(); }
+
+	virtual void beginSensitivity(const ParameterId& pId, unsigned int sensIdx) { _active->beginSensitivity(pId, sensIdx); }
+	virtual void endSensitivity(const ParameterId& pId, unsigned int sensIdx) { _active->endSensitivity(pId, sensIdx); }
+	virtual void beginSensitivityDerivative(const ParameterId& pId, unsigned int sensIdx) { _active->beginSensitivityDerivative(pId, sensIdx); }
+	virtual void endSensitivityDerivative(const ParameterId& pId, unsigned int sensIdx) { _active->endSensitivityDerivative(pId, sensIdx); }
+
+	inline unsigned int numDataPoints() const CADET_NOEXCEPT { return _numTimesteps; }
+	inline unsigned int blockSize() const CADET_NOEXCEPT { return _blockSize; }
+	inline unsigned int numBlocks() const CADET_NOEXCEPT { return _numBlocks; }
+
+protected:
+
+	/**
+	 * @brief Appends the given block to the output
+	 * @details Called from the background thread only.
+	 * @param [in] block Block with recorded time steps
+	 */
+	virtual void writeBlock(InternalStorageSystemRecorder& block) = 0;
+
+	/**
+	 * @brief Stops the background thread after all pending blocks have been written
+	 * @details Has to be called in the destructor of derived classes.
+	 */
+	void stopWriter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_cvWork.notify_all();
+
+		if (_thread.joinable())
+			_thread.join();
+	}
+
+	void startWriter()
+	{
+		if (_thread.joinable())
+			return;
+
+		_stop = false;
+		_thread = std::thread(&StreamingSystemRecorderBase::writerLoop, this);
+	}
+
+	/**
+	 * @brief Hands the active block over to the writer and continues with a free block
+	 * @details Blocks if no free block is available.
+	 */
+	void submitActiveBlock()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_fullBlocks.push_back(_active);
+		_cvWork.notify_one();
+
+		_cvDone.wait(lock, [this]() { return !_freeBlocks.empty(); });
+		_active = _freeBlocks.front();
+		_freeBlocks.pop_front();
+	}
+
+	void waitIdle()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cvDone.wait(lock, [this]() { return _fullBlocks.empty() && !_busy; });
+	}
+
+	void writerLoop()
+	{
+		while (true)
+		{
+			InternalStorageSystemRecorder* block = nullptr;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cvWork.wait(lock, [this]() { return _stop || !_fullBlocks.empty(); });
+
+				// Pending blocks are written before stopping
+				if (_fullBlocks.empty())
+					return;
+
+				block = _fullBlocks.front();
+				_fullBlocks.pop_front();
+				_busy = true;
+			}
+
+			// Skip all further writes after the first error
+			try
+			{
+				if (!_error)
+					writeBlock(*block);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_error = std::current_exception();
+			}
+
+			block->clear();
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_freeBlocks.push_back(block);
+				_busy = false;
+			}
+			_cvDone.notify_all();
+		}
+	}
+
+	unsigned int _blockSize; //!< Number of time steps in one block
+	unsigned int _numBlocks; //!< Number of blocks in the ring buffer
+
+	std::vector<std::unique_ptr<InternalStorageSystemRecorder>> _blocks; //!< Owns all blocks
+	InternalStorageSystemRecorder* _active; //!< Block that is currently filled by the time integrator
+	std::deque<InternalStorageSystemRecorder*> _freeBlocks; //!< Empty blocks
+	std::deque<InternalStorageSystemRecorder*> _fullBlocks; //!< Blocks waiting to be written in order of submission
+
+	unsigned int _numTimesteps; //!< Total number of recorded time steps
+	unsigned int _numSens; //!< Number of sensitivities
+
+	std::thread _thread; //!< Background thread that writes the blocks
+	std::mutex _mutex; //!< Protects the block queues and state flags
+	std::condition_variable _cvWork; //!< Signals the writer that a block is pending or it should stop
+	std::condition_variable _cvDone; //!< Signals the time integrator that a block has been written
+	bool _busy; //!< Determines whether the writer is currently writing a block
+	bool _stop; //!< Determines whether the writer should stop
+	std::exception_ptr _error; //!< First exception thrown while writing
+};
+
+
+/**
+ * @brief Streams the solution of the model system to a writer during time integration
+ * @details The datasets are created in @c /output/solution and @c /output/sensitivity with the
+ *          same names and layout as written by the Driver from an InternalStorageSystemRecorder.
+ *          Each block is appended to the datasets along their first (time) dimension. The writer
+ *          has to stay open and must not be used by other threads until finish() has returned.
+ *          The appended datasets are compressed. The compression setting of the writer is
+ *          restored when the recorder is destroyed.
+ * @tparam Writer_t Type of the writer, has to provide an @c append() function
+ */
+template <typename Writer_t>
+class StreamingSystemRecorder : public StreamingSystemRecorderBase
+{
+public:
+
+	/**
+	 * @brief Creates a streaming recorder
+	 * @param [in] writer Opened writer the solution is appended to
+	 * @param [in] blockSize Number of time steps per block
+	 * @param [in] numBlocks Number of blocks in the ring buffer (at least 2)
+	 */
+	StreamingSystemRecorder(Writer_t& writer, unsigned int blockSize, unsigned int numBlocks) : StreamingSystemRecorderBase(blockSize, numBlocks),
+		_writer(writer), _prevCompression(writer.compressFields())
+	{
+		_writer.compressFields(true);
+	}
+
+	virtual ~StreamingSystemRecorder() CADET_NOEXCEPT
+	{
+		// Stop thread before the writer becomes unusable
+		stopWriter();
+		_writer.compressFields(_prevCompression);
+	}
+
+protected:
+
+	virtual void writeBlock(InternalStorageSystemRecorder& block)
+	{
+		detail::AppendingWriter<Writer_t> appender(_writer);
+
+		_writer.pushGroup("output");
+
+		_writer.pushGroup("solution");
+		block.writeSolution(appender);
+		_writer.popGroup();
+
+		if (_numSens > 0)
+		{
+			_writer.pushGroup("sensitivity");
+			block.writeSensitivity(appender);
+			_writer.popGroup();
+		}
+
+		_writer.popGroup();
+	}
+
+	Writer_t& _writer; //!< Writer the solution is appended to
+	bool _prevCompression; //!< Compression setting of the writer before streaming
+};
+
+} // namespace cadet
+
+#endif  // CADET_STREAMINGSOLUTIONRECORDER_HPP_
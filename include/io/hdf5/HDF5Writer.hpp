@@ -16,6 +16,7 @@
 #include <vector>
 #include <string>
 #include <cstring>
+#include <algorithm>
 
 #include "cadet/cadetCompilerInfo.hpp"
 #include "common/CompilerSpecific.hpp"
@@ -72,6 +73,14 @@ public:
 	template <typename T>
 	void scalar(const std::string& dataSetName, const T buffer);
 
+	/// \brief Append data from C-array to an extendible dataset along its first dimension,
+	///        the dataset is created if it does not exist
+	template <typename T>
+	void append(const std::string& dataSetName, const size_t rank, const size_t* dims, const T* buffer, const size_t stride = 1);
+
+	/// \brief Returns whether existing datasets can be extended by append()
+	static inline bool supportsAppend() { return true; }
+
 	/// \brief Removes an existing group from the file
 	inline void unlinkGroup(const std::string& groupName);
 
@@ -81,6 +90,9 @@ public:
 	/// \brief Enable/disable compression for tensors of 2nd order and above
 	inline void compressFields(bool setCompression) {_writeCompressed = setCompression;}
 
+	/// \brief Returns whether compression is enabled for tensors of 2nd order and above
+	inline bool compressFields() const {return _writeCompressed;}
+
 	/// \brief Tensors of 2nd order (matrices) and above are written as extendible fields
 	///        (maxsize = unlimited, chunked layout), when set to true.
 	inline void extendibleFields(bool setExtendible) {_writeExtendible = setExtendible;}
@@ -88,6 +100,7 @@ public:
 private:
 
 	void writeWork(const std::string& dataSetName, hid_t memType, hid_t fileType, const size_t rank, const size_t* dims, const void* buffer, const size_t stride);
+	void appendWork(const std::string& dataSetName, hid_t memType, hid_t fileType, const size_t rank, const size_t* dims, const void* buffer, const size_t stride);
 
 	bool                    _writeScalar;
 	bool                    _writeExtendible;
@@ -173,6 +186,24 @@ void HDF5Writer::write(const std::string& dataSetName, const size_t rank, const
 {
 	throw IOException("You may not try to write an unsupported type");
 }
+
+template <>
+void HDF5Writer::append<double>(const std::string& dataSetName, const size_t rank, const size_t* dims, const double* buffer, const size_t stride)
+{
+	appendWork(dataSetName, H5T_NATIVE_DOUBLE, H5T_IEEE_F64LE, rank, dims, buffer, stride);
+}
+
+template <>
+void HDF5Writer::append<int>(const std::string& dataSetName, const size_t rank, const size_t* dims, const int* buffer, const size_t stride)
+{
+	appendWork(dataSetName, H5T_NATIVE_INT, H5T_STD_I32LE, rank, dims, buffer, stride);
+}
+
+template <typename T>
+void HDF5Writer::append(const std::string& dataSetName, const size_t rank, const size_t* dims, const T* buffer, const size_t stride)
+{
+	throw IOException("You may not try to append an unsupported type");
+}
 // ============================================================================================================
 
 
@@ -332,6 +363,92 @@ void HDF5Writer::writeWork(const std::string& dataSetName, hid_t memType, hid_t
 	H5Pclose(propList);
 }
 
+
+void HDF5Writer::appendWork(const std::string& dataSetName, hid_t memType, hid_t fileType, const size_t rank, const size_t* dims, const void* buffer, const size_t stride)
+{
+	std::vector<hsize_t> count(dims, dims + rank);
+
+	// Empty blocks are skipped, datasets with a vanishing fixed dimension cannot be chunked
+	for (size_t i = 0; i < rank; ++i)
+	{
+		if (count[i] == 0)
+			return;
+	}
+
+	openGroup(true);
+
+	hid_t dataSet = -1;
+	if (H5Lexists(_groupsOpened.top(), dataSetName.c_str(), H5P_DEFAULT) > 0)
+		dataSet = H5Dopen2(_groupsOpened.top(), dataSetName.c_str(), H5P_DEFAULT);
+	else
+	{
+		// Create empty dataset that is unlimited in the first dimension
+		std::vector<hsize_t> curDims(count);
+		std::vector<hsize_t> maxDims(count);
+		curDims[0] = 0;
+		maxDims[0] = H5S_UNLIMITED;
+
+		// One chunk holds the data of one append call, but is limited to 2^24 elements (128 MiB of doubles)
+		std::vector<hsize_t> chunks(rank);
+		hsize_t rowSize = 1;
+		for (size_t i = 1; i < rank; ++i)
+		{
+			chunks[i] = count[i];
+			rowSize *= chunks[i];
+		}
+		chunks[0] = std::max(std::min(count[0], (hsize_t(1) << 24) / rowSize), hsize_t(1));
+
+		const hid_t propList = H5Pcreate(H5P_DATASET_CREATE);
+		H5Pset_chunk(propList, rank, chunks.data());
+		if (_writeCompressed)
+			H5Pset_deflate(propList, 9);
+
+		const hid_t dataSpace = H5Screate_simple(rank, curDims.data(), maxDims.data());
+		dataSet = H5Dcreate2(_groupsOpened.top(), dataSetName.c_str(), fileType, dataSpace, H5P_DEFAULT, propList, H5P_DEFAULT);
+		H5Sclose(dataSpace);
+		H5Pclose(propList);
+	}
+	closeGroup();
+
+	if (dataSet < 0)
+		throw IOException("Failed to create or open dataset \"" + dataSetName + "\" for appending");
+
+	// Extend dataset by the number of appended rows
+	std::vector<hsize_t> extent(rank);
+	hid_t fileSpace = H5Dget_space(dataSet);
+	H5Sget_simple_extent_dims(fileSpace, extent.data(), nullptr);
+	H5Sclose(fileSpace);
+
+	std::vector<hsize_t> start(rank, 0);
+	start[0] = extent[0];
+	extent[0] += count[0];
+	H5Dset_extent(dataSet, extent.data());
+
+	// Select appended rows in file
+	fileSpace = H5Dget_space(dataSet);
+	H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr);
+
+	// Create (possibly strided) memory data space
+	hsize_t numElem = 1;
+	for (size_t i = 0; i < rank; ++i)
+		numElem *= count[i];
+
+	const hsize_t clampedStride = (stride < 1) ? 1 : stride;
+	const hsize_t spaceExtent = numElem * clampedStride;
+	const hid_t memSpace = H5Screate_simple(1, &spaceExtent, nullptr);
+	if (clampedStride > 1)
+	{
+		const hsize_t memStart = 0;
+		H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, &memStart, &clampedStride, &numElem, nullptr);
+	}
+
+	H5Dwrite(dataSet, memType, memSpace, fileSpace, H5P_DEFAULT, buffer);
+
+	H5Sclose(memSpace);
+	H5Sclose(fileSpace);
+	H5Dclose(dataSet);
+}
+
 }  // namespace io
 }  // namespace cadet
 
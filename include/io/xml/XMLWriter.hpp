@@ -84,12 +84,24 @@ public:
 	/// \brief This functionality is not supported by XML - this is a stub.
 	///        Set the level of compression used for tensors of 2nd order and above
 	inline void compressFields(bool setCompression) {}
+	inline bool compressFields() const { return false; }
 
 	/// \brief This functionality is not supported by XML - this is a stub.
 	///        Tensors of 2nd order (vectors) and above are written as extendible fields
 	///        (maxsize = unlimited, chunked layout), when set to true.
 	inline void extendibleFields(bool setExtendible) {}
 
+	/// \brief This functionality is not supported by XML - this is a stub.
+	///        Appends data to an extendible dataset along its first dimension.
+	template <typename T>
+	void append(const std::string& dataSetName, const size_t rank, const size_t* dims, const T* buffer, const size_t stride = 1)
+	{
+		throw IOException("Appending to datasets is not supported by XML");
+	}
+
+	/// \brief Returns whether existing datasets can be extended by append()
+	static inline bool supportsAppend() { return false; }
+
 private:
 
 	std::string _typeName;                      //!< Name of the type to be written
@@ -25,14 +25,18 @@
 #include "common/ParameterProviderImpl.hpp"
 #include "common/Driver.hpp"
 
-#ifdef CADET_BENCHMARK_MODE
-	#include "common/Timer.hpp"
-#endif
+#include "common/Timer.hpp"
 
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <cctype>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
 
 #ifndef CADET_LOGGING_DISABLE
 	template <>
@@ -109,9 +113,175 @@ namespace TCLAP
 	}
 }
 
+template <class Writer_t>
+void openOutputFile(Writer_t& writer, const std::string& inFileName, const std::string& outFileName)
+{
+	if (inFileName == outFileName)
+		writer.openFile(outFileName, "rw");
+	else
+		writer.openFile(outFileName, "co");
+}
+
+/**
+ * @brief Runs a parameter sweep of a base configuration
+ * @details The base configuration is read once per worker thread. Each worker owns a
+ *          fully configured simulator and model, which are reused for all variants
+ *          processed by that worker. Only the swept parameters and the initial state
+ *          are reset between variants. The results of variant @c i are written to group
+ *          @c /output/variant_i as soon as the variant has finished.
+ * @param [in] inFileName Name of the input file
+ * @param [in] outFileName Name of the output file
+ * @param [in] numWorkers Number of worker threads (@c 0 selects hardware concurrency)
+ */
+template <class Reader_t, class Writer_t>
+void runSweep(const std::string& inFileName, const std::string& outFileName, unsigned int numWorkers)
+{
+	std::vector<cadet::ParameterId> sweepParams;
+	std::vector<double> sweepValues;
+	unsigned int numVariants = 0;
+	std::vector<std::unique_ptr<cadet::Driver>> drivers;
+
+	{
+		Reader_t rd;
+		rd.openFile(inFileName, "r");
+
+		cadet::ParameterProviderImpl<Reader_t> pp(rd);
+		cadet::detail::readParameterSweep(pp, sweepParams, sweepValues, numVariants);
+
+		if (numWorkers == 0)
+			numWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+		numWorkers = std::max(std::min(numWorkers, numVariants), 1u);
+
+		// Configure one simulator and model per worker
+		drivers.reserve(numWorkers);
+		for (unsigned int i = 0; i < numWorkers; ++i)
+		{
+			drivers.push_back(std::unique_ptr<cadet::Driver>(new cadet::Driver()));
+			cadet::Driver& drv = *drivers.back();
+			drv.configure(pp);
+			drv.saveInitialState(pp);
+
+			// Sweeps cannot be resumed and workers would overwrite each other's checkpoints
+			drv.setCheckpointFile("");
+
+			// Parallelism is exploited over variants, do not oversubscribe cores
+			if (numWorkers > 1)
+				drv.simulator()->setNumThreads(1);
+		}
+
+		rd.closeFile();
+	}
+
+	Writer_t writer;
+	openOutputFile(writer, inFileName, outFileName);
+	writer.unlinkGroup("output");
+
+	std::mutex writerMutex;
+	std::atomic<unsigned int> nextVariant(0);
+	std::vector<int> variantStatus(numVariants, 0);
+	std::exception_ptr workerError = nullptr;
+
+	cadet::Timer sweepTimer;
+	sweepTimer.start();
+
+	const auto worker = [&](cadet::Driver& drv)
+	{
+		std::ostringstream oss;
+		for (unsigned int idx = nextVariant++; idx < numVariants; idx = nextVariant++)
+		{
+			try
+			{
+				drv.applyParameterVariant(sweepParams.data(), sweepValues.data() + idx * sweepParams.size(), sweepParams.size());
+				drv.run();
+			}
+			catch (const cadet::IntegrationException& e)
+			{
+				// A failed variant does not abort the sweep
+				std::lock_guard<std::mutex> lock(writerMutex);
+				std::cerr << "SOLVER ERROR in variant " << idx << ": " << e.what() << std::endl;
+				variantStatus[idx] = 1;
+				continue;
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(writerMutex);
+				if (!workerError)
+					workerError = std::current_exception();
+
+				// Stop all workers
+				nextVariant = numVariants;
+				return;
+			}
+
+			oss.str("");
+			oss << "variant_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << idx;
+
+			std::lock_guard<std::mutex> lock(writerMutex);
+			try
+			{
+				drv.writeVariant(writer, oss.str());
+			}
+			catch (...)
+			{
+				if (!workerError)
+					workerError = std::current_exception();
+
+				nextVariant = numVariants;
+				return;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(numWorkers - 1);
+	for (unsigned int i = 1; i < numWorkers; ++i)
+		threads.emplace_back(worker, std::ref(*drivers[i]));
+
+	// Main thread acts as first worker
+	worker(*drivers[0]);
+
+	for (std::thread& t : threads)
+		t.join();
+
+	if (workerError)
+		std::rethrow_exception(workerError);
+
+	const double sweepTime = sweepTimer.stop();
+
+	writer.pushGroup("output");
+	writer.pushGroup("sweep");
+	writer.vector("VARIANT_STATUS", variantStatus);
+	writer.popGroup();
+	writer.popGroup();
+
+	drivers[0]->writeMeta(writer, sweepTime);
+	writer.closeFile();
+
+	LOG(Debug) << "Ran " << numVariants << " variants on " << numWorkers << " workers in " << sweepTime << " sec";
+}
+
 template <class Reader_t, class Writer_t>
-void run(const std::string& inFileName, const std::string& outFileName)
+void run(const std::string& inFileName, const std::string& outFileName, unsigned int numSweepWorkers, bool resume)
 {
+	{
+		Reader_t rd;
+		rd.openFile(inFileName, "r");
+
+		cadet::ParameterProviderImpl<Reader_t> pp(rd);
+		const bool isSweep = pp.exists("sweep");
+
+		rd.closeFile();
+
+		if (isSweep)
+		{
+			if (resume)
+				LOG(Warning) << "Parameter sweeps cannot be resumed from a checkpoint, starting from scratch";
+
+			runSweep<Reader_t, Writer_t>(inFileName, outFileName, numSweepWorkers);
+			return;
+		}
+	}
+
 	cadet::Driver drv;
 	
 	{
@@ -124,17 +294,45 @@ void run(const std::string& inFileName, const std::string& outFileName)
 		rd.closeFile();
 	}
 
-	drv.run();
+	// Checkpoints are stored next to the output file by default
+	if (drv.checkpointFile().empty())
+		drv.setCheckpointFile(outFileName + ".ckpt");
+
+	if (resume)
+	{
+		const double t = drv.resumeFromCheckpoint();
+		LOG(Info) << "Resuming from checkpoint " << drv.checkpointFile() << " at t = " << t;
+
+		// Results recorded before the checkpoint are restored from the checkpoint, not from the output file
+		if (drv.streamSolution())
+		{
+			LOG(Warning) << "Solution cannot be streamed when resuming from a checkpoint, solution is written after time integration";
+			drv.setStreamSolution(false);
+		}
+	}
 
 	Writer_t writer;
-	if (inFileName == outFileName)
-		writer.openFile(outFileName, "rw");
-	else
-		writer.openFile(outFileName, "co");
+	openOutputFile(writer, inFileName, outFileName);
+
+	// Streaming writes the solution to the output file during time integration
+	const bool streaming = drv.streamSolution() && Writer_t::supportsAppend();
+	if (drv.streamSolution() && !streaming)
+		LOG(Warning) << "Output format does not support streaming, solution is written after time integration";
+
+	if (streaming)
+		drv.beginStreaming(writer);
+
+	drv.run();
+
+	if (streaming)
+		drv.endStreaming();
 
 	drv.write(writer);
 	writer.closeFile();
 
+	// The checkpoint is obsolete once the results have been written
+	drv.removeCheckpoint();
+
 #ifdef CADET_BENCHMARK_MODE
 	// Write timings in JSON format
 
@@ -181,6 +379,8 @@ int main(int argc, char** argv)
 	std::string inFileName = "";
 	std::string outFileName = "";
 	cadet::LogLevel logLevel = cadet::LogLevel::Trace;
+	unsigned int numSweepWorkers = 0;
+	bool resume = false;
 
 	try
 	{
@@ -189,6 +389,8 @@ int main(int argc, char** argv)
 		cmd.setOutput(&customOut);
 
 		cmd >> (new TCLAP::ValueArg<cadet::LogLevel>("L", "loglevel", "Set the log level", false, cadet::LogLevel::Trace, "LogLevel"))->storeIn(&logLevel);
+		cmd >> (new TCLAP::ValueArg<unsigned int>("j", "sweepThreads", "Number of worker threads for parameter sweeps (0 = all cores)", false, 0, "Number"))->storeIn(&numSweepWorkers);
+		cmd >> (new TCLAP::SwitchArg("r", "resume", "Resume from the latest checkpoint (see CHECKPOINT_FILE)"))->storeIn(&resume);
 		cmd >> (new TCLAP::UnlabeledValueArg<std::string>("input", "Input file", true, "", "File"))->storeIn(&inFileName);
 		cmd >> (new TCLAP::UnlabeledValueArg<std::string>("output", "Output file (defaults to input file)", false, "", "File"))->storeIn(&outFileName);
 
@@ -236,11 +438,11 @@ int main(int argc, char** argv)
 		{
 			if (cadet::util::caseInsensitiveEquals(fileExtOut, "h5"))
 			{
-				run<cadet::io::HDF5Reader, cadet::io::HDF5Writer>(inFileName, outFileName);
+				run<cadet::io::HDF5Reader, cadet::io::HDF5Writer>(inFileName, outFileName, numSweepWorkers, resume);
 			}
 			else if (cadet::util::caseInsensitiveEquals(fileExtOut, "xml"))
 			{
-				run<cadet::io::HDF5Reader, cadet::io::XMLWriter>(inFileName, outFileName);
+				run<cadet::io::HDF5Reader, cadet::io::XMLWriter>(inFileName, outFileName, numSweepWorkers, resume);
 			}
 			else
 			{
@@ -252,11 +454,11 @@ int main(int argc, char** argv)
 		{
 			if (cadet::util::caseInsensitiveEquals(fileExtOut, "xml"))
 			{
-				run<cadet::io::XMLReader, cadet::io::XMLWriter>(inFileName, outFileName);
+				run<cadet::io::XMLReader, cadet::io::XMLWriter>(inFileName, outFileName, numSweepWorkers, resume);
 			}
 			else if (cadet::util::caseInsensitiveEquals(fileExtOut, "h5"))
 			{
-				run<cadet::io::XMLReader, cadet::io::HDF5Writer>(inFileName, outFileName);
+				run<cadet::io::XMLReader, cadet::io::HDF5Writer>(inFileName, outFileName, numSweepWorkers, resume);
 			}
 			else
 			{
@@ -709,6 +709,34 @@ void reRun(cadet::Driver& drv, int nlhs, mxArray** plhs, int nrhs, const mxArray
 	drv.write(writer);
 }
 
+/**
+ * @brief Runs an already configured CADET simulation again from its last initial state
+ * @details Requires an already configured model and clears all existing results from memory.
+ *          The simulation starts from the initial state of the last call to @c run or @c rerun
+ *          and reuses all memory. This is faster than @c rerun with given initial conditions
+ *          if only parameter values have changed (e.g., in parameter estimation).
+ * @param [in] drv Driver
+ * @param [in] nlhs Number of left hand side (output) arguments
+ * @param [out] plhs List with output arguments
+ * @param [in] nrhs Number of right hand side (input) arguments
+ * @param [in] prhs List with input arguments
+ */
+void warmRerun(cadet::Driver& drv, int nlhs, mxArray** plhs, int nrhs, const mxArray** prhs)
+{
+	if (nrhs > 2)
+		mexWarnMsgIdAndTxt("CADET:mexWarn", "CadetMex: Command 'warmrerun' ignores all additional arguments (requires only 2).\n");
+	if (nlhs != 1)
+		mexErrMsgIdAndTxt("CADET:mexError", "CadetMex: Command 'warmrerun' requires exactly one output.\n");
+
+	requireConfiguredSimulatorAndModel(drv.simulator(), "warmrerun");
+
+	drv.clearResults();
+	drv.rerun();
+
+	cadet::mex::MatlabReaderWriter writer(&plhs[0]);	
+	drv.write(writer);
+}
+
 /**
  * @brief Reconfigures a given unit operation model, the model system itself, or the time integrator
  * @details Requires an already configured model. The entity that is configured depends on the 
@@ -1036,6 +1064,7 @@ CommandMap registeredCommands()
 	map["setsensparfactor"] = &command::setSensitiveParameterFactors;
 	map["setconsinitmode"] = &command::setConsistentInitializationMode;
 	map["rerun"] = &command::reRun;
+	map["warmrerun"] = &command::warmRerun;
 	map["reconf"] = &command::reconfigureModelOrSimulator;
 	map["setreturnconf"] = &command::setReturnConfiguration;
 	map["settimeintopts"] = &command::setTimeIntegratorOptions;
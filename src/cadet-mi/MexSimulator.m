@@ -494,6 +494,26 @@ classdef MexSimulator < handle
 			res = ResultsHelper.extract(res, obj.model.numUnitOperations);
 		end
 
+		function [res] = warmRunWithParameters(obj, paramVals)
+			%WARMRUNWITHPARAMETERS Runs a simulation with given parameters from the last initial state
+			%   RES = WARMRUNWITHPARAMETERS(PARAMVALS) sets the configured parameters to
+			%   PARAMVALS and runs the simulation from the initial state of the last run.
+			%   In contrast to RUNWITHPARAMETERS, neither the configuration is updated nor
+			%   are initial conditions transferred, and all memory of the simulator is
+			%   reused. This is meant for repeated simulations in parameter estimation.
+			%   The simulator has to be run at least once before. Returns the results in a
+			%   nested Matlab struct that contains cell arrays (one cell per unit operation)
+			%   as leaves.
+			%
+			% See also MEXSIMULATOR.RUNWITHPARAMETERS, MEXSIMULATOR.RUN
+
+			if ~isempty(paramVals)
+				obj.setVariableParameterValues(paramVals);
+			end
+			res = CadetMex('warmrerun', obj.mexHandle);
+			res = ResultsHelper.extract(res, obj.model.numUnitOperations);
+		end
+
 		function [res] = resume(obj, skipValidation)
 			%RESUME Resumes a simulation from the current state
 			%   RES = RESUME() does not reset solver state (e.g., state vectors) and continues
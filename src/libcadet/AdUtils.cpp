@@ -70,6 +70,30 @@ void extractBandedJacobianFromAd(active const* const adVec, unsigned int adDirOf
 	}
 }
 
+void extractBandedJacobianFromPlanes(double const* const planes, unsigned int planeStride, unsigned int diagDir, linalg::BandMatrix& mat)
+{
+	const unsigned int lowerBandwidth = mat.lowerBandwidth();
+	const unsigned int upperBandwidth = mat.upperBandwidth();
+	const unsigned int stride = lowerBandwidth + 1 + upperBandwidth;
+	for (unsigned int eq = 0; eq < mat.rows(); ++eq)
+	{
+		// Start with lowest subdiagonal, see extractBandedJacobianFromAd()
+		unsigned int dir = diagDir - lowerBandwidth + eq % stride;
+
+		// Loop over diagonals
+		for (unsigned int diag = 0; diag < stride; ++diag)
+		{
+			mat.native(eq, diag) = planes[dir * planeStride + eq];
+
+			// Wrap around at end of row and jump to lowest subdiagonal
+			if (dir == diagDir + upperBandwidth)
+				dir = diagDir - lowerBandwidth;
+			else
+				++dir;
+		}
+	}
+}
+
 void extractDenseJacobianFromBandedAd(active const* const adVec, unsigned int row, unsigned int adDirOffset, unsigned int diagDir, 
 	unsigned int lowerBandwidth, unsigned int upperBandwidth, linalg::detail::DenseMatrixBase& mat)
 {
@@ -177,6 +201,116 @@ double compareDenseJacobianWithBandedAd(active const* const adVec, unsigned int
 	return maxDiff;
 }
 
+unsigned int computeColumnColoring(const linalg::CompressedSparseMatrix& pattern, std::vector<unsigned int>& colors)
+{
+	const unsigned int n = pattern.rows();
+	const std::vector<unsigned int>& rowStart = pattern.rowStart();
+	const std::vector<unsigned int>& cols = pattern.columns();
+
+	// Transpose pattern to obtain the rows of each column
+	std::vector<unsigned int> colStart(n + 1, 0);
+	for (unsigned int idx = 0; idx < pattern.numNonZero(); ++idx)
+		++colStart[cols[idx] + 1];
+	for (unsigned int i = 0; i < n; ++i)
+		colStart[i + 1] += colStart[i];
+
+	std::vector<unsigned int> rowIdx(pattern.numNonZero());
+	std::vector<unsigned int> pos(colStart.begin(), colStart.end() - 1);
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		for (unsigned int idx = rowStart[i]; idx < rowStart[i + 1]; ++idx)
+			rowIdx[pos[cols[idx]]++] = i;
+	}
+
+	// Greedy coloring: Assign the smallest color that is not used by a column sharing a row
+	const unsigned int noColor = std::numeric_limits<unsigned int>::max();
+	colors.assign(n, noColor);
+
+	// Colors that are forbidden for column j are marked by j
+	std::vector<unsigned int> forbidden(n + 1, noColor);
+	unsigned int numColors = 0;
+	for (unsigned int j = 0; j < n; ++j)
+	{
+		for (unsigned int p = colStart[j]; p < colStart[j + 1]; ++p)
+		{
+			const unsigned int row = rowIdx[p];
+			for (unsigned int idx = rowStart[row]; idx < rowStart[row + 1]; ++idx)
+			{
+				const unsigned int c = colors[cols[idx]];
+				if (c != noColor)
+					forbidden[c] = j;
+			}
+		}
+
+		unsigned int c = 0;
+		while (forbidden[c] == j)
+			++c;
+
+		colors[j] = c;
+		numColors = std::max(numColors, c + 1);
+	}
+
+	return numColors;
+}
+
+void prepareAdVectorSeedsForColoring(active* const adVec, unsigned int adDirOffset, const std::vector<unsigned int>& colors)
+{
+	for (unsigned int eq = 0; eq < colors.size(); ++eq)
+	{
+		// Clear previously set directions
+		adVec[eq].fillADValue(adDirOffset, 0.0);
+		// Set direction
+		adVec[eq].setADValue(adDirOffset + colors[eq], 1.0);
+	}
+}
+
+void extractBandedJacobianFromColoredAd(active const* const adVec, unsigned int adDirOffset, const linalg::CompressedSparseMatrix& pattern,
+	const std::vector<unsigned int>& colors, linalg::BandMatrix& mat)
+{
+	const std::vector<unsigned int>& rowStart = pattern.rowStart();
+	const std::vector<unsigned int>& cols = pattern.columns();
+
+	mat.setAll(0.0);
+	for (unsigned int eq = 0; eq < pattern.rows(); ++eq)
+	{
+		for (unsigned int idx = rowStart[eq]; idx < rowStart[eq + 1]; ++idx)
+		{
+			const unsigned int col = cols[idx];
+			mat.centered(eq, static_cast<int>(col) - static_cast<int>(eq)) = adVec[eq].getADValue(adDirOffset + colors[col]);
+		}
+	}
+}
+
+double compareBandedJacobianWithColoredAd(active const* const adVec, unsigned int adDirOffset, const linalg::CompressedSparseMatrix& pattern,
+	const std::vector<unsigned int>& colors, const linalg::BandMatrix& mat)
+{
+	const int lowerBandwidth = static_cast<int>(mat.lowerBandwidth());
+	const int upperBandwidth = static_cast<int>(mat.upperBandwidth());
+
+	double maxDiff = 0.0;
+	for (unsigned int eq = 0; eq < mat.rows(); ++eq)
+	{
+		const int lower = std::max(-lowerBandwidth, -static_cast<int>(eq));
+		const int upper = std::min(upperBandwidth, static_cast<int>(mat.rows() - eq) - 1);
+		for (int diag = lower; diag <= upper; ++diag)
+		{
+			const unsigned int col = eq + diag;
+			const int idx = pattern.findElement(eq, col);
+			double baseVal = (idx >= 0) ? adVec[eq].getADValue(adDirOffset + colors[col]) : 0.0;
+			if (std::isnan(mat.centered(eq, diag)) || std::isnan(baseVal))
+				return std::numeric_limits<double>::quiet_NaN();
+			const double diff = std::abs(mat.centered(eq, diag) - baseVal);
+
+			baseVal = std::abs(baseVal);
+			if (baseVal > 0.0)
+				maxDiff = std::max(maxDiff, diff / baseVal);
+			else
+				maxDiff = std::max(maxDiff, diff);
+		}
+	}
+	return maxDiff;
+}
+
 void adMatrixVectorMultiply(const linalg::SparseMatrix<active>& mat, double const* x, double* y, double alpha, double beta, unsigned int adDir)
 {
 	const std::vector<unsigned int>& rows = mat.rows();
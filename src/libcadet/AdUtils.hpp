@@ -20,6 +20,8 @@
 
 #include "AutoDiff.hpp"
 
+#include <vector>
+
 namespace cadet
 {
 
@@ -33,6 +35,7 @@ namespace linalg
 	}
 
 	template <class real_t> class SparseMatrix;
+	class CompressedSparseMatrix;
 }
 
 namespace ad
@@ -64,6 +67,19 @@ void prepareAdVectorSeedsForBandMatrix(active* const adVec, unsigned int adDirOf
  */
 void extractBandedJacobianFromAd(active const* const adVec, unsigned int adDirOffset, unsigned int diagDir, linalg::BandMatrix& mat);
 
+/**
+ * @brief Extracts a band matrix from band compressed derivative planes
+ * @details Performs the same task as extractBandedJacobianFromAd() for derivatives stored as structure of
+			arrays: Plane @c k holds the derivatives of all rows in direction @c k, that is, the derivative of
+			row @c i in direction @c k is located at <tt>planes[k * planeStride + i]</tt>. The seed vectors are
+			given by prepareAdVectorSeedsForBandMatrix() with direction offset @c 0.
+ * @param [in] planes Derivative planes pointing to the first row of the band matrix in the first direction
+ * @param [in] planeStride Distance between two consecutive planes
+ * @param [in] diagDir Diagonal direction index
+ * @param [out] mat BandMatrix to be populated with the Jacobian
+ */
+void extractBandedJacobianFromPlanes(double const* const planes, unsigned int planeStride, unsigned int diagDir, linalg::BandMatrix& mat);
+
 /**
  * @brief Extracts a dense submatrix from band compressed AD seed vectors
  * @details Uses the results of an AD computation with seed vectors set by prepareAdVectorSeedsForBandMatrix() to
@@ -119,6 +135,59 @@ double compareBandedJacobianWithAd(active const* const adVec, unsigned int adDir
 double compareDenseJacobianWithBandedAd(active const* const adVec, unsigned int row, unsigned int adDirOffset, unsigned int diagDir, 
 	unsigned int lowerBandwidth, unsigned int upperBandwidth, const linalg::detail::DenseMatrixBase& mat);
 
+/**
+ * @brief Computes a column coloring of a sparse Jacobian for compressed AD seed vectors
+ * @details Two columns receive the same color only if they do not share a structurally non-zero
+ *          row (Curtis-Powell-Reid seeding). Columns of the same color are then seeded in the same AD
+ *          direction and the Jacobian is recovered from the compressed derivatives by
+ *          extractBandedJacobianFromColoredAd(). The coloring is computed by a greedy algorithm which
+ *          is optimal for dense band matrices and usually needs far fewer directions than band
+ *          compression for matrices with sparse bands.
+ * @param [in] pattern Sparsity pattern of the square Jacobian
+ * @param [out] colors Color (AD direction) of each column
+ * @return Number of colors (required AD directions)
+ */
+unsigned int computeColumnColoring(const linalg::CompressedSparseMatrix& pattern, std::vector<unsigned int>& colors);
+
+/**
+ * @brief Sets seed vectors on an AD vector for computing a sparse Jacobian with colored columns
+ * @details The direction of each column is given by a coloring computed by computeColumnColoring().
+ * @param [in,out] adVec Vector of AD datatypes whose seed vectors are to be set
+ * @param [in] adDirOffset Offset in the AD directions (can be used to move past parameter sensitivity directions)
+ * @param [in] colors Color of each column (length of the AD vector)
+ */
+void prepareAdVectorSeedsForColoring(active* const adVec, unsigned int adDirOffset, const std::vector<unsigned int>& colors);
+
+/**
+ * @brief Extracts a band matrix from AD vectors with colored seed vectors
+ * @details Uses the results of an AD computation with seed vectors set by prepareAdVectorSeedsForColoring() to
+			assemble the Jacobian. Only elements in the given pattern are extracted, all other elements of the
+			band matrix are set to @c 0. The pattern has to fit into the band of @p mat.
+ * @param [in] adVec Vector of AD datatypes with colored seed vectors
+ * @param [in] adDirOffset Offset in the AD directions (can be used to move past parameter sensitivity directions)
+ * @param [in] pattern Sparsity pattern of the Jacobian used for computing the coloring
+ * @param [in] colors Color of each column
+ * @param [out] mat BandMatrix to be populated with the Jacobian
+ */
+void extractBandedJacobianFromColoredAd(active const* const adVec, unsigned int adDirOffset, const linalg::CompressedSparseMatrix& pattern,
+	const std::vector<unsigned int>& colors, linalg::BandMatrix& mat);
+
+/**
+ * @brief Compares a banded Jacobian with an AD version derived by colored AD seed vectors
+ * @details Uses the results of an AD computation with seed vectors set by prepareAdVectorSeedsForColoring() to
+			compare the results with a given banded Jacobian. The relative difference is computed as in
+			compareBandedJacobianWithAd() for each element of the band. Elements outside the pattern are
+			treated as @c 0 in the AD Jacobian.
+ * @param [in] adVec Vector of AD datatypes with colored seed vectors
+ * @param [in] adDirOffset Offset in the AD directions (can be used to move past parameter sensitivity directions)
+ * @param [in] pattern Sparsity pattern of the Jacobian used for computing the coloring
+ * @param [in] colors Color of each column
+ * @param [in] mat BandMatrix populated with the analytic Jacobian
+ * @return The maximum absolute relative difference between the matrix elements
+ */
+double compareBandedJacobianWithColoredAd(active const* const adVec, unsigned int adDirOffset, const linalg::CompressedSparseMatrix& pattern,
+	const std::vector<unsigned int>& colors, const linalg::BandMatrix& mat);
+
 /**
  * @brief Performs the operation @f$ y = \alpha A x + \beta y @f$ using the derivative matrix
  * @details The provided sparse matrix @p mat actually consists of multiple matrices: A native one
@@ -172,6 +241,38 @@ inline void resetAd(active* const adVec, unsigned int size)
 		adVec[i] = 0.0;
 }
 
+/**
+ * @brief Returns the number of leading AD directions that contain all nonzero derivatives of an AD value
+ * @param [in] v AD value
+ * @param [in] nDirs Number of AD directions to check
+ * @return Index of the last nonzero derivative plus one, or @c 0 if all derivatives vanish
+ */
+inline unsigned int usedDirections(const active& v, unsigned int nDirs)
+{
+	for (unsigned int i = nDirs; i > 0; --i)
+	{
+		if (v.getADValue(i - 1) != 0.0)
+			return i;
+	}
+	return 0;
+}
+
+/**
+ * @brief Adds the scaled derivatives of an AD value to the derivatives of another AD value
+ * @details Performs @f$ \nabla y \leftarrow \nabla y + \alpha \nabla x @f$ on the first @p nDirs AD directions.
+ *          The value of @p y is not modified. This is used for applying the chain rule to analytically
+ *          computed derivatives with respect to AD seeded parameters.
+ * @param [in,out] y AD value whose derivatives are updated
+ * @param [in] alpha Factor @f$ \alpha @f$
+ * @param [in] x AD value whose derivatives are added
+ * @param [in] nDirs Number of AD directions
+ */
+inline void addScaledDerivatives(active& y, double alpha, const active& x, unsigned int nDirs)
+{
+	for (unsigned int i = 0; i < nDirs; ++i)
+		y.setADValue(i, y.getADValue(i) + alpha * x.getADValue(i));
+}
+
 } // namespace ad
 
 } // namespace cadet
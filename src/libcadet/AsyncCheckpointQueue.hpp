@@ -0,0 +1,219 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a single slot queue of checkpoints that are written by a background thread.
+ */
+
+#ifndef LIBCADET_ASYNCCHECKPOINTQUEUE_HPP_
+#define LIBCADET_ASYNCCHECKPOINTQUEUE_HPP_
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+namespace cadet
+{
+
+/**
+ * @brief Single slot queue of checkpoints that are written by a background thread
+ * @details The producer (time integrator) fills the checkpoint buffer obtained by buffer() and
+ *          hands it over by submit(). Buffers are swapped on submission such that the producer
+ *          never waits for the consumer. In contrast to AsyncSolutionQueue, checkpoints are not
+ *          queued: While a checkpoint is being written, idle() returns @c false and the producer
+ *          is expected to skip the checkpoint instead of waiting.
+ *
+ *          The producer buffer may be completed by another thread (e.g., the solution output
+ *          thread). In this case, the producer reserves the queue by reserve() before handing
+ *          the buffer over. The queue is not idle until the other thread calls submit() or cancel().
+ *
+ *          The consumer thread is started on first use and lives until the queue is destroyed.
+ */
+class AsyncCheckpointQueue
+{
+public:
+
+	/**
+	 * @brief Callback that writes a checkpoint
+	 * @details The arguments are the time of the checkpoint, the checkpoint data, and its length.
+	 */
+	typedef std::function<void(double, double const*, std::size_t)> Consumer_t;
+
+	AsyncCheckpointQueue() : _time(0.0), _pending(false), _reserved(false), _stop(false) { }
+
+	~AsyncCheckpointQueue() CADET_NOEXCEPT
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_cvWork.notify_all();
+
+		if (_thread.joinable())
+			_thread.join();
+	}
+
+	/**
+	 * @brief Prepares the queue for a new series of checkpoints
+	 * @details Waits for a pending checkpoint of a previous series.
+	 * @param [in] consumer Callback that is invoked on each checkpoint by the background thread
+	 */
+	void configure(const Consumer_t& consumer)
+	{
+		wait();
+
+		_consumer = consumer;
+		_error = nullptr;
+		_reserved = false;
+
+		if (!_thread.joinable())
+			_thread = std::thread(&AsyncCheckpointQueue::consumerLoop, this);
+	}
+
+	/**
+	 * @brief Determines whether a new checkpoint can be submitted without waiting
+	 * @return @c true if no checkpoint is being written, otherwise @c false
+	 */
+	bool idle() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return !_pending && !_reserved;
+	}
+
+	/**
+	 * @brief Reserves the producer buffer for a checkpoint that is submitted by another thread
+	 * @details The queue has to be idle. The reservation ends with submit() or cancel().
+	 */
+	void reserve()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_reserved = true;
+	}
+
+	/**
+	 * @brief Releases a reservation without submitting a checkpoint
+	 */
+	void cancel() CADET_NOEXCEPT
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_reserved = false;
+	}
+
+	/**
+	 * @brief Returns the buffer that is filled by the producer
+	 * @return Checkpoint buffer owned by the producer
+	 */
+	inline std::vector<double>& buffer() CADET_NOEXCEPT { return _producerBuffer; }
+
+	/**
+	 * @brief Hands the producer buffer over to the consumer
+	 * @details The queue has to be idle or reserved.
+	 * @param [in] t Time of the checkpoint
+	 */
+	void submit(double t)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_writerBuffer.swap(_producerBuffer);
+			_time = t;
+			_pending = true;
+			_reserved = false;
+		}
+		_cvWork.notify_one();
+	}
+
+	/**
+	 * @brief Waits for a pending checkpoint
+	 * @details Rethrows the first exception thrown by the consumer.
+	 */
+	void finish()
+	{
+		wait();
+
+		if (_error)
+		{
+			std::exception_ptr e = _error;
+			_error = nullptr;
+			std::rethrow_exception(e);
+		}
+	}
+
+	/**
+	 * @brief Waits for a pending checkpoint without reporting errors
+	 */
+	void wait() CADET_NOEXCEPT
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cvDone.wait(lock, [this]() { return !_pending; });
+	}
+
+protected:
+
+	void consumerLoop()
+	{
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cvWork.wait(lock, [this]() { return _stop || _pending; });
+
+				// A pending checkpoint is written before stopping
+				if (!_pending)
+					return;
+			}
+
+			// The producer does not touch the writer buffer until it is released below.
+			// Skip all further checkpoints after the first error.
+			if (!_error)
+			{
+				try
+				{
+					_consumer(_time, _writerBuffer.data(), _writerBuffer.size());
+				}
+				catch (...)
+				{
+					_error = std::current_exception();
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_pending = false;
+			}
+			_cvDone.notify_all();
+		}
+	}
+
+	std::vector<double> _producerBuffer; //!< Buffer filled by the producer
+	std::vector<double> _writerBuffer; //!< Buffer processed by the consumer
+	double _time; //!< Time of the pending checkpoint
+
+	Consumer_t _consumer; //!< Callback writing the checkpoints
+	std::thread _thread; //!< Consumer thread
+	mutable std::mutex _mutex; //!< Protects the buffers and state flags
+	std::condition_variable _cvWork; //!< Signals the consumer that a checkpoint is pending or it should stop
+	std::condition_variable _cvDone; //!< Signals the producer that a checkpoint has been written
+	bool _pending; //!< Determines whether a checkpoint is pending or being written
+	bool _reserved; //!< Determines whether the producer buffer is reserved for a checkpoint submitted by another thread
+	bool _stop; //!< Determines whether the consumer thread should stop
+	std::exception_ptr _error; //!< First exception thrown by the consumer
+};
+
+} // namespace cadet
+
+#endif  // LIBCADET_ASYNCCHECKPOINTQUEUE_HPP_
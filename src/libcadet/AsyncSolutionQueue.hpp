@@ -0,0 +1,271 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a bounded queue of solution snapshots that are processed by a background thread.
+ */
+
+#ifndef LIBCADET_ASYNCSOLUTIONQUEUE_HPP_
+#define LIBCADET_ASYNCSOLUTIONQUEUE_HPP_
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+namespace cadet
+{
+
+/**
+ * @brief Bounded FIFO queue of solution snapshots that are consumed by a background thread
+ * @details The producer (time integrator) copies its state into a free snapshot buffer obtained by
+ *          acquire() and hands it over by submit(). A single consumer thread processes the snapshots
+ *          strictly in the order of submission, which keeps the output deterministic. The snapshot
+ *          buffers form a ring whose length (depth) bounds the number of pending snapshots. The
+ *          producer only waits if all buffers are pending. Tasks submitted by submitTask() occupy a
+ *          slot of the ring and are executed by the consumer thread in the same order.
+ *
+ *          All memory is allocated in configure() and reused as long as the snapshot size and
+ *          depth do not change. The consumer thread is started on first use and lives until the
+ *          queue is destroyed.
+ */
+class AsyncSolutionQueue
+{
+public:
+
+	/**
+	 * @brief Callback that processes a snapshot
+	 * @details The first argument is the time of the snapshot, the second points to the snapshot data.
+	 */
+	typedef std::function<void(double, double const*)> Consumer_t;
+
+	/**
+	 * @brief Task that is executed by the background thread in order with the snapshots
+	 */
+	typedef std::function<void()> Task_t;
+
+	AsyncSolutionQueue() : _snapshotSize(0), _depth(0), _head(0), _tail(0), _count(0), _busy(false), _stop(false), _enabled(false) { }
+
+	~AsyncSolutionQueue() CADET_NOEXCEPT
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_cvWork.notify_all();
+
+		if (_thread.joinable())
+			_thread.join();
+	}
+
+	/**
+	 * @brief Prepares the queue for a new series of snapshots and enables it
+	 * @details Waits for all pending snapshots of a previous series.
+	 * @param [in] snapshotSize Number of elements of one snapshot
+	 * @param [in] depth Maximum number of pending snapshots (at least 1)
+	 * @param [in] consumer Callback that is invoked on each snapshot by the background thread
+	 */
+	void configure(std::size_t snapshotSize, unsigned int depth, const Consumer_t& consumer)
+	{
+		wait();
+
+		depth = std::max(depth, 1u);
+		if ((snapshotSize != _snapshotSize) || (depth != _depth))
+		{
+			_snapshotSize = snapshotSize;
+			_depth = depth;
+			_buffer.resize(snapshotSize * depth);
+			_time.resize(depth);
+			_task.resize(depth);
+		}
+
+		_consumer = consumer;
+		_head = 0;
+		_tail = 0;
+		_count = 0;
+		_error = nullptr;
+		_enabled = true;
+
+		if (!_thread.joinable())
+			_thread = std::thread(&AsyncSolutionQueue::consumerLoop, this);
+	}
+
+	/**
+	 * @brief Returns a free snapshot buffer
+	 * @details Blocks until a buffer becomes available. The buffer has to be handed
+	 *          over by submit() before the next call to acquire().
+	 * @return Snapshot buffer of configured size
+	 */
+	double* acquire()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cvDone.wait(lock, [this]() { return _count < _depth; });
+		return _buffer.data() + _head * _snapshotSize;
+	}
+
+	/**
+	 * @brief Hands the last acquired snapshot buffer over to the consumer
+	 * @param [in] t Time of the snapshot
+	 */
+	void submit(double t)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_time[_head] = t;
+			_head = (_head + 1) % _depth;
+			++_count;
+		}
+		_cvWork.notify_one();
+	}
+
+	/**
+	 * @brief Hands a task over to the consumer
+	 * @details The task is executed after all previously submitted snapshots have been processed
+	 *          and before the snapshots submitted afterwards. Blocks until a slot becomes available.
+	 * @param [in] task Task to be executed by the background thread
+	 */
+	void submitTask(const Task_t& task)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cvDone.wait(lock, [this]() { return _count < _depth; });
+			_task[_head] = task;
+			_head = (_head + 1) % _depth;
+			++_count;
+		}
+		_cvWork.notify_one();
+	}
+
+	/**
+	 * @brief Waits for all pending snapshots and disables the queue
+	 * @details Rethrows the first exception thrown by the consumer.
+	 */
+	void finish()
+	{
+		wait();
+
+		if (_error)
+		{
+			std::exception_ptr e = _error;
+			_error = nullptr;
+			std::rethrow_exception(e);
+		}
+	}
+
+	/**
+	 * @brief Waits for all pending snapshots and disables the queue without reporting errors
+	 */
+	void wait() CADET_NOEXCEPT
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cvDone.wait(lock, [this]() { return (_count == 0) && !_busy; });
+		_enabled = false;
+	}
+
+	/**
+	 * @brief Waits for all pending snapshots while keeping the queue enabled
+	 * @details Errors of the consumer are reported by the next call to finish().
+	 */
+	void flush() CADET_NOEXCEPT
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cvDone.wait(lock, [this]() { return (_count == 0) && !_busy; });
+	}
+
+	/**
+	 * @brief Determines whether snapshots are accepted
+	 * @return @c true if the queue has been configured and not finished yet, otherwise @c false
+	 */
+	inline bool enabled() const CADET_NOEXCEPT { return _enabled; }
+
+	inline unsigned int depth() const CADET_NOEXCEPT { return _depth; }
+
+protected:
+
+	void consumerLoop()
+	{
+		while (true)
+		{
+			double const* data = nullptr;
+			double t = 0.0;
+			Task_t task;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cvWork.wait(lock, [this]() { return _stop || (_count > 0); });
+
+				// Pending snapshots are processed before stopping
+				if (_count == 0)
+					return;
+
+				data = _buffer.data() + _tail * _snapshotSize;
+				t = _time[_tail];
+				task.swap(_task[_tail]);
+				_busy = true;
+			}
+
+			// The producer does not touch the buffer until it is released below.
+			// Skip all further snapshots after the first error.
+			if (!_error)
+			{
+				try
+				{
+					if (task)
+						task();
+					else
+						_consumer(t, data);
+				}
+				catch (...)
+				{
+					_error = std::current_exception();
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_tail = (_tail + 1) % _depth;
+				--_count;
+				_busy = false;
+			}
+			_cvDone.notify_all();
+		}
+	}
+
+	std::vector<double> _buffer; //!< Ring of snapshot buffers
+	std::vector<double> _time; //!< Time of each snapshot in the ring
+	std::vector<Task_t> _task; //!< Task of each slot in the ring (empty for snapshots)
+	std::size_t _snapshotSize; //!< Number of elements of one snapshot
+	unsigned int _depth; //!< Number of snapshot buffers in the ring
+
+	unsigned int _head; //!< Index of the next buffer filled by the producer
+	unsigned int _tail; //!< Index of the next buffer processed by the consumer
+	unsigned int _count; //!< Number of pending snapshots
+
+	Consumer_t _consumer; //!< Callback processing the snapshots
+	std::thread _thread; //!< Consumer thread
+	std::mutex _mutex; //!< Protects ring indices and state flags
+	std::condition_variable _cvWork; //!< Signals the consumer that a snapshot is pending or it should stop
+	std::condition_variable _cvDone; //!< Signals the producer that a snapshot has been processed
+	bool _busy; //!< Determines whether the consumer is currently processing a snapshot
+	bool _stop; //!< Determines whether the consumer thread should stop
+	bool _enabled; //!< Determines whether the queue accepts snapshots
+	std::exception_ptr _error; //!< First exception thrown by the consumer
+};
+
+} // namespace cadet
+
+#endif  // LIBCADET_ASYNCSOLUTIONQUEUE_HPP_
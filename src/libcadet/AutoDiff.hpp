@@ -125,7 +125,11 @@
 
 #elif defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
 
-	#define SFAD_DEFAULT_DIR 80
+	// Maximum number of AD directions (size of the gradient stored in each active)
+	// Can be set at build time by the AD_MAX_DIRECTIONS CMake option
+	#ifndef SFAD_DEFAULT_DIR
+		#define SFAD_DEFAULT_DIR 80
+	#endif
 
 	#if defined(ACTIVE_SFAD)
 		#include "sfad.hpp"
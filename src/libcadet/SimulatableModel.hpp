@@ -56,6 +56,14 @@ public:
 	 */
 	virtual unsigned int numPureDofs() const CADET_NOEXCEPT = 0;
 
+	/**
+	 * @brief Returns the offset of the given unit operation's DOFs in the global state vector
+	 * @param [in] unitOpIdx Index of the unit operation
+	 * @return Index of the first DOF of the unit operation in the global state vector, or
+	 *         numDofs() if the unit operation does not exist
+	 */
+	virtual unsigned int unitOperationDofOffset(UnitOpIdx unitOpIdx) const CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Returns whether AD is used for computing the system Jacobian
 	 * @details This is independent of any parameter sensitivity.
@@ -157,6 +165,21 @@ public:
 	 */
 	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset) = 0;
 
+	/**
+	 * @brief Returns the index of the current valve configuration
+	 * @details The index is updated by notifyDiscontinuousSectionTransition().
+	 * @return Index of the current valve configuration
+	 */
+	virtual unsigned int currentSwitchIndex() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Restores the valve configuration, for example, when resuming from a checkpoint
+	 * @details The restored configuration takes effect in the next call to notifyDiscontinuousSectionTransition(),
+	 *          which has to be issued for the section the checkpoint was taken in.
+	 * @param [in] idx Index of the valve configuration as returned by currentSwitchIndex()
+	 */
+	virtual void restoreSwitchIndex(unsigned int idx) = 0;
+
 	/**
 	 * @brief Applies initial conditions to the state vector and its time derivative
 	 * @details The initial conditions do not need to be consistent at this point. On a (discontinuous)
@@ -411,6 +434,71 @@ public:
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res) = 0;
 
+	/**
+	 * @brief Computes the solution of the linear system involving the transposed system Jacobian
+	 * @details The system \f[ \left( \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} \right)^T x = b \f]
+	 *          has to be solved, which arises in the backward integration of the adjoint system. The right hand side
+	 *          \f$ b \f$ is given by @p rhs and the solution is returned in @p rhs.
+	 *
+	 *          Prior to calling linearSolveTransposed() the time integrator calls dResDpFwdWithJacobian() with the
+	 *          point in time and state \f$(t, y, \dot{y})\f$ at which the Jacobian is evaluated.
+	 *
+	 *          The factorization of the transposed Jacobian is reused until @p alpha changes or
+	 *          invalidateTransposedFactorization() is called. Evaluating the Jacobian does not invalidate it.
+	 *
+	 * @param [in] t Current time point
+	 * @param [in] timeFactor Used for time transformation (pre factor of time derivatives) and to compute parameter derivatives with respect to section length
+	 * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+	 * @param [in] tol Error tolerance for the solution of the linear system from outer Newton iteration
+	 * @param [in,out] rhs On entry the right hand side of the linear equation system, on exit the solution
+	 * @param [in] weight Vector with error weights
+	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+	 */
+	virtual int linearSolveTransposed(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight) = 0;
+
+	/**
+	 * @brief Marks the factorization of the transposed Jacobian as outdated
+	 * @details The next call to linearSolveTransposed() factorizes the current Jacobian again.
+	 */
+	virtual void invalidateTransposedFactorization() = 0;
+
+	/**
+	 * @brief Multiplies the given vector with the transposed Jacobian @f$ \left(\frac{\partial F}{\partial y}\right)^T @f$ of the whole system
+	 * @details Actually, the operation @f$ z = \alpha \left(\frac{\partial F}{\partial y}\right)^T x + \beta z @f$ is performed.
+	 *          The Jacobian has to be up to date (see dResDpFwdWithJacobian()).
+	 * @param [in] yS Vector @f$ x @f$ that is transformed by the transposed Jacobian
+	 * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ \left(\frac{\partial F}{\partial y}\right)^T @f$
+	 * @param [in] beta Factor @f$ \beta @f$ in front of @f$ z @f$
+	 * @param [in,out] ret Vector @f$ z @f$ which stores the result of the operation
+	 */
+	virtual void multiplyWithJacobianTransposed(double const* yS, double alpha, double beta, double* ret) = 0;
+
+	/**
+	 * @brief Multiplies the given vector with the transposed time derivative Jacobian @f$ \left(\frac{\partial F}{\partial \dot{y}}\right)^T @f$ of the whole system
+	 * @details The operation @f$ z = \left(\frac{\partial F}{\partial \dot{y}}\right)^T x @f$ is performed.
+	 * @param [in] sDot Vector @f$ x @f$ that is transformed by the transposed Jacobian
+	 * @param [out] ret Vector @f$ z @f$ which stores the result of the operation
+	 * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+	 */
+	virtual void multiplyWithDerivativeJacobianTransposed(double const* sDot, double* ret, double timeFactor) = 0;
+
+	/**
+	 * @brief Evaluates the residual with AD to compute the parameter derivatives and at the same time updates the Jacobian
+	 * @details Evaluates @f$ \frac{\partial F}{\partial p} @f$, where @f$ p @f$ are the sensitive parameters, which are
+	 *          stored in the AD directions of @p adRes that belong to the parameters. The values of @p adRes hold the residual.
+	 * @param [in] t Current time point
+	 * @param [in] secIdx Index of the current section
+	 * @param [in] timeFactor Used for time transformation (pre factor of time derivatives) and to compute parameter derivatives with respect to section length
+	 * @param [in] y Pointer to global state vector
+	 * @param [in] yDot Pointer to global time derivative state vector
+	 * @param [in,out] adRes Pointer to global residual vector of AD datatypes for computing the parameter derivatives
+	 * @param [in,out] adY Pointer to global state vector of AD datatypes that can be used for computing the Jacobian (or @c nullptr if AD is disabled)
+	 * @param [in] adDirOffset Number of AD directions used for non-Jacobian purposes (e.g., parameter sensitivities)
+	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+	 */
+	virtual int dResDpFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot,
+		active* const adRes, active* const adY, unsigned int adDirOffset) = 0;
+
 	/**
 	 * @brief Prepares the AD system vectors by constructing seed vectors
 	 * @details Sets the seed vectors used in AD. Since the AD vector is fully managed by the model,
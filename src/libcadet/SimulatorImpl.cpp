@@ -12,6 +12,7 @@
 
 #include "cadet/Exceptions.hpp"
 #include "cadet/SolutionRecorder.hpp"
+#include "cadet/CheckpointWriter.hpp"
 #include "cadet/ParameterProvider.hpp"
 #include "SimulatorImpl.hpp"
 #include "SimulatableModel.hpp"
@@ -20,10 +21,16 @@
 
 #include <idas/idas.h>
 #include <idas/idas_impl.h>
+#include <idas/idas_spgmr.h>
 #include "SundialsVector.hpp"
 
 #include <vector>
 #include <sstream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <mutex>
+#include <condition_variable>
 
 #include "AutoDiff.hpp"
 #include "LoggingUtils.hpp"
@@ -48,6 +55,70 @@ namespace
 		return sensState;
 	}
 
+	/**
+	 * @brief Copies the data of N_Vector @p src to @p dest
+	 * @param [in] src Source vector
+	 * @param [out] dest Destination vector of the same length
+	 */
+	inline void copyNVector(N_Vector src, N_Vector dest)
+	{
+		double const* const data = NVEC_DATA(src);
+		std::copy(data, data + NVEC_LENGTH(src), NVEC_DATA(dest));
+	}
+
+	/**
+	 * @brief Extracts the data pointers of the given N_Vectors into an existing array
+	 * @details The array @p ptrs is only reallocated if its capacity is insufficient.
+	 * @param [out] ptrs Array of data pointers
+	 * @param [in] vec Array of N_Vectors
+	 * @param [in] numVec Number of elements in @p vec
+	 */
+	template <class T>
+	inline void fillNVectorPtrs(std::vector<T>& ptrs, N_Vector* vec, unsigned int numVec)
+	{
+		ptrs.resize(numVec);
+		for (unsigned int i = 0; i < numVec; ++i)
+			ptrs[i] = NVEC_DATA(vec[i]);
+	}
+
+	/**
+	 * @brief Drains an AsyncSolutionQueue or AsyncCheckpointQueue on scope exit
+	 * @details Ensures that the consumer thread has stopped accessing the solution recorder
+	 *          or the checkpoint writer when the time integration is left by an exception.
+	 */
+	template <class Queue_t>
+	class AsyncOutputGuard
+	{
+	public:
+		AsyncOutputGuard(Queue_t& queue) : _queue(queue) { }
+		~AsyncOutputGuard() CADET_NOEXCEPT { _queue.wait(); }
+	private:
+		Queue_t& _queue;
+	};
+
+	namespace checkpoint
+	{
+		/**
+		 * @brief Fields of the checkpoint header
+		 * @details The header is followed by the state vector, its time derivative, the forward
+		 *          sensitivities and their time derivatives (interleaved), the times and indices
+		 *          of the stop conditions hit so far, and the results of the solution recorder.
+		 */
+		enum HeaderField : unsigned int
+		{
+			Version = 0, //!< Version of the checkpoint format
+			NumDofs, //!< Number of DOFs of the model
+			NumSens, //!< Number of forward sensitivities
+			Time, //!< Time point in transformed time
+			Section, //!< Index of the first section of the current time slice
+			SwitchIndex, //!< Index of the current valve configuration
+			NumStopHits, //!< Number of stop conditions hit so far
+			HeaderSize //!< Number of elements in the header
+		};
+
+		const double FormatVersion = 2.0;
+	}
+
 	const std::vector<double*> convertNVectorToStdVectorPtrs(unsigned int& len, N_Vector* vec, unsigned int numVec)
 	{
 		if (!vec || (numVec == 0))
@@ -148,6 +219,53 @@ namespace
 	{
 		return hasNaN(NVEC_DATA(p), NVEC_LENGTH(p));
 	}
+
+#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
+	std::mutex adDirMutex; //!< Protects the process-wide number of AD directions
+	std::condition_variable adDirReleased; //!< Signals that a time integration has released the AD directions
+	unsigned int numAdDirUsers = 0; //!< Number of time integrations currently using the AD directions
+
+	/**
+	 * @brief Holds the process-wide number of AD directions during a time integration
+	 * @details The number of AD directions is a global setting shared by all Simulators.
+	 *          Simulators that integrate concurrently (e.g., in a parallel parameter sweep)
+	 *          run in parallel as long as they require the same number of directions.
+	 *          Otherwise, the time integration waits until all running ones have finished
+	 *          before the number is changed.
+	 */
+	class ScopedAdDirections
+	{
+	public:
+		ScopedAdDirections(std::size_t numDir)
+		{
+			std::unique_lock<std::mutex> lock(adDirMutex);
+			adDirReleased.wait(lock, [=]() { return (numAdDirUsers == 0) || (cadet::ad::getDirections() == numDir); });
+
+			if (cadet::ad::getDirections() != numDir)
+				cadet::ad::setDirections(numDir);
+
+			++numAdDirUsers;
+		}
+
+		~ScopedAdDirections()
+		{
+			std::lock_guard<std::mutex> lock(adDirMutex);
+			--numAdDirUsers;
+			if (numAdDirUsers == 0)
+				adDirReleased.notify_all();
+		}
+	};
+
+	/**
+	 * @brief Resets the number of AD directions to its maximum unless a time integration is running
+	 */
+	void resetAdDirections()
+	{
+		std::lock_guard<std::mutex> lock(adDirMutex);
+		if (numAdDirUsers == 0)
+			cadet::ad::setDirections(cadet::ad::getMaxDirections());
+	}
+#endif
 }
 
 namespace cadet
@@ -283,6 +401,8 @@ namespace cadet
 
 	/**
 	* @brief IDAS wrapper function to call the model's linearSolve() method
+	* @details IDAS calls this function once per right hand side, that is, separately for
+	*          the state and each forward sensitivity system.
 	*/
 	int linearSolveWrapper(IDAMem IDA_mem, N_Vector rhs, N_Vector weight, N_Vector y, N_Vector yDot, N_Vector res)
 	{
@@ -303,9 +423,9 @@ namespace cadet
 			void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
 	{
 		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(userData);
-		const std::vector<const double*> sensY = convertNVectorToStdVectorPtrs<const double*>(yS, ns);
-		const std::vector<const double*> sensYdot = convertNVectorToStdVectorPtrs<const double*>(ySDot, ns);
-		std::vector<double*> sensRes = convertNVectorToStdVectorPtrs<double*>(resS, ns);
+		fillNVectorPtrs(sim->_sensYconst, yS, ns);
+		fillNVectorPtrs(sim->_sensYdotConst, ySDot, ns);
+		fillNVectorPtrs(sim->_sensResPtr, resS, ns);
 		const unsigned int secIdx = sim->getCurrentSection(t);
 		const active timeFactor = sim->timeFactor();
 		
@@ -313,18 +433,146 @@ namespace cadet
 		//	sensY, sensYdot, sensRes, sim->_vecADres, NVEC_DATA(tmp1), NVEC_DATA(tmp2), NVEC_DATA(tmp3));
 
 		return sim->_model->residualSensFwd(ns, sim->toRealTime(t), secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(res), 
-			sensY, sensYdot, sensRes, sim->_vecADres, NVEC_DATA(tmp1), NVEC_DATA(tmp2), NVEC_DATA(tmp3));
+			sim->_sensYconst, sim->_sensYdotConst, sim->_sensResPtr, sim->_vecADres, NVEC_DATA(tmp1), NVEC_DATA(tmp2), NVEC_DATA(tmp3));
+	}
+
+	/**
+	* @brief IDAS wrapper function to evaluate the residual of the adjoint system
+	* @details The adjoint system reads \f[ \left(\frac{\partial F}{\partial \dot{y}}\right)^T \dot{\lambda} - \left(\frac{\partial F}{\partial y}\right)^T \lambda + \frac{\partial g}{\partial y} = 0, \f]
+	*          where \f$ g \f$ is the integrand of the output functional in transformed time.
+	*/
+	int adjointResidualWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, void* userData)
+	{
+		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(userData);
+		const unsigned int secIdx = sim->getCurrentSection(t);
+		const active timeFactor = sim->timeFactor(secIdx);
+		const active realT = sim->toRealTime(t);
+
+		// Update the Jacobian at the forward solution
+		const int flag = sim->_model->residualWithJacobian(realT, secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot), sim->_adjTemp.data(),
+			sim->_vecADres, sim->_vecADy, sim->numSensitivityAdDirections());
+		if (flag != 0)
+			return flag;
+
+		const double tf = static_cast<double>(timeFactor);
+		sim->_model->multiplyWithDerivativeJacobianTransposed(NVEC_DATA(yBdot), NVEC_DATA(resB), tf);
+		sim->_model->multiplyWithJacobianTransposed(NVEC_DATA(yB), -1.0, 1.0, NVEC_DATA(resB));
+		sim->adjointObjective(static_cast<double>(realT), NVEC_DATA(y), 1.0 / tf, NVEC_DATA(resB));
+		return 0;
+	}
+
+	/**
+	* @brief IDAS wrapper function to evaluate the right hand side of the backward quadratures
+	* @details The first quadratures \f$ \lambda^T \frac{\partial F}{\partial p_i} \f$ yield the gradient of the
+	*          output functional, the last one its value.
+	*/
+	int adjointQuadratureWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector rhsQB, void* userData)
+	{
+		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(userData);
+		const unsigned int secIdx = sim->getCurrentSection(t);
+		const active timeFactor = sim->timeFactor(secIdx);
+		const active realT = sim->toRealTime(t);
+		const unsigned int nSens = sim->_sensitiveParams.slices();
+		const unsigned int nDof = NVEC_LENGTH(yB);
+		double* const q = NVEC_DATA(rhsQB);
+
+		if (nSens > 0)
+		{
+			// Parameter derivatives of the residual are stored in the AD directions of the sensitive parameters
+			const int flag = sim->_model->dResDpFwdWithJacobian(realT, secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot),
+				sim->_vecADres, sim->_vecADy, sim->numSensitivityAdDirections());
+			if (flag != 0)
+				return flag;
+
+			double const* const lambda = NVEC_DATA(yB);
+			for (unsigned int param = 0; param < nSens; ++param)
+			{
+				double val = 0.0;
+				for (unsigned int i = 0; i < nDof; ++i)
+					val += lambda[i] * sim->_vecADres[i].getADValue(param);
+				q[param] = val;
+			}
+		}
+
+		// Integration runs backwards, hence the sign
+		q[nSens] = -sim->adjointObjective(static_cast<double>(realT), NVEC_DATA(y), 0.0, nullptr) / static_cast<double>(timeFactor);
+		return 0;
+	}
+
+	/**
+	* @brief IDAS wrapper function to set up the preconditioner of the adjoint system
+	* @details The Newton matrix of the adjoint system is \f$ -\left( \frac{\partial F}{\partial y} - c_j \frac{\partial F}{\partial \dot{y}} \right)^T. \f$
+	*          It is factorized by the model at the next call of adjointPrecSolveWrapper() and reused as exact
+	*          preconditioner of the GMRES method of IDAS until IDAS requests a new setup. Evaluations of the
+	*          adjoint residual do not trigger a factorization.
+	*/
+	int adjointPrecSetupWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, double cjB,
+		void* userData, N_Vector tmp1B, N_Vector tmp2B, N_Vector tmp3B)
+	{
+		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(userData);
+		const unsigned int secIdx = sim->getCurrentSection(t);
+		const active timeFactor = sim->timeFactor(secIdx);
+
+		// Update the Jacobian at the forward solution
+		const int flag = sim->_model->residualWithJacobian(sim->toRealTime(t), secIdx, timeFactor, NVEC_DATA(y), NVEC_DATA(yDot), NVEC_DATA(tmp1B),
+			sim->_vecADres, sim->_vecADy, sim->numSensitivityAdDirections());
+		if (flag != 0)
+			return flag;
+
+		sim->_model->invalidateTransposedFactorization();
+		sim->_adjPrecAlpha = -cjB;
+		return 0;
+	}
+
+	/**
+	* @brief IDAS wrapper function to apply the preconditioner of the adjoint system
+	* @details Calls the model's linearSolveTransposed() method with the factorization prepared by adjointPrecSetupWrapper().
+	*/
+	int adjointPrecSolveWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, N_Vector rhs, N_Vector z,
+		double cjB, double delta, void* userData, N_Vector tmpB)
+	{
+		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(userData);
+		const unsigned int secIdx = sim->getCurrentSection(t);
+		const double timeFactor = static_cast<double>(sim->timeFactor(secIdx));
+
+		// IDAS does not pass error weights to the preconditioner
+		NVec_Const(1.0, tmpB);
+		copyNVector(rhs, z);
+
+		const int flag = sim->_model->linearSolveTransposed(static_cast<double>(sim->toRealTime(t)), timeFactor, sim->_adjPrecAlpha, delta, NVEC_DATA(z), NVEC_DATA(tmpB));
+
+		double* const x = NVEC_DATA(z);
+		for (unsigned int i = 0; i < NVEC_LENGTH(z); ++i)
+			x[i] = -x[i];
+
+		return flag;
+	}
+
+	/**
+	* @brief IDAS wrapper function to evaluate the root functions of the stop conditions
+	*/
+	int stopConditionWrapper(double t, N_Vector y, N_Vector yDot, double* g, void* userData)
+	{
+		cadet::Simulator const* const sim = static_cast<cadet::Simulator const*>(userData);
+		sim->evaluateStopConditions(t, NVEC_DATA(y), g);
+		return 0;
 	}
 
 	Simulator::Simulator() : _model(nullptr), _solRecorder(nullptr), _idaMemBlock(nullptr), _vecStateY(nullptr), 
-		_vecStateYdot(nullptr), _vecFwdYs(nullptr), _vecFwdYsDot(nullptr),
-		_relTolS(1.0e-9), _absTol(1, 1.0e-12), _relTol(1.0e-9), _initStepSize(1, 1.0e-6), _maxSteps(10000), _curSec(0),
+		_vecStateYdot(nullptr), _vecFwdYs(nullptr), _vecFwdYsDot(nullptr), _vecInitY(nullptr), _vecInitYdot(nullptr),
+		_vecInitYs(nullptr), _vecInitYsDot(nullptr), _numInitSens(0), _initStateValid(false), _initSkipConsistencyStateY(false),
+		_initSkipConsistencySensitivity(false), _vecDenseY(nullptr), _vecDenseYdot(nullptr), _vecDenseYs(nullptr),
+		_vecDenseYsDot(nullptr), _numDenseSens(0),
+		_relTolS(1.0e-9), _absTol(1, 1.0e-12), _relTol(1.0e-9), _initStepSize(1, 1.0e-6), _maxSteps(10000), _denseOutput(false), _asyncOutputDepth(0), _recordedFields(RecordedField::All), _curSec(0),
 		_skipConsistencyStateY(false), _skipConsistencySensitivity(false), _consistentInitMode(ConsistentInitialization::Full), 
-		_consistentInitModeSens(ConsistentInitialization::Full), _vecADres(nullptr), _vecADy(nullptr), _lastIntTime(0.0)
+		_consistentInitModeSens(ConsistentInitialization::Full), _vecADres(nullptr), _vecADy(nullptr), _lastIntTime(0.0), _lastNumSteps(0),
+		_cssMaxCycles(0), _cssTol(1.0), _cssAndersonDepth(5), _lastNumCycles(0), _lastCssError(0.0), _adjUnitOp(UnitOpIndep),
+		_adjOutletOffset(0), _adjOutletStride(0), _adjMemInitialized(false), _adjCheckpointSteps(100), _adjPrecAlpha(0.0), _adjWhich(-1), _vecAdjY(nullptr), _vecAdjYdot(nullptr),
+		_vecAdjQuad(nullptr), _adjObjective(0.0), _checkpointWriter(nullptr), _checkpointInterval(0.0), _nextCheckpoint(0.0)
 	{
 #if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
-		LOG(Debug) << "Resetting AD directions from " << ad::getDirections() << " to default " << ad::getMaxDirections();
-		ad::setDirections(ad::getMaxDirections());
+		LOG(Debug) << "Resetting AD directions to default " << ad::getMaxDirections();
+		resetAdDirections();
 #endif
 	}
 
@@ -337,6 +585,12 @@ namespace cadet
 	{
 		delete[] _vecADy;
 		delete[] _vecADres;
+		_vecADy = nullptr;
+		_vecADres = nullptr;
+
+		clearInitialState();
+		clearDenseOutput();
+		clearAdjointState();
 
 		if ((_sensitiveParams.slices() > 0) && _vecFwdYs)
 		{
@@ -350,8 +604,158 @@ namespace cadet
 		if (_vecStateY)
 			NVec_Destroy(_vecStateY);
 
+		// Also frees the adjoint module and the backward problem
 		if (_idaMemBlock)
 			IDAFree(&_idaMemBlock);		
+
+		_adjMemInitialized = false;
+		_adjWhich = -1;
+
+		// Stop conditions refer to unit operations of the model
+		_stopConditions.clear();
+		_stopDirection.clear();
+	}
+
+	void Simulator::clearAdjointState() CADET_NOEXCEPT
+	{
+		if (_vecAdjQuad)
+			NVec_Destroy(_vecAdjQuad);
+		if (_vecAdjYdot)
+			NVec_Destroy(_vecAdjYdot);
+		if (_vecAdjY)
+			NVec_Destroy(_vecAdjY);
+
+		_vecAdjY = nullptr;
+		_vecAdjYdot = nullptr;
+		_vecAdjQuad = nullptr;
+	}
+
+	void Simulator::clearInitialState() CADET_NOEXCEPT
+	{
+		_initStateValid = false;
+
+		if (_vecInitYs)
+		{
+			NVec_DestroyArray(_vecInitYs, _numInitSens);
+			NVec_DestroyArray(_vecInitYsDot, _numInitSens);
+			_vecInitYs = nullptr;
+			_vecInitYsDot = nullptr;
+		}
+		_numInitSens = 0;
+
+		if (_vecInitYdot)
+			NVec_Destroy(_vecInitYdot);
+		if (_vecInitY)
+			NVec_Destroy(_vecInitY);
+
+		_vecInitY = nullptr;
+		_vecInitYdot = nullptr;
+	}
+
+	void Simulator::clearDenseOutput() CADET_NOEXCEPT
+	{
+		if (_vecDenseYs)
+		{
+			NVec_DestroyArray(_vecDenseYs, _numDenseSens);
+			NVec_DestroyArray(_vecDenseYsDot, _numDenseSens);
+			_vecDenseYs = nullptr;
+			_vecDenseYsDot = nullptr;
+		}
+		_numDenseSens = 0;
+
+		if (_vecDenseYdot)
+			NVec_Destroy(_vecDenseYdot);
+		if (_vecDenseY)
+			NVec_Destroy(_vecDenseY);
+
+		_vecDenseY = nullptr;
+		_vecDenseYdot = nullptr;
+	}
+
+	void Simulator::prepareDenseOutput()
+	{
+		const unsigned int nSens = numFwdSensitivities();
+
+		// Allocate memory on first use
+		if (!_vecDenseY)
+		{
+			_vecDenseY = NVec_New(NVEC_LENGTH(_vecStateY));
+			_vecDenseYdot = NVec_New(NVEC_LENGTH(_vecStateYdot));
+		}
+
+		if (_numDenseSens != nSens)
+		{
+			if (_vecDenseYs)
+			{
+				NVec_DestroyArray(_vecDenseYs, _numDenseSens);
+				NVec_DestroyArray(_vecDenseYsDot, _numDenseSens);
+				_vecDenseYs = nullptr;
+				_vecDenseYsDot = nullptr;
+			}
+
+			if (nSens > 0)
+			{
+				_vecDenseYs = NVec_CloneArray(nSens, _vecStateY);
+				_vecDenseYsDot = NVec_CloneArray(nSens, _vecStateYdot);
+			}
+			_numDenseSens = nSens;
+		}
+	}
+
+	void Simulator::saveInitialState()
+	{
+		const unsigned int nSens = _sensitiveParams.slices();
+
+		// Allocate memory on first use
+		if (!_vecInitY)
+		{
+			_vecInitY = NVec_New(NVEC_LENGTH(_vecStateY));
+			_vecInitYdot = NVec_New(NVEC_LENGTH(_vecStateYdot));
+		}
+
+		if (_numInitSens != nSens)
+		{
+			if (_vecInitYs)
+			{
+				NVec_DestroyArray(_vecInitYs, _numInitSens);
+				NVec_DestroyArray(_vecInitYsDot, _numInitSens);
+				_vecInitYs = nullptr;
+				_vecInitYsDot = nullptr;
+			}
+
+			if (nSens > 0)
+			{
+				_vecInitYs = NVec_CloneArray(nSens, _vecStateY);
+				_vecInitYsDot = NVec_CloneArray(nSens, _vecStateYdot);
+			}
+			_numInitSens = nSens;
+		}
+
+		copyNVector(_vecStateY, _vecInitY);
+		copyNVector(_vecStateYdot, _vecInitYdot);
+		for (unsigned int i = 0; i < nSens; ++i)
+		{
+			copyNVector(_vecFwdYs[i], _vecInitYs[i]);
+			copyNVector(_vecFwdYsDot[i], _vecInitYsDot[i]);
+		}
+
+		_initSkipConsistencyStateY = _skipConsistencyStateY;
+		_initSkipConsistencySensitivity = _skipConsistencySensitivity;
+		_initStateValid = true;
+	}
+
+	void Simulator::restoreInitialState()
+	{
+		copyNVector(_vecInitY, _vecStateY);
+		copyNVector(_vecInitYdot, _vecStateYdot);
+		for (unsigned int i = 0; i < _numInitSens; ++i)
+		{
+			copyNVector(_vecInitYs[i], _vecFwdYs[i]);
+			copyNVector(_vecInitYsDot[i], _vecFwdYsDot[i]);
+		}
+
+		_skipConsistencyStateY = _initSkipConsistencyStateY;
+		_skipConsistencySensitivity = _initSkipConsistencySensitivity;
 	}
 
 	void Simulator::initializeModel(IModelSystem& model)
@@ -451,23 +855,7 @@ namespace cadet
 				return;
 
 			N_Vector absTolTemp = NVec_New(_model->numDofs());
-			const unsigned int pureDofs = _model->numPureDofs();
-
-			// Check whether user has given us full absolute error for all (pure) DOFs
-			if (_absTol.size() >= pureDofs)
-			{
-				// Copy error tolerances for pure data
-				std::copy(_absTol.data(), _absTol.data() + pureDofs, NVEC_DATA(absTolTemp));
-
-				// Calculate error tolerances for coupling DOFs and append them
-				const std::vector<double> addAbsErrTol = _model->calculateErrorTolsForAdditionalDofs(_absTol.data(), _absTol.size());
-				std::copy(addAbsErrTol.data(), addAbsErrTol.data() + addAbsErrTol.size(), NVEC_DATA(absTolTemp) + pureDofs);
-			}
-			else
-			{
-				// We've received an expandable error specification
-				_model->expandErrorTol(_absTol.data(), _absTol.size(), NVEC_DATA(absTolTemp));
-			}
+			expandMainAbsTol(NVEC_DATA(absTolTemp));
 
 			IDASVtolerances(_idaMemBlock, _relTol, absTolTemp);
 			NVec_Destroy(absTolTemp);
@@ -476,6 +864,33 @@ namespace cadet
 			IDASStolerances(_idaMemBlock, _relTol, _absTol[0]);		
 	}
 
+	void Simulator::expandMainAbsTol(double* const absTol) const
+	{
+		if (_absTol.size() <= 1)
+		{
+			std::fill(absTol, absTol + _model->numDofs(), _absTol[0]);
+			return;
+		}
+
+		const unsigned int pureDofs = _model->numPureDofs();
+
+		// Check whether user has given us full absolute error for all (pure) DOFs
+		if (_absTol.size() >= pureDofs)
+		{
+			// Copy error tolerances for pure data
+			std::copy(_absTol.data(), _absTol.data() + pureDofs, absTol);
+
+			// Calculate error tolerances for coupling DOFs and append them
+			const std::vector<double> addAbsErrTol = _model->calculateErrorTolsForAdditionalDofs(_absTol.data(), _absTol.size());
+			std::copy(addAbsErrTol.data(), addAbsErrTol.data() + addAbsErrTol.size(), absTol + pureDofs);
+		}
+		else
+		{
+			// We've received an expandable error specification
+			_model->expandErrorTol(_absTol.data(), _absTol.size(), absTol);
+		}
+	}
+
 	void Simulator::preFwdSensInit(unsigned int nSens)
 	{
 		// Turn off solution of sensitivity systems (this will be overridden by a call to IDASensInit below)
@@ -484,6 +899,9 @@ namespace cadet
 		// sensitivities is started.
 		IDASensToggleOff(_idaMemBlock);
 
+		// Saved initial state does not match the new sensitivities
+		_initStateValid = false;
+
 		if (_vecFwdYs)
 		{
 			NVec_DestroyArray(_vecFwdYs, nSens);
@@ -575,6 +993,8 @@ namespace cadet
 		if (nSens == 0)
 			return;
 
+		_initStateValid = false;
+
 		if (!initSens && !initSensDot)
 		{
 			for (unsigned int dir = 0; dir < nSens; ++dir)
@@ -610,6 +1030,7 @@ namespace cadet
 	{
 		_model->applyInitialCondition(paramProvider, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot));
 		IDAReInit(_idaMemBlock, _transformedTimes[0], _vecStateY, _vecStateYdot);
+		_initStateValid = false;
 
 		// Better check for consistency
 		_skipConsistencyStateY = false;
@@ -622,6 +1043,7 @@ namespace cadet
 		std::copy(initState, initState + NVEC_LENGTH(_vecStateY), y);
 
 		IDAReInit(_idaMemBlock, _transformedTimes[0], _vecStateY, _vecStateYdot);
+		_initStateValid = false;
 
 		// We need to compute matching yDot for consistency
 		_skipConsistencyStateY = false;
@@ -638,6 +1060,7 @@ namespace cadet
 		std::copy(initStateDot, initStateDot + NVEC_LENGTH(_vecStateY), yDot);
 
 		IDAReInit(_idaMemBlock, _transformedTimes[0], _vecStateY, _vecStateYdot);
+		_initStateValid = false;
 
 		// Do not assume that the initial state is consistent
 		_skipConsistencyStateY = false;
@@ -647,6 +1070,10 @@ namespace cadet
 	{
 		_skipConsistencyStateY = true;
 		_skipConsistencySensitivity = true;
+
+		// Also applies to reintegrate()
+		_initSkipConsistencyStateY = true;
+		_initSkipConsistencySensitivity = true;
 	}
 
 	void Simulator::setConsistentInitialization(ConsistentInitialization ci)
@@ -973,11 +1400,167 @@ namespace cadet
 		_solRecorder = recorder;
 		if (_solRecorder)
 		{
-			_solRecorder->prepare(NVEC_LENGTH(_vecStateY), _sensitiveParams.slices(), _solutionTimes.size());
+			_solRecorder->prepare(NVEC_LENGTH(_vecStateY), numFwdSensitivities(), _solutionTimes.size());
 			_model->reportSolutionStructure(*_solRecorder);
 		}
 	}
 
+	void Simulator::setCheckpointWriter(ICheckpointWriter* writer)
+	{
+		_checkpointWriter = writer;
+	}
+
+	void Simulator::setCheckpointInterval(double interval)
+	{
+		if (interval < 0.0)
+			throw InvalidParameterException("Checkpoint interval has to be non-negative");
+
+		_checkpointInterval = interval;
+	}
+
+	void Simulator::resumeFromCheckpoint(double const* data, unsigned int len)
+	{
+		if (!_model)
+			throw InvalidParameterException("Resuming from a checkpoint requires a model");
+
+		if ((len < checkpoint::HeaderSize) || (data[checkpoint::Version] != checkpoint::FormatVersion))
+			throw InvalidParameterException("Unsupported checkpoint format");
+
+		const unsigned int nDof = static_cast<unsigned int>(data[checkpoint::NumDofs]);
+		const unsigned int nSens = static_cast<unsigned int>(data[checkpoint::NumSens]);
+		if (nDof != _model->numDofs())
+			throw InvalidParameterException("Number of DOFs in checkpoint (" + std::to_string(nDof) + ") does not match model (" + std::to_string(_model->numDofs()) + ")");
+
+		const unsigned int nHits = static_cast<unsigned int>(data[checkpoint::NumStopHits]);
+		if (len < checkpoint::HeaderSize + 2 * (nSens + 1) * nDof + 2 * nHits)
+			throw InvalidParameterException("Checkpoint is truncated");
+
+		_resumeState.assign(data, data + len);
+	}
+
+	double Simulator::restoreCheckpointState()
+	{
+		// The checkpoint is consumed even if restoring fails
+		std::vector<double> state;
+		state.swap(_resumeState);
+
+		double const* const data = state.data();
+		const unsigned int nDof = NVEC_LENGTH(_vecStateY);
+		const unsigned int nSens = static_cast<unsigned int>(data[checkpoint::NumSens]);
+		if (nSens != numFwdSensitivities())
+			throw InvalidParameterException("Number of sensitivities in checkpoint (" + std::to_string(nSens) + ") does not match simulator (" + std::to_string(numFwdSensitivities()) + ")");
+
+		const unsigned int secIdx = static_cast<unsigned int>(data[checkpoint::Section]);
+		if (secIdx + 1 >= _transformedTimes.size())
+			throw InvalidParameterException("Section " + std::to_string(secIdx) + " of checkpoint does not exist");
+
+		double const* ptr = data + checkpoint::HeaderSize;
+		std::copy(ptr, ptr + nDof, NVEC_DATA(_vecStateY));
+		ptr += nDof;
+		std::copy(ptr, ptr + nDof, NVEC_DATA(_vecStateYdot));
+		ptr += nDof;
+		for (unsigned int i = 0; i < nSens; ++i)
+		{
+			std::copy(ptr, ptr + nDof, NVEC_DATA(_vecFwdYs[i]));
+			ptr += nDof;
+			std::copy(ptr, ptr + nDof, NVEC_DATA(_vecFwdYsDot[i]));
+			ptr += nDof;
+		}
+
+		const unsigned int nHits = static_cast<unsigned int>(data[checkpoint::NumStopHits]);
+		_stopHitTimes.assign(ptr, ptr + nHits);
+		ptr += nHits;
+		for (unsigned int i = 0; i < nHits; ++i)
+			_stopHitIndices.push_back(static_cast<unsigned int>(ptr[i]));
+		ptr += nHits;
+
+		_curSec = secIdx;
+		_model->restoreSwitchIndex(static_cast<unsigned int>(data[checkpoint::SwitchIndex]));
+
+		if (_solRecorder && (ptr != data + state.size()))
+			_solRecorder->restoreCheckpoint(ptr, data + state.size() - ptr);
+
+		// The state has been consistent when the checkpoint was taken
+		_skipConsistencyStateY = true;
+		_skipConsistencySensitivity = true;
+
+		const double t = data[checkpoint::Time];
+		LOG(Debug) << "Resuming from checkpoint at t = " << t << " (transformed) in section " << _curSec;
+		return t;
+	}
+
+	void Simulator::takeCheckpoint(double t, double realT)
+	{
+		if (realT < _nextCheckpoint)
+			return;
+
+		// Never stall the time integration by waiting for the previous checkpoint
+		if (!_asyncCheckpoint.idle())
+		{
+			LOG(Debug) << "Skipping checkpoint at t = " << realT << " since previous checkpoint is still being written";
+			return;
+		}
+
+		const unsigned int nDof = NVEC_LENGTH(_vecStateY);
+		const unsigned int nSens = numFwdSensitivities();
+		if (nSens > 0)
+		{
+			// Sensitivities are not extracted from IDAS after each step
+			double tSens = t;
+			IDAGetSens(_idaMemBlock, &tSens, _vecFwdYs);
+			IDAGetSensDky(_idaMemBlock, t, 1, _vecFwdYsDot);
+		}
+
+		std::vector<double>& buffer = _asyncCheckpoint.buffer();
+		buffer.clear();
+		buffer.reserve(checkpoint::HeaderSize + 2 * (nSens + 1) * nDof + 2 * _stopHitTimes.size());
+		buffer.resize(checkpoint::HeaderSize);
+		buffer[checkpoint::Version] = checkpoint::FormatVersion;
+		buffer[checkpoint::NumDofs] = nDof;
+		buffer[checkpoint::NumSens] = nSens;
+		buffer[checkpoint::Time] = t;
+		buffer[checkpoint::Section] = _curSec;
+		buffer[checkpoint::SwitchIndex] = _model->currentSwitchIndex();
+		buffer[checkpoint::NumStopHits] = _stopHitTimes.size();
+
+		buffer.insert(buffer.end(), NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateY) + nDof);
+		buffer.insert(buffer.end(), NVEC_DATA(_vecStateYdot), NVEC_DATA(_vecStateYdot) + nDof);
+		for (unsigned int i = 0; i < nSens; ++i)
+		{
+			buffer.insert(buffer.end(), NVEC_DATA(_vecFwdYs[i]), NVEC_DATA(_vecFwdYs[i]) + nDof);
+			buffer.insert(buffer.end(), NVEC_DATA(_vecFwdYsDot[i]), NVEC_DATA(_vecFwdYsDot[i]) + nDof);
+		}
+
+		buffer.insert(buffer.end(), _stopHitTimes.begin(), _stopHitTimes.end());
+		buffer.insert(buffer.end(), _stopHitIndices.begin(), _stopHitIndices.end());
+
+		LOG(Debug) << "Taking checkpoint at t = " << realT;
+		_nextCheckpoint = realT + _checkpointInterval;
+
+		if (!_asyncOutput.enabled())
+		{
+			_asyncCheckpoint.submit(realT);
+			return;
+		}
+
+		// The recorder is serialized by the output thread after it has recorded all solutions up to
+		// this point, which keeps the serialization off the time integration
+		_asyncCheckpoint.reserve();
+		_asyncOutput.submitTask([this, realT]()
+			{
+				try
+				{
+					_solRecorder->saveCheckpoint(_asyncCheckpoint.buffer());
+				}
+				catch (...)
+				{
+					_asyncCheckpoint.cancel();
+					throw;
+				}
+				_asyncCheckpoint.submit(realT);
+			});
+	}
+
 	const active Simulator::timeFactor(unsigned int curSec) const
 	{
 //		return (_transformedTimes[curSec + 1] - _transformedTimes[curSec]) / static_cast<double>(_sectionTimes[curSec + 1] - _sectionTimes[curSec]);
@@ -1013,28 +1596,170 @@ namespace cadet
 
 	void Simulator::integrate()
 	{
-		// In this function the model is integrated by IDAS from the SUNDIALS package.
-		// The authors of IDAS recommend to restart the time integrator when a discontinuity
-		// is encountered (see https://computation.llnl.gov/casc/sundials/support/notes.html#disc).
-		// The sectionTime (together with the sectionContinuity) array indicates such
-		// discontinuitites and the solver is restarted accordingly. This also requires
-		// the computation of consistent initial values for each restart.
-
-		// This sets up the tbb thread limiter
-		// TBB can use up to _nThreads but it may use fewer
-#ifdef CADET_PARALLELIZE
-		tbb::task_scheduler_init init(tbb::task_scheduler_init::deferred);
-		if (_nThreads > 0)
-			init.initialize(_nThreads);
+		saveInitialState();
+		if (_cssMaxCycles > 0)
+			integrateCyclicSteadyState();
 		else
-			init.initialize(tbb::task_scheduler_init::default_num_threads());
-#endif
+		{
+			_lastNumCycles = 0;
+			integrateFromCurrentState();
+		}
+	}
 
-		// Set number of threads in SUNDIALS OpenMP-enabled implementation
-		#ifdef CADET_SUNDIALS_OPENMP
-			if (_vecStateY)
-				NVec_SetThreads(_vecStateY, nThreads);
-			if (_vecStateYdot)
+	void Simulator::reintegrate()
+	{
+		if (!_initStateValid)
+		{
+			integrate();
+			return;
+		}
+
+		restoreInitialState();
+		if (_cssMaxCycles > 0)
+			integrateCyclicSteadyState();
+		else
+		{
+			_lastNumCycles = 0;
+			integrateFromCurrentState();
+		}
+	}
+
+	void Simulator::packCyclicState(double* const buffer) const
+	{
+		const unsigned int nDof = NVEC_LENGTH(_vecStateY);
+		double const* const y = NVEC_DATA(_vecStateY);
+		std::copy(y, y + nDof, buffer);
+
+		for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+		{
+			double const* const yS = NVEC_DATA(_vecFwdYs[i]);
+			std::copy(yS, yS + nDof, buffer + (i + 1) * nDof);
+		}
+	}
+
+	void Simulator::unpackCyclicState(double const* const buffer)
+	{
+		const unsigned int nDof = NVEC_LENGTH(_vecStateY);
+		std::copy(buffer, buffer + nDof, NVEC_DATA(_vecStateY));
+
+		for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+			std::copy(buffer + (i + 1) * nDof, buffer + (i + 2) * nDof, NVEC_DATA(_vecFwdYs[i]));
+	}
+
+	void Simulator::cyclicStateWeights(double* const weight) const
+	{
+		// Same error weights as used by the time integrator, evaluated at the end of the cycle
+		const unsigned int nDof = NVEC_LENGTH(_vecStateY);
+		double const* const y = NVEC_DATA(_vecStateY);
+		expandMainAbsTol(weight);
+		for (unsigned int j = 0; j < nDof; ++j)
+			weight[j] = 1.0 / (_relTol * std::abs(y[j]) + weight[j]);
+
+		for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+		{
+			double const* const yS = NVEC_DATA(_vecFwdYs[i]);
+			double* const wS = weight + (i + 1) * nDof;
+			for (unsigned int j = 0; j < nDof; ++j)
+				wS[j] = 1.0 / (_relTolS * std::abs(yS[j]) + _absTolS[i]);
+		}
+	}
+
+	void Simulator::integrateCyclicSteadyState()
+	{
+		if (adjointMode())
+			throw InvalidParameterException("Cyclic steady state mode cannot be combined with adjoint sensitivities");
+
+		const unsigned int nTotal = NVEC_LENGTH(_vecStateY) * (_sensitiveParams.slices() + 1);
+
+		_cssIterate.resize(nTotal);
+		_cssImage.resize(nTotal);
+		_cssWeight.resize(nTotal);
+		if ((_cssAccel.size() != nTotal) || (_cssAccel.depth() != _cssAndersonDepth))
+			_cssAccel.resize(nTotal, _cssAndersonDepth);
+		else
+			_cssAccel.reset();
+
+		packCyclicState(_cssIterate.data());
+
+		// Do not record intermediate cycles
+		ISolutionRecorder* const recorder = _solRecorder;
+		_solRecorder = nullptr;
+
+		double totalTime = 0.0;
+		unsigned int totalSteps = 0;
+		_lastNumCycles = 0;
+		_lastCssError = std::numeric_limits<double>::infinity();
+
+		try
+		{
+			while (_lastNumCycles < _cssMaxCycles)
+			{
+				integrateFromCurrentState();
+				++_lastNumCycles;
+				totalTime += _lastIntTime;
+				totalSteps += _lastNumSteps;
+
+				packCyclicState(_cssImage.data());
+				cyclicStateWeights(_cssWeight.data());
+
+				_lastCssError = 0.0;
+				for (unsigned int i = 0; i < nTotal; ++i)
+					_lastCssError = std::max(_lastCssError, std::abs(_cssImage[i] - _cssIterate[i]) * _cssWeight[i]);
+
+				LOG(Debug) << "Cycle " << _lastNumCycles << " weighted change " << _lastCssError;
+
+				if (_lastCssError <= _cssTol)
+					break;
+
+				// Start next cycle from the extrapolated state, the time derivatives
+				// are recomputed by the consistent initialization
+				_cssAccel.update(_cssIterate.data(), _cssImage.data(), _cssWeight.data());
+				unpackCyclicState(_cssIterate.data());
+			}
+		}
+		catch (...)
+		{
+			_solRecorder = recorder;
+			throw;
+		}
+
+		_solRecorder = recorder;
+
+		if (_lastCssError > _cssTol)
+		{
+			LOG(Warning) << "Cyclic steady state not reached after " << _lastNumCycles << " cycles (weighted change " << _lastCssError << ")";
+		}
+
+		// Record the cycle starting from the last state
+		integrateFromCurrentState();
+		_lastIntTime += totalTime;
+		_lastNumSteps += totalSteps;
+	}
+
+	void Simulator::integrateFromCurrentState()
+	{
+		// In this function the model is integrated by IDAS from the SUNDIALS package.
+		// The authors of IDAS recommend to restart the time integrator when a discontinuity
+		// is encountered (see https://computation.llnl.gov/casc/sundials/support/notes.html#disc).
+		// The sectionTime (together with the sectionContinuity) array indicates such
+		// discontinuitites and the solver is restarted accordingly. This also requires
+		// the computation of consistent initial values for each restart.
+
+		// This sets up the tbb thread limiter
+		// TBB can use up to _nThreads but it may use fewer
+#ifdef CADET_PARALLELIZE
+		tbb::task_scheduler_init init(tbb::task_scheduler_init::deferred);
+		if (_nThreads > 0)
+			init.initialize(_nThreads);
+		else
+			init.initialize(tbb::task_scheduler_init::default_num_threads());
+#endif
+
+		// Set number of threads in SUNDIALS OpenMP-enabled implementation
+		#ifdef CADET_SUNDIALS_OPENMP
+			if (_vecStateY)
+				NVec_SetThreads(_vecStateY, nThreads);
+			if (_vecStateYdot)
 				NVec_SetThreads(_vecStateYdot, nThreads);
 
 			for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
@@ -1044,14 +1769,77 @@ namespace cadet
 			}
 		#endif
 
+		if (!_resumeState.empty() && ((_cssMaxCycles > 0) || adjointMode()))
+			throw InvalidParameterException("Resuming from a checkpoint is not supported in cyclic steady state and adjoint mode");
+
+		if (!_stopConditions.empty() && ((_cssMaxCycles > 0) || adjointMode()))
+			throw InvalidParameterException("Stop conditions are not supported in cyclic steady state and adjoint mode");
+
+		// Register stop conditions as root functions (or remove the ones of a previous run)
+		_stopHitTimes.clear();
+		_stopHitIndices.clear();
+		if (_stopConditions.empty())
+			IDARootInit(_idaMemBlock, 0, nullptr);
+		else
+		{
+			IDARootInit(_idaMemBlock, _stopConditions.size(), &stopConditionWrapper);
+			IDASetRootDirection(_idaMemBlock, _stopDirection.data());
+			_stopRootsFound.resize(_stopConditions.size());
+		}
+
 		_timerIntegration.start();
 
-		// Set number of AD directions
-		// @todo This is problematic if multiple Simulators are run concurrently!
+		// Set number of AD directions, concurrently running Simulators have to agree on it
 #if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
-		LOG(Debug) << "Setting AD directions from " << ad::getDirections() << " to " << numSensitivityAdDirections() + _model->requiredADdirs();
-		ad::setDirections(numSensitivityAdDirections() + _model->requiredADdirs());
+		if (numSensitivityAdDirections() + _model->requiredADdirs() > ad::getMaxDirections())
+			throw InvalidParameterException("Number of required AD directions (" + std::to_string(numSensitivityAdDirections() + _model->requiredADdirs())
+				+ ") exceeds maximum number of AD directions (" + std::to_string(ad::getMaxDirections()) + ")");
+
+		LOG(Debug) << "Setting AD directions to " << numSensitivityAdDirections() + _model->requiredADdirs();
+		const ScopedAdDirections adDirGuard(numSensitivityAdDirections() + _model->requiredADdirs());
 #endif
+
+		if (adjointMode())
+		{
+			using std::to_string;
+
+			for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+			{
+				ParameterId const* const ids = _sensitiveParams[i];
+				for (unsigned int j = 0; j < _sensitiveParams.sliceSize(i); ++j)
+				{
+					if (isSectionTimeParameter(ids[j], _sectionTimes.size()))
+						throw InvalidParameterException("Sensitive parameter " + to_string(ids[j]) + " is not supported in adjoint mode");
+				}
+			}
+
+			// Forward sensitivity systems are replaced by the backward quadratures of the adjoint system
+			IDASensToggleOff(_idaMemBlock);
+
+			// Backward problem has to be created again if the number of its quadratures has changed
+			if (_adjMemInitialized && _vecAdjQuad && (NVEC_LENGTH(_vecAdjQuad) != static_cast<long int>(_sensitiveParams.slices()) + 1))
+			{
+				IDAAdjFree(_idaMemBlock);
+				_adjMemInitialized = false;
+				_adjWhich = -1;
+			}
+
+			if (!_adjMemInitialized)
+			{
+				IDAAdjInit(_idaMemBlock, _adjCheckpointSteps, IDA_HERMITE);
+				_adjMemInitialized = true;
+			}
+
+			if (!_vecADres && (_sensitiveParams.slices() > 0))
+				_vecADres = new active[_model->numDofs()];
+
+			_adjTemp.resize(_model->numDofs());
+			_adjSliceStart.clear();
+			_adjSliceEnd.clear();
+			_adjSliceSection.clear();
+			_adjSliceState.clear();
+		}
+
 		// Setup AD vectors by model
 		_model->prepareADvectors(_vecADres, _vecADy, numSensitivityAdDirections());
 
@@ -1059,22 +1847,58 @@ namespace cadet
 		double tOut = 0.0;
 
 		const bool writeAtUserTimes = _solutionTimes.size() > 0;
-		const bool wantSensitivities = _sensitiveParams.slices() > 0;
+		const bool wantSensitivities = numFwdSensitivities() > 0;
+
+		// Checkpoints are written by a background thread, which must not outlive the writer.
+		// The guard is destroyed after the one of the solution output, which may still submit a checkpoint.
+		const bool takeCheckpoints = _checkpointWriter && (_checkpointInterval > 0.0) && !adjointMode() && (_cssMaxCycles == 0);
+		if (takeCheckpoints)
+		{
+			ICheckpointWriter* const writer = _checkpointWriter;
+			_asyncCheckpoint.configure([writer](double t, double const* data, std::size_t len)
+				{
+					writer->writeCheckpoint(t, data, len);
+				});
+			_nextCheckpoint = static_cast<double>(_sectionTimes[0]) + _checkpointInterval;
+		}
+		AsyncOutputGuard<AsyncCheckpointQueue> checkpointGuard(_asyncCheckpoint);
 
 		if (_solRecorder)
 		{
-			_solRecorder->notifyIntegrationStart(NVEC_LENGTH(_vecStateY), _sensitiveParams.slices(), _solutionTimes.size());
+			_solRecorder->notifyIntegrationStart(NVEC_LENGTH(_vecStateY), numFwdSensitivities(), _solutionTimes.size());
 			_model->reportSolutionStructure(*_solRecorder);			
+
+			// Systems that are not recorded by any unit operation are skipped when writing solutions
+			_recordedFields = _solRecorder->recordedFields(UnitOpIndep);
+
+			// Checkpoints serialize the recorder on the output thread, which requires asynchronous output
+			if ((_asyncOutputDepth > 0) || takeCheckpoints)
+			{
+				// Snapshot layout: y, yDot, sY_0, sYdot_0, sY_1, sYdot_1, ...
+				const unsigned int n = NVEC_LENGTH(_vecStateY);
+				_asyncOutput.configure((2 + 2 * numFwdSensitivities()) * n, std::max(_asyncOutputDepth, 1u), [this, n](double t, double const* data)
+					{
+						this->recordSolution(t, data, data + n, [=](unsigned int idx) { return data + (2 + idx) * n; });
+					});
+			}
 		}
 
+		// Make sure the consumer thread does not access the recorder anymore if we leave by exception
+		AsyncOutputGuard<AsyncSolutionQueue> asyncGuard(_asyncOutput);
+
 		// Decide whether to use user specified solution output times (IDA_NORMAL)
-		// or internal integrator steps (IDA_ONE_STEP)
+		// or internal integrator steps (IDA_ONE_STEP). Dense output interpolates
+		// the solution at user specified times from internal integrator steps.
+		const bool denseOutput = writeAtUserTimes && _denseOutput;
 		int idaTask = IDA_ONE_STEP;
-		if (writeAtUserTimes)
+		if (writeAtUserTimes && !denseOutput)
 		{
 			idaTask = IDA_NORMAL;
 		}
 
+		if (denseOutput)
+			prepareDenseOutput();
+
 		LOG(Debug) << "Integration span: [" << _transformedTimes[0] << ", " << _transformedTimes.back() 
 			<< "] transformed, [" << static_cast<double>(_sectionTimes[0]) << ", " << static_cast<double>(_sectionTimes.back()) << "] sections";
 		
@@ -1085,14 +1909,26 @@ namespace cadet
 
 		double transformedT = _transformedTimes[0];
 		_curSec = 0;
+		_lastNumSteps = 0;
+
+		// Continue within the section of the checkpoint instead of starting from the beginning
+		bool resumeSlice = !_resumeState.empty();
+		if (resumeSlice)
+		{
+			transformedT = restoreCheckpointState();
+			_nextCheckpoint = static_cast<double>(toRealTime(transformedT, _curSec)) + _checkpointInterval;
+		}
+
 		const double tEnd = writeAtUserTimes ? _solutionTimes.back() : _transformedTimes.back();
-		while (transformedT < tEnd)
+		bool stopIntegration = false;
+		while ((transformedT < tEnd) && !stopIntegration)
 		{
 			// Get smallest index with t_i >= transformedT (t_i being a _transformedTimes element)
 			// This will return i if transformedT == _transformedTimes[i], which effectively advances
 			// the index if required
-			_curSec = getNextSection(transformedT, _curSec);
-			const double startTime = _transformedTimes[_curSec];
+			if (!resumeSlice)
+				_curSec = getNextSection(transformedT, _curSec);
+			const double startTime = resumeSlice ? transformedT : _transformedTimes[_curSec];
 
 			// Determine continuous time slice
 			unsigned int skip = 1; // Always finish the current section
@@ -1160,7 +1996,7 @@ namespace cadet
 			}
 			_skipConsistencyStateY = false;
 
-			if ((_sensitiveParams.slices() > 0) && !_skipConsistencySensitivity && (_consistentInitModeSens != ConsistentInitialization::None))
+			if ((numFwdSensitivities() > 0) && !_skipConsistencySensitivity && (_consistentInitModeSens != ConsistentInitialization::None))
 			{
 #ifdef CADET_DEBUG
 				const std::vector<const double*> sensYdbg = convertNVectorToStdVectorPtrs<const double*>(_vecFwdYs, _sensitiveParams.slices());
@@ -1178,9 +2014,9 @@ namespace cadet
 				if (mode == ConsistentInitialization::Full)
 				{
 					// Compute consistent initial conditions for sensitivity subsystems
-					std::vector<double*> sensY = convertNVectorToStdVectorPtrs<double*>(_vecFwdYs, _sensitiveParams.slices());
-					std::vector<double*> sensYdot = convertNVectorToStdVectorPtrs<double*>(_vecFwdYsDot, _sensitiveParams.slices());
-					_model->consistentInitialSensitivity(realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), sensY, sensYdot, _vecADres, _vecADy);
+					fillNVectorPtrs(_sensYptr, _vecFwdYs, _sensitiveParams.slices());
+					fillNVectorPtrs(_sensYdotPtr, _vecFwdYsDot, _sensitiveParams.slices());
+					_model->consistentInitialSensitivity(realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), _sensYptr, _sensYdotPtr, _vecADres, _vecADy);
 
 #ifdef CADET_DEBUG
 					_model->residualSensFwdNorm(_sensitiveParams.slices(), realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot),
@@ -1192,9 +2028,9 @@ namespace cadet
 				else if (mode == ConsistentInitialization::Lean)
 				{
 					// Compute consistent initial conditions for sensitivity subsystems
-					std::vector<double*> sensY = convertNVectorToStdVectorPtrs<double*>(_vecFwdYs, _sensitiveParams.slices());
-					std::vector<double*> sensYdot = convertNVectorToStdVectorPtrs<double*>(_vecFwdYsDot, _sensitiveParams.slices());
-					_model->leanConsistentInitialSensitivity(realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), sensY, sensYdot, _vecADres, _vecADy);
+					fillNVectorPtrs(_sensYptr, _vecFwdYs, _sensitiveParams.slices());
+					fillNVectorPtrs(_sensYdotPtr, _vecFwdYsDot, _sensitiveParams.slices());
+					_model->leanConsistentInitialSensitivity(realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), _sensYptr, _sensYdotPtr, _vecADres, _vecADy);
 
 #ifdef CADET_DEBUG
 					_model->residualSensFwdNorm(_sensitiveParams.slices(), realT, _curSec, curTimeFactor, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot),
@@ -1221,38 +2057,58 @@ namespace cadet
 
 			// IDAS Step 5.2: Re-initialization of the solver
 			IDAReInit(_idaMemBlock, startTime, _vecStateY, _vecStateYdot);
-			if (numSensParams() > 0)
+			if (numFwdSensitivities() > 0)
 				IDASensReInit(_idaMemBlock, IDA_STAGGERED, _vecFwdYs, _vecFwdYsDot);
 
+			if (adjointMode())
+			{
+				// Save the consistent initial state of the time slice for recomputing its checkpoints in the backward pass
+				const unsigned int nDof = NVEC_LENGTH(_vecStateY);
+				_adjSliceStart.push_back(startTime);
+				_adjSliceEnd.push_back(endTime);
+				_adjSliceSection.push_back(_curSec);
+				_adjSliceState.insert(_adjSliceState.end(), NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateY) + nDof);
+				_adjSliceState.insert(_adjSliceState.end(), NVEC_DATA(_vecStateYdot), NVEC_DATA(_vecStateYdot) + nDof);
+
+				// Checkpoints are only kept for the current time slice
+				IDAAdjReInit(_idaMemBlock);
+			}
+
 			// Inititalize the IDA solver flag
 			int solverFlag = IDA_SUCCESS;
+			bool leaveSlice = false;
 
 			if (writeAtUserTimes)
 			{
 				// Write initial conditions only if desired by user
-				if (_curSec == 0 && _solutionTimes.front() == transformedT)
+				if (!resumeSlice && (_curSec == 0) && (_solutionTimes.front() == transformedT))
 					writeSolution(static_cast<double>(realT));
 
 				// Initialize iterator and forward it to the first solution time that lies inside the current section
 				it = _solutionTimes.begin();
 				while ((*it) <= startTime) ++it;
+
+				// Let the integrator step freely until the end of the section
+				if (denseOutput)
+					tOut = endTime;
 			}
 			else
 			{
 				// Always write initial conditions if solutions are written at integration times
-				if (_curSec == 0) writeSolution(static_cast<double>(realT));
+				if (!resumeSlice && (_curSec == 0)) writeSolution(static_cast<double>(realT));
 
 				// Here tOut - only during the first call to IDASolve - specifies the direction
 				// and rough scale of the independent variable, see IDAS Guide p.33
 				tOut = endTime;
 			}
+			resumeSlice = false;
 
 			// Main loop which integrates the system until reaching the end time of the current section
 			// or until an error occures
-			while ((solverFlag == IDA_SUCCESS) || (solverFlag == IDA_ROOT_RETURN))
+			while (((solverFlag == IDA_SUCCESS) || (solverFlag == IDA_ROOT_RETURN)) && !leaveSlice)
 			{
 				// Update tOut if we write solutions at user specified times
-				if (writeAtUserTimes)
+				if (writeAtUserTimes && !denseOutput)
 				{
 					// Check if user specified times are sufficiently long.
 					// otherwise integrate till IDA_TSTOP_RETURN
@@ -1263,7 +2119,13 @@ namespace cadet
 				}
 
 				// IDA Step 11: Advance solution in time
-				solverFlag = IDASolve(_idaMemBlock, tOut, &transformedT, _vecStateY, _vecStateYdot, idaTask);
+				if (adjointMode())
+				{
+					int numCheckpoints = 0;
+					solverFlag = IDASolveF(_idaMemBlock, tOut, &transformedT, _vecStateY, _vecStateYdot, idaTask, &numCheckpoints);
+				}
+				else
+					solverFlag = IDASolve(_idaMemBlock, tOut, &transformedT, _vecStateY, _vecStateYdot, idaTask);
 				LOG(Debug) << "Solve from " << transformedT << " to " << tOut << " => " 
 					<< (solverFlag == IDA_SUCCESS ? "IDA_SUCCESS" : "") << (solverFlag == IDA_TSTOP_RETURN ? "IDA_TSTOP_RETURN" : "");
 				realT = toRealTime(transformedT, _curSec);
@@ -1271,6 +2133,21 @@ namespace cadet
 				switch (solverFlag)
 				{
 				case IDA_SUCCESS:
+					if (denseOutput)
+					{
+						// An internal step was taken, write all solution times covered by the step
+						while ((it != _solutionTimes.end()) && (*it <= transformedT))
+						{
+							writeDenseSolution(*it, static_cast<double>(toRealTime(*it, _curSec)));
+							++it;
+						}
+
+						// Resuming at the end of a time slice is not possible
+						if (takeCheckpoints && (transformedT < endTime))
+							takeCheckpoint(transformedT, static_cast<double>(realT));
+						break;
+					}
+
 					// tOut was reached
 
 					// Extract sensitivity information from IDA (required for consistent initialization
@@ -1282,10 +2159,60 @@ namespace cadet
 					}
 					writeSolution(static_cast<double>(realT));
 					++it;
+
+					if (takeCheckpoints && (transformedT < endTime))
+						takeCheckpoint(transformedT, static_cast<double>(realT));
 					break;
 				case IDA_ROOT_RETURN:
-					// A root was found
-					// Eventually call some routine
+					// A stop condition was hit, the sensitivities neglect the dependence of
+					// the hit time on the parameters
+					if (wantSensitivities)
+					{
+						IDAGetSens(_idaMemBlock, &transformedT, _vecFwdYs);
+						IDAGetSensDky(_idaMemBlock, transformedT, 1, _vecFwdYsDot);
+					}
+
+					if (denseOutput)
+					{
+						// The last internal step covers all solution times up to the hit time
+						while ((it != _solutionTimes.end()) && (*it < transformedT))
+						{
+							writeDenseSolution(*it, static_cast<double>(toRealTime(*it, _curSec)));
+							++it;
+						}
+					}
+
+					// Solutions are only recorded at user specified times if there are some
+					if (!writeAtUserTimes || ((it != _solutionTimes.end()) && (*it == transformedT)))
+					{
+						writeSolution(static_cast<double>(realT));
+						if (writeAtUserTimes)
+							++it;
+					}
+
+					if (recordStopConditionHits(static_cast<double>(realT)) == StopConditionAction::Stop)
+						stopIntegration = true;
+					else
+					{
+						// Continue from the current state at the beginning of the next section
+						const unsigned int hitSection = getCurrentSection(transformedT);
+						const double nextSectionStart = _transformedTimes[hitSection + 1];
+
+						// The state is held over the skipped remainder of the section, so record it
+						// at the solution times in between to provide all announced time points
+						if (writeAtUserTimes)
+						{
+							// The time slice may have started in an earlier section
+							while ((it != _solutionTimes.end()) && (*it <= nextSectionStart))
+							{
+								writeSolution(static_cast<double>(toRealTime(*it, hitSection)));
+								++it;
+							}
+						}
+
+						transformedT = nextSectionStart;
+					}
+					leaveSlice = true;
 					break;
 				case IDA_TSTOP_RETURN:
 					// Extract sensitivity information from IDA (required for consistent initialization
@@ -1296,6 +2223,23 @@ namespace cadet
 						IDAGetSensDky(_idaMemBlock, transformedT, 1, _vecFwdYsDot);
 					}
 
+					// Write remaining solution times of the last step, which includes the section end time
+					if (denseOutput)
+					{
+						while ((it != _solutionTimes.end()) && (*it < transformedT))
+						{
+							writeDenseSolution(*it, static_cast<double>(toRealTime(*it, _curSec)));
+							++it;
+						}
+
+						// Interpolation is not required at the end of the last step
+						if ((it != _solutionTimes.end()) && (*it == transformedT))
+						{
+							writeSolution(static_cast<double>(realT));
+							++it;
+						}
+					}
+
 					// Section end time was reached (in previous step)
 					if (!writeAtUserTimes && (endTime == _transformedTimes.back()))
 					{
@@ -1315,11 +2259,197 @@ namespace cadet
 
 			} // while
 
+			// Step counter is reset by IDAReInit() in the next section
+			long int numSteps = 0;
+			IDAGetNumSteps(_idaMemBlock, &numSteps);
+			_lastNumSteps += numSteps;
+
 		} // for (_sec ...)
 
+		// Wait for pending solution output, which belongs to the integration time
+		if (_asyncOutput.enabled())
+			_asyncOutput.finish();
+
+		if (takeCheckpoints)
+			_asyncCheckpoint.finish();
+
+		if (adjointMode())
+			integrateAdjointBackward();
+
 		_lastIntTime = _timerIntegration.stop();
 	}
 
+	void Simulator::integrateAdjointBackward()
+	{
+		const unsigned int nDof = NVEC_LENGTH(_vecStateY);
+		const unsigned int nSens = _sensitiveParams.slices();
+		const unsigned int nSlices = _adjSliceStart.size();
+
+		// Allocate memory on first use
+		if (!_vecAdjY)
+		{
+			_vecAdjY = NVec_New(nDof);
+			_vecAdjYdot = NVec_New(nDof);
+		}
+		if (!_vecAdjQuad || (NVEC_LENGTH(_vecAdjQuad) != nSens + 1))
+		{
+			if (_vecAdjQuad)
+				NVec_Destroy(_vecAdjQuad);
+			_vecAdjQuad = NVec_New(nSens + 1);
+		}
+
+		// The forward integration of earlier slices overwrites the final state, which is restored afterwards
+		const std::vector<double> finalState(NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateY) + nDof);
+		const std::vector<double> finalStateDot(NVEC_DATA(_vecStateYdot), NVEC_DATA(_vecStateYdot) + nDof);
+
+		// Final condition lambda = 0 requires (dF / dyDot)^T lambdaDot = -dg / dy
+		const double tfEnd = static_cast<double>(timeFactor(_curSec));
+		NVec_Const(0.0, _vecAdjY);
+		NVec_Const(0.0, _vecAdjYdot);
+		NVec_Const(0.0, _vecAdjQuad);
+		adjointObjective(static_cast<double>(toRealTime(_adjSliceEnd.back(), _curSec)), NVEC_DATA(_vecStateY), -1.0 / (tfEnd * tfEnd), NVEC_DATA(_vecAdjYdot));
+
+		const double absTolB = *std::min_element(_absTol.begin(), _absTol.end());
+		for (int slice = nSlices - 1; slice >= 0; --slice)
+		{
+			const double startTime = _adjSliceStart[slice];
+			const double endTime = _adjSliceEnd[slice];
+			_curSec = _adjSliceSection[slice];
+
+			LOG(Debug) << " ###### ADJOINT SLICE " << slice << " from " << endTime << " to " << startTime;
+
+			if (slice < static_cast<int>(nSlices) - 1)
+			{
+				// Repeat the forward integration of the slice to recreate its checkpoints
+				double const* const state = _adjSliceState.data() + 2 * nDof * slice;
+				std::copy(state, state + nDof, NVEC_DATA(_vecStateY));
+				std::copy(state + nDof, state + 2 * nDof, NVEC_DATA(_vecStateYdot));
+
+				_model->notifyDiscontinuousSectionTransition(static_cast<double>(toRealTime(startTime, _curSec)), _curSec, _vecADres, _vecADy, numSensitivityAdDirections());
+
+				const double stepSize = _initStepSize.size() > 1 ? _initStepSize[_curSec] : _initStepSize[0];
+				IDASetInitStep(_idaMemBlock, stepSize);
+				IDASetStopTime(_idaMemBlock, endTime);
+				IDAReInit(_idaMemBlock, startTime, _vecStateY, _vecStateYdot);
+				IDAAdjReInit(_idaMemBlock);
+
+				double tRet = startTime;
+				int numCheckpoints = 0;
+				const int flag = IDASolveF(_idaMemBlock, endTime, &tRet, _vecStateY, _vecStateYdot, IDA_NORMAL, &numCheckpoints);
+				if (flag < 0)
+				{
+					LOG(Error) << "IDASolveF returned " << IDAGetReturnFlagName(flag) << " at t = " << tRet;
+					throw IntegrationException("Error in IDASolveF!");
+				}
+			}
+
+			if (_adjWhich < 0)
+			{
+				IDACreateB(_idaMemBlock, &_adjWhich);
+				IDAInitB(_idaMemBlock, _adjWhich, &adjointResidualWrapper, endTime, _vecAdjY, _vecAdjYdot);
+				IDASStolerancesB(_idaMemBlock, _adjWhich, _relTol, absTolB);
+				IDASetUserDataB(_idaMemBlock, _adjWhich, this);
+				IDASetMaxNumStepsB(_idaMemBlock, _adjWhich, _maxSteps);
+
+				// GMRES preconditioned by the factorized transposed Jacobian usually converges in one iteration
+				IDASpgmrB(_idaMemBlock, _adjWhich, 5);
+				IDASpilsSetPreconditionerB(_idaMemBlock, _adjWhich, &adjointPrecSetupWrapper, &adjointPrecSolveWrapper);
+
+				IDAQuadInitB(_idaMemBlock, _adjWhich, &adjointQuadratureWrapper, _vecAdjQuad);
+				IDAQuadSStolerancesB(_idaMemBlock, _adjWhich, _relTolS, absTolB);
+				IDASetQuadErrConB(_idaMemBlock, _adjWhich, true);
+			}
+			else
+			{
+				// Continue with the adjoint state at the end of the slice
+				IDAReInitB(_idaMemBlock, _adjWhich, endTime, _vecAdjY, _vecAdjYdot);
+				IDAQuadReInitB(_idaMemBlock, _adjWhich, _vecAdjQuad);
+			}
+
+			// Jacobian structure may change at section transitions
+			_model->invalidateTransposedFactorization();
+
+			const int flag = IDASolveB(_idaMemBlock, startTime, IDA_NORMAL);
+			if (flag < 0)
+			{
+				LOG(Error) << "IDASolveB returned " << IDAGetReturnFlagName(flag) << " in slice " << slice;
+				throw IntegrationException("Error in IDASolveB!");
+			}
+
+			double tRet = startTime;
+			IDAGetB(_idaMemBlock, _adjWhich, &tRet, _vecAdjY, _vecAdjYdot);
+			IDAGetQuadB(_idaMemBlock, _adjWhich, &tRet, _vecAdjQuad);
+		}
+
+		double const* const q = NVEC_DATA(_vecAdjQuad);
+		_adjGradient.assign(q, q + nSens);
+		_adjObjective = q[nSens];
+
+		// Add initial condition term lambda(t0)^T * dF / dyDot * s(t0), where s(t0) are the initial
+		// forward sensitivities (e.g., given for initial condition parameters). Algebraic components
+		// of s(t0) do not contribute since the corresponding columns of dF / dyDot vanish.
+		if (nSens > 0)
+		{
+			const unsigned int sec = _adjSliceSection[0];
+			const active tf = timeFactor(sec);
+			double const* const state = _adjSliceState.data();
+			_model->residualWithJacobian(toRealTime(_adjSliceStart[0], sec), sec, tf, state, state + nDof, _adjTemp.data(),
+				_vecADres, _vecADy, numSensitivityAdDirections());
+
+			std::vector<double> lambdaM(nDof, 0.0);
+			_model->multiplyWithDerivativeJacobianTransposed(NVEC_DATA(_vecAdjY), lambdaM.data(), static_cast<double>(tf));
+
+			for (unsigned int param = 0; param < nSens; ++param)
+			{
+				double const* const s = NVEC_DATA(_vecFwdYs[param]);
+				double val = 0.0;
+				for (unsigned int i = 0; i < nDof; ++i)
+					val += lambdaM[i] * s[i];
+				_adjGradient[param] += val;
+			}
+		}
+
+		std::copy(finalState.begin(), finalState.end(), NVEC_DATA(_vecStateY));
+		std::copy(finalStateDot.begin(), finalStateDot.end(), NVEC_DATA(_vecStateYdot));
+		_curSec = _adjSliceSection.back();
+	}
+
+	double Simulator::adjointObjective(double t, double const* y, double factor, double* gradY) const
+	{
+		const unsigned int nComp = _adjWeights.size();
+
+		// Locate the interval of the reference that contains t, the reference is constant outside
+		const std::vector<double>::const_iterator it = std::upper_bound(_adjTime.begin(), _adjTime.end(), t);
+		unsigned int idxLeft = 0;
+		unsigned int idxRight = 0;
+		double weightRight = 0.0;
+		if (it == _adjTime.end())
+		{
+			idxLeft = _adjTime.size() - 1;
+			idxRight = idxLeft;
+		}
+		else if (it != _adjTime.begin())
+		{
+			idxRight = it - _adjTime.begin();
+			idxLeft = idxRight - 1;
+			weightRight = (t - _adjTime[idxLeft]) / (_adjTime[idxRight] - _adjTime[idxLeft]);
+		}
+
+		double val = 0.0;
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+		{
+			const double ref = (1.0 - weightRight) * _adjReference[idxLeft * nComp + comp] + weightRight * _adjReference[idxRight * nComp + comp];
+			const unsigned int idx = _adjOutletOffset + comp * _adjOutletStride;
+			const double diff = y[idx] - ref;
+
+			val += 0.5 * _adjWeights[comp] * diff * diff;
+			if (gradY)
+				gradY[idx] += factor * _adjWeights[comp] * diff;
+		}
+
+		return val;
+	}
+
 	double const* Simulator::getLastSolution(unsigned int& len) const
 	{
 		len = NVEC_LENGTH(_vecStateY);
@@ -1342,6 +2472,34 @@ namespace cadet
 		return convertNVectorToStdVectorConstPtrs(len, _vecFwdYsDot, _sensitiveParams.slices());
 	}
 
+	double const* Simulator::getAdjointGradient(unsigned int& len) const
+	{
+		len = 0;
+		if (!adjointMode())
+			return nullptr;
+
+		len = _adjGradient.size();
+		return _adjGradient.data();
+	}
+
+	double const* Simulator::getStopConditionHitTimes(unsigned int& len) const
+	{
+		len = _stopHitTimes.size();
+		if (_stopHitTimes.empty())
+			return nullptr;
+
+		return _stopHitTimes.data();
+	}
+
+	unsigned int const* Simulator::getStopConditionHitIndices(unsigned int& len) const
+	{
+		len = _stopHitIndices.size();
+		if (_stopHitIndices.empty())
+			return nullptr;
+
+		return _stopHitIndices.data();
+	}
+
 	void Simulator::configureTimeIntegrator(double relTol, double absTol, double initStepSize, unsigned int maxSteps, double maxStepSize)
 	{
 		_absTol.clear();
@@ -1402,6 +2560,11 @@ namespace cadet
 		else
 			_nThreads = 0;
 
+		if (paramProvider.exists("ASYNC_SOLUTION_OUTPUT"))
+			_asyncOutputDepth = std::max(paramProvider.getInt("ASYNC_SOLUTION_OUTPUT"), 0);
+		else
+			_asyncOutputDepth = 0;
+
 		_solutionTimes.clear();
 		_solutionTimesOriginal.clear();
 		if (paramProvider.exists("USER_SOLUTION_TIMES"))
@@ -1410,12 +2573,57 @@ namespace cadet
 			_solutionTimesOriginal = _solutionTimes;
 		}
 
+		if (paramProvider.exists("USE_DENSE_OUTPUT"))
+			_denseOutput = paramProvider.getBool("USE_DENSE_OUTPUT");
+		else
+			_denseOutput = false;
+
 		if (paramProvider.exists("CONSISTENT_INIT_MODE"))
 			_consistentInitMode = toConsistentInitialization(paramProvider.getInt("CONSISTENT_INIT_MODE"));
 
 		if (paramProvider.exists("CONSISTENT_INIT_MODE_SENS"))
 			_consistentInitModeSens = toConsistentInitialization(paramProvider.getInt("CONSISTENT_INIT_MODE_SENS"));
 
+		if (paramProvider.exists("CSS_MAX_CYCLES"))
+		{
+			const int maxCycles = paramProvider.getInt("CSS_MAX_CYCLES");
+			if (maxCycles < 0)
+				throw InvalidParameterException("CSS_MAX_CYCLES has to be non-negative");
+
+			_cssMaxCycles = maxCycles;
+		}
+		else
+			_cssMaxCycles = 0;
+
+		if (paramProvider.exists("CSS_TOL"))
+		{
+			_cssTol = paramProvider.getDouble("CSS_TOL");
+			if (_cssTol <= 0.0)
+				throw InvalidParameterException("CSS_TOL has to be positive");
+		}
+		else
+			_cssTol = 1.0;
+
+		if (paramProvider.exists("CSS_ANDERSON_DEPTH"))
+		{
+			const int depth = paramProvider.getInt("CSS_ANDERSON_DEPTH");
+			if (depth < 0)
+				throw InvalidParameterException("CSS_ANDERSON_DEPTH has to be non-negative");
+
+			_cssAndersonDepth = depth;
+		}
+		else
+			_cssAndersonDepth = 5;
+
+		if (paramProvider.exists("CHECKPOINT_INTERVAL"))
+		{
+			_checkpointInterval = paramProvider.getDouble("CHECKPOINT_INTERVAL");
+			if (_checkpointInterval < 0.0)
+				throw InvalidParameterException("CHECKPOINT_INTERVAL has to be non-negative");
+		}
+		else
+			_checkpointInterval = 0.0;
+
 		// @todo: Read more configuration values
 	}
 
@@ -1522,30 +2730,98 @@ namespace cadet
 		return success;
 	}
 
+	void Simulator::writeDenseSolution(double t, double realT)
+	{
+		if (!_solRecorder)
+			return;
+
+		IDAGetDky(_idaMemBlock, t, 0, _vecDenseY);
+		IDAGetDky(_idaMemBlock, t, 1, _vecDenseYdot);
+		if (numFwdSensitivities() > 0)
+		{
+			IDAGetSensDky(_idaMemBlock, t, 0, _vecDenseYs);
+			IDAGetSensDky(_idaMemBlock, t, 1, _vecDenseYsDot);
+		}
+
+		writeSolution(realT, _vecDenseY, _vecDenseYdot, _vecDenseYs, _vecDenseYsDot);
+	}
+
 	void Simulator::writeSolution(double t)
+	{
+		writeSolution(t, _vecStateY, _vecStateYdot, _vecFwdYs, _vecFwdYsDot);
+	}
+
+	void Simulator::writeSolution(double t, N_Vector y, N_Vector yDot, N_Vector* yS, N_Vector* ySdot)
 	{
 		if (!_solRecorder)
 			return;
 
+		if (_asyncOutput.enabled())
+		{
+			// Take a snapshot and let the consumer thread pass it to the recorder
+			const unsigned int n = NVEC_LENGTH(y);
+			double* const snapshot = _asyncOutput.acquire();
+
+			// Only copy systems that are recorded
+			if (_recordedFields & RecordedField::Solution)
+				std::copy_n(NVEC_DATA(y), n, snapshot);
+			if (_recordedFields & RecordedField::SolutionDerivative)
+				std::copy_n(NVEC_DATA(yDot), n, snapshot + n);
+			for (unsigned int i = 0; i < numFwdSensitivities(); ++i)
+			{
+				if (_recordedFields & RecordedField::Sensitivity)
+					std::copy_n(NVEC_DATA(yS[i]), n, snapshot + (2 + 2 * i) * n);
+				if (_recordedFields & RecordedField::SensitivityDerivative)
+					std::copy_n(NVEC_DATA(ySdot[i]), n, snapshot + (3 + 2 * i) * n);
+			}
+
+			_asyncOutput.submit(t);
+			return;
+		}
+
+		recordSolution(t, NVEC_DATA(y), NVEC_DATA(yDot), [=](unsigned int idx) -> double const*
+			{
+				if (idx % 2 == 0)
+					return NVEC_DATA(yS[idx / 2]);
+				else
+					return NVEC_DATA(ySdot[idx / 2]);
+			});
+	}
+
+	template <typename SensAccessor_t>
+	void Simulator::recordSolution(double t, double const* y, double const* yDot, SensAccessor_t sens)
+	{
 		_solRecorder->beginTimestep(t);
 		
-		_solRecorder->beginSolution();
-		_model->reportSolution(*_solRecorder, NVEC_DATA(_vecStateY));
-		_solRecorder->endSolution();
+		if (_recordedFields & RecordedField::Solution)
+		{
+			_solRecorder->beginSolution();
+			_model->reportSolution(*_solRecorder, y);
+			_solRecorder->endSolution();
+		}
 
-		_solRecorder->beginSolutionDerivative();
-		_model->reportSolution(*_solRecorder, NVEC_DATA(_vecStateYdot));
-		_solRecorder->endSolutionDerivative();
+		if (_recordedFields & RecordedField::SolutionDerivative)
+		{
+			_solRecorder->beginSolutionDerivative();
+			_model->reportSolution(*_solRecorder, yDot);
+			_solRecorder->endSolutionDerivative();
+		}
 
-		for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+		for (unsigned int i = 0; i < numFwdSensitivities(); ++i)
 		{
-			_solRecorder->beginSensitivity(*_sensitiveParams[i], i);
-			_model->reportSolution(*_solRecorder, NVEC_DATA(_vecFwdYs[i]));
-			_solRecorder->endSensitivity(*_sensitiveParams[i], i);
+			if (_recordedFields & RecordedField::Sensitivity)
+			{
+				_solRecorder->beginSensitivity(*_sensitiveParams[i], i);
+				_model->reportSolution(*_solRecorder, sens(2 * i));
+				_solRecorder->endSensitivity(*_sensitiveParams[i], i);
+			}
 
-			_solRecorder->beginSensitivityDerivative(*_sensitiveParams[i], i);
-			_model->reportSolution(*_solRecorder, NVEC_DATA(_vecFwdYsDot[i]));
-			_solRecorder->endSensitivityDerivative(*_sensitiveParams[i], i);
+			if (_recordedFields & RecordedField::SensitivityDerivative)
+			{
+				_solRecorder->beginSensitivityDerivative(*_sensitiveParams[i], i);
+				_model->reportSolution(*_solRecorder, sens(2 * i + 1));
+				_solRecorder->endSensitivityDerivative(*_sensitiveParams[i], i);
+			}
 		}
 
 		_solRecorder->endTimestep();
@@ -1600,4 +2876,182 @@ namespace cadet
 		_nThreads = nThreads;
 	}
 
+	void Simulator::setAsyncSolutionOutput(unsigned int depth) CADET_NOEXCEPT
+	{
+		_asyncOutputDepth = depth;
+	}
+
+	void Simulator::setDenseOutput(bool enabled) CADET_NOEXCEPT
+	{
+		_denseOutput = enabled;
+	}
+
+	void Simulator::setCyclicSteadyState(unsigned int maxCycles, double tol, unsigned int andersonDepth)
+	{
+		if (tol <= 0.0)
+			throw InvalidParameterException("Tolerance of cyclic steady state has to be positive");
+
+		_cssMaxCycles = maxCycles;
+		_cssTol = tol;
+		_cssAndersonDepth = andersonDepth;
+	}
+
+	void Simulator::setAdjointObjective(UnitOpIdx unitOp, const std::vector<double>& weights, const std::vector<double>& time, const std::vector<double>& reference)
+	{
+		if (!_model)
+			throw InvalidParameterException("Adjoint objective requires a model");
+
+		IUnitOperation const* const unit = static_cast<IUnitOperation const*>(_model->getUnitOperationModel(unitOp));
+		if (!unit || !unit->hasInlet() || !unit->hasOutlet())
+			throw InvalidParameterException("Unit operation " + std::to_string(unitOp) + " of adjoint objective has to possess an inlet and an outlet");
+
+		if (time.empty())
+			throw InvalidParameterException("Adjoint objective requires at least one reference time point");
+
+		for (unsigned int i = 1; i < time.size(); ++i)
+		{
+			if (time[i] <= time[i - 1])
+				throw InvalidParameterException("Time points of adjoint objective have to be strictly increasing");
+		}
+
+		const unsigned int nComp = unit->numComponents();
+		if (weights.size() != nComp)
+			throw InvalidParameterException("Adjoint objective requires one weight per component (" + std::to_string(nComp) + ")");
+
+		if (reference.size() != time.size() * nComp)
+			throw InvalidParameterException("Adjoint objective requires one reference value per component and time point");
+
+		_adjWeights = weights;
+		_adjTime = time;
+		_adjReference = reference;
+		_adjOutletOffset = _model->unitOperationDofOffset(unitOp) + unit->localOutletComponentIndex();
+		_adjOutletStride = unit->localOutletComponentStride();
+		_adjUnitOp = unitOp;
+
+		_adjGradient.clear();
+		_adjObjective = 0.0;
+	}
+
+	void Simulator::setAdjointCheckpointSteps(unsigned int steps)
+	{
+		if (steps == 0)
+			throw InvalidParameterException("Number of steps between adjoint checkpoints has to be positive");
+
+		if (steps == _adjCheckpointSteps)
+			return;
+
+		// Adjoint module of IDAS has to be initialized again
+		if (_adjMemInitialized)
+		{
+			IDAAdjFree(_idaMemBlock);
+			_adjMemInitialized = false;
+			_adjWhich = -1;
+		}
+
+		_adjCheckpointSteps = steps;
+	}
+
+	void Simulator::clearAdjointObjective()
+	{
+		_adjUnitOp = UnitOpIndep;
+		_adjWeights.clear();
+		_adjTime.clear();
+		_adjReference.clear();
+		_adjGradient.clear();
+		_adjObjective = 0.0;
+	}
+
+	void Simulator::addStopCondition(StopConditionType type, UnitOpIdx unitOp, unsigned int comp, double threshold, int direction, StopConditionAction action)
+	{
+		StopCondition cond;
+		cond.type = type;
+		cond.action = action;
+		cond.threshold = threshold;
+		cond.unit = nullptr;
+		cond.offset = 0;
+		cond.comp = comp;
+
+		if (type == StopConditionType::SectionTime)
+		{
+			if (threshold <= 0.0)
+				throw InvalidParameterException("Time of section time stop condition has to be positive");
+
+			// Section time only increases within a section and drops at section transitions, which must not be hit
+			direction = 1;
+		}
+		else
+		{
+			if (!_model)
+				throw InvalidParameterException("Stop condition requires a model");
+
+			cond.unit = static_cast<IUnitOperation const*>(_model->getUnitOperationModel(unitOp));
+			if (!cond.unit)
+				throw InvalidParameterException("Unit operation " + std::to_string(unitOp) + " of stop condition does not exist");
+
+			if (comp >= cond.unit->numComponents())
+				throw InvalidParameterException("Component " + std::to_string(comp) + " of stop condition does not exist in unit operation " + std::to_string(unitOp));
+
+			if ((type == StopConditionType::OutletConcentration) && !cond.unit->hasOutlet())
+				throw InvalidParameterException("Unit operation " + std::to_string(unitOp) + " of outlet stop condition has to possess an outlet");
+
+			cond.offset = _model->unitOperationDofOffset(unitOp);
+		}
+
+		_stopConditions.push_back(cond);
+		_stopDirection.push_back((direction > 0) - (direction < 0));
+	}
+
+	void Simulator::clearStopConditions()
+	{
+		_stopConditions.clear();
+		_stopDirection.clear();
+		_stopHitTimes.clear();
+		_stopHitIndices.clear();
+	}
+
+	void Simulator::evaluateStopConditions(double t, double const* y, double* g) const
+	{
+		for (unsigned int i = 0; i < _stopConditions.size(); ++i)
+		{
+			const StopCondition& cond = _stopConditions[i];
+			switch (cond.type)
+			{
+			case StopConditionType::OutletConcentration:
+				// Outlet index depends on the current flow direction
+				g[i] = y[cond.offset + cond.unit->localOutletComponentIndex() + cond.comp * cond.unit->localOutletComponentStride()] - cond.threshold;
+				break;
+			case StopConditionType::BoundMass:
+				g[i] = cond.unit->boundMass(y + cond.offset, cond.comp) - cond.threshold;
+				break;
+			case StopConditionType::SectionTime:
+				{
+					const unsigned int secIdx = getCurrentSection(t);
+					g[i] = static_cast<double>(toRealTime(t, secIdx)) - static_cast<double>(_sectionTimes[secIdx]) - cond.threshold;
+				}
+				break;
+			}
+		}
+	}
+
+	StopConditionAction Simulator::recordStopConditionHits(double t)
+	{
+		IDAGetRootInfo(_idaMemBlock, _stopRootsFound.data());
+
+		StopConditionAction action = StopConditionAction::NextSection;
+		for (unsigned int i = 0; i < _stopConditions.size(); ++i)
+		{
+			if (_stopRootsFound[i] == 0)
+				continue;
+
+			LOG(Debug) << "Stop condition " << i << " hit at t = " << t;
+			_stopHitTimes.push_back(t);
+			_stopHitIndices.push_back(i);
+
+			if (_stopConditions[i].action == StopConditionAction::Stop)
+				action = StopConditionAction::Stop;
+		}
+
+		return action;
+	}
+
 } // namespace cadet
@@ -28,6 +28,9 @@
 #include "AutoDiff.hpp"
 #include "SlicedVector.hpp"
 #include "common/Timer.hpp"
+#include "AsyncSolutionQueue.hpp"
+#include "AsyncCheckpointQueue.hpp"
+#include "nonlin/AndersonAcceleration.hpp"
 
 namespace cadet
 {
@@ -40,9 +43,21 @@ int residualSensWrapper(int ns, double t, N_Vector y, N_Vector yDot, N_Vector re
 		N_Vector* yS, N_Vector* ySDot, N_Vector* resS,
 		void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 
+int adjointResidualWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, void* userData);
+
+int adjointQuadratureWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector rhsQB, void* userData);
+
+int adjointPrecSetupWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, double cjB,
+	void* userData, N_Vector tmp1B, N_Vector tmp2B, N_Vector tmp3B);
+int adjointPrecSolveWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, N_Vector rhs, N_Vector z,
+	double cjB, double delta, void* userData, N_Vector tmpB);
+
+int stopConditionWrapper(double t, N_Vector y, N_Vector yDot, double* g, void* userData);
+
 //int weightWrapper(N_Vector y, N_Vector ewt, void *user_data);
 
 class ISimulatableModel;
+class IUnitOperation;
 
 /**
  * @brief Provides functionality to simulate a model using a time integrator
@@ -89,14 +104,21 @@ public:
 	virtual void initializeFwdSensitivities(double const * const* const initSens, double const * const* const initSensDot);
 
 	virtual void setSolutionRecorder(ISolutionRecorder* recorder);
+	virtual void setCheckpointWriter(ICheckpointWriter* writer);
+	virtual void setCheckpointInterval(double interval);
+	virtual void resumeFromCheckpoint(double const* data, unsigned int len);
 
 	virtual void integrate();
+	virtual void reintegrate();
 
 	virtual double const* getLastSolution(unsigned int& len) const;
 	virtual double const* getLastSolutionDerivative(unsigned int& len) const;
 
 	virtual const std::vector<double const*> getLastSensitivities(unsigned int& len) const;
 	virtual const std::vector<double const*> getLastSensitivityDerivatives(unsigned int& len) const;
+	virtual double const* getAdjointGradient(unsigned int& len) const;
+	virtual double const* getStopConditionHitTimes(unsigned int& len) const;
+	virtual unsigned int const* getStopConditionHitIndices(unsigned int& len) const;
 
 	virtual void configure(IParameterProvider& paramProvider);
 	virtual void reconfigure(IParameterProvider& paramProvider);
@@ -122,9 +144,21 @@ public:
 
 	virtual unsigned int numDofs() const CADET_NOEXCEPT;
 	virtual void setNumThreads(unsigned int nThreads) CADET_NOEXCEPT;
+	virtual void setAsyncSolutionOutput(unsigned int depth) CADET_NOEXCEPT;
+	virtual void setDenseOutput(bool enabled) CADET_NOEXCEPT;
+	virtual void setCyclicSteadyState(unsigned int maxCycles, double tol, unsigned int andersonDepth);
+	virtual void setAdjointObjective(UnitOpIdx unitOp, const std::vector<double>& weights, const std::vector<double>& time, const std::vector<double>& reference);
+	virtual void clearAdjointObjective();
+	virtual void setAdjointCheckpointSteps(unsigned int steps);
+	virtual void addStopCondition(StopConditionType type, UnitOpIdx unitOp, unsigned int comp, double threshold, int direction, StopConditionAction action);
+	virtual void clearStopConditions();
 
 	virtual double lastSimulationDuration() const CADET_NOEXCEPT { return _lastIntTime; }
 	virtual double totalSimulationDuration() const CADET_NOEXCEPT { return _timerIntegration.totalElapsedTime(); }
+	virtual unsigned int lastNumTimeSteps() const CADET_NOEXCEPT { return _lastNumSteps; }
+	virtual unsigned int lastNumCycles() const CADET_NOEXCEPT { return _lastNumCycles; }
+	virtual double lastCyclicSteadyStateError() const CADET_NOEXCEPT { return _lastCssError; }
+	virtual double lastObjectiveValue() const CADET_NOEXCEPT { return _adjObjective; }
 protected:
 
 	/**
@@ -132,12 +166,177 @@ protected:
 	 */
 	void clearModel() CADET_NOEXCEPT;
 
+	/**
+	 * @brief Runs the time integration from the current state
+	 * @details Implements integrate() and reintegrate() after the initial state has been saved or restored.
+	 */
+	void integrateFromCurrentState();
+
+	/**
+	 * @brief Saves the current state vectors and consistency flags as initial state for reintegrate()
+	 * @details Memory for the saved state is allocated on first use and reused afterwards.
+	 */
+	void saveInitialState();
+
+	/**
+	 * @brief Runs the time integration in cyclic steady state mode from the current state
+	 * @details Repeats the cycle given by the section times without recording the solution
+	 *          until the cyclic steady state is reached. The fixed point iteration is
+	 *          accelerated by Anderson mixing. Finally, one cycle is integrated and recorded.
+	 */
+	void integrateCyclicSteadyState();
+
+	/**
+	 * @brief Copies the current state and forward sensitivity vectors into a contiguous buffer
+	 * @param [out] buffer Buffer of size @c numDofs() times (number of sensitive parameters + 1)
+	 */
+	void packCyclicState(double* const buffer) const;
+
+	/**
+	 * @brief Copies a contiguous buffer into the current state and forward sensitivity vectors
+	 * @param [in] buffer Buffer of size @c numDofs() times (number of sensitive parameters + 1)
+	 */
+	void unpackCyclicState(double const* const buffer);
+
+	/**
+	 * @brief Computes the error weights of the time integrator for the packed state
+	 * @details The weights are computed from the relative and absolute tolerances and the current
+	 *          state and forward sensitivity vectors in the same way as IDAS does.
+	 * @param [out] weight Buffer of size @c numDofs() times (number of sensitive parameters + 1)
+	 */
+	void cyclicStateWeights(double* const weight) const;
+
+	/**
+	 * @brief Integrates the adjoint system backwards in time after the forward integration
+	 * @details The adjoint system is integrated time slice by time slice from the end of the
+	 *          last slice to the beginning of the first one. IDAS only holds the checkpoints of
+	 *          the last forward slice. Hence, the forward integration of all other slices is
+	 *          repeated from their saved consistent initial states before they are integrated
+	 *          backwards. The adjoint state is carried over unchanged at discontinuous section
+	 *          transitions. The gradient of the output functional and its value are obtained
+	 *          from the backward quadratures.
+	 */
+	void integrateAdjointBackward();
+
+	/**
+	 * @brief Evaluates the integrand of the adjoint output functional and adds its scaled state derivative
+	 * @param [in] t Time point in real time
+	 * @param [in] y State vector
+	 * @param [in] factor Factor of the derivative added to @p gradY
+	 * @param [in,out] gradY Vector to which the scaled derivative of the integrand with respect to @p y is added, may be @c nullptr
+	 * @return Value of the integrand
+	 */
+	double adjointObjective(double t, double const* y, double factor, double* gradY) const;
+
+	/**
+	 * @brief Frees memory of the adjoint state and quadrature vectors
+	 */
+	void clearAdjointState() CADET_NOEXCEPT;
+
+	/**
+	 * @brief Returns whether the adjoint sensitivity mode is enabled
+	 * @return @c true if an output functional has been set by setAdjointObjective(), otherwise @c false
+	 */
+	inline bool adjointMode() const CADET_NOEXCEPT { return _adjUnitOp != UnitOpIndep; }
+
+	/**
+	 * @brief Returns the number of forward sensitivity systems that are integrated along with the model
+	 * @details Forward sensitivities are not computed in adjoint mode.
+	 * @return Number of forward sensitivity systems
+	 */
+	inline unsigned int numFwdSensitivities() const CADET_NOEXCEPT { return adjointMode() ? 0 : _sensitiveParams.slices(); }
+
+	/**
+	 * @brief Restores the state vectors and consistency flags saved by saveInitialState()
+	 */
+	void restoreInitialState();
+
+	/**
+	 * @brief Evaluates the root functions of all stop conditions
+	 * @param [in] t Time point in transformed time
+	 * @param [in] y State vector
+	 * @param [out] g Values of the root functions, one per stop condition
+	 */
+	void evaluateStopConditions(double t, double const* y, double* g) const;
+
+	/**
+	 * @brief Records the stop conditions found by IDAS at the given time
+	 * @param [in] t Time point in real time
+	 * @return Action taken for the recorded conditions, StopConditionAction::Stop takes precedence
+	 */
+	StopConditionAction recordStopConditionHits(double t);
+
+	/**
+	 * @brief Frees memory of the saved initial state and invalidates it
+	 */
+	void clearInitialState() CADET_NOEXCEPT;
+
+	/**
+	 * @brief Allocates the vectors that hold solutions interpolated by dense output
+	 * @details Memory is allocated on first use and reused afterwards.
+	 */
+	void prepareDenseOutput();
+
+	/**
+	 * @brief Frees memory of the dense output vectors
+	 */
+	void clearDenseOutput() CADET_NOEXCEPT;
+
+	/**
+	 * @brief Interpolates the solution at time point @p t from the last integrator step and writes it
+	 * @details The time @p t has to lie within the last step taken by the time integrator.
+	 * @param [in] t Time point in transformed time
+	 * @param [in] realT Time point in real time
+	 */
+	void writeDenseSolution(double t, double realT);
+
 	/**
 	 * @brief Writes the solution at time point t
 	 * @param [in] t Current time point
 	 */
 	void writeSolution(double t);
 
+	/**
+	 * @brief Writes the given solution at time point t
+	 * @param [in] t Current time point
+	 * @param [in] y State vector
+	 * @param [in] yDot Time derivative of the state vector
+	 * @param [in] yS Sensitivity vectors
+	 * @param [in] ySdot Time derivatives of the sensitivity vectors
+	 */
+	void writeSolution(double t, N_Vector y, N_Vector yDot, N_Vector* yS, N_Vector* ySdot);
+
+	/**
+	 * @brief Passes the given solution to the solution recorder
+	 * @details Used by writeSolution() for synchronous output and by the consumer thread of
+	 *          @c _asyncOutput for asynchronous output.
+	 * @param [in] t Time point of the solution
+	 * @param [in] y State vector
+	 * @param [in] yDot Time derivative of the state vector
+	 * @param [in] sens Functor returning a pointer to the sensitivity (@c 2i) or its time derivative (@c 2i+1)
+	 *             of the @c i th sensitive parameter
+	 */
+	template <typename SensAccessor_t>
+	void recordSolution(double t, double const* y, double const* yDot, SensAccessor_t sens);
+
+	/**
+	 * @brief Takes a checkpoint of the current state if it is due
+	 * @details The checkpoint is skipped if the previous one is still being written. Only the state
+	 *          of the time integrator is captured here. The solution recorder is serialized by the
+	 *          consumer thread of @c _asyncOutput after it has recorded all preceding solutions.
+	 * @param [in] t Current time point in transformed time
+	 * @param [in] realT Current time point in real time
+	 */
+	void takeCheckpoint(double t, double realT);
+
+	/**
+	 * @brief Restores the state saved by resumeFromCheckpoint() at the beginning of the time integration
+	 * @details Sets the state vectors, the current section, the valve configuration, and the results
+	 *          of the solution recorder. Consistent initialization of the restored state is skipped.
+	 * @return Time point of the checkpoint in transformed time
+	 */
+	double restoreCheckpointState();
+
 	/**
 	 * @brief Computes the index of the next section from the given time @p t
 	 * @details Returns the lowest index @c i with @f$ t_i \geq t @f$, where 
@@ -218,6 +417,13 @@ protected:
 	 */
 	void updateMainErrorTolerances();
 
+	/**
+	 * @brief Expands the absolute error tolerances of the original system to all DOFs of the model
+	 * @details Requires a model to be present.
+	 * @param [out] absTol Buffer of size @c numDofs() that receives the absolute tolerance of each DOF
+	 */
+	void expandMainAbsTol(double* const absTol) const;
+
 	const active timeFactor(unsigned int curSec) const;
 	inline const active timeFactor() const { return timeFactor(_curSec); }
 
@@ -238,6 +444,14 @@ protected:
 			N_Vector* yS, N_Vector* ySDot, N_Vector* resS,
 			void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 
+	friend int ::cadet::adjointResidualWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, void* userData);
+	friend int ::cadet::adjointQuadratureWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector rhsQB, void* userData);
+	friend int ::cadet::adjointPrecSetupWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, double cjB,
+		void* userData, N_Vector tmp1B, N_Vector tmp2B, N_Vector tmp3B);
+	friend int ::cadet::adjointPrecSolveWrapper(double t, N_Vector y, N_Vector yDot, N_Vector yB, N_Vector yBdot, N_Vector resB, N_Vector rhs, N_Vector z,
+		double cjB, double delta, void* userData, N_Vector tmpB);
+	friend int ::cadet::stopConditionWrapper(double t, N_Vector y, N_Vector yDot, double* g, void* userData);
+
 	ISimulatableModel* _model; //!< Simulated model, not owned by the Simulator
 
 	ISolutionRecorder* _solRecorder;
@@ -261,6 +475,27 @@ protected:
 	N_Vector _vecStateYdot; //!< IDAS state vector time derivative
 	N_Vector* _vecFwdYs; //!< IDAS sensitivities vector	
 	N_Vector* _vecFwdYsDot; //!< IDAS sensitivities vector time derivative
+
+	N_Vector _vecInitY; //!< Saved initial state vector for reintegrate()
+	N_Vector _vecInitYdot; //!< Saved initial state vector time derivative for reintegrate()
+	N_Vector* _vecInitYs; //!< Saved initial sensitivities for reintegrate()
+	N_Vector* _vecInitYsDot; //!< Saved initial sensitivity time derivatives for reintegrate()
+	unsigned int _numInitSens; //!< Number of saved initial sensitivities in @c _vecInitYs and @c _vecInitYsDot
+	bool _initStateValid; //!< Determines whether the saved initial state can be used by reintegrate()
+	bool _initSkipConsistencyStateY; //!< Saved value of @c _skipConsistencyStateY
+	bool _initSkipConsistencySensitivity; //!< Saved value of @c _skipConsistencySensitivity
+
+	N_Vector _vecDenseY; //!< State vector interpolated by dense output
+	N_Vector _vecDenseYdot; //!< State vector time derivative interpolated by dense output
+	N_Vector* _vecDenseYs; //!< Sensitivities interpolated by dense output
+	N_Vector* _vecDenseYsDot; //!< Sensitivity time derivatives interpolated by dense output
+	unsigned int _numDenseSens; //!< Number of sensitivities in @c _vecDenseYs and @c _vecDenseYsDot
+
+	std::vector<double const*> _sensYconst; //!< Pointers to the data of the sensitivity vectors passed to residualSensFwd()
+	std::vector<double const*> _sensYdotConst; //!< Pointers to the data of the sensitivity time derivatives passed to residualSensFwd()
+	std::vector<double*> _sensResPtr; //!< Pointers to the data of the sensitivity residuals passed to residualSensFwd()
+	std::vector<double*> _sensYptr; //!< Pointers to the data of @c _vecFwdYs used in consistent initialization
+	std::vector<double*> _sensYdotPtr; //!< Pointers to the data of @c _vecFwdYsDot used in consistent initialization
 	util::SlicedVector<ParameterId> _sensitiveParams; //!< Stores (fused) sensitive parameters
 	std::vector<double> _sensitiveParamsFactor; //!< Stores the factors of the linear sensitive parameter combinations
 	std::vector<active> _sectionTimes; //!< Stores the AD variables used for SECTION_TIMES parameter derivatives
@@ -275,6 +510,11 @@ protected:
 	unsigned int _maxSteps; //!< Maximum number of time integration steps
 	double _maxStepSize; //!< Maximum time step size
 	unsigned int _nThreads; //!< Maximum number of threads CADET is allowed to use 0, disables maximum setting
+	bool _denseOutput; //!< Determines whether solutions at user specified times are interpolated from internal integrator steps
+	unsigned int _asyncOutputDepth; //!< Maximum number of pending solution snapshots of asynchronous output, 0 disables asynchronous output
+
+	unsigned int _recordedFields; //!< RecordedField flags of all unit operations requested by the solution recorder
+	AsyncSolutionQueue _asyncOutput; //!< Hands solution snapshots over to a thread that invokes the solution recorder
 
 	SectionIdx _curSec; //!< Index of the current section
 
@@ -289,6 +529,63 @@ protected:
 
 	Timer _timerIntegration; //!< Timer measuring the duration of the call to integrate()
 	double _lastIntTime; //!< Last simulation duration
+	unsigned int _lastNumSteps; //!< Number of integrator steps of the last simulation
+
+	unsigned int _cssMaxCycles; //!< Maximum number of cycles in cyclic steady state mode (@c 0 disables the mode)
+	double _cssTol; //!< Tolerance for the weighted change of the state over one cycle
+	unsigned int _cssAndersonDepth; //!< Number of previous cycles used for Anderson acceleration
+	nonlin::AndersonAcceleration _cssAccel; //!< Accelerates the fixed point iteration over cycles
+	std::vector<double> _cssIterate; //!< Packed state and sensitivities at the beginning of the current cycle
+	std::vector<double> _cssImage; //!< Packed state and sensitivities at the end of the current cycle
+	std::vector<double> _cssWeight; //!< Error weights of the packed state and sensitivities
+	unsigned int _lastNumCycles; //!< Number of cycles required to reach the cyclic steady state in the last simulation
+	double _lastCssError; //!< Weighted change of the state over the last cycle of the last simulation
+
+	UnitOpIdx _adjUnitOp; //!< Unit operation whose outlet enters the adjoint output functional, @c UnitOpIndep disables the adjoint mode
+	std::vector<double> _adjWeights; //!< Weights of the components in the output functional
+	std::vector<double> _adjTime; //!< Time points of the reference in the output functional
+	std::vector<double> _adjReference; //!< Reference concentrations in time-major order
+	unsigned int _adjOutletOffset; //!< Index of the first outlet component of the unit operation in the global state vector
+	unsigned int _adjOutletStride; //!< Stride between the outlet components in the global state vector
+	bool _adjMemInitialized; //!< Determines whether the adjoint module of IDAS has been initialized
+	unsigned int _adjCheckpointSteps; //!< Number of integration steps between two checkpoints of the forward solution in adjoint mode
+	double _adjPrecAlpha; //!< Value of alpha the preconditioner of the adjoint system has been set up with
+	int _adjWhich; //!< Identifier of the backward problem in IDAS, negative if it has not been created yet
+	std::vector<double> _adjSliceStart; //!< Transformed start times of the time slices of the forward integration
+	std::vector<double> _adjSliceEnd; //!< Transformed end times of the time slices of the forward integration
+	std::vector<unsigned int> _adjSliceSection; //!< Index of the first section of each time slice
+	std::vector<double> _adjSliceState; //!< Consistent state and time derivative at the beginning of each time slice
+	std::vector<double> _adjTemp; //!< Temporary storage in the size of the state vector used by the adjoint residual
+	N_Vector _vecAdjY; //!< IDAS adjoint state vector
+	N_Vector _vecAdjYdot; //!< IDAS adjoint state vector time derivative
+	N_Vector _vecAdjQuad; //!< IDAS backward quadratures (gradient followed by the value of the output functional)
+	std::vector<double> _adjGradient; //!< Gradient of the output functional of the last simulation
+	double _adjObjective; //!< Value of the output functional of the last simulation
+
+	ICheckpointWriter* _checkpointWriter; //!< Receives checkpoints of the state, not owned by the Simulator
+	double _checkpointInterval; //!< Minimum simulation time between two checkpoints, @c 0 disables checkpoints
+	double _nextCheckpoint; //!< Simulation time from which on the next checkpoint is taken
+	AsyncCheckpointQueue _asyncCheckpoint; //!< Hands checkpoints over to a thread that invokes the checkpoint writer
+	std::vector<double> _resumeState; //!< Checkpoint the next time integration is resumed from, empty if there is none
+
+	/**
+	 * @brief Condition that ends the time integration or the current section when its root function crosses zero
+	 */
+	struct StopCondition
+	{
+		StopConditionType type; //!< Monitored quantity
+		StopConditionAction action; //!< Action taken when the condition is hit
+		double threshold; //!< Value of the monitored quantity at which the condition is hit
+		IUnitOperation const* unit; //!< Monitored unit operation, @c nullptr for section time conditions
+		unsigned int offset; //!< Index of the first DOF of the monitored unit operation in the global state vector
+		unsigned int comp; //!< Index of the monitored component
+	};
+
+	std::vector<StopCondition> _stopConditions; //!< Stop conditions registered as root functions with IDAS
+	std::vector<int> _stopDirection; //!< Direction of the zero crossing of each stop condition as required by IDAS
+	std::vector<int> _stopRootsFound; //!< Stop conditions whose root function has crossed zero in the last step
+	std::vector<double> _stopHitTimes; //!< Times at which stop conditions have been hit in the last simulation
+	std::vector<unsigned int> _stopHitIndices; //!< Indices of the stop conditions hit at the corresponding element of _stopHitTimes
 };
 
 } // namespace cadet
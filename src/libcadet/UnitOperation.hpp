@@ -539,6 +539,15 @@ public:
 	*/
 	virtual bool canAccumulate() const CADET_NOEXCEPT = 0;
 
+	/**
+	 * @brief Computes the total amount of a component bound in this unit operation
+	 * @details Sums over all bound states of the component. Unit operations without a solid phase return @c 0.
+	 * @param [in] y Slice of the state vector managed by this unit operation
+	 * @param [in] comp Index of the component
+	 * @return Total amount of the component in the solid phase
+	 */
+	virtual double boundMass(double const* const y, unsigned int comp) const = 0;
+
 	/**
 	 * @brief Multiplies the given vector with the system Jacobian (i.e., @f$ \frac{\partial F}{\partial y} @f$)
 	 * @details Actually, the operation @f$ z = \alpha \frac{\partial F}{\partial y} x + \beta z @f$ is performed.
@@ -558,6 +567,51 @@ public:
 	 * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
 	 */
 	virtual void multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor) = 0;
+
+	/**
+	 * @brief Multiplies the given vector with the transposed system Jacobian (i.e., @f$ \left(\frac{\partial F}{\partial y}\right)^T @f$)
+	 * @details Actually, the operation @f$ z = \alpha \left(\frac{\partial F}{\partial y}\right)^T x + \beta z @f$ is performed.
+	 *          The Jacobian has to be up to date (see residualWithJacobian()).
+	 * @param [in] yS Vector @f$ x @f$ that is transformed by the transposed Jacobian
+	 * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ \left(\frac{\partial F}{\partial y}\right)^T @f$
+	 * @param [in] beta Factor @f$ \beta @f$ in front of @f$ z @f$
+	 * @param [in,out] ret Vector @f$ z @f$ which stores the result of the operation
+	 */
+	virtual void multiplyWithJacobianTransposed(double const* yS, double alpha, double beta, double* ret) = 0;
+
+	/**
+	 * @brief Multiplies the transposed time derivative Jacobian @f$ \left(\frac{\partial F}{\partial \dot{y}}\right)^T @f$ with a given vector
+	 * @details The operation @f$ z = \left(\frac{\partial F}{\partial \dot{y}}\right)^T x @f$ is performed.
+	 *          The matrix-vector multiplication is transformed matrix-free (i.e., no matrix is explicitly formed).
+	 * @param [in] sDot Vector @f$ x @f$ that is transformed by the transposed Jacobian
+	 * @param [out] ret Vector @f$ z @f$ which stores the result of the operation
+	 * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+	 */
+	virtual void multiplyWithDerivativeJacobianTransposed(double const* sDot, double* ret, double timeFactor) = 0;
+
+	/**
+	 * @brief Computes the solution of the linear system involving the transposed system Jacobian
+	 * @details The system \f[ \left( \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} \right)^T x = b \f]
+	 *          has to be solved, which arises in the backward integration of the adjoint system. The Jacobian has to be
+	 *          up to date (see residualSensFwdWithJacobian()). The solution is returned in @p rhs.
+	 *
+	 *          The factorization is reused until @p alpha changes or invalidateTransposedFactorization() is called.
+	 *
+	 * @param [in] t Current time point
+	 * @param [in] timeFactor Used for time transformation (pre factor of time derivatives) and to compute parameter derivatives with respect to section length
+	 * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+	 * @param [in] tol Error tolerance for the solution of the linear system from outer Newton iteration
+	 * @param [in,out] rhs On entry the right hand side of the linear equation system, on exit the solution
+	 * @param [in] weight Vector with error weights
+	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+	 */
+	virtual int linearSolveTransposed(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight) = 0;
+
+	/**
+	 * @brief Marks the factorization used by linearSolveTransposed() as outdated
+	 * @details The next call to linearSolveTransposed() factorizes the current Jacobian again.
+	 */
+	virtual void invalidateTransposedFactorization() = 0;
 };
 
 } // namespace cadet
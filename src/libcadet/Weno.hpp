@@ -55,7 +55,7 @@ public:
 	/**
 	 * @brief Creates the WENO scheme
 	 */
-	Weno() : _order(maxOrder()), _boundaryTreatment(BoundaryTreatment::ReduceOrder), _intermediateValues(3 * maxOrder() * sizeof(active)) { }
+	Weno() : _order(maxOrder()), _boundaryTreatment(BoundaryTreatment::ReduceOrder), _intermediateValues(workspaceSize()) { }
 
 	/**
 	 * @brief Returns the maximum order \f$ r \f$ of the implemented schemes
@@ -69,6 +69,12 @@ public:
 	 */
 	CADET_CONSTEXPR static inline unsigned int maxStencilSize() CADET_NOEXCEPT { return 2 * maxOrder() - 1; }
 
+	/**
+	 * @brief Returns the size of the workspace required by reconstruct() in bytes
+	 * @return Size of the workspace in bytes
+	 */
+	CADET_CONSTEXPR static inline unsigned int workspaceSize() CADET_NOEXCEPT { return 3 * maxOrder() * sizeof(active); }
+
 	/**
 	 * @brief Reconstructs a cell face value from volume averages
 	 * @param [in] epsilon \f$ \varepsilon \f$ of the WENO emthod (prevents division by zero in the weights) 
@@ -85,7 +91,7 @@ public:
 	template <typename StateType, typename StencilType>
 	int reconstruct(double epsilon, unsigned int cellIdx, unsigned int numCells, const StencilType& w, StateType& result, double* const Dvm)
 	{
-		return reconstruct<StateType, StencilType, true>(epsilon, cellIdx, numCells, w, result, Dvm);
+		return reconstruct<StateType, StencilType, true>(epsilon, cellIdx, numCells, w, result, Dvm, _intermediateValues);
 	}
 
 	/**
@@ -103,7 +109,50 @@ public:
 	template <typename StateType, typename StencilType>
 	int reconstruct(double epsilon, unsigned int cellIdx, unsigned int numCells, const StencilType& w, StateType& result)
 	{
-		return reconstruct<StateType, StencilType, false>(epsilon, cellIdx, numCells, w, result, nullptr);
+		return reconstruct<StateType, StencilType, false>(epsilon, cellIdx, numCells, w, result, nullptr, _intermediateValues);
+	}
+
+	/**
+	 * @brief Reconstructs a cell face value from volume averages using the given workspace
+	 * @details In contrast to the other overloads, the WENO object is not modified. Hence, this function
+	 *          can be called concurrently as long as each thread provides its own workspace.
+	 * @param [in] epsilon \f$ \varepsilon \f$ of the WENO emthod (prevents division by zero in the weights) 
+	 * @param [in] cellIdx Index of the current cell
+	 * @param [in] numCells Number of cells
+	 * @param [in] w Stencil that contains the \f$ 2r-1 \f$ volume averages from which the cell face values are reconstructed centered at the 
+	 *               current cell (i.e., index 0 is the current cell, -2 the next to previous cell, 2 the next but one cell)
+	 * @param [out] result Reconstructed cell face value
+	 * @param [out] Dvm Gradient of the reconstructed cell face value (array has to be of size \f$ 2r-1\f$ where \f$ r \f$ is the WENO order)
+	 * @param [in,out] workspace Memory for intermediate values of at least workspaceSize() bytes
+	 * @tparam StateType Type of the state variables
+	 * @tparam StencilType Type of the stencil (can be a dedicated class with overloaded operator[] or a simple pointer)
+	 * @return Order of the WENO scheme that was used in the computation
+	 */
+	template <typename StateType, typename StencilType>
+	int reconstruct(double epsilon, unsigned int cellIdx, unsigned int numCells, const StencilType& w, StateType& result, double* const Dvm, ArrayPool& workspace) const
+	{
+		return reconstruct<StateType, StencilType, true>(epsilon, cellIdx, numCells, w, result, Dvm, workspace);
+	}
+
+	/**
+	 * @brief Reconstructs a cell face value from volume averages using the given workspace
+	 * @details In contrast to the other overloads, the WENO object is not modified. Hence, this function
+	 *          can be called concurrently as long as each thread provides its own workspace.
+	 * @param [in] epsilon \f$ \varepsilon \f$ of the WENO emthod (prevents division by zero in the weights) 
+	 * @param [in] cellIdx Index of the current cell
+	 * @param [in] numCells Number of cells
+	 * @param [in] w Stencil that contains the \f$ 2r-1 \f$ volume averages from which the cell face values are reconstructed centered at the 
+	 *               current cell (i.e., index 0 is the current cell, -2 the next to previous cell, 2 the next but one cell)
+	 * @param [out] result Reconstructed cell face value
+	 * @param [in,out] workspace Memory for intermediate values of at least workspaceSize() bytes
+	 * @tparam StateType Type of the state variables
+	 * @tparam StencilType Type of the stencil (can be a dedicated class with overloaded operator[] or a simple pointer)
+	 * @return Order of the WENO scheme that was used in the computation
+	 */
+	template <typename StateType, typename StencilType>
+	int reconstruct(double epsilon, unsigned int cellIdx, unsigned int numCells, const StencilType& w, StateType& result, ArrayPool& workspace) const
+	{
+		return reconstruct<StateType, StencilType, false>(epsilon, cellIdx, numCells, w, result, nullptr, workspace);
 	}
 
 	/**
@@ -190,11 +239,12 @@ private:
 	 * @param [out] Dvm Gradient of the reconstructed cell face value (array has to be of size \f$ 2r-1\f$ where \f$ r \f$ is the WENO order)
 	 * @tparam StateType Type of the state variables
 	 * @tparam StencilType Type of the stencil (can be a dedicated class with overloaded operator[] or a simple pointer)
+	 * @param [in,out] workspace Memory for intermediate values
 	 * @tparam wantJac Determines if the gradient is computed (@c true) or not (@c false)
 	 * @return Order of the WENO scheme that was used in the computation
 	 */
 	template <typename StateType, typename StencilType, bool wantJac>
-	int reconstruct(double epsilon, unsigned int cellIdx, unsigned int numCells, const StencilType& w, StateType& result, double* const Dvm)
+	int reconstruct(double epsilon, unsigned int cellIdx, unsigned int numCells, const StencilType& w, StateType& result, double* const Dvm, ArrayPool& workspace) const
 	{
 #if defined(ACTIVE_SETFAD) || defined(ACTIVE_SFAD)
 		using cadet::sqr;
@@ -267,7 +317,7 @@ private:
 		}
 
 		// Allocate memory for intermediate values: beta, alpha (= omega), and vr
-		StateType* const work = _intermediateValues.create<StateType>(3 * order);
+		StateType* const work = workspace.create<StateType>(3 * order);
 		StateType* const beta  = work;
 		StateType* const alpha = work + order;
 		StateType* const omega = work + order;
@@ -376,7 +426,7 @@ private:
 					Dvm[order - 1 + j - r] += static_cast<double>(omega[r]) * c[r + order * j];
 		}
 
-		_intermediateValues.destroy<StateType>();
+		workspace.destroy<StateType>();
 		return order;
 	}
 
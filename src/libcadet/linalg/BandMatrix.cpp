@@ -27,7 +27,7 @@ namespace
 {
 
 void bandMatrixVectorMultiplication(unsigned int rows, unsigned int upperBand, unsigned int lowerBand, unsigned int stride,
-	double const* const data, double alpha, double beta, double const* const x, double* const y)
+	double const* const data, double alpha, double beta, double const* const x, double* const y, bool transposed = false)
 {
 	// Since LAPACK uses column-major storage and we use row-major,
 	// we actually have constructed the transposed matrix. Thus,
@@ -40,7 +40,10 @@ void bandMatrixVectorMultiplication(unsigned int rows, unsigned int upperBand, u
 
 	// For LAPACK the matrix looks like it's transposed. We, thus,
 	// multiply with the transposed matrix, which in the end uses the original matrix.
+	// Conversely, the original LAPACK matrix is the transpose of our matrix.
 	char trans[] = "T";
+	if (transposed)
+		trans[0] = 'N';
 
 	// LAPACK computes y <- alpha * A * x + beta * y
 	LapackMultiplyDenseBanded(trans, &n, &n, &kl, &ku, &alpha, const_cast<double*>(data), &ldab, const_cast<double*>(x), &inc, &beta, const_cast<double*>(y), &inc);
@@ -97,6 +100,11 @@ void BandMatrix::multiplyVector(const double* const x, double alpha, double beta
 	bandMatrixVectorMultiplication(_rows, _upperBand, _lowerBand, stride(), _data, alpha, beta, x, y);
 }
 
+void BandMatrix::transposedMultiplyVector(const double* const x, double alpha, double beta, double* const y) const
+{
+	bandMatrixVectorMultiplication(_rows, _upperBand, _lowerBand, stride(), _data, alpha, beta, x, y, true);
+}
+
 void BandMatrix::submatrixMultiplyVector(const double* const x, unsigned int startRow, int startDiag, 
 		unsigned int numRows, unsigned int numCols, double alpha, double beta, double* const y) const
 {
@@ -190,6 +198,11 @@ bool FactorizableBandMatrix::factorize()
 }
 
 bool FactorizableBandMatrix::solve(double* rhs) const
+{
+	return solve(rhs, 1);
+}
+
+bool FactorizableBandMatrix::solve(double* rhs, unsigned int nRhs) const
 {
 	// Since LAPACK uses column-major storage and we use row-major,
 	// we actually have constructed the transposed matrix. Thus,
@@ -197,7 +210,7 @@ bool FactorizableBandMatrix::solve(double* rhs) const
 	lapackInt_t n = _rows;
 	lapackInt_t kl = _upperBand;
 	lapackInt_t ku = _lowerBand;
-	lapackInt_t nrhs = 1;
+	lapackInt_t nrhs = nRhs;
 	lapackInt_t ldab = stride();
 	lapackInt_t flag = 0;
 
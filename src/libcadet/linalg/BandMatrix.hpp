@@ -828,6 +828,16 @@ public:
 	 */
 	void multiplyVector(const double* const x, double alpha, double beta, double* const y) const;
 
+	/**
+	 * @brief Multiplies the transpose of the matrix @f$ A @f$ with a given vector @f$ x @f$ and adds it to another vector using LAPACK
+	 * @details Computes @f$ y = \alpha A^T x + \beta y@f$, where @f$ A @f$ is this matrix and @f$ x @f$ is given.
+	 * @param [in] x Vector the transposed matrix is multiplied with
+	 * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ A^T x @f$
+	 * @param [in] beta Factor @f$ \beta @f$ in front of @f$ y @f$
+	 * @param [out] y Result of the matrix-vector multiplication
+	 */
+	void transposedMultiplyVector(const double* const x, double alpha, double beta, double* const y) const;
+
 protected:
 	double* _data; //!< Pointer to the array in which the matrix is stored
 	unsigned int _lowerBand; //!< Lower bandwidth excluding main diagonal
@@ -1226,6 +1236,18 @@ public:
 	 */
 	bool solve(double* rhs) const;
 
+	/**
+	 * @brief Uses the factorized matrix to solve the equation @f$ AX = B @f$ with multiple right hand sides with LAPACK
+	 * @details Before the equation can be solved, the matrix has to be factorized first by calling factorize().
+	 *          The right hand sides are stored consecutively, that is, column @f$ k @f$ of @f$ B @f$ starts
+	 *          at @c rhs + k * rows(). All right hand sides are processed by a single LAPACK call, which
+	 *          traverses the factors only once.
+	 * @param [in,out] rhs On entry pointer to the right hand side vectors @f$ B @f$ of the equation, on exit the solutions @f$ X @f$
+	 * @param [in] nRhs Number of right hand sides
+	 * @return @c true if the solution process was successful, otherwise @c false
+	 */
+	bool solve(double* rhs, unsigned int nRhs) const;
+
 protected:
 	double* _data; //!< Pointer to the array in which the matrix is stored
 	unsigned int _lowerBand; //!< Lower bandwidth excluding main diagonal
@@ -168,13 +168,18 @@ bool DenseMatrixBase::factorize()
 }
 
 bool DenseMatrixBase::solve(double* rhs) const
+{
+	return solve(rhs, 1);
+}
+
+bool DenseMatrixBase::solve(double* rhs, unsigned int nRhs) const
 {
 	cadet_assert(_rows == _cols);
 
 	// Since LAPACK uses column-major storage and we use row-major,
 	// we actually have constructed the transposed matrix.
 	lapackInt_t n = _rows;
-	lapackInt_t nrhs = 1;
+	lapackInt_t nrhs = nRhs;
 	lapackInt_t lda = stride();
 	lapackInt_t flag = 0;
 
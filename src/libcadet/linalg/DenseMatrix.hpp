@@ -512,6 +512,17 @@ namespace detail
 		 */
 		bool solve(double* rhs) const;
 
+		/**
+		 * @brief Uses the factorized matrix to solve the equation @f$ AX = Y @f$ with multiple right hand sides with LAPACK
+		 * @details Before the equation can be solved, the matrix has to be factorized first by calling factorize().
+		 *          The right hand sides are stored consecutively, that is, column @f$ k @f$ of @f$ Y @f$ starts
+		 *          at @c rhs + k * rows().
+		 * @param [in,out] rhs On entry pointer to the right hand side vectors @f$ Y @f$ of the equation, on exit the solutions @f$ X @f$
+		 * @param [in] nRhs Number of right hand sides
+		 * @return @c true if the solution process was successful, otherwise @c false
+		 */
+		bool solve(double* rhs, unsigned int nRhs) const;
+
 		/**
 		 * @brief Returns the optimal working memory size for solving @f$ \text{min}_x \lVert Ax - y \rVert @f$ with LAPACK
 		 * @details LAPACK requires at least @f$ 2 mn @f$ doubles, where @f$ m @f$ is the number of rows and @f$ n @f$ the number of columns.
@@ -28,18 +28,43 @@ namespace linalg
 int gmresCallback(void* userData, N_Vector v, N_Vector z)
 {
 	Gmres* const g = static_cast<Gmres*>(userData);
-	Gmres::MatrixVectorMultFun callback = g->matrixVectorMultiplier();
+	const Gmres::MatrixVectorMultFun& callback = g->matrixVectorMultiplier();
 	return callback(g->userData(), NVEC_DATA(v), NVEC_DATA(z));
 }
 
-Gmres::Gmres() CADET_NOEXCEPT : _mem(nullptr), _ortho(Orthogonalization::ModifiedGramSchmidt), _maxRestarts(0), _matrixSize(0), _matVecMul(nullptr), _userData(nullptr)
+// Wrapper function that calls the user preconditioner with the supplied user data
+int gmresPrecondCallback(void* userData, N_Vector r, N_Vector z, int lr)
+{
+	Gmres* const g = static_cast<Gmres*>(userData);
+	const Gmres::PreconditionerFun& callback = g->preconditioner();
+	return callback(g->userData(), NVEC_DATA(r), NVEC_DATA(z));
+}
+
+Gmres::Gmres() CADET_NOEXCEPT : _mem(nullptr), _ortho(Orthogonalization::ModifiedGramSchmidt), _maxRestarts(0), _matrixSize(0), _matVecMul(nullptr), 
+	_precond(nullptr), _userData(nullptr), _numIter(0), _totalIter(0), _nvSol(nullptr), _nvWeight(nullptr), _nvRhs(nullptr)
 {
 }
 
 Gmres::~Gmres() CADET_NOEXCEPT
+{
+	freeMemory();
+}
+
+void Gmres::freeMemory() CADET_NOEXCEPT
 {
 	if (_mem)
 		SpgmrFree(_mem);
+	_mem = nullptr;
+
+	if (_nvSol)
+	{
+		NVec_Destroy(_nvRhs);
+		NVec_Destroy(_nvWeight);
+		NVec_Destroy(_nvSol);
+		_nvSol = nullptr;
+		_nvWeight = nullptr;
+		_nvRhs = nullptr;
+	}
 }
 
 void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov)
@@ -49,6 +74,8 @@ void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov)
 
 void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov, Orthogonalization om, unsigned int maxRestarts)
 {
+	freeMemory();
+
 	_matrixSize = matrixSize;
 	if (maxKrylov == 0)
 		maxKrylov = _matrixSize;
@@ -64,20 +91,26 @@ void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov, Orthogon
 	_mem = SpgmrMalloc(maxKrylov, NV_tmpl);
 
 	NVec_Destroy(NV_tmpl);
+
+	// Create empty vectors whose data pointers are bent to the arguments of solve(),
+	// which avoids allocating memory in each call
+	_nvSol = NVec_NewEmpty(_matrixSize);
+	_nvWeight = NVec_NewEmpty(_matrixSize);
+	_nvRhs = NVec_NewEmpty(_matrixSize);
 }
 
 int Gmres::solve(double tolerance, double const* weight, double const* rhs, double* sol)
 {
-	// Create init-guess/solution vector by bending pointer
-	N_Vector NV_sol = NVec_NewEmpty(_matrixSize);
+	// Init-guess/solution vector by bending pointer
+	N_Vector NV_sol = _nvSol;
 	NVEC_DATA(NV_sol) = sol;
 
-	// Create weight vector by bending pointer
-	N_Vector NV_weight = NVec_NewEmpty(_matrixSize);
+	// Weight vector by bending pointer
+	N_Vector NV_weight = _nvWeight;
 	NVEC_DATA(NV_weight) = const_cast<double*>(weight);
 
-	// Create right hand side vector by pointer bending
-	N_Vector NV_rhs = NVec_NewEmpty(_matrixSize);
+	// Right hand side vector by pointer bending
+	N_Vector NV_rhs = _nvRhs;
 	NVEC_DATA(NV_rhs) = const_cast<double*>(rhs);
 
 //	double tolerance = _cc.sqrt_neq() * IDA_mem->ida_epsNewt * _schurSafety;
@@ -88,14 +121,12 @@ int Gmres::solve(double tolerance, double const* weight, double const* rhs, doub
 	double resNorm = -1.0;
 
 	const int flag = SpgmrSolve(_mem, this, NV_sol, NV_rhs,
-			PREC_NONE, gsType, tolerance, _maxRestarts, NULL,
-			NV_weight, NV_weight, &gmresCallback, NULL, 
+			_precond ? PREC_RIGHT : PREC_NONE, gsType, tolerance, _maxRestarts, this,
+			NV_weight, NV_weight, &gmresCallback, _precond ? &gmresPrecondCallback : NULL, 
 			&resNorm, &nIter, &nPrecondSolve);
 
-	// Free NVector memory space
-	NVec_Destroy(NV_rhs);
-	NVec_Destroy(NV_weight);
-	NVec_Destroy(NV_sol);
+	_numIter = nIter;
+	_totalIter += nIter;
 
 	return flag;
 }
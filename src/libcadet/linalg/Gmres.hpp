@@ -25,6 +25,7 @@
 
 // Forward declare SUNDIALS types
 typedef struct _SpgmrMemRec SpgmrMemRec;
+struct _generic_N_Vector;
 
 namespace cadet
 {
@@ -77,6 +78,18 @@ public:
  	 */
 	typedef std::function<int(void* userData, double const* x, double* z)> MatrixVectorMultFun;
 
+	/**
+ 	 * @brief Prototype of preconditioner function provided to GMRES algorithm
+ 	 * @details Approximately solves @f$ Pz = r @f$, where @f$ P \approx A @f$ is the preconditioner.
+ 	 *          The preconditioner is applied from the right.
+ 	 * 
+ 	 * @param [in] userData User data
+ 	 * @param [in] r Right hand side of the preconditioner system
+ 	 * @param [out] z Solution of the preconditioner system (memory is provided by the caller)
+ 	 * @return @c 0 if successful, a positive value on recoverable error, and a negative value on failure
+ 	 */
+	typedef std::function<int(void* userData, double const* r, double* z)> PreconditionerFun;
+
 	Gmres() CADET_NOEXCEPT;
 	~Gmres() CADET_NOEXCEPT;
 
@@ -139,7 +152,7 @@ public:
 	 * @brief Returns the matrix-vector multiplication function
 	 * @return Matrix-vector multiplication function
 	 */
-	inline MatrixVectorMultFun matrixVectorMultiplier() const CADET_NOEXCEPT { return _matVecMul; }
+	inline const MatrixVectorMultFun& matrixVectorMultiplier() const CADET_NOEXCEPT { return _matVecMul; }
 	/**
 	 * @brief Sets the matrix-vector multiplication function
 	 * @param [in] mvm Matrix-vector multiplication function
@@ -156,6 +169,31 @@ public:
 		_userData = ud;
 	}
 
+	/**
+	 * @brief Returns the preconditioner function
+	 * @return Preconditioner function or @c nullptr if no preconditioner is used
+	 */
+	inline const PreconditionerFun& preconditioner() const CADET_NOEXCEPT { return _precond; }
+
+	/**
+	 * @brief Sets the preconditioner function
+	 * @details Passing @c nullptr disables preconditioning.
+	 * @param [in] pf Preconditioner function
+	 */
+	inline void preconditioner(PreconditionerFun pf) CADET_NOEXCEPT { _precond = pf; }
+
+	/**
+	 * @brief Returns the number of iterations performed in the last call to solve()
+	 * @return Number of iterations of the last solve
+	 */
+	inline unsigned int numIterations() const CADET_NOEXCEPT { return _numIter; }
+
+	/**
+	 * @brief Returns the total number of iterations performed in all calls to solve()
+	 * @return Total number of iterations
+	 */
+	inline unsigned int totalIterations() const CADET_NOEXCEPT { return _totalIter; }
+
 	/**
 	 * @brief Returns the user data passed to the matrix-vector multiplication function
 	 * @return User data
@@ -180,7 +218,15 @@ protected:
 	unsigned int _maxRestarts; //!< Maximum number of restarts
 	unsigned int _matrixSize; //!< Size of the square matrix
 	MatrixVectorMultFun _matVecMul; //!< Matrix-vector multiplication function required for GMRES algorithm
+	PreconditionerFun _precond; //!< Optional preconditioner function
 	void* _userData; //!< User data for matrix-vector multiplication function
+	unsigned int _numIter; //!< Number of iterations in last solve
+	unsigned int _totalIter; //!< Total number of iterations in all solves
+	_generic_N_Vector* _nvSol; //!< Empty N_Vector pointing to the solution vector in solve()
+	_generic_N_Vector* _nvWeight; //!< Empty N_Vector pointing to the weight vector in solve()
+	_generic_N_Vector* _nvRhs; //!< Empty N_Vector pointing to the right hand side vector in solve()
+
+	void freeMemory() CADET_NOEXCEPT;
 };
 
 } // namespace linalg
@@ -0,0 +1,516 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "linalg/SparseDirectSolver.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <utility>
+#include <cmath>
+
+namespace cadet
+{
+
+namespace linalg
+{
+
+namespace
+{
+	const unsigned int noPivot = std::numeric_limits<unsigned int>::max();
+}
+
+void SparseDirectSolver::clear() CADET_NOEXCEPT
+{
+	_rows = 0;
+	_factorized = false;
+	_numFactorNonZero = 0;
+	_numOffDiagPivots = 0;
+	_perm.clear();
+	_pivot.clear();
+	_matColStart.clear();
+	_matRows.clear();
+	_matValues.clear();
+	_matToCsc.clear();
+	_lColStart.clear();
+	_lRows.clear();
+	_lValues.clear();
+	_uColStart.clear();
+	_uRows.clear();
+	_uValues.clear();
+	_work.clear();
+	_rhs.clear();
+	_res.clear();
+	_reach.clear();
+	_stack.clear();
+	_stackPos.clear();
+	_mark.clear();
+}
+
+void SparseDirectSolver::minimumDegreeOrdering(const CompressedSparseMatrix& mat, std::vector<std::vector<unsigned int>>& elimNeighbors)
+{
+	const unsigned int n = mat.rows();
+	const std::vector<unsigned int>& rowStart = mat.rowStart();
+	const std::vector<unsigned int>& cols = mat.columns();
+
+	// Build adjacency graph of A + A^T without self loops
+	std::vector<std::vector<unsigned int>> adj(n);
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		for (unsigned int idx = rowStart[i]; idx < rowStart[i + 1]; ++idx)
+		{
+			const unsigned int j = cols[idx];
+			if (i == j)
+				continue;
+
+			adj[i].push_back(j);
+			adj[j].push_back(i);
+		}
+	}
+
+	// Nodes ordered by degree, ties are broken by index
+	std::set<std::pair<unsigned int, unsigned int>> queue;
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		std::sort(adj[i].begin(), adj[i].end());
+		adj[i].erase(std::unique(adj[i].begin(), adj[i].end()), adj[i].end());
+		queue.insert(std::make_pair(static_cast<unsigned int>(adj[i].size()), i));
+	}
+
+	_perm.resize(n);
+	elimNeighbors.clear();
+	elimNeighbors.resize(n);
+
+	// Eliminate nodes in order of minimum degree and update the elimination graph
+	std::vector<unsigned int> merged;
+	for (unsigned int k = 0; k < n; ++k)
+	{
+		const unsigned int p = queue.begin()->second;
+		queue.erase(queue.begin());
+		_perm[k] = p;
+
+		// Neighbors of p form a clique after its elimination
+		std::vector<unsigned int>& nbrs = adj[p];
+		for (unsigned int u : nbrs)
+		{
+			std::vector<unsigned int>& adjU = adj[u];
+			queue.erase(std::make_pair(static_cast<unsigned int>(adjU.size()), u));
+
+			merged.clear();
+			std::set_union(adjU.begin(), adjU.end(), nbrs.begin(), nbrs.end(), std::back_inserter(merged));
+			merged.erase(std::remove_if(merged.begin(), merged.end(), [=](unsigned int v) { return (v == u) || (v == p); }), merged.end());
+			adjU.swap(merged);
+
+			queue.insert(std::make_pair(static_cast<unsigned int>(adjU.size()), u));
+		}
+
+		elimNeighbors[k].swap(nbrs);
+	}
+}
+
+void SparseDirectSolver::analyzePattern(const CompressedSparseMatrix& mat)
+{
+	clear();
+
+	const unsigned int n = mat.rows();
+	if (n == 0)
+		return;
+
+	// Fill-reducing column ordering, the elimination neighbors predict the fill-in without pivoting
+	std::vector<std::vector<unsigned int>> elimNeighbors;
+	minimumDegreeOrdering(mat, elimNeighbors);
+
+	unsigned int numOffDiag = 0;
+	for (unsigned int k = 0; k < n; ++k)
+		numOffDiag += elimNeighbors[k].size();
+
+	_numFactorNonZero = 2 * numOffDiag + n;
+
+	// Column-compressed copy of the pattern and the location of each element of the row-compressed matrix in it
+	const std::vector<unsigned int>& rowStart = mat.rowStart();
+	const std::vector<unsigned int>& cols = mat.columns();
+
+	_matColStart.assign(n + 1, 0);
+	for (unsigned int idx = 0; idx < mat.numNonZero(); ++idx)
+		++_matColStart[cols[idx] + 1];
+
+	for (unsigned int j = 0; j < n; ++j)
+		_matColStart[j + 1] += _matColStart[j];
+
+	_matRows.resize(mat.numNonZero());
+	_matToCsc.resize(mat.numNonZero());
+	std::vector<unsigned int> pos(_matColStart.begin(), _matColStart.end() - 1);
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		for (unsigned int idx = rowStart[i]; idx < rowStart[i + 1]; ++idx)
+		{
+			const unsigned int p = pos[cols[idx]]++;
+			_matRows[p] = i;
+			_matToCsc[idx] = p;
+		}
+	}
+
+	_matValues.assign(mat.numNonZero(), 0.0);
+
+	// Preallocate factors for the predicted fill-in
+	_lColStart.assign(n + 1, 0);
+	_uColStart.assign(n + 1, 0);
+	_lRows.reserve(numOffDiag);
+	_lValues.reserve(numOffDiag);
+	_uRows.reserve(numOffDiag + n);
+	_uValues.reserve(numOffDiag + n);
+
+	_pivot.assign(n, noPivot);
+	_work.assign(n, 0.0);
+	_rhs.assign(n, 0.0);
+	_res.assign(n, 0.0);
+	_reach.assign(n, 0);
+	_stack.assign(n, 0);
+	_stackPos.assign(n, 0);
+	_mark.assign(n, 0);
+	_rows = n;
+}
+
+/**
+ * @brief Computes the nodes reachable from the pattern of a column of the matrix in the graph of @f$ L @f$
+ * @details The reachable nodes constitute the pattern of the column after elimination with the
+ *          already computed columns of @f$ L @f$. They are stored in topological order in
+ *          @c _reach from the returned index to the end.
+ * @param [in] col Original index of the column of the matrix
+ * @param [in] stamp Mark of visited nodes, has to be unique for each column
+ * @return Index of the first reachable node in @c _reach
+ */
+unsigned int SparseDirectSolver::reach(unsigned int col, unsigned int stamp)
+{
+	unsigned int top = _rows;
+	for (unsigned int p = _matColStart[col]; p < _matColStart[col + 1]; ++p)
+	{
+		if (_mark[_matRows[p]] != stamp)
+			top = depthFirstSearch(_matRows[p], top, stamp);
+	}
+	return top;
+}
+
+/**
+ * @brief Performs a non-recursive depth-first search in the graph of @f$ L @f$
+ * @details Rows that have already been pivoted are connected to the rows of the corresponding
+ *          column of @f$ L @f$. Finished nodes are prepended to the topological order in @c _reach.
+ * @param [in] start Original row index of the start node
+ * @param [in] top Index of the first node in @c _reach
+ * @param [in] stamp Mark of visited nodes
+ * @return Index of the first node in @c _reach after the search
+ */
+unsigned int SparseDirectSolver::depthFirstSearch(unsigned int start, unsigned int top, unsigned int stamp)
+{
+	unsigned int head = 0;
+	_stack[0] = start;
+
+	while (true)
+	{
+		const unsigned int j = _stack[head];
+		const unsigned int c = _pivot[j];
+		if (_mark[j] != stamp)
+		{
+			_mark[j] = stamp;
+			_stackPos[head] = (c == noPivot) ? 0 : _lColStart[c];
+		}
+
+		// Descend into the first unvisited child
+		const unsigned int end = (c == noPivot) ? 0 : _lColStart[c + 1];
+		bool done = true;
+		for (unsigned int p = _stackPos[head]; p < end; ++p)
+		{
+			const unsigned int i = _lRows[p];
+			if (_mark[i] == stamp)
+				continue;
+
+			_stackPos[head] = p + 1;
+			_stack[++head] = i;
+			done = false;
+			break;
+		}
+
+		if (done)
+		{
+			_reach[--top] = j;
+			if (head == 0)
+				break;
+
+			--head;
+		}
+	}
+
+	return top;
+}
+
+bool SparseDirectSolver::factorize(const CompressedSparseMatrix& mat)
+{
+	cadet_assert(mat.rows() == _rows);
+	cadet_assert(mat.numNonZero() == _matToCsc.size());
+
+	_factorized = false;
+	if (cadet_unlikely(!analyzed()))
+		return false;
+
+	// Copy values to the column-compressed matrix
+	const std::vector<double>& vals = mat.values();
+	for (unsigned int idx = 0; idx < _matToCsc.size(); ++idx)
+		_matValues[_matToCsc[idx]] = vals[idx];
+
+	_lRows.clear();
+	_lValues.clear();
+	_uRows.clear();
+	_uValues.clear();
+	std::fill(_pivot.begin(), _pivot.end(), noPivot);
+	std::fill(_mark.begin(), _mark.end(), 0);
+	_numOffDiagPivots = 0;
+
+	// Left-looking LU factorization, column k of the factors is computed from column _perm[k] of the matrix
+	for (unsigned int k = 0; k < _rows; ++k)
+	{
+		const unsigned int col = _perm[k];
+
+		// Symbolic step: Pattern of the column after elimination in topological order
+		const unsigned int top = reach(col, k + 1);
+
+		// Numeric step: Solve L x = a_col with the already computed columns of L
+		for (unsigned int p = top; p < _rows; ++p)
+			_work[_reach[p]] = 0.0;
+
+		for (unsigned int p = _matColStart[col]; p < _matColStart[col + 1]; ++p)
+			_work[_matRows[p]] = _matValues[p];
+
+		for (unsigned int p = top; p < _rows; ++p)
+		{
+			const unsigned int i = _reach[p];
+			const unsigned int c = _pivot[i];
+			if (c == noPivot)
+				continue;
+
+			const double xi = _work[i];
+			for (unsigned int q = _lColStart[c]; q < _lColStart[c + 1]; ++q)
+				_work[_lRows[q]] -= _lValues[q] * xi;
+		}
+
+		// Store column of U and select pivot among the remaining rows
+		unsigned int pivRow = noPivot;
+		double pivMax = -1.0;
+		for (unsigned int p = top; p < _rows; ++p)
+		{
+			const unsigned int i = _reach[p];
+			if (_pivot[i] == noPivot)
+			{
+				if (std::abs(_work[i]) > pivMax)
+				{
+					pivMax = std::abs(_work[i]);
+					pivRow = i;
+				}
+			}
+			else
+			{
+				_uRows.push_back(_pivot[i]);
+				_uValues.push_back(_work[i]);
+			}
+		}
+
+		// A vanishing (or subnormal) largest pivot candidate indicates a singular matrix. A relative threshold
+		// is not used since the Jacobians are badly scaled (e.g., steric mass action binding)
+		if (cadet_unlikely((pivRow == noPivot) || !std::isfinite(pivMax) || (pivMax < std::numeric_limits<double>::min())))
+			return false;
+
+		// Prefer the diagonal element of the fill-reducing ordering
+		if ((pivRow != col) && (_pivot[col] == noPivot) && (_mark[col] == k + 1))
+		{
+			const double diag = std::abs(_work[col]);
+			if ((diag > 0.0) && (diag >= _pivotThreshold * pivMax))
+				pivRow = col;
+		}
+
+		if (pivRow != col)
+			++_numOffDiagPivots;
+
+		const double pivot = _work[pivRow];
+		_pivot[pivRow] = k;
+
+		_uRows.push_back(k);
+		_uValues.push_back(pivot);
+		_uColStart[k + 1] = _uRows.size();
+
+		// Store column of L
+		for (unsigned int p = top; p < _rows; ++p)
+		{
+			const unsigned int i = _reach[p];
+			if (_pivot[i] != noPivot)
+				continue;
+
+			_lRows.push_back(i);
+			_lValues.push_back(_work[i] / pivot);
+		}
+		_lColStart[k + 1] = _lRows.size();
+	}
+
+	// Convert row indices of L to pivot indices
+	for (unsigned int& r : _lRows)
+		r = _pivot[r];
+
+	std::fill(_work.begin(), _work.end(), 0.0);
+	_numFactorNonZero = _lRows.size() + _uRows.size();
+	_factorized = true;
+	return true;
+}
+
+/**
+ * @brief Solves @f$ Ax = b @f$ by forward and backward substitution with the factors
+ * @param [in,out] x On entry the right hand side @f$ b @f$, on exit the solution @f$ x @f$
+ */
+void SparseDirectSolver::substitute(double* const x)
+{
+	// Apply row permutation
+	for (unsigned int i = 0; i < _rows; ++i)
+		_work[_pivot[i]] = x[i];
+
+	// Forward substitution with unit lower triangular L (column-oriented)
+	for (unsigned int k = 0; k < _rows; ++k)
+	{
+		const double xk = _work[k];
+		for (unsigned int q = _lColStart[k]; q < _lColStart[k + 1]; ++q)
+			_work[_lRows[q]] -= _lValues[q] * xk;
+	}
+
+	// Backward substitution with upper triangular U (column-oriented, diagonal is stored last)
+	for (unsigned int k = _rows; k-- > 0; )
+	{
+		const unsigned int diag = _uColStart[k + 1] - 1;
+		const double xk = _work[k] / _uValues[diag];
+		_work[k] = xk;
+		for (unsigned int q = _uColStart[k]; q < diag; ++q)
+			_work[_uRows[q]] -= _uValues[q] * xk;
+	}
+
+	// Undo column permutation
+	for (unsigned int k = 0; k < _rows; ++k)
+		x[_perm[k]] = _work[k];
+}
+
+/**
+ * @brief Solves @f$ A^T x = b @f$ by forward and backward substitution with the transposed factors
+ * @param [in,out] x On entry the right hand side @f$ b @f$, on exit the solution @f$ x @f$
+ */
+void SparseDirectSolver::substituteTransposed(double* const x)
+{
+	// Apply column permutation
+	for (unsigned int k = 0; k < _rows; ++k)
+		_work[k] = x[_perm[k]];
+
+	// Forward substitution with lower triangular U^T (row k of U^T is column k of U)
+	for (unsigned int k = 0; k < _rows; ++k)
+	{
+		const unsigned int diag = _uColStart[k + 1] - 1;
+		double sum = _work[k];
+		for (unsigned int q = _uColStart[k]; q < diag; ++q)
+			sum -= _uValues[q] * _work[_uRows[q]];
+		_work[k] = sum / _uValues[diag];
+	}
+
+	// Backward substitution with unit upper triangular L^T (row k of L^T is column k of L)
+	for (unsigned int k = _rows; k-- > 0; )
+	{
+		double sum = _work[k];
+		for (unsigned int q = _lColStart[k]; q < _lColStart[k + 1]; ++q)
+			sum -= _lValues[q] * _work[_lRows[q]];
+		_work[k] = sum;
+	}
+
+	// Undo row permutation
+	for (unsigned int i = 0; i < _rows; ++i)
+		x[i] = _work[_pivot[i]];
+}
+
+/**
+ * @brief Computes the residual @f$ r = b - Ax @f$ or @f$ r = b - A^T x @f$ with the factorized matrix
+ * @param [in] b Right hand side
+ * @param [in] x Solution
+ * @param [out] r Residual
+ * @param [in] transposed Determines whether the residual of the transposed system is computed
+ */
+void SparseDirectSolver::residual(double const* const b, double const* const x, double* const r, bool transposed) const
+{
+	if (transposed)
+	{
+		for (unsigned int j = 0; j < _rows; ++j)
+		{
+			double sum = b[j];
+			for (unsigned int p = _matColStart[j]; p < _matColStart[j + 1]; ++p)
+				sum -= _matValues[p] * x[_matRows[p]];
+			r[j] = sum;
+		}
+	}
+	else
+	{
+		std::copy(b, b + _rows, r);
+		for (unsigned int j = 0; j < _rows; ++j)
+		{
+			const double xj = x[j];
+			for (unsigned int p = _matColStart[j]; p < _matColStart[j + 1]; ++p)
+				r[_matRows[p]] -= _matValues[p] * xj;
+		}
+	}
+}
+
+bool SparseDirectSolver::solve(double* const rhs)
+{
+	if (cadet_unlikely(!_factorized))
+		return false;
+
+	if (_refinementSteps > 0)
+		std::copy(rhs, rhs + _rows, _rhs.begin());
+
+	substitute(rhs);
+
+	// Iterative refinement: x += A^{-1} (b - Ax)
+	for (unsigned int step = 0; step < _refinementSteps; ++step)
+	{
+		residual(_rhs.data(), rhs, _res.data(), false);
+		substitute(_res.data());
+		for (unsigned int i = 0; i < _rows; ++i)
+			rhs[i] += _res[i];
+	}
+
+	return true;
+}
+
+bool SparseDirectSolver::solveTransposed(double* const rhs)
+{
+	if (cadet_unlikely(!_factorized))
+		return false;
+
+	if (_refinementSteps > 0)
+		std::copy(rhs, rhs + _rows, _rhs.begin());
+
+	substituteTransposed(rhs);
+
+	// Iterative refinement: x += A^{-T} (b - A^T x)
+	for (unsigned int step = 0; step < _refinementSteps; ++step)
+	{
+		residual(_rhs.data(), rhs, _res.data(), true);
+		substituteTransposed(_res.data());
+		for (unsigned int i = 0; i < _rows; ++i)
+			rhs[i] += _res[i];
+	}
+
+	return true;
+}
+
+} // namespace linalg
+
+} // namespace cadet
@@ -0,0 +1,203 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Defines a direct solver for sparse linear systems based on LU factorization
+ */
+
+#ifndef LIBCADET_SPARSEDIRECTSOLVER_HPP_
+#define LIBCADET_SPARSEDIRECTSOLVER_HPP_
+
+#include <vector>
+
+#include "cadet/cadetCompilerInfo.hpp"
+#include "common/CompilerSpecific.hpp"
+#include "linalg/SparseMatrix.hpp"
+
+namespace cadet
+{
+
+namespace linalg
+{
+
+/**
+ * @brief Solves sparse linear systems with a fixed sparsity pattern by LU factorization
+ * @details The solution process is split into three phases:
+ *              -# analyzePattern() computes a fill-reducing column ordering (minimum degree on the pattern
+ *                 of @f$ A + A^T @f$) and sets up a column-compressed copy of the pattern.
+ *              -# factorize() computes the numeric factorization @f$ PAQ = LU @f$ of a matrix with the
+ *                 analyzed pattern by a left-looking sparse LU (Gilbert-Peierls) with threshold partial
+ *                 pivoting. The diagonal element of the fill-reducing ordering is preferred as pivot as long
+ *                 as its magnitude is at least pivotThreshold() times the largest candidate in its column.
+ *                 Otherwise, the largest candidate is chosen. The factorization fails if the largest
+ *                 candidate vanishes (i.e., is zero, subnormal, or not finite).
+ *              -# solve() applies the factorization to a right hand side, solveTransposed() applies the
+ *                 factorization of the transposed matrix. Both perform refinementSteps() steps of iterative
+ *                 refinement with the residual computed from a copy of the factorized matrix.
+ *
+ *          The memory of the factors is kept between factorizations. It is only enlarged if pivoting
+ *          creates more fill-in than in all previous factorizations.
+ */
+class SparseDirectSolver
+{
+public:
+	SparseDirectSolver() CADET_NOEXCEPT : _rows(0), _pivotThreshold(0.1), _refinementSteps(1), _factorized(false),
+		_numFactorNonZero(0), _numOffDiagPivots(0) { }
+	~SparseDirectSolver() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Computes fill-reducing ordering of the given matrix and prepares the factorization
+	 * @details Only the sparsity pattern of @p mat is used. The pattern of all matrices passed
+	 *          to factorize() has to match the one given here.
+	 * @param [in] mat Square matrix whose pattern is analyzed
+	 */
+	void analyzePattern(const CompressedSparseMatrix& mat);
+
+	/**
+	 * @brief Computes the numeric LU factorization of the given matrix
+	 * @details The pattern of @p mat has to be analyzed by analyzePattern() before. The values
+	 *          of @p mat are copied for iterative refinement in solve() and solveTransposed().
+	 * @param [in] mat Matrix to be factorized
+	 * @return @c true if the factorization was successful, otherwise @c false (e.g., if the matrix is numerically singular)
+	 */
+	bool factorize(const CompressedSparseMatrix& mat);
+
+	/**
+	 * @brief Uses the factorization to solve the equation @f$ Ax = y @f$
+	 * @details Before the equation can be solved, the matrix has to be factorized first by calling factorize().
+	 *          Uses internal working memory and, thus, must not be called concurrently.
+	 * @param [in,out] rhs On entry pointer to the right hand side vector @f$ y @f$ of the equation, on exit the solution @f$ x @f$
+	 * @return @c true if the solution process was successful, otherwise @c false
+	 */
+	bool solve(double* const rhs);
+
+	/**
+	 * @brief Uses the factorization to solve the transposed equation @f$ A^T x = y @f$
+	 * @details Before the equation can be solved, the matrix has to be factorized first by calling factorize().
+	 *          Since @f$ A^T = Q U^T L^T P @f$, the system is solved by substitution with @f$ U^T @f$ and @f$ L^T @f$.
+	 *          Uses internal working memory and, thus, must not be called concurrently.
+	 * @param [in,out] rhs On entry pointer to the right hand side vector @f$ y @f$ of the equation, on exit the solution @f$ x @f$
+	 * @return @c true if the solution process was successful, otherwise @c false
+	 */
+	bool solveTransposed(double* const rhs);
+
+	/**
+	 * @brief Returns whether a sparsity pattern has been analyzed
+	 * @return @c true if analyzePattern() has been called, otherwise @c false
+	 */
+	inline bool analyzed() const CADET_NOEXCEPT { return _rows > 0; }
+
+	/**
+	 * @brief Discards the analyzed pattern and the factorization
+	 */
+	void clear() CADET_NOEXCEPT;
+
+	/**
+	 * @brief Returns the number of rows (and columns) of the analyzed matrix
+	 * @return Number of rows
+	 */
+	inline unsigned int rows() const CADET_NOEXCEPT { return _rows; }
+
+	/**
+	 * @brief Returns the number of structurally non-zero elements of the factors @f$ L @f$ and @f$ U @f$
+	 * @details Includes the diagonal and all fill-in elements. Before the first factorization, the number
+	 *          of elements predicted by the fill-reducing ordering without pivoting is returned.
+	 * @return Number of elements in the factors
+	 */
+	inline unsigned int numFactorNonZero() const CADET_NOEXCEPT { return _numFactorNonZero; }
+
+	/**
+	 * @brief Returns the number of pivots of the last factorization that deviate from the fill-reducing ordering
+	 * @return Number of off-diagonal pivots
+	 */
+	inline unsigned int numOffDiagonalPivots() const CADET_NOEXCEPT { return _numOffDiagPivots; }
+
+	/**
+	 * @brief Returns the relative threshold for keeping the diagonal pivot
+	 * @return Pivot threshold in @f$ [0, 1] @f$
+	 */
+	inline double pivotThreshold() const CADET_NOEXCEPT { return _pivotThreshold; }
+
+	/**
+	 * @brief Sets the relative threshold for keeping the diagonal pivot
+	 * @details A value of @c 1 results in partial pivoting, a value of @c 0 keeps the fill-reducing
+	 *          ordering unless the diagonal element vanishes.
+	 * @param [in] thresh Pivot threshold in @f$ [0, 1] @f$
+	 */
+	inline void pivotThreshold(double thresh) CADET_NOEXCEPT { _pivotThreshold = thresh; }
+
+	/**
+	 * @brief Returns the number of iterative refinement steps performed by solve() and solveTransposed()
+	 * @return Number of refinement steps
+	 */
+	inline unsigned int refinementSteps() const CADET_NOEXCEPT { return _refinementSteps; }
+
+	/**
+	 * @brief Sets the number of iterative refinement steps performed by solve() and solveTransposed()
+	 * @param [in] steps Number of refinement steps
+	 */
+	inline void refinementSteps(unsigned int steps) CADET_NOEXCEPT { _refinementSteps = steps; }
+
+protected:
+
+	/**
+	 * @brief Computes a minimum degree ordering and the elimination neighbors of each pivot
+	 * @details The neighbors of a node at the time of its elimination constitute the off-diagonal
+	 *          pattern of the corresponding column of @f$ L @f$ and row of @f$ U @f$ if no pivoting occurs.
+	 * @param [in] mat Matrix whose pattern is used
+	 * @param [out] elimNeighbors Neighbors (original indices) of each eliminated node in elimination order
+	 */
+	void minimumDegreeOrdering(const CompressedSparseMatrix& mat, std::vector<std::vector<unsigned int>>& elimNeighbors);
+
+	unsigned int reach(unsigned int col, unsigned int stamp);
+	unsigned int depthFirstSearch(unsigned int start, unsigned int top, unsigned int stamp);
+	void substitute(double* const x);
+	void substituteTransposed(double* const x);
+	void residual(double const* const b, double const* const x, double* const r, bool transposed) const;
+
+	unsigned int _rows; //!< Number of rows of the matrix
+	std::vector<unsigned int> _perm; //!< Column permutation @f$ Q @f$ (new index to original index)
+	std::vector<unsigned int> _pivot; //!< Row permutation @f$ P @f$ (original row index to pivot index)
+
+	std::vector<unsigned int> _matColStart; //!< Start of each column of the column-compressed copy of the matrix
+	std::vector<unsigned int> _matRows; //!< Row indices of the column-compressed copy of the matrix
+	std::vector<double> _matValues; //!< Values of the column-compressed copy of the matrix
+	std::vector<unsigned int> _matToCsc; //!< Position of each element of the analyzed (row-compressed) matrix in _matValues
+
+	std::vector<unsigned int> _lColStart; //!< Start of each column of @f$ L @f$ (unit diagonal is not stored)
+	std::vector<unsigned int> _lRows; //!< Row indices of @f$ L @f$ (pivot indices after factorization)
+	std::vector<double> _lValues; //!< Values of @f$ L @f$
+	std::vector<unsigned int> _uColStart; //!< Start of each column of @f$ U @f$ (diagonal element is stored last)
+	std::vector<unsigned int> _uRows; //!< Row indices (pivot indices) of @f$ U @f$
+	std::vector<double> _uValues; //!< Values of @f$ U @f$
+
+	std::vector<double> _work; //!< Dense working memory of size _rows
+	std::vector<double> _rhs; //!< Copy of the right hand side for iterative refinement
+	std::vector<double> _res; //!< Residual of iterative refinement
+	std::vector<unsigned int> _reach; //!< Nodes reachable from the pattern of a column in topological order
+	std::vector<unsigned int> _stack; //!< Stack of the depth-first search
+	std::vector<unsigned int> _stackPos; //!< Position in the adjacency list of each node on the stack
+	std::vector<unsigned int> _mark; //!< Marks visited nodes in the depth-first search of a column
+
+	double _pivotThreshold; //!< Relative threshold for keeping the diagonal pivot
+	unsigned int _refinementSteps; //!< Number of iterative refinement steps
+	bool _factorized; //!< Determines whether a valid factorization is available
+	unsigned int _numFactorNonZero; //!< Number of elements in the factors
+	unsigned int _numOffDiagPivots; //!< Number of pivots of the last factorization that deviate from the fill-reducing ordering
+};
+
+} // namespace linalg
+
+} // namespace cadet
+
+#endif  // LIBCADET_SPARSEDIRECTSOLVER_HPP_
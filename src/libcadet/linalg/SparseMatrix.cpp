@@ -14,6 +14,7 @@
 
 #include <sstream>
 #include <ostream>
+#include <algorithm>
 
 namespace cadet
 {
@@ -63,6 +64,50 @@ std::ostream& operator<<(std::ostream& out, const DoubleSparseMatrix& sm)
 	return out;
 }
 
+void CompressedSparseMatrix::assignPattern(unsigned int rows, const DoubleSparseMatrix& pattern)
+{
+	const std::vector<unsigned int>& spRows = pattern.rows();
+	const std::vector<unsigned int>& spCols = pattern.cols();
+
+	// Sort elements by row and column
+	std::vector<unsigned int> order(pattern.numNonZero());
+	for (unsigned int i = 0; i < order.size(); ++i)
+		order[i] = i;
+
+	std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b)
+		{
+			if (spRows[a] != spRows[b])
+				return spRows[a] < spRows[b];
+			return spCols[a] < spCols[b];
+		});
+
+	_rows = rows;
+	_rowStart.assign(rows + 1, 0);
+	_colIdx.clear();
+	_colIdx.reserve(order.size());
+
+	for (unsigned int i = 0; i < order.size(); ++i)
+	{
+		const unsigned int r = spRows[order[i]];
+		const unsigned int c = spCols[order[i]];
+		cadet_assert(r < rows);
+		cadet_assert(c < rows);
+
+		// Skip duplicates
+		if ((i > 0) && (r == spRows[order[i-1]]) && (c == spCols[order[i-1]]))
+			continue;
+
+		_colIdx.push_back(c);
+		++_rowStart[r + 1];
+	}
+
+	// Convert row counts to start indices
+	for (unsigned int i = 0; i < rows; ++i)
+		_rowStart[i + 1] += _rowStart[i];
+
+	_values.assign(_colIdx.size(), 0.0);
+}
+
 
 }  // namespace linalg
 
@@ -20,6 +20,7 @@
 
 #include <vector>
 #include <ostream>
+#include <algorithm>
 
 #include "cadet/cadetCompilerInfo.hpp"
 #include "common/CompilerSpecific.hpp"
@@ -340,6 +341,24 @@ public:
 			out[_rows[i]] -= alpha * _values[i] * x[_cols[i]];
 	}
 
+	/**
+	 * @brief Multiplies the transpose of this sparse matrix with a vector and adds the scaled result to another vector
+	 * @details Computes the matrix vector operation \f$ b + \alpha A^T x \f$, where the matrix vector
+	 *          product is added to @p out, which is \f$ b \f$.
+	 *
+	 * @param [in] x Vector to multiply with
+	 * @param [in,out] out Vector to add the matrix-vector product to
+	 * @param [in] alpha Scale factor
+	 * @tparam arg_t Type of the vector \f$ x \f$
+	 * @tparam result_t Type of the vector \f$ y \f$
+	 */
+	template <typename arg_t, typename result_t>
+	inline void transposedMultiplyAdd(arg_t const* const x, result_t* const out, double alpha) const
+	{
+		for (unsigned int i = 0; i < _curIdx; ++i)
+			out[_cols[i]] += alpha * _values[i] * x[_rows[i]];
+	}
+
 	/**
 	 * @brief Returns a vector with row indices
 	 * @details Not all elements in the vector are actually set. Only the first numNonZero()
@@ -381,12 +400,114 @@ typedef SparseMatrix<double> DoubleSparseMatrix;
 
 std::ostream& operator<<(std::ostream& out, const DoubleSparseMatrix& sm);
 
+/**
+ * @brief Represents a sparse matrix in compressed sparse row (CSR) format with a fixed sparsity pattern
+ * @details The sparsity pattern is set once by assignPattern() and does not change afterwards. Only the
+ *          values of the structurally non-zero elements can be modified. Column indices are sorted in
+ *          ascending order within each row, which allows fast lookup of elements.
+ *
+ *          The pattern is usually constructed from a SparseMatrix in coordinate list format that holds
+ *          all (possibly) non-zero positions.
+ */
 class CompressedSparseMatrix
 {
 public:
-	CompressedSparseMatrix() CADET_NOEXCEPT : _values(nullptr) { }
+	/**
+	 * @brief Creates an empty CompressedSparseMatrix
+	 * @details Users have to call assignPattern() prior to populating the matrix.
+	 */
+	CompressedSparseMatrix() CADET_NOEXCEPT : _rows(0) { }
+
+	~CompressedSparseMatrix() CADET_NOEXCEPT { }
+
+	// Default copy and assignment semantics
+	CompressedSparseMatrix(const CompressedSparseMatrix& cpy) = default;
+	CompressedSparseMatrix(CompressedSparseMatrix&& cpy) CADET_NOEXCEPT = default;
+
+	CompressedSparseMatrix& operator=(const CompressedSparseMatrix& cpy) = default;
 
+#ifdef COMPILER_SUPPORT_NOEXCEPT_DEFAULTED_MOVE
+	CompressedSparseMatrix& operator=(CompressedSparseMatrix&& cpy) CADET_NOEXCEPT = default;
+#else
+	CompressedSparseMatrix& operator=(CompressedSparseMatrix&& cpy) = default;
+#endif
+
+	/**
+	 * @brief Sets the sparsity pattern of the square matrix
+	 * @details The pattern is given by the positions of the elements in @p pattern, their values are
+	 *          ignored. Duplicate positions are merged. All values are reset to @c 0.0.
+	 * @param [in] rows Number of rows (and columns) of the matrix
+	 * @param [in] pattern Coordinate list with positions of the structurally non-zero elements
+	 */
+	void assignPattern(unsigned int rows, const DoubleSparseMatrix& pattern);
+
+	/**
+	 * @brief Resets the matrix to an empty state without any elements
+	 */
+	inline void clear() CADET_NOEXCEPT
+	{
+		_rows = 0;
+		_rowStart.clear();
+		_colIdx.clear();
+		_values.clear();
+	}
 
+	/**
+	 * @brief Sets all structurally non-zero elements to the given value
+	 * @param [in] val Value all elements are set to
+	 */
+	inline void setAll(double val)
+	{
+		std::fill(_values.begin(), _values.end(), val);
+	}
+
+	/**
+	 * @brief Returns the index of the given element in the values() array
+	 * @param [in] row Row index
+	 * @param [in] col Column index
+	 * @return Index of the element in the values() array or @c -1 if the element is not part of the pattern
+	 */
+	inline int findElement(unsigned int row, unsigned int col) const
+	{
+		cadet_assert(row < _rows);
+
+		const std::vector<unsigned int>::const_iterator begin = _colIdx.begin() + _rowStart[row];
+		const std::vector<unsigned int>::const_iterator end = _colIdx.begin() + _rowStart[row + 1];
+		const std::vector<unsigned int>::const_iterator it = std::lower_bound(begin, end, col);
+		if ((it == end) || (*it != col))
+			return -1;
+
+		return static_cast<int>(it - _colIdx.begin());
+	}
+
+	/**
+	 * @brief Accesses an element at the given position
+	 * @details The element has to be part of the sparsity pattern.
+	 * @param [in] row Row index
+	 * @param [in] col Column index
+	 * @return Value of the element at the given position
+	 */
+	inline double& operator()(unsigned int row, unsigned int col)
+	{
+		const int idx = findElement(row, col);
+		cadet_assert(idx >= 0);
+		return _values[idx];
+	}
+
+	/**
+	 * @brief Accesses an element at the given position
+	 * @details If the element is not part of the sparsity pattern, @c 0.0 is returned.
+	 * @param [in] row Row index
+	 * @param [in] col Column index
+	 * @return Value of the element at the given position
+	 */
+	inline const double operator()(unsigned int row, unsigned int col) const
+	{
+		const int idx = findElement(row, col);
+		if (idx < 0)
+			return 0.0;
+		return _values[idx];
+	}
 
 	/**
 	 * @brief Multiplies this sparse matrix with a vector and adds the result to another vector
@@ -396,9 +517,15 @@ public:
 	 * @param [in] x Vector to multiply with
 	 * @param [in,out] out Vector to add the matrix-vector product to
 	 */
-	inline void multiplyAdd(double const* const x, double* const out)
+	inline void multiplyAdd(double const* const x, double* const out) const
 	{
-
+		for (unsigned int i = 0; i < _rows; ++i)
+		{
+			double sum = 0.0;
+			for (unsigned int j = _rowStart[i]; j < _rowStart[i + 1]; ++j)
+				sum += _values[j] * x[_colIdx[j]];
+			out[i] += sum;
+		}
 	}
 
 	/**
@@ -410,9 +537,15 @@ public:
 	 * @param [in] x Vector to multiply with
 	 * @param [in,out] out Vector to add the matrix-vector product to
 	 */
-	inline void multiplyAdd(double alpha, double const* const x, double* const out)
+	inline void multiplyAdd(double alpha, double const* const x, double* const out) const
 	{
-
+		for (unsigned int i = 0; i < _rows; ++i)
+		{
+			double sum = 0.0;
+			for (unsigned int j = _rowStart[i]; j < _rowStart[i + 1]; ++j)
+				sum += _values[j] * x[_colIdx[j]];
+			out[i] += alpha * sum;
+		}
 	}
 
 	/**
@@ -423,13 +556,48 @@ public:
 	 * @param [in] x Vector to multiply with
 	 * @param [in,out] out Vector to subtract the matrix-vector product from
 	 */
-	inline void multiplySubtract(double const* const x, double* const out)
+	inline void multiplySubtract(double const* const x, double* const out) const
 	{
-
+		multiplyAdd(-1.0, x, out);
 	}
 
+	/**
+	 * @brief Returns the number of rows (and columns) of the matrix
+	 * @return Number of rows
+	 */
+	inline unsigned int rows() const CADET_NOEXCEPT { return _rows; }
+
+	/**
+	 * @brief Returns the number of structurally non-zero elements in the matrix
+	 * @return Number of structurally non-zero elements
+	 */
+	inline unsigned int numNonZero() const CADET_NOEXCEPT { return _colIdx.size(); }
+
+	/**
+	 * @brief Returns the indices of the first element of each row in the columns() and values() arrays
+	 * @details The array has rows() + 1 elements, the last one being numNonZero().
+	 * @return Array with row start indices
+	 */
+	inline const std::vector<unsigned int>& rowStart() const CADET_NOEXCEPT { return _rowStart; }
+
+	/**
+	 * @brief Returns the column indices of the elements
+	 * @return Array with column indices
+	 */
+	inline const std::vector<unsigned int>& columns() const CADET_NOEXCEPT { return _colIdx; }
+
+	/**
+	 * @brief Returns the values of the elements
+	 * @return Array with element values
+	 */
+	inline const std::vector<double>& values() const CADET_NOEXCEPT { return _values; }
+	inline std::vector<double>& values() CADET_NOEXCEPT { return _values; }
+
 protected:
-	double* _values;
+	unsigned int _rows; //!< Number of rows
+	std::vector<unsigned int> _rowStart; //!< Index of the first element of each row (size _rows + 1)
+	std::vector<unsigned int> _colIdx; //!< Column index of each element
+	std::vector<double> _values; //!< Value of each element
 };
 
 } // namespace linalg
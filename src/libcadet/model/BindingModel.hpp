@@ -35,6 +35,29 @@ class IExternalFunction;
 namespace model
 {
 
+/**
+ * @brief Location of a particle shell in the state vector and in the column
+ * @details Describes one shell of a batch that is passed to IBindingModel::consistentInitialStateBatch().
+ */
+struct ParticleShell
+{
+	double z; //!< Axial position in normalized coordinates (column inlet = 0, column outlet = 1)
+	double r; //!< Radial position in normalized coordinates (outer shell = 1, inner center = 0)
+	unsigned int particleOffset; //!< Offset of the particle block in the state vector
+	unsigned int shellOffset; //!< Offset of the first bound state of the shell to the beginning of its particle block
+};
+
+/**
+ * @brief Statistics of the consistent initialization of bound states
+ */
+struct ConsistentInitStats
+{
+	unsigned int numShells; //!< Number of processed shells
+	unsigned int numGuesses; //!< Number of shells for which an initial guess has been provided
+	unsigned int numGuessesUsed; //!< Number of shells that started from the provided initial guess
+	unsigned int numSkipped; //!< Number of shells whose initial state satisfied the error tolerance without invoking the nonlinear solver
+};
+
 /**
  * @brief Defines an internal BindingModel interface
  * @details The binding model is responsible for handling bound states and their residuals.
@@ -228,6 +251,59 @@ public:
 		unsigned int adEqOffset, unsigned int adOffset, unsigned int diagDir, unsigned int lowerBandwidth, unsigned int upperBandwidth, double* const workingMemory,
 		linalg::detail::DenseMatrixBase& workingMat) const = 0;
 
+	/**
+	 * @brief Returns the size of the required workspace (number of doubles) for batched consistent initialization
+	 * @details The workspace is used by consistentInitialStateBatch() for a complete batch of shells.
+	 * @return Size of the workspace for batched consistent initialization
+	 */
+	virtual unsigned int consistentInitializationBatchWorkspaceSize() const { return consistentInitializationWorkspaceSize(); }
+
+	/**
+	 * @brief Computes consistent initial state values for a batch of particle shells
+	 * @details Performs the same task as consistentInitialState() for all given shells one after the other
+	 *          using the same workspace. Implementations may exploit that consecutive shells are close to
+	 *          each other (e.g., by using the solution of a shell as initial guess for the next one).
+	 *          
+	 *          An optional initial guess (e.g., the solution of a previous run) can be provided for each shell.
+	 *          It is only used if it is closer to the solution than the current state.
+	 *          
+	 *          This function is called simultaneously from multiple threads on disjoint batches.
+	 *          
+	 *          If both @p adRes and @p adY are valid pointers, the Jacobian is to be computed by AD.
+	 * 
+	 * @param [in] t Current time point
+	 * @param [in] secIdx Index of the current section
+	 * @param [in] shells Array with the locations of the shells in the batch
+	 * @param [in] nShells Number of shells in the batch
+	 * @param [in,out] vecStateY Pointer to the beginning of the state vector of the unit operation
+	 * @param [in] guess Bound states of all shells in the batch (one shell after the other) used as initial guess or @c nullptr
+	 * @param [in] errorTol Error tolerance for solving the algebraic equations
+	 * @param [in,out] adRes Pointer to residual vector of AD datatypes of the unit operation or @c nullptr
+	 * @param [in,out] adY Pointer to state vector of AD datatypes of the unit operation or @c nullptr
+	 * @param [in] adOffset Offset to the usable AD directions
+	 * @param [in] diagDir AD direction of the main diagonal
+	 * @param [in] lowerBandwidth Lower bandwidth of the banded Jacobian of the particle block
+	 * @param [in] upperBandwidth Upper bandwidth of the banded Jacobian of the particle block
+	 * @param [in,out] workingMemory Working memory of size consistentInitializationBatchWorkspaceSize()
+	 * @param [in,out] workingMat Working matrix for nonlinear equation solvers with at least as 
+	 *                 many rows and columns as number of bound states
+	 * @return Statistics of the batch
+	 */
+	virtual ConsistentInitStats consistentInitialStateBatch(double t, unsigned int secIdx, ParticleShell const* shells, unsigned int nShells, double* const vecStateY,
+		double const* guess, double errorTol, active* const adRes, active* const adY, unsigned int adOffset, unsigned int diagDir, unsigned int lowerBandwidth,
+		unsigned int upperBandwidth, double* const workingMemory, linalg::detail::DenseMatrixBase& workingMat) const
+	{
+		for (unsigned int i = 0; i < nShells; ++i)
+		{
+			const ParticleShell& shell = shells[i];
+			consistentInitialState(t, shell.z, shell.r, secIdx, vecStateY + shell.particleOffset + shell.shellOffset, errorTol,
+				adRes ? adRes + shell.particleOffset : nullptr, adY ? adY + shell.particleOffset : nullptr, shell.shellOffset,
+				adOffset, diagDir, lowerBandwidth, upperBandwidth, workingMemory, workingMat);
+		}
+
+		return ConsistentInitStats{ nShells, guess ? nShells : 0u, 0u, 0u };
+	}
+
 	/**
 	 * @brief Evaluates the residual for one particle shell
 	 * @details The binding model is responsible for implementing the complete bound state equations,
@@ -260,6 +336,56 @@ public:
 	virtual int residual(double t, double z, double r, unsigned int secIdx, double timeFactor, double const* y,
 		double const* yDot, double* res) const = 0;
 
+	/**
+	 * @brief Evaluates the residual for a batch of consecutive particle shells
+	 * @details Performs the same task as residual() for @p nShells shells of the same particle block.
+	 *          The shells are located equidistantly in memory, that is, the bound states of shell @c i
+	 *          start at @c y[i * stride] (usually, @p stride is Indexer::strideParShell()). As in residual(),
+	 *          the liquid phase of each shell is located directly in front of its bound states.
+	 *
+	 *          The default implementation calls residual() for each shell. Implementations may evaluate
+	 *          the isotherm for all shells at once in order to avoid per-shell overhead.
+	 *
+	 *          This function is called simultaneously from multiple threads.
+	 *
+	 * @param [in] t Current time point
+	 * @param [in] z Axial position in normalized coordinates (column inlet = 0, column outlet = 1)
+	 * @param [in] r Array with radial position of each shell in normalized coordinates (outer shell = 1, inner center = 0)
+	 * @param [in] secIdx Index of the current section
+	 * @param [in] timeFactor Used to compute parameter derivatives with respect to section length,
+	 *             originates from time transformation and is premultiplied to time derivatives
+	 * @param [in] nShells Number of shells in the batch
+	 * @param [in] stride Distance between the bound states of two consecutive shells
+	 * @param [in] y Pointer to first bound state of the first component in the first shell of the batch
+	 * @param [in] yDot Pointer to first bound state time derivative of the first component in the first shell
+	 *             of the batch or @c nullptr if time derivatives shall be left out
+	 * @param [out] res Pointer to residual equation of first bound state of the first component in the first shell of the batch
+	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+	 */
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor, unsigned int nShells,
+		unsigned int stride, active const* y, double const* yDot, active* res) const
+	{
+		return residualBatchPerShell(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);
+	}
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor, unsigned int nShells,
+		unsigned int stride, active const* y, double const* yDot, active* res) const
+	{
+		return residualBatchPerShell(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);
+	}
+
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor, unsigned int nShells,
+		unsigned int stride, double const* y, double const* yDot, active* res) const
+	{
+		return residualBatchPerShell(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);
+	}
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor, unsigned int nShells,
+		unsigned int stride, double const* y, double const* yDot, double* res) const
+	{
+		return residualBatchPerShell(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);
+	}
+
 	/**
 	 * @brief Evaluates the Jacobian of the bound states for one particle shell analytically
 	 * @details The binding model is responsible for implementing the complete bound state equations,
@@ -313,7 +439,55 @@ public:
 	 * @param [out] dResDt Pointer to array that stores the time derivative
 	 */
 	virtual void timeDerivativeAlgebraicResidual(double t, double z, double r, unsigned int secIdx, double const* y, double* dResDt) const = 0;
+
+	/**
+	 * @brief Returns whether the binding model provides analytic parameter derivatives via addParamDerivatives()
+	 * @details If analytic parameter derivatives are not available, the residual is evaluated with AD in
+	 *          order to compute parameter sensitivities.
+	 * @return @c true if addParamDerivatives() is implemented, otherwise @c false
+	 */
+	virtual bool hasAnalyticParamDerivatives() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Adds the parameter derivatives of the residual to the AD directions of the given residual for one particle shell
+	 * @details Computes @f$ \sum_p \frac{\partial \text{res}}{\partial p} \nabla p @f$ analytically, where @f$ p @f$
+	 *          runs over all model parameters and @f$ \nabla p @f$ denotes the AD directions (seeds) of @f$ p @f$.
+	 *          The result is added to the first @p nDirs AD directions of @p res, the values of @p res are
+	 *          left unchanged. Derivatives with respect to the time transformation (@c timeFactor) are not
+	 *          included.
+	 *
+	 *          This function is called simultaneously from multiple threads.
+	 *          It can be left out (empty implementation) if hasAnalyticParamDerivatives() returns @c false.
+	 *
+	 * @param [in] t Current time point
+	 * @param [in] z Axial position in normalized coordinates (column inlet = 0, column outlet = 1)
+	 * @param [in] r Radial position in normalized coordinates (outer shell = 1, inner center = 0)
+	 * @param [in] secIdx Index of the current section
+	 * @param [in] y Pointer to first bound state of the first component in the current particle shell
+	 * @param [in] nDirs Number of AD directions that carry parameter seeds
+	 * @param [in,out] res Pointer to residual equation of first bound state of the first component in the current particle shell
+	 */
+	virtual void addParamDerivatives(double t, double z, double r, unsigned int secIdx, double const* y, unsigned int nDirs, active* res) const = 0;
 protected:
+
+	/**
+	 * @brief Evaluates the residual of a batch of shells by calling residual() for each shell
+	 * @details Implements the default behavior of residualBatch().
+	 * @return First nonzero return code of residual() or @c 0 on success
+	 */
+	template <typename StateType, typename ResidualType, typename ParamType>
+	int residualBatchPerShell(const ParamType& t, double z, double const* r, unsigned int secIdx, const ParamType& timeFactor, unsigned int nShells,
+		unsigned int stride, StateType const* y, double const* yDot, ResidualType* res) const
+	{
+		int retCode = 0;
+		for (unsigned int i = 0; i < nShells; ++i)
+		{
+			const int curCode = residual(t, z, r[i], secIdx, timeFactor, y + i * stride, yDot ? yDot + i * stride : nullptr, res + i * stride);
+			if (retCode == 0)
+				retCode = curCode;
+		}
+		return retCode;
+	}
 };
 
 } // namespace model
@@ -13,6 +13,7 @@
 #include "model/GeneralRateModel.hpp"
 #include "linalg/DenseMatrix.hpp"
 #include "linalg/BandMatrix.hpp"
+#include "AdUtils.hpp"
 #include "ParamReaderHelper.hpp"
 
 #include <algorithm>
@@ -32,6 +33,36 @@ namespace cadet
 namespace model
 {
 
+namespace
+{
+	/**
+	 * @brief Solves a factorized diagonal Jacobian block for the right hand sides of all sensitivity systems at once
+	 * @details The parts of the right hand sides that belong to the block are gathered into a contiguous array
+	 *          such that all of them are solved by a single LAPACK call. The solutions are scattered back.
+	 * @param [in] fbm Factorized diagonal Jacobian block
+	 * @param [in,out] vecRhs Right hand side vectors of all sensitivity systems, overwritten by the solutions
+	 * @param [in] offset Offset of the block in the right hand side vectors
+	 * @return @c true if the solution process was successful, otherwise @c false
+	 */
+	bool solveSensitivityBlock(const linalg::FactorizableBandMatrix& fbm, std::vector<double*>& vecRhs, int offset)
+	{
+		if (vecRhs.size() == 1)
+			return fbm.solve(vecRhs[0] + offset);
+
+		const unsigned int blockSize = fbm.rows();
+		std::vector<double> rhs(blockSize * vecRhs.size());
+		for (unsigned int param = 0; param < vecRhs.size(); ++param)
+			std::copy(vecRhs[param] + offset, vecRhs[param] + offset + blockSize, rhs.data() + param * blockSize);
+
+		const bool result = fbm.solve(rhs.data(), vecRhs.size());
+
+		for (unsigned int param = 0; param < vecRhs.size(); ++param)
+			std::copy(rhs.data() + param * blockSize, rhs.data() + (param + 1) * blockSize, vecRhs[param] + offset);
+
+		return result;
+	}
+}
+
 void GeneralRateModel::applyInitialCondition(IParameterProvider& paramProvider, double* const vecStateY, double* const vecStateYdot)
 {
 	// Check if INIT_STATE is present
@@ -157,9 +188,6 @@ void GeneralRateModel::consistentInitialState(double t, unsigned int secIdx, dou
 {
 	BENCH_SCOPE(_timerConsistentInit);
 
-	// TODO: Check memory consumption and offsets
-	const unsigned int requiredMem = _binding->consistentInitializationWorkspaceSize();
-
 	Indexer idxr(_disc);
 
 	// Step 1: Solve algebraic equations
@@ -167,39 +195,98 @@ void GeneralRateModel::consistentInitialState(double t, unsigned int secIdx, dou
 	// Step 1a: Compute quasi-stationary binding model state
 	if (_binding->hasAlgebraicEquations())
 	{
-		//Problem capturing variables here
+		// The binding model requires band compressed seed vectors, which cover its dense Jacobian of the bound states
+		// in a shell. We temporarily replace the colored seed vectors of the particle blocks.
+		const unsigned int bndDiagDir = _disc.strideBound - 1;
+		if (adY)
+		{
+#ifdef CADET_PARALLELIZE
+			tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+#else
+			for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+#endif
+			{
+				ad::prepareAdVectorSeedsForBandMatrix(adY + idxr.offsetCp(pblk), adDirOffset, idxr.strideParBlock(), bndDiagDir, bndDiagDir, bndDiagDir);
+			} CADET_PARFOR_END;
+		}
+
+		// The shells of all particles are split into batches of consecutive shells, which are solved in parallel.
+		// Each batch has its own workspace and working matrix.
+		const unsigned int nShells = _consInitShells.size();
+		const unsigned int nBatches = numConsistentInitBatches();
+		const unsigned int batchMem = _binding->consistentInitializationBatchWorkspaceSize() + _disc.strideBound * _disc.strideBound;
+
+		// Converged bound states of a previous run in the same section serve as initial guesses
+		double* cache = nullptr;
+		bool cacheValid = false;
+		if (_consInitUseCache)
+		{
+			std::vector<double>& secCache = _consInitCache[secIdx];
+			cacheValid = !secCache.empty();
+			if (!cacheValid)
+				secCache.resize(nShells * _disc.strideBound);
+			cache = secCache.data();
+		}
+
 #ifdef CADET_PARALLELIZE
 		BENCH_SCOPE(_timerConsistentInitPar);
-		tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+		tbb::parallel_for(size_t(0), size_t(nBatches), [&](size_t batch)
 #else
-		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		for (unsigned int batch = 0; batch < nBatches; ++batch)
 #endif
 		{
-			// Reuse memory of band matrix for dense matrix
-			linalg::DenseMatrixView jacobianMatrix(_jacPdisc[pblk].data(), _jacPdisc[pblk].pivot(), _disc.strideBound, _disc.strideBound);
+			const unsigned int first = batch * _consInitBatchSize;
+			const unsigned int len = std::min(_consInitBatchSize, nShells - first);
 
-			// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
-			const double z = 1.0 / static_cast<double>(_disc.nCol) * (0.5 + pblk);
+			double* const workspace = _consInitWorkspace.data() + batch * batchMem;
+			linalg::DenseMatrixView jacobianMatrix(workspace + _binding->consistentInitializationBatchWorkspaceSize(),
+				_consInitPivot.data() + batch * _disc.strideBound, _disc.strideBound, _disc.strideBound);
 
-			// This loop cannot be run in parallel without creating a Jacobian matrix for each one which would increase memory usage
-			for(size_t shell = 0; shell < size_t(_disc.nPar); shell++)
+			double* const batchCache = cache ? cache + first * _disc.strideBound : nullptr;
+			_consInitBatchStats[batch] = _binding->consistentInitialStateBatch(t, secIdx, _consInitShells.data() + first, len, vecStateY,
+				cacheValid ? batchCache : nullptr, errorTol, adRes, adY, adDirOffset, bndDiagDir, bndDiagDir, bndDiagDir, workspace, jacobianMatrix);
+
+			// Update cache with converged bound states
+			if (batchCache)
 			{
-				const int localOffsetToParticle = idxr.offsetCp(pblk);
-				const int localOffsetInParticle = static_cast<int>(shell) * idxr.strideParShell() + idxr.strideParLiquid();
+				for (unsigned int i = 0; i < len; ++i)
+				{
+					const ParticleShell& shell = _consInitShells[first + i];
+					double const* const q = vecStateY + shell.particleOffset + shell.shellOffset;
+					std::copy(q, q + _disc.strideBound, batchCache + i * _disc.strideBound);
+				}
+			}
+		} CADET_PARFOR_END;
+
+		ConsistentInitStats stats{ 0u, 0u, 0u, 0u };
+		for (unsigned int batch = 0; batch < nBatches; ++batch)
+		{
+			stats.numShells += _consInitBatchStats[batch].numShells;
+			stats.numGuesses += _consInitBatchStats[batch].numGuesses;
+			stats.numGuessesUsed += _consInitBatchStats[batch].numGuessesUsed;
+			stats.numSkipped += _consInitBatchStats[batch].numSkipped;
+		}
 
-				// Get pointer to q variables in a shell of particle pblk
-				double* const qShell = vecStateY + localOffsetToParticle + localOffsetInParticle;
-				active* const localAdRes = adRes ? adRes + localOffsetToParticle : nullptr;
-				active* const localAdY = adY ? adY + localOffsetToParticle : nullptr;
+		_consInitStats.numShells += stats.numShells;
+		_consInitStats.numGuesses += stats.numGuesses;
+		_consInitStats.numGuessesUsed += stats.numGuessesUsed;
+		_consInitStats.numSkipped += stats.numSkipped;
 
-				// We are essentially creating a 2d vector of blocks out of a linear strip of memory
-				const unsigned int offset = requiredMem * (_disc.nPar * pblk + shell);
+		LOG(Debug) << "Consistent initialization of unit " << _unitOpIdx << " in section " << secIdx << ": " << stats.numGuessesUsed << " of "
+			<< stats.numGuesses << " cached guesses used, " << stats.numSkipped << " of " << stats.numShells << " shells already consistent";
 
-				// Solve algebraic variables
-				_binding->consistentInitialState(t, z, _parCenterRadius[shell], secIdx, qShell, errorTol, localAdRes, localAdY,
-					localOffsetInParticle, adDirOffset, _jacP[0].lowerBandwidth(), _jacP[0].lowerBandwidth(), _jacP[0].upperBandwidth(), _tempState + offset, jacobianMatrix);
-			}
-		} CADET_PARFOR_END;
+		// Restore colored seed vectors
+		if (adY)
+		{
+#ifdef CADET_PARALLELIZE
+			tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+#else
+			for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+#endif
+			{
+				ad::prepareAdVectorSeedsForColoring(adY + idxr.offsetCp(pblk), adDirOffset, _jacPadColors);
+			} CADET_PARFOR_END;
+		}
 	}
 
 	// Step 1b: Compute fluxes j_f
@@ -266,6 +353,9 @@ void GeneralRateModel::consistentInitialTimeDerivative(double t, unsigned int se
 
 	Indexer idxr(_disc);
 
+	// The diagonal Jacobian blocks are overwritten, so their factorization cannot be reused in linearSolve()
+	_factorizedAlpha = 0.0;
+
 	// Step 2: Compute the correct time derivative of the state vector
 
 	// Step 2a: Assemble, factorize, and solve diagonal blocks of linear system
@@ -508,6 +598,9 @@ void GeneralRateModel::leanConsistentInitialTimeDerivative(double t, double time
 
 	Indexer idxr(_disc);
 
+	// The diagonal Jacobian blocks are overwritten, so their factorization cannot be reused in linearSolve()
+	_factorizedAlpha = 0.0;
+
 	// Step 2: Compute the correct time derivative of the state vector
 
 	// Step 2a: Assemble, factorize, and solve column bulk block of linear system
@@ -626,48 +719,63 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 
 	Indexer idxr(_disc);
 
-	for (unsigned int param = 0; param < vecSensY.size(); ++param)
+	// The diagonal Jacobian blocks are overwritten, so their factorization cannot be reused in linearSolve()
+	_factorizedAlpha = 0.0;
+
+	const unsigned int nSens = vecSensY.size();
+	if (nSens == 0)
+		return;
+
+	// Copy parameter derivatives from AD to time derivatives and negate them
+	for (unsigned int param = 0; param < nSens; ++param)
 	{
-		double* const sensY = vecSensY[param];
 		double* const sensYdot = vecSensYdot[param];
-
-		// Copy parameter derivative from AD to tempState and negate it
 		for (unsigned int i = _disc.nComp; i < numDofs(); ++i)
 			sensYdot[i] = -adRes[i].getADValue(param);
+	}
 
-		// Step 1: Solve algebraic equations
+	// Step 1: Solve algebraic equations
 
-		// Step 1a: Compute quasi-stationary binding model state
-		if (_binding->hasAlgebraicEquations())
-		{
+	// Step 1a: Compute quasi-stationary binding model state
+	// The Jacobian of the algebraic equations is the same for all parameters, which allows to
+	// factorize it only once per shell and to solve all sensitivity systems together
+	if (_binding->hasAlgebraicEquations())
+	{
 #ifdef CADET_PARALLELIZE
-			BENCH_SCOPE(_timerConsistentInitPar);
-			tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+		BENCH_SCOPE(_timerConsistentInitPar);
+		tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
 #else
-			for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
 #endif
-			{
-				// Get algebraic block
-				unsigned int algStart = 0;
-				unsigned int algLen = 0;
-				_binding->getAlgebraicBlock(algStart, algLen);
+		{
+			// Get algebraic block
+			unsigned int algStart = 0;
+			unsigned int algLen = 0;
+			_binding->getAlgebraicBlock(algStart, algLen);
 
-				// Reuse memory of band matrix for dense matrix
-				linalg::DenseMatrixView jacobianMatrix(_jacPdisc[pblk].data(), _jacPdisc[pblk].pivot(), algLen, algLen);
+			// Reuse memory of band matrix for dense matrix
+			linalg::DenseMatrixView jacobianMatrix(_jacPdisc[pblk].data(), _jacPdisc[pblk].pivot(), algLen, algLen);
 
-				for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
-				{
-					const unsigned int jacRowOffset = shell * static_cast<unsigned int>(idxr.strideParShell()) + static_cast<unsigned int>(idxr.strideParLiquid());
-					const int localCpOffset = idxr.offsetCp(pblk) + static_cast<int>(shell) * idxr.strideParShell();
-					const int localOffset = localCpOffset + idxr.strideParLiquid();
+			// Right hand sides of all sensitivity systems
+			std::vector<double> algRhs(algLen * nSens);
 
+			for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
+			{
+				const unsigned int jacRowOffset = shell * static_cast<unsigned int>(idxr.strideParShell()) + static_cast<unsigned int>(idxr.strideParLiquid());
+				const int localCpOffset = idxr.offsetCp(pblk) + static_cast<int>(shell) * idxr.strideParShell();
+				const int localOffset = localCpOffset + idxr.strideParLiquid();
+
+				for (unsigned int param = 0; param < nSens; ++param)
+				{
 					// Get pointer to q variables in a shell of particle pblk
-					double* const qShell = sensY + localOffset;
+					double* const qShell = vecSensY[param] + localOffset;
 					// Pointer to -dF / dp
-					double* const dFdP = sensYdot + localOffset;
+					double* const dFdP = vecSensYdot[param] + localOffset;
 					// Pointer to c_p variables in this shell
-					double* const cpShell = sensY + localCpOffset;
-			
+					double* const cpShell = vecSensY[param] + localCpOffset;
+					// Right hand side of this parameter
+					double* const rhs = algRhs.data() + param * algLen;
+
 					// In general, the linear system looks like this
 					// [c_p | q_diff | q_alg | q_diff ] * state + dF /dp = 0
 					// We want to solve the q_alg block, which means we have to solve
@@ -675,148 +783,154 @@ void GeneralRateModel::consistentInitialSensitivity(const active& t, unsigned in
 					// Note that we do not have to worry about fluxes since we are dealing
 					// with bound states here.
 
-					// Overwrite state with right hand side
-
-					// Copy -dF / dp to state
-					std::copy(dFdP + algStart, dFdP + algStart + algLen, qShell + algStart);
+					// Copy -dF / dp to right hand side
+					std::copy(dFdP + algStart, dFdP + algStart + algLen, rhs);
 
 					// Subtract [c_p | q_diff] * state
 					_jacP[pblk].submatrixMultiplyVector(cpShell, jacRowOffset + algStart, -idxr.strideParLiquid() - static_cast<int>(algStart), 
-						algLen, static_cast<unsigned int>(idxr.strideParLiquid()) + algStart, -1.0, 1.0, qShell + algStart);
+						algLen, static_cast<unsigned int>(idxr.strideParLiquid()) + algStart, -1.0, 1.0, rhs);
 
 					// Subtract [q_diff] * state (potential differential block behind q_alg block)
 					if (algStart + algLen < _disc.strideBound)
 						_jacP[pblk].submatrixMultiplyVector(qShell + algStart + algLen, jacRowOffset + algStart, algLen, 
-							algLen, _disc.strideBound - algStart - algLen, -1.0, 1.0, qShell + algStart);
+							algLen, _disc.strideBound - algStart - algLen, -1.0, 1.0, rhs);
+				}
 
-					// Copy main block to dense matrix
-					jacobianMatrix.copySubmatrixFromBanded(_jacP[pblk], jacRowOffset + algStart, 0, algLen, algLen);
+				// Copy main block to dense matrix
+				jacobianMatrix.copySubmatrixFromBanded(_jacP[pblk], jacRowOffset + algStart, 0, algLen, algLen);
 
-					// Solve algebraic variables
-					jacobianMatrix.factorize();
-					jacobianMatrix.solve(qShell + algStart);
-				}
-			} CADET_PARFOR_END;
-		}
+				// Solve algebraic variables of all sensitivity systems
+				jacobianMatrix.factorize();
+				jacobianMatrix.solve(algRhs.data(), nSens);
+
+				for (unsigned int param = 0; param < nSens; ++param)
+					std::copy(algRhs.data() + param * algLen, algRhs.data() + (param + 1) * algLen, vecSensY[param] + localOffset + algStart);
+			}
+		} CADET_PARFOR_END;
+	}
+
+	for (unsigned int param = 0; param < nSens; ++param)
+	{
+		double* const sensY = vecSensY[param];
+		double* const sensYdot = vecSensYdot[param];
 
 		// Step 1b: Compute fluxes j_f, right hand side is -dF / dp
 		std::copy(sensYdot + idxr.offsetJf(), sensYdot + numDofs(), sensY + idxr.offsetJf());
 
 		solveForFluxes(sensY, idxr);
 
-		// Step 2: Compute the correct time derivative of the state vector
-
-		// Step 2a: Assemble, factorize, and solve diagonal blocks of linear system
-
-		// Compute right hand side by adding -dF / dy * s = -J * s to -dF / dp which is already stored in sensYdot
+		// Compute right hand side of step 2a by adding -dF / dy * s = -J * s to -dF / dp which is already stored in sensYdot
 		multiplyWithJacobian(sensY, -1.0, 1.0, sensYdot);
 
 		// Note that we have correctly negated the right hand side
+	}
+
+	// Step 2: Compute the correct time derivative of the state vector
 
-		// Threads that are done with the bulk column blocks can proceed to the particle blocks
+	// Step 2a: Assemble, factorize, and solve diagonal blocks of linear system
+	// The matrix is the same for all parameters, so it is factorized once and applied to all right hand sides
+
+	// Threads that are done with the bulk column blocks can proceed to the particle blocks
 #ifdef CADET_PARALLELIZE
-		BENCH_START(_timerConsistentInitPar);
-		tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+	BENCH_START(_timerConsistentInitPar);
+	tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
 #else
-		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
 #endif
+	{
+		// Assemble
+		linalg::FactorizableBandMatrix& fbm = _jacCdisc[comp];
+		fbm.setAll(0.0);
+		addTimeDerivativeToJacobianColumnBlock(fbm, idxr, 1.0, static_cast<double>(timeFactor));
+
+		// Factorize
+		const bool result = fbm.factorize();
+		if (!result)
 		{
-			// Assemble
-			linalg::FactorizableBandMatrix& fbm = _jacCdisc[comp];
-			fbm.setAll(0.0);
-			addTimeDerivativeToJacobianColumnBlock(fbm, idxr, 1.0, static_cast<double>(timeFactor));
-
-			// Factorize
-			const bool result = fbm.factorize();
-			if (!result)
-			{
-				LOG(Error) << "Factorize() failed for comp " << comp;
-			}
+			LOG(Error) << "Factorize() failed for comp " << comp;
+		}
 
-			// Solve
-			const bool result2 = fbm.solve(sensYdot + comp * idxr.strideColComp() + idxr.offsetC());
-			if (!result2)
-			{
-				LOG(Error) << "Solve() failed for comp " << comp;
-			}
-		} CADET_PARFOR_END;
+		// Solve
+		const bool result2 = solveSensitivityBlock(fbm, vecSensYdot, comp * idxr.strideColComp() + idxr.offsetC());
+		if (!result2)
+		{
+			LOG(Error) << "Solve() failed for comp " << comp;
+		}
+	} CADET_PARFOR_END;
 
-		// Process the particle blocks
+	// Process the particle blocks
 #ifdef CADET_PARALLELIZE
-		tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
 #else
-		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
 #endif
+	{
+		// Assemble
+		linalg::FactorizableBandMatrix& fbm = _jacPdisc[pblk];
+		fbm.setAll(0.0);
+
+		const double invBetaP = 1.0 / static_cast<double>(_parPorosity) - 1.0;
+		linalg::FactorizableBandMatrix::RowIterator jac = fbm.row(0);
+		for (unsigned int j = 0; j < _disc.nPar; ++j)
 		{
-			// Assemble
-			linalg::FactorizableBandMatrix& fbm = _jacPdisc[pblk];
-			fbm.setAll(0.0);
+			// Mobile phase
+			addMobilePhaseTimeDerivativeToJacobianParticleBlock(jac, idxr, 1.0, invBetaP, static_cast<double>(timeFactor));
 
-			const double invBetaP = 1.0 / static_cast<double>(_parPorosity) - 1.0;
-			linalg::FactorizableBandMatrix::RowIterator jac = fbm.row(0);
-			for (unsigned int j = 0; j < _disc.nPar; ++j)
-			{
-				// Mobile phase
-				addMobilePhaseTimeDerivativeToJacobianParticleBlock(jac, idxr, 1.0, invBetaP, static_cast<double>(timeFactor));
+			// Stationary phase
+			// Populate matrix with time derivative Jacobian first
+			_binding->jacobianAddDiscretized(static_cast<double>(timeFactor), jac);
 
-				// Stationary phase
-				// Populate matrix with time derivative Jacobian first
-				_binding->jacobianAddDiscretized(static_cast<double>(timeFactor), jac);
+			// Overwrite rows corresponding to algebraic equations with the Jacobian and set right hand side to 0
+			if (_binding->hasAlgebraicEquations())
+			{
+				// Get start and length of algebraic block
+				unsigned int algStart = 0;
+				unsigned int algLen = 0;
+				_binding->getAlgebraicBlock(algStart, algLen);
 
-				// Overwrite rows corresponding to algebraic equations with the Jacobian and set right hand side to 0
-				if (_binding->hasAlgebraicEquations())
-				{
-					// Get start and length of algebraic block
-					unsigned int algStart = 0;
-					unsigned int algLen = 0;
-					_binding->getAlgebraicBlock(algStart, algLen);
-
-					// Get row iterators to algebraic block
-					linalg::FactorizableBandMatrix::RowIterator jacAlg = jac;
-					jacAlg += algStart;
-					linalg::BandMatrix::RowIterator origJacobian = _jacP[pblk].row(j * static_cast<unsigned int>(idxr.strideParShell()) + static_cast<unsigned int>(idxr.strideParLiquid()) + algStart);
-
-					// Pointer to right hand side of algebraic block
-					double* const qShellDot = sensYdot + idxr.offsetCp(pblk) + static_cast<int>(j) * idxr.strideParShell() + idxr.strideParLiquid() + static_cast<int>(algStart);
-
-					// Copy rows and reset right hand side
-					for (unsigned int algRow = 0; algRow < algLen; ++algRow, ++jacAlg, ++origJacobian)
-					{
-						jacAlg.copyRowFrom(origJacobian);
-
-						// Right hand side is -\frac{\partial^2 res(t, y, \dot{y})}{\partial p \partial t}
-						// If the residual is not explicitly depending on time, this expression is 0
-						// @todo This is wrong if external functions are used. Take that into account!
-						qShellDot[algRow] = 0.0;
-					}
-				}
+				// Get row iterators to algebraic block
+				linalg::FactorizableBandMatrix::RowIterator jacAlg = jac;
+				jacAlg += algStart;
+				linalg::BandMatrix::RowIterator origJacobian = _jacP[pblk].row(j * static_cast<unsigned int>(idxr.strideParShell()) + static_cast<unsigned int>(idxr.strideParLiquid()) + algStart);
 
-				// Advance pointers over all bound states
-				jac += idxr.strideParBound();
-			}   
+				// Copy rows
+				for (unsigned int algRow = 0; algRow < algLen; ++algRow, ++jacAlg, ++origJacobian)
+					jacAlg.copyRowFrom(origJacobian);
 
-			// Factorize
-			const bool result = fbm.factorize();
-			if (!result)
-			{
-				LOG(Error) << "Factorize() failed for par block " << pblk;
+				// Right hand side is -\frac{\partial^2 res(t, y, \dot{y})}{\partial p \partial t}
+				// If the residual is not explicitly depending on time, this expression is 0
+				// @todo This is wrong if external functions are used. Take that into account!
+				const int algOffset = idxr.offsetCp(pblk) + static_cast<int>(j) * idxr.strideParShell() + idxr.strideParLiquid() + static_cast<int>(algStart);
+				for (unsigned int param = 0; param < nSens; ++param)
+					std::fill(vecSensYdot[param] + algOffset, vecSensYdot[param] + algOffset + algLen, 0.0);
 			}
 
-			// Solve
-			const bool result2 = fbm.solve(sensYdot + idxr.offsetCp(pblk));
-			if (!result2)
-			{
-				LOG(Error) << "Solve() failed for par block " << pblk;
-			}
-		} CADET_PARFOR_END;
+			// Advance pointers over all bound states
+			jac += idxr.strideParBound();
+		}
+
+		// Factorize
+		const bool result = fbm.factorize();
+		if (!result)
+		{
+			LOG(Error) << "Factorize() failed for par block " << pblk;
+		}
+
+		// Solve
+		const bool result2 = solveSensitivityBlock(fbm, vecSensYdot, idxr.offsetCp(pblk));
+		if (!result2)
+		{
+			LOG(Error) << "Solve() failed for par block " << pblk;
+		}
+	} CADET_PARFOR_END;
 
 #ifdef CADET_PARALLELIZE
-		BENCH_STOP(_timerConsistentInitPar);
+	BENCH_STOP(_timerConsistentInitPar);
 #endif
 
-		// Step 2b: Solve for fluxes j_f by backward substitution
-		solveForFluxes(sensYdot, idxr);
-	}
+	// Step 2b: Solve for fluxes j_f by backward substitution
+	for (unsigned int param = 0; param < nSens; ++param)
+		solveForFluxes(vecSensYdot[param], idxr);
 }
 
 /**
@@ -878,7 +992,14 @@ void GeneralRateModel::leanConsistentInitialSensitivity(const active& t, unsigne
 
 	Indexer idxr(_disc);
 
-	for (unsigned int param = 0; param < vecSensY.size(); ++param)
+	// The diagonal Jacobian blocks are overwritten, so their factorization cannot be reused in linearSolve()
+	_factorizedAlpha = 0.0;
+
+	const unsigned int nSens = vecSensY.size();
+	if (nSens == 0)
+		return;
+
+	for (unsigned int param = 0; param < nSens; ++param)
 	{
 		double* const sensY = vecSensY[param];
 		double* const sensYdot = vecSensYdot[param];
@@ -895,49 +1016,51 @@ void GeneralRateModel::leanConsistentInitialSensitivity(const active& t, unsigne
 
 		solveForFluxes(sensY, idxr);
 
-		// Step 2: Compute the correct time derivative of the state vector
-
-		// Step 2a: Assemble, factorize, and solve diagonal blocks of linear system
-
-		// Compute right hand side by adding -dF / dy * s = -J * s to -dF / dp which is already stored in sensYdot
+		// Compute right hand side of step 2a by adding -dF / dy * s = -J * s to -dF / dp which is already stored in sensYdot
 		multiplyWithJacobian(sensY, -1.0, 1.0, sensYdot);
 
 		// Note that we have correctly negated the right hand side
+	}
+
+	// Step 2: Compute the correct time derivative of the state vector
+
+	// Step 2a: Assemble, factorize, and solve diagonal blocks of linear system
+	// The matrix is the same for all parameters, so it is factorized once and applied to all right hand sides
 
 #ifdef CADET_PARALLELIZE
-		BENCH_START(_timerConsistentInitPar);
-		tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+	BENCH_START(_timerConsistentInitPar);
+	tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
 #else
-		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
 #endif
+	{
+		// Assemble
+		linalg::FactorizableBandMatrix& fbm = _jacCdisc[comp];
+		fbm.setAll(0.0);
+		addTimeDerivativeToJacobianColumnBlock(fbm, idxr, 1.0, static_cast<double>(timeFactor));
+
+		// Factorize
+		const bool result = fbm.factorize();
+		if (!result)
 		{
-			// Assemble
-			linalg::FactorizableBandMatrix& fbm = _jacCdisc[comp];
-			fbm.setAll(0.0);
-			addTimeDerivativeToJacobianColumnBlock(fbm, idxr, 1.0, static_cast<double>(timeFactor));
-
-			// Factorize
-			const bool result = fbm.factorize();
-			if (!result)
-			{
-				LOG(Error) << "Factorize() failed for comp " << comp;
-			}
+			LOG(Error) << "Factorize() failed for comp " << comp;
+		}
 
-			// Solve
-			const bool result2 = fbm.solve(sensYdot + comp * idxr.strideColComp() + idxr.offsetC());
-			if (!result2)
-			{
-				LOG(Error) << "Solve() failed for comp " << comp;
-			}
-		} CADET_PARFOR_END;
+		// Solve
+		const bool result2 = solveSensitivityBlock(fbm, vecSensYdot, comp * idxr.strideColComp() + idxr.offsetC());
+		if (!result2)
+		{
+			LOG(Error) << "Solve() failed for comp " << comp;
+		}
+	} CADET_PARFOR_END;
 
 #ifdef CADET_PARALLELIZE
-		BENCH_STOP(_timerConsistentInitPar);
+	BENCH_STOP(_timerConsistentInitPar);
 #endif
 
-		// Step 2b: Solve for fluxes j_f by backward substitution
-		solveForFluxes(sensYdot, idxr);
-	}
+	// Step 2b: Solve for fluxes j_f by backward substitution
+	for (unsigned int param = 0; param < nSens; ++param)
+		solveForFluxes(vecSensYdot[param], idxr);
 }
 
 /**
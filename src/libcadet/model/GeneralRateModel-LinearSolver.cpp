@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <cmath>
 
 #include "LoggingUtils.hpp"
 #include "Logging.hpp"
@@ -94,9 +95,19 @@ namespace model
  *                 @f[ y_f = b_f - \sum_{i=0}^{N_z} J_{f,i} y_i. @f]
  *              -# Solve the Schur-complement @f$ S x_f = y_f @f$ using an iterative method that only requires
  *                 matrix-vector products. The already inverted diagonal blocks @f$ J_i^{-1} @f$ come in handy here.
+ *                 If the direct Schur-complement solver is selected, @f$ S @f$ is assembled and LU factorized
+ *                 once per Jacobian factorization instead (see assembleSchurComplement()).
  *              -# Solve the rest of the @f$ U x = y @f$ system by backward substitution. To be more precise, compute
  *                 @f[ x_i = y_i - J_i^{-1} J_{i,f} y_f. @f]
  *
+ *          If the sparse direct solver is selected, the decomposition is not used and the full Jacobian is
+ *          factorized by a sparse LU instead (see linearSolveSparse()).
+ *
+ *          During time integration, IDAS passes the forward sensitivity systems to this function one at a
+ *          time, so each sensitivity requires its own forward and backward substitution and Schur-complement
+ *          solve. Solving all sensitivity systems with multiple right hand sides is only done in the
+ *          consistent initialization (see consistentInitialSensitivity()), where the model owns all systems.
+ *
  *
  * @param [in] t Current time point
  * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
@@ -116,9 +127,15 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 
 	Indexer idxr(_disc);
 
+	// The full Jacobian is handled by the sparse direct solver if selected
+	if (_sparseSolve)
+		return linearSolveSparse(timeFactor, alpha, rhs, idxr);
+
 	// ==== Step 1: Factorize diagonal Jacobian blocks
 
 	// Factorize partial Jacobians only if required
+	double alphaRatio = 1.0;
+	const bool factorize = needsFactorization(alpha, alphaRatio);
 
 #ifdef CADET_PARALLELIZE
 	tbb::flow::graph g;
@@ -128,8 +145,10 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 	node_t A(g, [&](msg_t)
 	{
 #endif
-		if (_factorizeJacobian)
+		if (factorize)
 		{
+			BENCH_SCOPE(_timerFactorize);
+
 			// Assemble and factorize discretized system Jacobians
 			// Threads that are done with the bulk column blocks can proceed to the particle blocks
 
@@ -158,8 +177,10 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 	node_t B(g, [&](msg_t)
 	{
 #endif
-		if (_factorizeJacobian)
+		if (factorize)
 		{
+			BENCH_SCOPE(_timerFactorizePar);
+
 #ifdef CADET_PARALLELIZE
 			tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
 #else
@@ -188,8 +209,9 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 	node_t C(g, [&](msg_t) 
 	{
 #endif
-		// Do not factorize again at next call without changed Jacobians
-		_factorizeJacobian = false;
+		// Assemble and factorize the Schur-complement from the freshly factorized diagonal blocks
+		if (_directSchur && factorize)
+			_schurFactorized = assembleSchurComplement(idxr);
 
 		_jacInlet.multiplySubtract(rhs, rhs + idxr.offsetC());
 	CADET_PARNODE_END;
@@ -253,26 +275,41 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 
 		// Now, rhs contains the full intermediate solution y = L^{-1} b
 
-		// Initialize temporary storage by copying over the fluxes
-		// Note that the rest of _tempState is zeroed out in schurComplementMatrixVector()
-		std::copy(rhs + idxr.offsetJf(), rhs + numDofs(), _tempState + idxr.offsetJf());
-
 		// ==== Step 3: Solve Schur-complement to get x_f = S^{-1} y_f
 		// Column and particle parts remain unchanged.
-		// The only thing to be done is the iterative (and approximate)
-		// solution of the Schur complement system:
+		// The only thing to be done is the solution of the Schur complement system:
 		//     S * x_f = y_f
 
-		// Note that rhs is updated in-place with the solution of the Schur-complement
-		// The temporary storage is only needed to hold the right hand side of the Schur-complement
-		const double tolerance = std::sqrt(static_cast<double>(numDofs())) * outerTol * _schurSafety;
+		if (_schurFactorized)
+		{
+			// Direct solution with the dense LU factorization of S (rhs is updated in-place)
+			if (cadet_unlikely(!_schurDense.solve(rhs + idxr.offsetJf())))
+			{
+				LOG(Error) << "Solve() failed for Schur-complement";
+			}
+
+			// Remove leftovers of the backward substitution of a previous solve with the same factorization
+			std::fill(_tempState + idxr.offsetC(), _tempState + idxr.offsetJf(), 0.0);
+		}
+		else
+		{
+			// Iterative (and approximate) solution
 
-		BENCH_START(_timerGmres);
-		const int gmresResult = _gmres.solve(tolerance, weight + idxr.offsetJf(), _tempState + idxr.offsetJf(), rhs + idxr.offsetJf());
-		BENCH_STOP(_timerGmres);
+			// Initialize temporary storage by copying over the fluxes
+			// Note that the rest of _tempState is zeroed out in schurComplementMatrixVector()
+			std::copy(rhs + idxr.offsetJf(), rhs + numDofs(), _tempState + idxr.offsetJf());
+
+			// Note that rhs is updated in-place with the solution of the Schur-complement
+			// The temporary storage is only needed to hold the right hand side of the Schur-complement
+			const double tolerance = std::sqrt(static_cast<double>(numDofs())) * outerTol * _schurSafety;
+
+			BENCH_START(_timerGmres);
+			const int gmresResult = _gmres.solve(tolerance, weight + idxr.offsetJf(), _tempState + idxr.offsetJf(), rhs + idxr.offsetJf());
+			BENCH_STOP(_timerGmres);
 
 			// Remove temporary results that are leftovers from schurComplementMatrixVector()
-		std::fill(_tempState + idxr.offsetC(), _tempState + idxr.offsetJf(), 0.0);
+			std::fill(_tempState + idxr.offsetC(), _tempState + idxr.offsetJf(), 0.0);
+		}
 
 		// At this point, rhs contains the intermediate solution [y_0, ..., y_{N_z}, x_f]
 
@@ -360,9 +397,72 @@ int GeneralRateModel::linearSolve(double t, double timeFactor, double alpha, dou
 #endif
 
 	// The full solution is now stored in rhs
+	correctReusedFactorization(alphaRatio, rhs, idxr);
 	return 0;
 }
 
+/**
+ * @brief Decides whether the time-discretized Jacobian has to be factorized in the current linear solve
+ * @details Without reuse (@c JACOBIAN_REUSE_TOL is @c 0), the Jacobian is factorized whenever it has been
+ *          updated. Otherwise, the last factorization is kept as long as the relative change of @f$ \alpha @f$
+ *          is below the threshold, that is, @f[ \left| \frac{\alpha}{\alpha_{\text{fact}}} - 1 \right| \leq \text{tol}, @f]
+ *          even if the Jacobian has been updated in the meantime (modified Newton method). The mismatch of
+ *          the stale iteration matrix is absorbed by correctReusedFactorization() and the outer Newton iteration.
+ *
+ *          The factorization and reuse counters are updated.
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [out] alphaRatio Ratio @f$ \alpha / \alpha_{\text{fact}} @f$ of the current and the factorized @f$ \alpha @f$
+ * @return @c true if the Jacobian has to be factorized, otherwise @c false
+ */
+bool GeneralRateModel::needsFactorization(double alpha, double& alphaRatio)
+{
+	alphaRatio = 1.0;
+
+	// Always factorize if there is no valid factorization
+	bool factorize = true;
+	if (_factorizedAlpha > 0.0)
+	{
+		if (_jacReuseTol > 0.0)
+			factorize = std::abs(alpha / _factorizedAlpha - 1.0) > _jacReuseTol;
+		else
+			factorize = _factorizeJacobian;
+	}
+
+	if (factorize)
+	{
+		_factorizedAlpha = alpha;
+		++_numFactorizations;
+	}
+	else if ((_jacReuseTol > 0.0) && (_factorizeJacobian || (alpha != _factorizedAlpha)))
+	{
+		alphaRatio = alpha / _factorizedAlpha;
+		++_numFactorizationReuses;
+	}
+
+	// Do not factorize again at next call without changed Jacobians
+	_factorizeJacobian = false;
+	return factorize;
+}
+
+/**
+ * @brief Corrects the solution of a linear system that has been solved with the factorization of a different @f$ \alpha @f$
+ * @details As in the direct linear solvers of IDAS, the solution is scaled by @f$ 2 / (1 + c_r) @f$, where
+ *          @f$ c_r = \alpha / \alpha_{\text{fact}} @f$. This accounts for the dominant time derivative part of the
+ *          iteration matrix. The inlet DOFs are not scaled since their Jacobian does not depend on @f$ \alpha @f$.
+ * @param [in] alphaRatio Ratio @f$ c_r = \alpha / \alpha_{\text{fact}} @f$ of the current and the factorized @f$ \alpha @f$
+ * @param [in,out] rhs Solution of the linear equation system with the reused factorization
+ * @param [in] idxr Indexer
+ */
+void GeneralRateModel::correctReusedFactorization(double alphaRatio, double* const rhs, const Indexer& idxr) const
+{
+	if (alphaRatio == 1.0)
+		return;
+
+	const double factor = 2.0 / (1.0 + alphaRatio);
+	for (unsigned int i = idxr.offsetC(); i < numDofs(); ++i)
+		rhs[i] *= factor;
+}
+
 /**
  * @brief Performs the matrix-vector product @f$ z = Sx @f$ with the Schur-complement @f$ S @f$ from the Jacobian
  * @details The Schur-complement @f$ S @f$ is given by
@@ -474,6 +574,420 @@ int GeneralRateModel::schurComplementMatrixVector(double const* x, double* z) co
 	return 0;
 }
 
+/**
+ * @brief Assembles and factorizes the Schur-complement @f$ S @f$ as dense matrix
+ * @details The Schur-complement
+ *          @f[ \begin{align}
+				S = I - \sum_{p=0}^{N_z}{J_{f,p} \, J_p^{-1} \, J_{p,f}}
+			\end{align} @f]
+ *          is assembled column by column using the already factorized diagonal blocks @f$ J_p @f$.
+ *          Since the off-diagonal blocks @f$ J_{p,f} @f$ are sparse, each of their nonzero elements
+ *          requires only one solve with a single diagonal block. The bulk blocks are processed in
+ *          parallel with respect to the component, the particle blocks with respect to the column cell.
+ *          This is race free because a flux DOF is coupled to exactly one bulk component block and
+ *          one particle block, hence the tasks of each phase write to disjoint columns of @f$ S @f$.
+ *
+ *          The bulk and particle parts of @c _tempState are used as scratch memory and are zeroed out on exit.
+ * @param [in] idxr Indexer
+ * @return @c true if the Schur-complement has been factorized successfully, otherwise @c false
+ */
+bool GeneralRateModel::assembleSchurComplement(const Indexer& idxr)
+{
+	BENCH_SCOPE(_timerSchurAssemble);
+
+	// Start with the identity matrix J_f
+	_schurDense.setAll(0.0);
+	for (unsigned int i = 0; i < _schurDense.rows(); ++i)
+		_schurDense.native(i, i) = 1.0;
+
+	// Subtract J_{f,0} * J_0^{-1} * J_{0,f}
+	const unsigned int nnzCF = _jacCF.numNonZero();
+	const unsigned int nnzFC = _jacFC.numNonZero();
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+#else
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+#endif
+	{
+		const unsigned int blkStart = comp * idxr.strideColComp();
+		const unsigned int blkEnd = blkStart + _disc.nCol;
+		double* const tmp = _tempState + idxr.offsetC() + blkStart;
+
+		for (unsigned int k = 0; k < nnzCF; ++k)
+		{
+			const unsigned int row = _jacCF.rows()[k];
+			if ((row < blkStart) || (row >= blkEnd))
+				continue;
+
+			// Compute column of J_0^{-1} * J_{0,f}
+			std::fill(tmp, tmp + _disc.nCol, 0.0);
+			tmp[row - blkStart] = _jacCF.values()[k];
+
+			const bool result = _jacCdisc[comp].solve(tmp);
+			if (cadet_unlikely(!result))
+			{
+				LOG(Error) << "Solve() failed for comp " << comp;
+			}
+
+			// Apply J_{f,0} and subtract from column of S
+			const unsigned int col = _jacCF.cols()[k];
+			for (unsigned int m = 0; m < nnzFC; ++m)
+			{
+				const unsigned int idx = _jacFC.cols()[m];
+				if ((idx >= blkStart) && (idx < blkEnd))
+					_schurDense.native(_jacFC.rows()[m], col) -= _jacFC.values()[m] * tmp[idx - blkStart];
+			}
+		}
+	} CADET_PARFOR_END;
+
+	// Subtract J_{f,p} * J_p^{-1} * J_{p,f}
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+#else
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+#endif
+	{
+		const linalg::DoubleSparseMatrix& jacPF = _jacPF[pblk];
+		const linalg::DoubleSparseMatrix& jacFP = _jacFP[pblk];
+		double* const tmp = _tempState + idxr.offsetCp(pblk);
+
+		for (unsigned int k = 0; k < jacPF.numNonZero(); ++k)
+		{
+			// Compute column of J_p^{-1} * J_{p,f}
+			std::fill(tmp, tmp + idxr.strideParBlock(), 0.0);
+			tmp[jacPF.rows()[k]] = jacPF.values()[k];
+
+			const bool result = _jacPdisc[pblk].solve(tmp);
+			if (cadet_unlikely(!result))
+			{
+				LOG(Error) << "Solve() failed for par block " << pblk;
+			}
+
+			// Apply J_{f,p} and subtract from column of S
+			const unsigned int col = jacPF.cols()[k];
+			for (unsigned int m = 0; m < jacFP.numNonZero(); ++m)
+				_schurDense.native(jacFP.rows()[m], col) -= jacFP.values()[m] * tmp[jacFP.cols()[m]];
+		}
+	} CADET_PARFOR_END;
+
+	// Leave clean scratch memory behind
+	std::fill(_tempState + idxr.offsetC(), _tempState + idxr.offsetJf(), 0.0);
+
+	const bool result = _schurDense.factorize();
+	if (cadet_unlikely(!result))
+	{
+		LOG(Warning) << "Factorize() failed for Schur-complement, falling back to GMRES";
+	}
+	return result;
+}
+
+/**
+ * @brief Solves the linear system with the full Jacobian by a sparse direct solver
+ * @details Instead of exploiting the block structure of the Jacobian (see linearSolve()), the time-discretized
+ *          Jacobian without the inlet DOFs is assembled into a sparse matrix and factorized by sparse LU. The
+ *          sparsity pattern is fixed. Its fill-reducing ordering and symbolic factorization are computed once
+ *          on first use, whereas the numeric factorization is repeated whenever the Jacobian has changed.
+ *
+ *          The inlet DOFs are treated as in linearSolve() since their Jacobian is the identity matrix.
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in,out] rhs On entry the right hand side of the linear equation system, on exit the solution
+ * @param [in] idxr Indexer
+ * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+ */
+int GeneralRateModel::linearSolveSparse(double timeFactor, double alpha, double* const rhs, const Indexer& idxr)
+{
+	double alphaRatio = 1.0;
+	if (needsFactorization(alpha, alphaRatio))
+	{
+		// The factorization of the transposed system in linearSolveTransposed() is overwritten
+		_factorizedAlphaTransposed = 0.0;
+
+		if (cadet_unlikely(!factorizeSparseJacobian(alpha, idxr, timeFactor)))
+		{
+			// Factorize again at next call
+			_factorizedAlpha = 0.0;
+			return 1;
+		}
+	}
+
+	// Solve J c_uo = b_uo - A * c_in = b_uo - A*b_in
+	_jacInlet.multiplySubtract(rhs, rhs + idxr.offsetC());
+
+	const bool result = _sparseSolver.solve(rhs + idxr.offsetC());
+	if (cadet_unlikely(!result))
+	{
+		LOG(Error) << "Solve() failed for sparse Jacobian";
+		return 1;
+	}
+
+	correctReusedFactorization(alphaRatio, rhs, idxr);
+	return 0;
+}
+
+/**
+ * @brief Solves the linear system with the transposed full Jacobian by a sparse direct solver
+ * @details The transposed time-discretized Jacobian is not formed explicitly. Instead, the full Jacobian
+ *          without inlet DOFs is assembled and factorized as in linearSolveSparse() and its factorization
+ *          is applied in transposed form. This is independent of the linear solver selected for linearSolve().
+ *
+ *          Since the inlet DOFs couple to the bulk cells via the block @f$ A @f$ below the identity matrix,
+ *          the transposed system is block upper triangular. Thus, the column DOFs are solved first and the
+ *          inlet DOFs are given by @f$ x_{\text{in}} = b_{\text{in}} - A^T x_{\text{uo}} @f$.
+ *
+ *          The factorization is shared with linearSolveSparse(). Assembling the Jacobian overwrites the
+ *          factorized diagonal blocks and, hence, invalidates the factorization of linearSolve().
+ * @param [in] t Current time point
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] outerTol Error tolerance for the solution of the linear system from outer Newton iteration
+ * @param [in,out] rhs On entry the right hand side of the linear equation system, on exit the solution
+ * @param [in] weight Vector with error weights
+ * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+ */
+int GeneralRateModel::linearSolveTransposed(double t, double timeFactor, double alpha, double outerTol, double* const rhs, double const* const weight)
+{
+	BENCH_SCOPE(_timerLinearSolve);
+
+	Indexer idxr(_disc);
+
+	if (_factorizeTransposed || (alpha != _factorizedAlphaTransposed))
+	{
+		_factorizedAlpha = 0.0;
+		_factorizedAlphaTransposed = 0.0;
+		++_numFactorizations;
+
+		if (cadet_unlikely(!factorizeSparseJacobian(alpha, idxr, timeFactor)))
+			return 1;
+
+		_factorizedAlphaTransposed = alpha;
+		_factorizeTransposed = false;
+	}
+
+	// Solve J^T x_uo = b_uo
+	const bool result = _sparseSolver.solveTransposed(rhs + idxr.offsetC());
+	if (cadet_unlikely(!result))
+	{
+		LOG(Error) << "Solve() failed for transposed sparse Jacobian";
+		return 1;
+	}
+
+	// Solve x_in = b_in - A^T x_uo
+	_jacInlet.transposedMultiplyAdd(rhs + idxr.offsetC(), rhs, -1.0);
+	return 0;
+}
+
+/**
+ * @brief Assembles the full time-discretized Jacobian (without inlet DOFs) and factorizes it by sparse LU
+ * @details The fill-reducing ordering and symbolic factorization are computed on first use only.
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] idxr Indexer
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ * @return @c true if the factorization was successful, otherwise @c false
+ */
+bool GeneralRateModel::factorizeSparseJacobian(double alpha, const Indexer& idxr, double timeFactor)
+{
+	BENCH_SCOPE(_timerSparseFactorize);
+
+	// Ordering and symbolic factorization are computed only once
+	if (cadet_unlikely(!_sparseSolver.analyzed()))
+	{
+		setupSparseJacobianPattern(idxr);
+		_sparseSolver.analyzePattern(_jacSparse);
+
+		LOG(Debug) << "Sparse Jacobian of unit " << _unitOpIdx << " has " << _jacSparse.numNonZero() << " elements, factors have "
+			<< _sparseSolver.numFactorNonZero() << " elements";
+	}
+
+	// Assemble and factorize
+	assembleSparseJacobian(alpha, idxr, timeFactor);
+
+	const bool result = _sparseSolver.factorize(_jacSparse);
+	if (cadet_unlikely(!result))
+	{
+		LOG(Error) << "Factorize() failed for sparse Jacobian";
+		return false;
+	}
+
+	if (_sparseSolver.numOffDiagonalPivots() > 0)
+	{
+		LOG(Debug) << "Chose " << _sparseSolver.numOffDiagonalPivots() << " off-diagonal pivots in sparse Jacobian factorization";
+	}
+
+	return true;
+}
+
+/**
+ * @brief Sets up the sparsity pattern of the full Jacobian (without inlet DOFs) in @c _jacSparse
+ * @details All elements inside the bands of the diagonal blocks are part of the pattern. The bulk blocks
+ *          reserve the larger bandwidth on both sides of the main diagonal such that the pattern remains
+ *          valid when the flow direction is reversed. The off-diagonal blocks have to be assembled
+ *          (see assembleOffdiagJac()). The positions of the diagonal elements and of the off-diagonal
+ *          block elements in the values array of @c _jacSparse are stored for assembleSparseJacobian().
+ * @param [in] idxr Indexer
+ */
+void GeneralRateModel::setupSparseJacobianPattern(const Indexer& idxr)
+{
+	const int nCol = static_cast<int>(_disc.nCol);
+	const int nParBlock = idxr.strideParBlock();
+	const int colBand = static_cast<int>(std::max(_jacC[0].lowerBandwidth(), _jacC[0].upperBandwidth()));
+	const int parLowerBand = static_cast<int>(_jacP[0].lowerBandwidth());
+	const int parUpperBand = static_cast<int>(_jacP[0].upperBandwidth());
+	const unsigned int offsetJf = idxr.offsetJf() - idxr.offsetC();
+
+	linalg::DoubleSparseMatrix pattern(_disc.nComp * _disc.nCol * (2 * colBand + 6) + _disc.nCol * nParBlock * (parLowerBand + parUpperBand + 1));
+
+	// Bulk blocks
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		const unsigned int offset = comp * idxr.strideColComp();
+		for (int i = 0; i < nCol; ++i)
+		{
+			for (int j = std::max(i - colBand, 0); j <= std::min(i + colBand, nCol - 1); ++j)
+				pattern.addElement(offset + i, offset + j, 0.0);
+		}
+	}
+
+	// Particle blocks
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		const unsigned int offset = idxr.offsetCp(pblk) - idxr.offsetC();
+		for (int i = 0; i < nParBlock; ++i)
+		{
+			for (int j = std::max(i - parLowerBand, 0); j <= std::min(i + parUpperBand, nParBlock - 1); ++j)
+				pattern.addElement(offset + i, offset + j, 0.0);
+		}
+	}
+
+	// Flux block J_f = I
+	for (unsigned int i = 0; i < _disc.nCol * _disc.nComp; ++i)
+		pattern.addElement(offsetJf + i, offsetJf + i, 0.0);
+
+	// Off-diagonal blocks
+	for (unsigned int k = 0; k < _jacCF.numNonZero(); ++k)
+		pattern.addElement(_jacCF.rows()[k], offsetJf + _jacCF.cols()[k], 0.0);
+
+	for (unsigned int k = 0; k < _jacFC.numNonZero(); ++k)
+		pattern.addElement(offsetJf + _jacFC.rows()[k], _jacFC.cols()[k], 0.0);
+
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		const unsigned int offset = idxr.offsetCp(pblk) - idxr.offsetC();
+		for (unsigned int k = 0; k < _jacPF[pblk].numNonZero(); ++k)
+			pattern.addElement(offset + _jacPF[pblk].rows()[k], offsetJf + _jacPF[pblk].cols()[k], 0.0);
+
+		for (unsigned int k = 0; k < _jacFP[pblk].numNonZero(); ++k)
+			pattern.addElement(offsetJf + _jacFP[pblk].rows()[k], offset + _jacFP[pblk].cols()[k], 0.0);
+	}
+
+	_jacSparse.assignPattern(numDofs() - idxr.offsetC(), pattern);
+
+	// Positions of the elements in the values array, the bands of the diagonal blocks are contiguous in each row
+	_jacSparseDiag.resize(_jacSparse.rows());
+	for (unsigned int i = 0; i < _jacSparse.rows(); ++i)
+		_jacSparseDiag[i] = _jacSparse.findElement(i, i);
+
+	_jacSparseOffdiag.clear();
+	_jacSparseOffdiag.reserve(_jacCF.numNonZero() + _jacFC.numNonZero() + _disc.nCol * (_jacPF[0].numNonZero() + _jacFP[0].numNonZero()));
+	for (unsigned int k = 0; k < _jacCF.numNonZero(); ++k)
+		_jacSparseOffdiag.push_back(_jacSparse.findElement(_jacCF.rows()[k], offsetJf + _jacCF.cols()[k]));
+
+	for (unsigned int k = 0; k < _jacFC.numNonZero(); ++k)
+		_jacSparseOffdiag.push_back(_jacSparse.findElement(offsetJf + _jacFC.rows()[k], _jacFC.cols()[k]));
+
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		const unsigned int offset = idxr.offsetCp(pblk) - idxr.offsetC();
+		for (unsigned int k = 0; k < _jacPF[pblk].numNonZero(); ++k)
+			_jacSparseOffdiag.push_back(_jacSparse.findElement(offset + _jacPF[pblk].rows()[k], offsetJf + _jacPF[pblk].cols()[k]));
+
+		for (unsigned int k = 0; k < _jacFP[pblk].numNonZero(); ++k)
+			_jacSparseOffdiag.push_back(_jacSparse.findElement(offsetJf + _jacFP[pblk].rows()[k], offset + _jacFP[pblk].cols()[k]));
+	}
+}
+
+/**
+ * @brief Assembles the full time-discretized Jacobian (without inlet DOFs) into @c _jacSparse
+ * @details The diagonal blocks are assembled by assembleDiscretizedJacobianColumnBlock() and
+ *          assembleDiscretizedJacobianParticleBlock() and copied to the sparse matrix in parallel.
+ *          The band matrices are not factorized.
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] idxr Indexer
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ */
+void GeneralRateModel::assembleSparseJacobian(double alpha, const Indexer& idxr, double timeFactor)
+{
+	_jacSparse.setAll(0.0);
+	std::vector<double>& values = _jacSparse.values();
+
+	const int nCol = static_cast<int>(_disc.nCol);
+	const int nParBlock = idxr.strideParBlock();
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+#else
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+#endif
+	{
+		assembleDiscretizedJacobianColumnBlock(comp, alpha, idxr, timeFactor);
+
+		const linalg::FactorizableBandMatrix& fbm = _jacCdisc[comp];
+		const int lb = static_cast<int>(fbm.lowerBandwidth());
+		const int ub = static_cast<int>(fbm.upperBandwidth());
+		const unsigned int offset = comp * idxr.strideColComp();
+		for (int i = 0; i < nCol; ++i)
+		{
+			double* const diag = values.data() + _jacSparseDiag[offset + i];
+			for (int d = -std::min(lb, i); d <= std::min(ub, nCol - 1 - i); ++d)
+				diag[d] = fbm(i, d);
+		}
+	} CADET_PARFOR_END;
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+#else
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+#endif
+	{
+		assembleDiscretizedJacobianParticleBlock(pblk, alpha, idxr, timeFactor);
+
+		const linalg::FactorizableBandMatrix& fbm = _jacPdisc[pblk];
+		const int lb = static_cast<int>(fbm.lowerBandwidth());
+		const int ub = static_cast<int>(fbm.upperBandwidth());
+		const unsigned int offset = idxr.offsetCp(pblk) - idxr.offsetC();
+		for (int i = 0; i < nParBlock; ++i)
+		{
+			double* const diag = values.data() + _jacSparseDiag[offset + i];
+			for (int d = -std::min(lb, i); d <= std::min(ub, nParBlock - 1 - i); ++d)
+				diag[d] = fbm(i, d);
+		}
+	} CADET_PARFOR_END;
+
+	// Flux block J_f = I and off-diagonal blocks
+	const unsigned int offsetJf = idxr.offsetJf() - idxr.offsetC();
+	for (unsigned int i = 0; i < _disc.nCol * _disc.nComp; ++i)
+		values[_jacSparseDiag[offsetJf + i]] = 1.0;
+
+	unsigned int const* pos = _jacSparseOffdiag.data();
+	for (unsigned int k = 0; k < _jacCF.numNonZero(); ++k, ++pos)
+		values[*pos] += _jacCF.values()[k];
+
+	for (unsigned int k = 0; k < _jacFC.numNonZero(); ++k, ++pos)
+		values[*pos] += _jacFC.values()[k];
+
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+	{
+		for (unsigned int k = 0; k < _jacPF[pblk].numNonZero(); ++k, ++pos)
+			values[*pos] += _jacPF[pblk].values()[k];
+
+		for (unsigned int k = 0; k < _jacFP[pblk].numNonZero(); ++k, ++pos)
+			values[*pos] += _jacFP[pblk].values()[k];
+	}
+
+	cadet_assert(pos == _jacSparseOffdiag.data() + _jacSparseOffdiag.size());
+}
+
 /**
  * @brief Assembles the column void Jacobian block @f$ J_0 @f$ of the time-discretized equations
  * @details The system \f[ \left( \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} \right) x = b \f]
@@ -546,6 +1060,31 @@ void GeneralRateModel::addTimeDerivativeToJacobianColumnBlock(linalg::Factorizab
  */
 void GeneralRateModel::assembleDiscretizedJacobianParticleBlock(unsigned int pblk, double alpha, const Indexer& idxr, double timeFactor)
 {
+	// Dispatch table of particle kernels indexed by _shellLayout
+	typedef void (GeneralRateModel::*ParticleKernel_t)(unsigned int, double, double);
+	static const ParticleKernel_t particleKernels[] = {
+		&GeneralRateModel::assembleDiscretizedJacobianParticleBlockImpl<DynamicShellLayout>,
+		&GeneralRateModel::assembleDiscretizedJacobianParticleBlockImpl<FixedShellLayout<1>>,
+		&GeneralRateModel::assembleDiscretizedJacobianParticleBlockImpl<FixedShellLayout<2>>,
+		&GeneralRateModel::assembleDiscretizedJacobianParticleBlockImpl<FixedShellLayout<3>>,
+		&GeneralRateModel::assembleDiscretizedJacobianParticleBlockImpl<FixedShellLayout<4>>
+	};
+
+	(this->*particleKernels[_shellLayout])(pblk, alpha, timeFactor);
+}
+
+/**
+ * @brief Assembles a particle Jacobian block @f$ J_i @f$ (@f$ i > 0 @f$) of the time-discretized equations
+ * @details Implements assembleDiscretizedJacobianParticleBlock() for the given shell layout.
+ * @param [in] pblk Index of the particle block
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ * @tparam ShellLayout_t Layout of a particle shell
+ */
+template <typename ShellLayout_t>
+void GeneralRateModel::assembleDiscretizedJacobianParticleBlockImpl(unsigned int pblk, double alpha, double timeFactor)
+{
+	const ShellLayout_t layout(_disc);
 	linalg::FactorizableBandMatrix& fbm = _jacPdisc[pblk];
 	const linalg::BandMatrix& bm = _jacP[pblk];
 
@@ -558,13 +1097,13 @@ void GeneralRateModel::assembleDiscretizedJacobianParticleBlock(unsigned int pbl
 	for (unsigned int j = 0; j < _disc.nPar; ++j)
 	{
 		// Mobile phase
-		addMobilePhaseTimeDerivativeToJacobianParticleBlock(jac, idxr, alpha, invBetaP, timeFactor);
+		addMobilePhaseTimeDerivativeToJacobianParticleBlock(jac, layout, alpha, invBetaP, timeFactor);
 
 		// Stationary phase
 		_binding->jacobianAddDiscretized(alpha * timeFactor, jac);
 
 		// Advance pointers over all bound states
-		jac += idxr.strideParBound();
+		jac += layout.strideParBound();
 	}
 }
 
@@ -580,25 +1119,42 @@ void GeneralRateModel::assembleDiscretizedJacobianParticleBlock(unsigned int pbl
  * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
  */
 void GeneralRateModel::addMobilePhaseTimeDerivativeToJacobianParticleBlock(linalg::FactorizableBandMatrix::RowIterator& jac, const Indexer& idxr, double alpha, double invBetaP, double timeFactor)
+{
+	addMobilePhaseTimeDerivativeToJacobianParticleBlock(jac, DynamicShellLayout(_disc), alpha, invBetaP, timeFactor);
+}
+
+/**
+ * @brief Adds Jacobian @f$ \frac{\partial F}{\partial \dot{y}} @f$ to bead mobile phase rows of system Jacobian
+ * @details Implements addMobilePhaseTimeDerivativeToJacobianParticleBlock() for the given shell layout.
+ * @param [in,out] jac On entry, RowIterator of the particle block pointing to the beginning of a bead shell;
+ *                     on exit, the iterator points to the end of the mobile phase
+ * @param [in] layout Layout of a particle shell
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] invBetaP Inverse porosity term @f$\frac{1}{\beta_p}@f$
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ * @tparam ShellLayout_t Layout of a particle shell
+ */
+template <typename ShellLayout_t>
+void GeneralRateModel::addMobilePhaseTimeDerivativeToJacobianParticleBlock(linalg::FactorizableBandMatrix::RowIterator& jac, const ShellLayout_t& layout, double alpha, double invBetaP, double timeFactor)
 {
 	// Compute total factor
 	alpha *= timeFactor;
 
 	// Mobile phase
-	for (int comp = 0; comp < static_cast<int>(_disc.nComp); ++comp, ++jac)
+	for (int comp = 0; comp < static_cast<int>(layout.nComp()); ++comp, ++jac)
 	{
 		// Add derviative with respect to dc_p / dt to Jacobian
 		jac[0] += alpha;
 
 		// Add derivative with respect to dq / dt to Jacobian
-		for (int i = 0; i < static_cast<int>(_disc.nBound[comp]); ++i)
+		for (int i = 0; i < static_cast<int>(layout.nBound(comp)); ++i)
 		{
 			// Index explanation:
 			//   -comp -> go back to beginning of liquid phase
 			//   + strideParLiquid() skip to solid phase
 			//   + offsetBoundComp() jump to component (skips all bound states of previous components)
 			//   + i go to current bound state
-			jac[idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i] += alpha * invBetaP;
+			jac[layout.strideParLiquid() - comp + layout.offsetBoundComp(comp) + i] += alpha * invBetaP;
 		}
 	}
 }
@@ -52,8 +52,10 @@ int schurComplementMultiplierGRM(void* userData, double const* x, double* z)
 
 GeneralRateModel::GeneralRateModel(UnitOpIdx unitOpIdx) : _unitOpIdx(unitOpIdx), _binding(nullptr),
 	_jacC(nullptr), _jacP(nullptr), _jacPF(nullptr), _jacFP(nullptr), _jacCdisc(nullptr), _jacPdisc(nullptr), _jacInlet(),
-	_analyticJac(true), _stencilMemory(sizeof(active) * Weno::maxStencilSize()), _wenoDerivatives(new double[Weno::maxStencilSize()]),
-	_weno(), _jacobianAdDirs(0), _factorizeJacobian(false), _tempState(nullptr)
+	_analyticJac(true), _analyticParamDeriv(false), _adDirectionPlanes(false), _stencilMemory(nullptr), _wenoMemory(nullptr), _wenoDerivatives(nullptr),
+	_weno(), _sensBindingParams(false), _jacobianAdDirs(0), _parAdDirs(0), _factorizeJacobian(false), _jacReuseTol(0.0), _factorizedAlpha(0.0),
+	_numFactorizations(0), _numFactorizationReuses(0), _tempState(nullptr), _shellLayout(0), _consInitBatchSize(1), _consInitUseCache(false),
+	_directSchur(false), _schurFactorized(false), _sparseSolve(false), _factorizeTransposed(true), _factorizedAlphaTransposed(0.0)
 {
 }
 
@@ -61,6 +63,8 @@ GeneralRateModel::~GeneralRateModel() CADET_NOEXCEPT
 {
 	delete[] _tempState;
 
+	delete[] _stencilMemory;
+	delete[] _wenoMemory;
 	delete[] _wenoDerivatives;
 
 	delete[] _jacPF;
@@ -164,11 +168,99 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 	const bool analyticJac = false;
 #endif
 
+	// Parameter derivatives of the residual (forward sensitivities) can be computed analytically instead of by AD
+	_analyticParamDeriv = false;
+	if (paramProvider.exists("USE_ANALYTIC_PARAM_DERIVATIVES"))
+		_analyticParamDeriv = paramProvider.getBool("USE_ANALYTIC_PARAM_DERIVATIVES");
+
+	// AD Jacobian of the transport terms can be computed by sweeps over direction planes instead of AD vectors
+	_adDirectionPlanes = false;
+	if (paramProvider.exists("USE_AD_DIRECTION_PLANES"))
+		_adDirectionPlanes = paramProvider.getBool("USE_AD_DIRECTION_PLANES");
+
 	// Initialize and configure GMRES for solving the Schur-complement
 	_gmres.initialize(_disc.nCol * _disc.nComp, paramProvider.getInt("MAX_KRYLOV"), linalg::toOrthogonalization(paramProvider.getInt("GS_TYPE")), paramProvider.getInt("MAX_RESTARTS"));
 	_gmres.matrixVectorMultiplier(&schurComplementMultiplierGRM, this);
 	_schurSafety = paramProvider.getDouble("SCHUR_SAFETY");
 
+	// Small Schur-complements can be assembled and factorized instead of using GMRES
+	_directSchur = false;
+	if (paramProvider.exists("LINEAR_SOLVER_SCHUR"))
+	{
+		const std::string schurSolver = paramProvider.getString("LINEAR_SOLVER_SCHUR");
+		if (schurSolver == "DIRECT")
+			_directSchur = true;
+		else if (schurSolver != "GMRES")
+			throw InvalidParameterException("Unknown Schur-complement solver " + schurSolver + " (expected GMRES or DIRECT)");
+	}
+
+	if (_directSchur)
+	{
+		const unsigned int maxDirectSize = paramProvider.exists("SCHUR_DIRECT_MAX_SIZE") ? paramProvider.getInt("SCHUR_DIRECT_MAX_SIZE") : 500;
+		if (_disc.nCol * _disc.nComp > maxDirectSize)
+		{
+			LOG(Warning) << "Schur-complement of unit " << _unitOpIdx << " has " << _disc.nCol * _disc.nComp << " DOFs which exceeds SCHUR_DIRECT_MAX_SIZE = "
+				<< maxDirectSize << ", falling back to GMRES";
+			_directSchur = false;
+		}
+	}
+
+	if (_directSchur)
+		_schurDense.resize(_disc.nCol * _disc.nComp, _disc.nCol * _disc.nComp);
+	_schurFactorized = false;
+
+	// Alternatively, the full Jacobian can be solved by a sparse direct solver
+	_sparseSolve = false;
+	if (paramProvider.exists("LINEAR_SOLVER"))
+	{
+		const std::string linSolver = paramProvider.getString("LINEAR_SOLVER");
+		if (linSolver == "SPARSE")
+			_sparseSolve = true;
+		else if (linSolver != "SCHUR")
+			throw InvalidParameterException("Unknown linear solver " + linSolver + " (expected SCHUR or SPARSE)");
+	}
+
+	// Factorizations of the time-discretized Jacobian can be reused as long as alpha changes only slightly
+	_jacReuseTol = 0.0;
+	if (paramProvider.exists("JACOBIAN_REUSE_TOL"))
+	{
+		_jacReuseTol = paramProvider.getDouble("JACOBIAN_REUSE_TOL");
+		if (_jacReuseTol < 0.0)
+			throw InvalidParameterException("JACOBIAN_REUSE_TOL has to be non-negative");
+	}
+	_factorizedAlpha = 0.0;
+	_numFactorizations = 0;
+	_numFactorizationReuses = 0;
+
+	// Number of particle shells that are consistently initialized in one batch (task)
+	_consInitBatchSize = 4;
+	if (paramProvider.exists("CONSISTENT_INIT_BATCH_SIZE"))
+	{
+		const int batchSize = paramProvider.getInt("CONSISTENT_INIT_BATCH_SIZE");
+		if (batchSize <= 0)
+			throw InvalidParameterException("CONSISTENT_INIT_BATCH_SIZE has to be positive");
+		_consInitBatchSize = batchSize;
+	}
+
+	// Converged bound states can be cached and reused as initial guesses in the same section of later runs
+	_consInitUseCache = true;
+	if (paramProvider.exists("CONSISTENT_INIT_CACHE"))
+		_consInitUseCache = paramProvider.getBool("CONSISTENT_INIT_CACHE");
+
+	// Particle kernels with compile-time sizes are used for few components with one bound state each
+	_shellLayout = 0;
+	const bool useSpecializedKernels = paramProvider.exists("USE_SPECIALIZED_KERNELS") ? paramProvider.getBool("USE_SPECIALIZED_KERNELS") : true;
+	if (useSpecializedKernels && (_disc.nComp <= maxFixedShellComponents())
+		&& std::all_of(_disc.nBound, _disc.nBound + _disc.nComp, [](unsigned int nb) { return nb == 1; }))
+	{
+		_shellLayout = _disc.nComp;
+	}
+
+	// Sparsity pattern is set up and analyzed on first use
+	_jacSparse.clear();
+	_sparseSolver.clear();
+	_factorizedAlphaTransposed = 0.0;
+
 	paramProvider.popScope();
 
 	// ==== Read model parameters
@@ -219,8 +311,18 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 
 	_discParFlux.resize(sizeof(active) * _disc.nComp);
 
-	// Set whether analytic Jacobian is used
-	useAnalyticJacobian(analyticJac);
+	// Each component has its own stencil and WENO storage such that components can be processed concurrently
+	_stencilMemory = new ArrayPool[_disc.nComp];
+	_wenoMemory = new ArrayPool[_disc.nComp];
+	for (unsigned int i = 0; i < _disc.nComp; ++i)
+	{
+		_stencilMemory[i].resize(sizeof(active) * Weno::maxStencilSize());
+		_wenoMemory[i].resize(Weno::workspaceSize());
+	}
+	_wenoDerivatives = new double[Weno::maxStencilSize() * _disc.nComp];
+
+	// Compute AD seeding of the particle blocks from their sparsity pattern
+	setupParticleAdColoring();
 
 	// ==== Construct and configure binding model
 	delete _binding;
@@ -235,18 +337,55 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider, IConfigHelpe
 	const bool bindingConfSuccess = _binding->configure(paramProvider, _unitOpIdx);
 	paramProvider.popScope();
 
-	// setup the memory for tempState based on state vector or memory needed for consistent initialization of isotherms, whichever is larger
-	unsigned int size = numDofs();
+	_tempState = new double[numDofs()];
+
+	// Set up batches of particle shells and their workspaces for consistent initialization of isotherms
+	_consInitShells.clear();
+	_consInitWorkspace.clear();
+	_consInitPivot.clear();
+	_consInitCache.clear();
+	_consInitStats = ConsistentInitStats{ 0u, 0u, 0u, 0u };
 	if (_binding->hasAlgebraicEquations())
 	{
-		// Required memory (number of doubles) for nonlinear solvers
-		const unsigned int requiredMem = _binding->consistentInitializationWorkspaceSize() * _disc.nPar * _disc.nCol;
-		if (requiredMem > size)
+		_consInitShells.reserve(_disc.nCol * _disc.nPar);
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
 		{
-			size = requiredMem;
+			// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
+			const double z = 1.0 / static_cast<double>(_disc.nCol) * (0.5 + pblk);
+			for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
+				_consInitShells.push_back(ParticleShell{ z, _parCenterRadius[shell], static_cast<unsigned int>(idxr.offsetCp(pblk)),
+					static_cast<unsigned int>(shell * idxr.strideParShell() + idxr.strideParLiquid()) });
 		}
+
+		// Each batch has its own nonlinear solver workspace and dense working matrix
+		const unsigned int nBatches = numConsistentInitBatches();
+		_consInitWorkspace.resize(nBatches * (_binding->consistentInitializationBatchWorkspaceSize() + _disc.strideBound * _disc.strideBound), 0.0);
+		_consInitPivot.resize(nBatches * _disc.strideBound);
+		_consInitBatchStats.resize(nBatches);
+	}
+
+	if (_analyticParamDeriv)
+		_paramDerivBuffer.resize(numDofs());
+	else
+		_paramDerivBuffer.clear();
+
+	if (_adDirectionPlanes)
+	{
+		// Bandwidth of the bulk blocks changes with the flow direction, but their stride does not
+		const unsigned int bulkDirs = _jacC[0].stride();
+		_dirPlanes.bulkSeeds.resize(bulkDirs * _disc.nCol);
+		_dirPlanes.bulkDerivs.resize(_disc.nComp * bulkDirs * _disc.nCol);
+		_dirPlanes.particleSeeds.resize(_parAdDirs * idxr.strideParBlock());
+		_dirPlanes.particleDerivs.resize(_parAdDirs * idxr.strideParBlock());
+		_dirPlanes.wenoDerivs.resize(_disc.nComp * _disc.nCol * Weno::maxStencilSize());
+		_dirPlanes.wenoOrder.resize(_disc.nComp * _disc.nCol);
+		_dirPlanes.faceDerivs.resize(_disc.nComp * _disc.nCol);
 	}
-	_tempState = new double[size];
+	else
+		_dirPlanes = DirectionPlanes();
+
+	// Set whether analytic Jacobian is used (number of AD directions depends on binding model)
+	useAnalyticJacobian(analyticJac);
 
 	return bindingConfSuccess;
 }
@@ -446,6 +585,7 @@ bool GeneralRateModel::setSensitiveParameter(const ParameterId& pId, unsigned in
 
 			// Register parameter and set AD seed / direction
 			_sensParams.insert(paramBinding);
+			_sensBindingParams = true;
 			paramBinding->setADValue(adDirection, adValue);
 			return true;
 		}
@@ -461,6 +601,7 @@ void GeneralRateModel::clearSensParams()
 		sp->setADValue(0.0);
 
 	_sensParams.clear();
+	_sensBindingParams = false;
 }
 
 void GeneralRateModel::useAnalyticJacobian(const bool analyticJac)
@@ -468,23 +609,41 @@ void GeneralRateModel::useAnalyticJacobian(const bool analyticJac)
 #ifndef CADET_CHECK_ANALYTIC_JACOBIAN
 	_analyticJac = analyticJac;
 	if (!_analyticJac)
-		// We need as many directions as the highest bandwidth of the diagonal blocks:
-		// The bandwidth of the column block depends on the size of the WENO stencil, whereas
-		// the bandwidth of the particle blocks are given by the number of components and bound states.
-		_jacobianAdDirs = std::max(_jacC[0].stride(), _jacP[0].stride());
+		_jacobianAdDirs = numJacobianAdDirs();
 	else
 		_jacobianAdDirs = 0;
 #else
 	_analyticJac = false;
-	// We need as many directions as the highest bandwidth of the diagonal blocks:
-	// The bandwidth of the column block depends on the size of the WENO stencil, whereas
-	// the bandwidth of the particle blocks are given by the number of components and bound states.
-	_jacobianAdDirs = std::max(_jacC[0].stride(), _jacP[0].stride());
+	_jacobianAdDirs = numJacobianAdDirs();
 #endif
 }
 
+/**
+ * @brief Returns the number of AD directions required for computing the Jacobian
+ * @details The column blocks are seeded by band compression since their band is densely populated.
+ *          Its bandwidth depends on the size of the WENO stencil. The particle blocks are seeded
+ *          according to a coloring of their pattern (see setupParticleAdColoring()). Both blocks
+ *          are decoupled and, thus, share the same directions.
+ *          
+ *          Consistent initialization of algebraic binding models temporarily seeds the bound states
+ *          of a shell by band compression of their dense Jacobian.
+ * @return Number of AD directions
+ */
+unsigned int GeneralRateModel::numJacobianAdDirs() const CADET_NOEXCEPT
+{
+	unsigned int dirs = std::max(_jacC[0].stride(), _parAdDirs);
+	if (_binding && _binding->hasAlgebraicEquations() && (_disc.strideBound > 0))
+		dirs = std::max(dirs, 2 * _disc.strideBound - 1);
+
+	return dirs;
+}
+
 void GeneralRateModel::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset)
 {
+	// The Jacobian may change discontinuously, so its last factorization is not reused
+	_factorizedAlpha = 0.0;
+	_factorizedAlphaTransposed = 0.0;
+
 	// Setup flux Jacobian blocks at the beginning of the simulation or in case of
 	// section dependent film or particle diffusion coefficients
 	if ((secIdx == 0) || (_filmDiffusion.size() > _disc.nComp) || (_parDiffusion.size() > _disc.nComp))
@@ -594,7 +753,7 @@ unsigned int GeneralRateModel::requiredADdirs() const CADET_NOEXCEPT
 	return _jacobianAdDirs;
 #else
 	// If CADET_CHECK_ANALYTIC_JACOBIAN is active, we always need the AD directions for the Jacobian
-	return std::max(_jacC[0].stride(), _jacP[0].stride());
+	return numJacobianAdDirs();
 #endif
 }
 
@@ -606,18 +765,71 @@ void GeneralRateModel::prepareADvectors(active* const adRes, active* const adY,
 
 	Indexer idxr(_disc);
 
-	// Get bandwidths of blocks
-	const unsigned int lowerParBandwidth = _jacP[0].lowerBandwidth();
-	const unsigned int upperParBandwidth = _jacP[0].upperBandwidth();
-
 	// Column block	
 	prepareBulkADvectors(adRes, adY, adDirOffset);
 
 	// Particle blocks
 	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
 	{
-		ad::prepareAdVectorSeedsForBandMatrix(adY + idxr.offsetCp(pblk), adDirOffset, idxr.strideParBlock(), lowerParBandwidth, upperParBandwidth, lowerParBandwidth);
+		ad::prepareAdVectorSeedsForColoring(adY + idxr.offsetCp(pblk), adDirOffset, _jacPadColors);
+	}
+}
+
+/**
+ * @brief Computes the sparsity pattern of the particle blocks and a coloring of its columns for AD seeding
+ * @details Although the particle blocks are banded, their band is only sparsely populated: The bound
+ *          states of a shell depend on all states of that shell, whereas the mobile phase of a component
+ *          is only coupled to the same component (and its bound states) in the adjacent shells. Seeding
+ *          the AD vectors according to a coloring of this pattern requires considerably fewer directions
+ *          than band compression. All particle blocks share the same pattern.
+ *          
+ *          Elements outside of the band of the particle blocks are not included in the pattern.
+ */
+void GeneralRateModel::setupParticleAdColoring()
+{
+	Indexer idxr(_disc);
+
+	const int strideShell = idxr.strideParShell();
+	const int lowerBandwidth = static_cast<int>(_jacP[0].lowerBandwidth());
+	const int upperBandwidth = static_cast<int>(_jacP[0].upperBandwidth());
+
+	linalg::DoubleSparseMatrix pattern(_disc.nPar * (3 + _disc.strideBound) * strideShell);
+	const auto addElement = [&](int row, int col)
+	{
+		if ((col - row >= -lowerBandwidth) && (col - row <= upperBandwidth))
+			pattern.addElement(row, col, 0.0);
+	};
+
+	for (unsigned int par = 0; par < _disc.nPar; ++par)
+	{
+		const int shellStart = par * strideShell;
+
+		// Mobile phase depends on itself and its bound states in current and adjacent shells
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		{
+			const int row = shellStart + comp;
+			const int bndStart = shellStart + idxr.strideParLiquid() + idxr.offsetBoundComp(comp);
+			for (int shell = std::max(static_cast<int>(par) - 1, 0); shell <= static_cast<int>(std::min(par + 1, _disc.nPar - 1)); ++shell)
+			{
+				const int offset = (shell - static_cast<int>(par)) * strideShell;
+				addElement(row, row + offset);
+				for (unsigned int bnd = 0; bnd < _disc.nBound[comp]; ++bnd)
+					addElement(row, bndStart + offset + bnd);
+			}
+		}
+
+		// Bound states depend on all states of the shell
+		for (int bnd = 0; bnd < idxr.strideParBound(); ++bnd)
+		{
+			for (int col = 0; col < strideShell; ++col)
+				addElement(shellStart + idxr.strideParLiquid() + bnd, shellStart + col);
+		}
 	}
+
+	_jacPadPattern.assignPattern(idxr.strideParBlock(), pattern);
+	_parAdDirs = ad::computeColumnColoring(_jacPadPattern, _jacPadColors);
+
+	LOG(Debug) << "Unit " << _unitOpIdx << " particle block AD directions: " << _parAdDirs << " (band compression: " << _jacP[0].stride() << ")";
 }
 
 /**
@@ -650,8 +862,9 @@ void GeneralRateModel::prepareBulkADvectors(active* const adRes, active* const a
 }
 
 /**
- * @brief Extracts the system Jacobian from band compressed AD seed vectors
- * @param [in] adRes Residual vector of AD datatypes with band compressed seed vectors
+ * @brief Extracts the system Jacobian from compressed AD seed vectors
+ * @details The column blocks use band compression, the particle blocks use colored seed vectors.
+ * @param [in] adRes Residual vector of AD datatypes with compressed seed vectors
  * @param [in] adDirOffset Number of AD directions used for non-Jacobian purposes (e.g., parameter sensitivities)
  */
 void GeneralRateModel::extractJacobianFromAD(active const* const adRes, unsigned int adDirOffset)
@@ -664,7 +877,295 @@ void GeneralRateModel::extractJacobianFromAD(active const* const adRes, unsigned
 
 	// Particles
 	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-		ad::extractBandedJacobianFromAd(adRes + idxr.offsetCp(pblk), adDirOffset, _jacP[pblk].lowerBandwidth(), _jacP[pblk]);
+		ad::extractBandedJacobianFromColoredAd(adRes + idxr.offsetCp(pblk), adDirOffset, _jacPadPattern, _jacPadColors, _jacP[pblk]);
+}
+
+/**
+ * @brief Fills the seed planes of the direction plane sweeps
+ * @details The seeds use the same compression as the AD vectors, i.e., band compression for the
+ *          column bulk (see prepareBulkADvectors()) and the particle coloring for the particle blocks
+ *          (see setupParticleAdColoring()). The bulk seeds depend on the flow direction.
+ */
+void GeneralRateModel::prepareDirectionPlaneSeeds()
+{
+	Indexer idxr(_disc);
+
+	const unsigned int bulkDirs = _jacC[0].stride();
+	const unsigned int lowerColBandwidth = _jacC[0].lowerBandwidth();
+	std::fill(_dirPlanes.bulkSeeds.begin(), _dirPlanes.bulkSeeds.end(), 0.0);
+	for (unsigned int col = 0; col < _disc.nCol; ++col)
+		_dirPlanes.bulkSeeds[((col + lowerColBandwidth) % bulkDirs) * _disc.nCol + col] = 1.0;
+
+	const unsigned int blockLen = idxr.strideParBlock();
+	std::fill(_dirPlanes.particleSeeds.begin(), _dirPlanes.particleSeeds.end(), 0.0);
+	for (unsigned int i = 0; i < blockLen; ++i)
+		_dirPlanes.particleSeeds[_jacPadColors[i] * blockLen + i] = 1.0;
+}
+
+/**
+ * @brief Computes the directional derivatives of the column bulk transport of one component
+ * @details The WENO reconstruction is linearized once per cell. Each seed plane is then swept
+ *          through convection and dispersion as a contiguous array of doubles. The inlet and
+ *          flux DOFs are not seeded (see extractJacobianFromAD()).
+ * @param [in] comp Index of the component
+ * @param [in] secIdx Index of the current section
+ * @param [in] y Pointer to the state vector
+ */
+void GeneralRateModel::bulkDirectionPlanes(unsigned int comp, unsigned int secIdx, double const* y)
+{
+	Indexer idxr(_disc);
+
+	const double u = static_cast<double>(_curVelocity);
+	const double d_c = static_cast<double>(getSectionDependentScalar(_colDispersion, secIdx));
+	const double h = static_cast<double>(_colLength) / static_cast<double>(_disc.nCol);
+	const double convFactor = std::abs(u) / h;
+	const double dispFactor = d_c / (h * h);
+
+	const int nCol = static_cast<int>(_disc.nCol);
+	const bool forwardFlow = (u >= 0.0);
+	const int dirSign = forwardFlow ? 1 : -1;
+	const int shift = std::max(_weno.order(), 2);
+
+	// Linearize the WENO reconstruction of the downwind face of each cell (same stencils as residualBulk())
+	typedef CachingStencil<double, ArrayPool> StencilType;
+	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory[comp], std::max(_weno.order() - 1, 1));
+
+	for (int i = -shift + 1; i < 0; ++i)
+		stencil[i] = 0.0;
+	for (int i = 0; i < shift; ++i)
+		stencil[i] = idxr.c<double>(y, static_cast<unsigned int>(forwardFlow ? i : nCol - i - 1), comp);
+
+	double* const wenoDerivs = _dirPlanes.wenoDerivs.data() + comp * _disc.nCol * Weno::maxStencilSize();
+	int* const wenoOrder = _dirPlanes.wenoOrder.data() + comp * _disc.nCol;
+	double vm = 0.0;
+	for (int i = 0; i < nCol; ++i)
+	{
+		const int col = forwardFlow ? i : nCol - i - 1;
+		wenoOrder[col] = _weno.reconstruct<double, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm, wenoDerivs + col * Weno::maxStencilSize(), _wenoMemory[comp]);
+
+		if (forwardFlow)
+			stencil.advance(idxr.c<double>(y, col + shift, comp));
+		else if (col - shift >= 0)
+			stencil.advance(idxr.c<double>(y, col - shift, comp));
+		else
+			stencil.advance(0.0);
+	}
+
+	// Sweep over the seed planes
+	const unsigned int nDirs = _jacC[comp].stride();
+	double* const faceDerivs = _dirPlanes.faceDerivs.data() + comp * _disc.nCol;
+	for (unsigned int dir = 0; dir < nDirs; ++dir)
+	{
+		double const* const seed = _dirPlanes.bulkSeeds.data() + dir * _disc.nCol;
+		double* const deriv = _dirPlanes.bulkDerivs.data() + (comp * nDirs + dir) * _disc.nCol;
+
+		// Reconstructed face values
+		for (int col = 0; col < nCol; ++col)
+		{
+			const int order = wenoOrder[col];
+			double const* const Dvm = wenoDerivs + col * Weno::maxStencilSize();
+			double faceDeriv = 0.0;
+			for (int i = 0; i < 2 * order - 1; ++i)
+			{
+				const int j = col + dirSign * (i - order + 1);
+				if ((j >= 0) && (j < nCol))
+					faceDeriv += Dvm[i] * seed[j];
+			}
+			faceDerivs[col] = faceDeriv;
+		}
+
+		for (int col = 0; col < nCol; ++col)
+		{
+			// Convection through the downwind and upwind face (inflow boundary does not depend on the bulk)
+			double r = convFactor * faceDerivs[col];
+			const int upwind = col - dirSign;
+			if ((upwind >= 0) && (upwind < nCol))
+				r -= convFactor * faceDerivs[upwind];
+
+			// Dispersion
+			if (cadet_likely(col < nCol - 1))
+				r -= dispFactor * (seed[col + 1] - seed[col]);
+			if (cadet_likely(col > 0))
+				r -= dispFactor * (seed[col - 1] - seed[col]);
+
+			deriv[col] = r;
+		}
+	}
+}
+
+/**
+ * @brief Computes the directional derivatives of the mobile phase transport in a particle block
+ * @details Pore and surface diffusion are linear and identical for all particle blocks. Hence,
+ *          the derivative planes are computed once and shared by all blocks. The rows of the
+ *          bound phases are left untouched, they are taken from the binding model's AD vectors.
+ * @param [in] secIdx Index of the current section
+ */
+void GeneralRateModel::particleDirectionPlanes(unsigned int secIdx)
+{
+	Indexer idxr(_disc);
+
+	const double radius = static_cast<double>(_parRadius);
+	const double invBetaP = 1.0 / static_cast<double>(_parPorosity) - 1.0;
+	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
+	active const* const parSurfDiff = getSectionDependentSlice(_parSurfDiffusion, idxr.strideParBound(), secIdx);
+
+	const int strideShell = static_cast<int>(idxr.strideParShell());
+	const unsigned int blockLen = idxr.strideParBlock();
+
+	for (unsigned int dir = 0; dir < _parAdDirs; ++dir)
+	{
+		double const* const seed = _dirPlanes.particleSeeds.data() + dir * blockLen;
+		double* const deriv = _dirPlanes.particleDerivs.data() + dir * blockLen;
+
+		for (unsigned int par = 0; par < _disc.nPar; ++par)
+		{
+			const double outerAreaPerVolume = static_cast<double>(_parOuterSurfAreaPerVolume[par]) / radius;
+			const double innerAreaPerVolume = static_cast<double>(_parInnerSurfAreaPerVolume[par]) / radius;
+			const int shellStart = static_cast<int>(par) * strideShell;
+
+			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+			{
+				const int row = shellStart + static_cast<int>(comp);
+				const int bndStart = shellStart + static_cast<int>(idxr.strideParLiquid()) + idxr.offsetBoundComp(comp);
+				const double dp = static_cast<double>(parDiff[comp]);
+				double r = 0.0;
+
+				// Outer surface (inflow boundary is handled by the flux DOFs)
+				if (cadet_likely(par != 0))
+				{
+					const double dr = static_cast<double>(_parCenterRadius[par - 1] - _parCenterRadius[par]) * radius;
+					r -= outerAreaPerVolume * dp * (seed[row - strideShell] - seed[row]) / dr;
+					for (unsigned int i = 0; i < _disc.nBound[comp]; ++i)
+					{
+						const int bnd = bndStart + static_cast<int>(i);
+						r -= outerAreaPerVolume * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) * invBetaP * (seed[bnd - strideShell] - seed[bnd]) / dr;
+					}
+				}
+
+				// Inner surface (no flux at the particle center)
+				if (cadet_likely(par != _disc.nPar - 1))
+				{
+					const double dr = static_cast<double>(_parCenterRadius[par] - _parCenterRadius[par + 1]) * radius;
+					r += innerAreaPerVolume * dp * (seed[row] - seed[row + strideShell]) / dr;
+					for (unsigned int i = 0; i < _disc.nBound[comp]; ++i)
+					{
+						const int bnd = bndStart + static_cast<int>(i);
+						r += innerAreaPerVolume * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) * invBetaP * (seed[bnd] - seed[bnd + strideShell]) / dr;
+					}
+				}
+
+				deriv[row] = r;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Extracts the Jacobian of a particle block from the direction planes
+ * @details Rows of the mobile phase are taken from the derivative planes, rows of the
+ *          bound phases from the AD vectors of the binding model.
+ * @param [in] pblk Index of the particle block
+ * @param [in] adRes Residual vector of AD datatypes with colored seed vectors in the bound phases
+ * @param [in] adDirOffset Number of AD directions used for non-Jacobian purposes (e.g., parameter sensitivities)
+ */
+void GeneralRateModel::extractParticleJacobianFromPlanes(unsigned int pblk, active const* const adRes, unsigned int adDirOffset)
+{
+	Indexer idxr(_disc);
+
+	active const* const adVec = adRes + idxr.offsetCp(pblk);
+	const unsigned int blockLen = idxr.strideParBlock();
+	const unsigned int strideShell = idxr.strideParShell();
+	const std::vector<unsigned int>& rowStart = _jacPadPattern.rowStart();
+	const std::vector<unsigned int>& cols = _jacPadPattern.columns();
+	linalg::BandMatrix& mat = _jacP[pblk];
+
+	mat.setAll(0.0);
+	for (unsigned int eq = 0; eq < blockLen; ++eq)
+	{
+		const bool liquid = (eq % strideShell < _disc.nComp);
+		for (unsigned int idx = rowStart[eq]; idx < rowStart[eq + 1]; ++idx)
+		{
+			const unsigned int col = cols[idx];
+			const unsigned int dir = _jacPadColors[col];
+			mat.centered(eq, static_cast<int>(col) - static_cast<int>(eq)) = liquid ? _dirPlanes.particleDerivs[dir * blockLen + eq] : adVec[eq].getADValue(adDirOffset + dir);
+		}
+	}
+}
+
+/**
+ * @brief Computes the residual and the Jacobian by sweeping over direction planes
+ * @details This is an alternative to evaluating residualImpl() with AD vectors. The linear
+ *          transport terms of column bulk and particles are differentiated in structure-of-arrays
+ *          layout, where each AD direction is a contiguous array of doubles. Only the binding
+ *          model, which is evaluated element-wise, uses AD vectors. Parameter sensitivities
+ *          are not supported by this mode.
+ * @param [in] t Current time point
+ * @param [in] secIdx Index of the current section
+ * @param [in] timeFactor Used for time transformation (pre factor of time derivatives) and to compute parameter derivatives with respect to section length
+ * @param [in] y Pointer to state vector
+ * @param [in] yDot Pointer to time derivative state vector
+ * @param [out] res Pointer to residual vector (may be @c nullptr)
+ * @param [in,out] adRes Pointer to residual vector of AD datatypes that receives the binding model residual
+ * @param [in,out] adY Pointer to state vector of AD datatypes with seed vectors
+ * @param [in] adDirOffset Number of AD directions used for non-Jacobian purposes
+ * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+ */
+int GeneralRateModel::residualWithDirectionPlanes(double t, unsigned int secIdx, double timeFactor, double const* const y, double const* const yDot, double* const res,
+	active* const adRes, active* const adY, unsigned int adDirOffset)
+{
+	int retCode = 0;
+	if (res)
+		retCode = residualImpl<double, double, double, false>(t, secIdx, timeFactor, y, yDot, res);
+
+	prepareDirectionPlaneSeeds();
+	particleDirectionPlanes(secIdx);
+
+	Indexer idxr(_disc);
+	const unsigned int blockLen = idxr.strideParBlock();
+	const unsigned int offsetBound = idxr.strideParLiquid();
+	const unsigned int nTasks = _disc.nComp + _disc.nCol;
+
+	// The first nComp tasks process the bulk of one component each, the remaining tasks one particle block each
+	auto processTask = [&](unsigned int task)
+	{
+		if (task < _disc.nComp)
+		{
+			bulkDirectionPlanes(task, secIdx, y);
+			ad::extractBandedJacobianFromPlanes(_dirPlanes.bulkDerivs.data() + task * _jacC[task].stride() * _disc.nCol, _disc.nCol, _jacC[task].lowerBandwidth(), _jacC[task]);
+		}
+		else
+		{
+			const unsigned int pblk = task - _disc.nComp;
+			const unsigned int offset = idxr.offsetCp(pblk);
+
+			// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
+			const double z = 1.0 / static_cast<double>(_disc.nCol) * (0.5 + pblk);
+
+			ad::copyToAd(y + offset, adY + offset, blockLen);
+			ad::resetAd(adRes + offset, blockLen);
+			_binding->residualBatch(t, z, _parCenterRadius.data(), secIdx, timeFactor, _disc.nPar, idxr.strideParShell(),
+				adY + offset + offsetBound, yDot ? yDot + offset + offsetBound : nullptr, adRes + offset + offsetBound);
+
+			extractParticleJacobianFromPlanes(pblk, adRes, adDirOffset);
+		}
+	};
+
+	BENCH_START(_timerResidualPar);
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nTasks, 1), [&](const tbb::blocked_range<unsigned int>& r)
+	{
+		for (unsigned int task = r.begin(); task != r.end(); ++task)
+			processTask(task);
+	}, tbb::simple_partitioner());
+#else
+	for (unsigned int task = 0; task < nTasks; ++task)
+		processTask(task);
+#endif
+
+	BENCH_STOP(_timerResidualPar);
+
+	return retCode;
 }
 
 #ifdef CADET_CHECK_ANALYTIC_JACOBIAN
@@ -672,7 +1173,7 @@ void GeneralRateModel::extractJacobianFromAD(active const* const adRes, unsigned
 /**
  * @brief Compares the analytical Jacobian with a Jacobian derived by AD
  * @details The analytical Jacobian is assumed to be stored in the corresponding band matrices.
- * @param [in] adRes Residual vector of AD datatypes with band compressed seed vectors
+ * @param [in] adRes Residual vector of AD datatypes with compressed seed vectors
  * @param [in] adDirOffset Number of AD directions used for non-Jacobian purposes (e.g., parameter sensitivities)
  */
 void GeneralRateModel::checkAnalyticJacobianAgainstAd(active const* const adRes, unsigned int adDirOffset) const
@@ -695,7 +1196,7 @@ void GeneralRateModel::checkAnalyticJacobianAgainstAd(active const* const adRes,
 	// Particles
 	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
 	{
-		const double localDiff = ad::compareBandedJacobianWithAd(adRes + idxr.offsetCp(pblk), adDirOffset, _jacP[pblk].lowerBandwidth(), _jacP[pblk]);
+		const double localDiff = ad::compareBandedJacobianWithColoredAd(adRes + idxr.offsetCp(pblk), adDirOffset, _jacPadPattern, _jacPadColors, _jacP[pblk]);
 		LOG(Debug) << "-> Par block diff " << pblk << ": " << localDiff;
 		maxDiffPar = std::max(maxDiffPar, localDiff);
 	}
@@ -733,7 +1234,11 @@ int GeneralRateModel::residual(const active& t, unsigned int secIdx, const activ
 		{
 			if (paramSensitivity)
 			{
-				const int retCode = residualImpl<double, active, active, true>(t, secIdx, timeFactor, y, yDot, adRes);
+				int retCode = 0;
+				if (canUseAnalyticParamDerivatives(t, timeFactor))
+					retCode = residualWithAnalyticParamDerivatives<true>(t, secIdx, timeFactor, y, yDot, adRes);
+				else
+					retCode = residualImpl<double, active, active, true>(t, secIdx, timeFactor, y, yDot, adRes);
 
 				// Copy AD residuals to original residuals vector
 				if (res)
@@ -746,6 +1251,10 @@ int GeneralRateModel::residual(const active& t, unsigned int secIdx, const activ
 		}
 		else
 		{
+			// Parameter derivatives require AD vectors for the complete residual
+			if (_adDirectionPlanes && !paramSensitivity)
+				return residualWithDirectionPlanes(static_cast<double>(t), secIdx, static_cast<double>(timeFactor), y, yDot, res, adRes, adY, adDirOffset);
+
 			// Compute Jacobian via AD
 
 			// Copy over state vector to AD state vector (without changing directional values to keep seed vectors)
@@ -828,23 +1337,84 @@ int GeneralRateModel::residualImpl(const ParamType& t, unsigned int secIdx, cons
 {
 	LOG(Debug) << "t = " << t << " timeFactor = " << timeFactor;
 
+	// Dispatch table of particle kernels indexed by _shellLayout
+	typedef int (GeneralRateModel::*ParticleKernel_t)(const ParamType&, unsigned int, unsigned int, const ParamType&, StateType const*, double const*, ResidualType*);
+	static const ParticleKernel_t particleKernels[] = {
+		&GeneralRateModel::residualParticle<StateType, ResidualType, ParamType, wantJac, DynamicShellLayout>,
+		&GeneralRateModel::residualParticle<StateType, ResidualType, ParamType, wantJac, FixedShellLayout<1>>,
+		&GeneralRateModel::residualParticle<StateType, ResidualType, ParamType, wantJac, FixedShellLayout<2>>,
+		&GeneralRateModel::residualParticle<StateType, ResidualType, ParamType, wantJac, FixedShellLayout<3>>,
+		&GeneralRateModel::residualParticle<StateType, ResidualType, ParamType, wantJac, FixedShellLayout<4>>
+	};
+	const ParticleKernel_t particleKernel = particleKernels[_shellLayout];
+
+	// Parameters of the film diffusion and the bead boundary condition
+	const ParamType invBetaC = 1.0 / static_cast<ParamType>(_colPorosity) - 1.0;
+	const ParamType epsP = static_cast<ParamType>(_parPorosity);
+	const ParamType radius = static_cast<ParamType>(_parRadius);
+
+	active const* const filmDiff = getSectionDependentSlice(_filmDiffusion, _disc.nComp, secIdx);
+	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
+
+	const ParamType surfaceToVolumeRatio = 3.0 / radius;
+	const ParamType outerAreaPerVolume = _parOuterSurfAreaPerVolume[0] / radius;
+
+	const ParamType jacCF_val = invBetaC * surfaceToVolumeRatio;
+	const ParamType jacPF_val = -outerAreaPerVolume / epsP;
+
+	// Discretized film diffusion kf for finite volumes
+	ParamType* const kf_FV = _discParFlux.create<ParamType>(_disc.nComp);
+
+	const double relOuterShellHalfRadius = 0.5 * _parCellSize[0];
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		kf_FV[comp] = 1.0 / (radius * relOuterShellHalfRadius / epsP / static_cast<ParamType>(parDiff[comp]) + 1.0 / static_cast<ParamType>(filmDiff[comp]));
+	}
+
+	// The first nComp tasks compute the bulk of one component each, the remaining tasks
+	// compute consecutive particle blocks including their flux equations. For few column
+	// cells, each particle block is a task of its own. Otherwise, cells are grouped such
+	// that the number of tasks (and, hence, the scheduling overhead) stays bounded.
+	const unsigned int cellsPerTask = std::max(_disc.nCol / maxResidualParticleTasks(), 1u);
+	const unsigned int nParticleTasks = (_disc.nCol + cellsPerTask - 1) / cellsPerTask;
+	const unsigned int nTasks = _disc.nComp + nParticleTasks;
+
+	auto processTask = [&](unsigned int task)
+	{
+		if (task < _disc.nComp)
+		{
+			residualBulk<StateType, ResidualType, ParamType, wantJac>(t, task, secIdx, timeFactor, y, yDot, res);
+			residualBulkFlux<StateType, ResidualType, ParamType>(task, jacCF_val, y, res);
+		}
+		else
+		{
+			const unsigned int cellStart = (task - _disc.nComp) * cellsPerTask;
+			const unsigned int cellEnd = std::min(cellStart + cellsPerTask, _disc.nCol);
+			for (unsigned int pblk = cellStart; pblk < cellEnd; ++pblk)
+			{
+				(this->*particleKernel)(t, pblk, secIdx, timeFactor, y, yDot, res);
+				residualParticleFlux<StateType, ResidualType, ParamType>(pblk, jacPF_val, kf_FV, y, res);
+			}
+		}
+	};
+
 	BENCH_START(_timerResidualPar);
 
 #ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), size_t(_disc.nCol + 1), [&](size_t pblk)
+	// Tasks are coarse and of different size, so each one is scheduled on its own
+	tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nTasks, 1), [&](const tbb::blocked_range<unsigned int>& r)
+	{
+		for (unsigned int task = r.begin(); task != r.end(); ++task)
+			processTask(task);
+	}, tbb::simple_partitioner());
 #else
-	for (unsigned int pblk = 0; pblk < _disc.nCol + 1; ++pblk)
+	for (unsigned int task = 0; task < nTasks; ++task)
+		processTask(task);
 #endif
-	{
-		if (cadet_unlikely(pblk == 0))
-			residualBulk<StateType, ResidualType, ParamType, wantJac>(t, secIdx, timeFactor, y, yDot, res);
-		else
-			residualParticle<StateType, ResidualType, ParamType, wantJac>(t, pblk-1, secIdx, timeFactor, y, yDot, res);
-	} CADET_PARFOR_END;
 
 	BENCH_STOP(_timerResidualPar);
 
-	residualFlux<StateType, ResidualType, ParamType>(t, secIdx, y, yDot, res);
+	_discParFlux.destroy<ParamType>();
 
 	Indexer idxr(_disc);
 
@@ -859,20 +1429,19 @@ int GeneralRateModel::residualImpl(const ParamType& t, unsigned int secIdx, cons
 }
 
 template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
-int GeneralRateModel::residualBulk(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res)
+int GeneralRateModel::residualBulk(const ParamType& t, unsigned int comp, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res)
 {
 	const ParamType u = static_cast<ParamType>(_curVelocity);
+	const ParamType d_c = static_cast<ParamType>(getSectionDependentScalar(_colDispersion, secIdx));
 	if (u >= 0.0)
-		return residualBulkForwardsFlow<StateType, ResidualType, ParamType, wantJac>(t, secIdx, timeFactor, y, yDot, res);
+		return residualBulkForwardsFlow<StateType, ResidualType, ParamType, wantJac>(t, comp, secIdx, timeFactor, u, d_c, y, yDot, res);
 	else
-		return residualBulkBackwardsFlow<StateType, ResidualType, ParamType, wantJac>(t, secIdx, timeFactor, y, yDot, res);
+		return residualBulkBackwardsFlow<StateType, ResidualType, ParamType, wantJac>(t, comp, secIdx, timeFactor, u, d_c, y, yDot, res);
 }
 
 template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
-int GeneralRateModel::residualBulkForwardsFlow(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res)
+int GeneralRateModel::residualBulkForwardsFlow(const ParamType& t, unsigned int comp, unsigned int secIdx, const ParamType& timeFactor, const ParamType& u, const ParamType& d_c, StateType const* y, double const* yDot, ResidualType* res)
 {
-	const ParamType u = static_cast<ParamType>(_curVelocity);
-	const ParamType d_c = static_cast<ParamType>(getSectionDependentScalar(_colDispersion, secIdx));
 	const ParamType h = static_cast<ParamType>(_colLength) / static_cast<double>(_disc.nCol);
 	const ParamType h2 = h * h;
 
@@ -880,130 +1449,129 @@ int GeneralRateModel::residualBulkForwardsFlow(const ParamType& t, unsigned int
 
 	// The stencil caches parts of the state vector for better spatial coherence
 	typedef CachingStencil<StateType, ArrayPool> StencilType;
-	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory, std::max(_weno.order() - 1, 1));
+	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory[comp], std::max(_weno.order() - 1, 1));
 
-	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
-	{
-		// Reset Jacobian
-		if (wantJac)
-			_jacC[comp].setAll(0.0);
+	// Storage of this component allows to process components concurrently
+	double* const wenoDerivatives = _wenoDerivatives + comp * Weno::maxStencilSize();
+	ArrayPool& wenoMemory = _wenoMemory[comp];
 
-		// The RowIterator is always centered on the main diagonal.
-		// This means that jac[0] is the main diagonal, jac[-1] is the first lower diagonal,
-		// and jac[1] is the first upper diagonal. We can also access the rows from left to
-		// right beginning with the last lower diagonal moving towards the main diagonal and
-		// continuing to the last upper diagonal by using the native() method.
-		linalg::BandMatrix::RowIterator jac = _jacC[comp].row(0);
+	// Reset Jacobian
+	if (wantJac)
+		_jacC[comp].setAll(0.0);
 
-		// Add time derivative to each cell
-		if (yDot)
-		{
-			for (unsigned int col = 0; col < _disc.nCol; ++col)
-				idxr.c<ResidualType>(res, col, comp) = timeFactor * idxr.c<double>(yDot, col, comp);
-		}
-		else
-		{
-			for (unsigned int col = 0; col < _disc.nCol; ++col)
-				idxr.c<ResidualType>(res, col, comp) = 0.0;
-		}
+	// The RowIterator is always centered on the main diagonal.
+	// This means that jac[0] is the main diagonal, jac[-1] is the first lower diagonal,
+	// and jac[1] is the first upper diagonal. We can also access the rows from left to
+	// right beginning with the last lower diagonal moving towards the main diagonal and
+	// continuing to the last upper diagonal by using the native() method.
+	linalg::BandMatrix::RowIterator jac = _jacC[comp].row(0);
 
-		// Fill stencil (left side with zeros, right side with states)
-		for (int i = -std::max(_weno.order(), 2) + 1; i < 0; ++i)
-			stencil[i] = 0.0;
-		for (int i = 0; i < std::max(_weno.order(), 2); ++i)
-			stencil[i] = idxr.c<StateType>(y, static_cast<unsigned int>(i), comp);
+	// Add time derivative to each cell
+	if (yDot)
+	{
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+			idxr.c<ResidualType>(res, col, comp) = timeFactor * idxr.c<double>(yDot, col, comp);
+	}
+	else
+	{
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+			idxr.c<ResidualType>(res, col, comp) = 0.0;
+	}
 
-		// Reset WENO output
-		StateType vm(0.0); // reconstructed value
-		if (wantJac)
-			std::fill(_wenoDerivatives, _wenoDerivatives + _weno.stencilSize(), 0.0);
+	// Fill stencil (left side with zeros, right side with states)
+	for (int i = -std::max(_weno.order(), 2) + 1; i < 0; ++i)
+		stencil[i] = 0.0;
+	for (int i = 0; i < std::max(_weno.order(), 2); ++i)
+		stencil[i] = idxr.c<StateType>(y, static_cast<unsigned int>(i), comp);
 
-		int wenoOrder = 0;
+	// Reset WENO output
+	StateType vm(0.0); // reconstructed value
+	if (wantJac)
+		std::fill(wenoDerivatives, wenoDerivatives + _weno.stencilSize(), 0.0);
 
-		// Iterate over all cells
-		for (unsigned int col = 0; col < _disc.nCol; ++col)
-		{
-			// ------------------- Dispersion -------------------
+	int wenoOrder = 0;
 
-			// Right side, leave out if we're in the last cell (boundary condition)
-			if (cadet_likely(col < _disc.nCol - 1))
-			{
-				idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[1] - stencil[0]);
-				// Jacobian entries
-				if (wantJac)
-				{
-					jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
-					jac[1] -= static_cast<double>(d_c) / static_cast<double>(h2);
-				}
-			}
+	// Iterate over all cells
+	for (unsigned int col = 0; col < _disc.nCol; ++col)
+	{
+		// ------------------- Dispersion -------------------
 
-			// Left side, leave out if we're in the first cell (boundary condition)
-			if (cadet_likely(col > 0))
+		// Right side, leave out if we're in the last cell (boundary condition)
+		if (cadet_likely(col < _disc.nCol - 1))
+		{
+			idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[1] - stencil[0]);
+			// Jacobian entries
+			if (wantJac)
 			{
-				idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[-1] - stencil[0]);
-				// Jacobian entries
-				if (wantJac)
-				{
-					jac[0]  += static_cast<double>(d_c) / static_cast<double>(h2);
-					jac[-1] -= static_cast<double>(d_c) / static_cast<double>(h2);
-				}
+				jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
+				jac[1] -= static_cast<double>(d_c) / static_cast<double>(h2);
 			}
+		}
 
-			// ------------------- Convection -------------------
-
-			// Add convection through this cell's left face
-			if (cadet_likely(col > 0))
-			{
-				// Remember that vm still contains the reconstructed value of the previous 
-				// cell's *right* face, which is identical to this cell's *left* face!
-				idxr.c<ResidualType>(res, col, comp) -= u / h * vm;
-
-				// Jacobian entries
-				if (wantJac)
-				{
-					for (int i = 0; i < 2 * wenoOrder - 1; ++i)
-						// Note that we have an offset of -1 here (compared to the right cell face below), since
-						// the reconstructed value depends on the previous stencil (which has now been moved by one cell)
-						jac[i - wenoOrder] -= static_cast<double>(u) / static_cast<double>(h) * _wenoDerivatives[i];
-				}
-			}
-			else
+		// Left side, leave out if we're in the first cell (boundary condition)
+		if (cadet_likely(col > 0))
+		{
+			idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[-1] - stencil[0]);
+			// Jacobian entries
+			if (wantJac)
 			{
-				// In the first cell we need to apply the boundary condition: inflow concentration
-				idxr.c<ResidualType>(res, col, comp) -= u / h * y[comp];
+				jac[0]  += static_cast<double>(d_c) / static_cast<double>(h2);
+				jac[-1] -= static_cast<double>(d_c) / static_cast<double>(h2);
 			}
+		}
 
-			// Reconstruct concentration on this cell's right face
-			if (wantJac)
-				wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm, _wenoDerivatives);
-			else
-				wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm);
+		// ------------------- Convection -------------------
+
+		// Add convection through this cell's left face
+		if (cadet_likely(col > 0))
+		{
+			// Remember that vm still contains the reconstructed value of the previous 
+			// cell's *right* face, which is identical to this cell's *left* face!
+			idxr.c<ResidualType>(res, col, comp) -= u / h * vm;
 
-			// Right side
-			idxr.c<ResidualType>(res, col, comp) += u / h * vm;
 			// Jacobian entries
 			if (wantJac)
 			{
 				for (int i = 0; i < 2 * wenoOrder - 1; ++i)
-					jac[i - wenoOrder + 1] += static_cast<double>(u) / static_cast<double>(h) * _wenoDerivatives[i];
+					// Note that we have an offset of -1 here (compared to the right cell face below), since
+					// the reconstructed value depends on the previous stencil (which has now been moved by one cell)
+					jac[i - wenoOrder] -= static_cast<double>(u) / static_cast<double>(h) * wenoDerivatives[i];
 			}
+		}
+		else
+		{
+			// In the first cell we need to apply the boundary condition: inflow concentration
+			idxr.c<ResidualType>(res, col, comp) -= u / h * y[comp];
+		}
 
-			// Update stencil
-			stencil.advance(idxr.c<StateType>(y, col + std::max(_weno.order(), 2), comp));
-			++jac;
+		// Reconstruct concentration on this cell's right face
+		if (wantJac)
+			wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm, wenoDerivatives, wenoMemory);
+		else
+			wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm, wenoMemory);
+
+		// Right side
+		idxr.c<ResidualType>(res, col, comp) += u / h * vm;
+		// Jacobian entries
+		if (wantJac)
+		{
+			for (int i = 0; i < 2 * wenoOrder - 1; ++i)
+				jac[i - wenoOrder + 1] += static_cast<double>(u) / static_cast<double>(h) * wenoDerivatives[i];
 		}
+
+		// Update stencil
+		stencil.advance(idxr.c<StateType>(y, col + std::max(_weno.order(), 2), comp));
+		++jac;
 	}
 
-	// Film diffusion with flux into beads is added in residualFlux() function
+	// Film diffusion with flux into beads is added in residualBulkFlux() function
 
 	return 0;
 }
 
 template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
-int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res)
+int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int comp, unsigned int secIdx, const ParamType& timeFactor, const ParamType& u, const ParamType& d_c, StateType const* y, double const* yDot, ResidualType* res)
 {
-	const ParamType u = static_cast<ParamType>(_curVelocity);
-	const ParamType d_c = static_cast<ParamType>(getSectionDependentScalar(_colDispersion, secIdx));
 	const ParamType h = static_cast<ParamType>(_colLength) / static_cast<double>(_disc.nCol);
 	const ParamType h2 = h * h;
 
@@ -1011,134 +1579,136 @@ int GeneralRateModel::residualBulkBackwardsFlow(const ParamType& t, unsigned int
 
 	// The stencil caches parts of the state vector for better spatial coherence
 	typedef CachingStencil<StateType, ArrayPool> StencilType;
-	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory, std::max(_weno.order() - 1, 1));
+	StencilType stencil(std::max(_weno.stencilSize(), 3u), _stencilMemory[comp], std::max(_weno.order() - 1, 1));
 
-	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
-	{
-		// Reset Jacobian
-		if (wantJac)
-			_jacC[comp].setAll(0.0);
+	// Storage of this component allows to process components concurrently
+	double* const wenoDerivatives = _wenoDerivatives + comp * Weno::maxStencilSize();
+	ArrayPool& wenoMemory = _wenoMemory[comp];
 
-		// The RowIterator is always centered on the main diagonal.
-		// This means that jac[0] is the main diagonal, jac[-1] is the first lower diagonal,
-		// and jac[1] is the first upper diagonal. We can also access the rows from left to
-		// right beginning with the last lower diagonal moving towards the main diagonal and
-		// continuing to the last upper diagonal by using the native() method.
-		linalg::BandMatrix::RowIterator jac = _jacC[comp].row(_disc.nCol - 1);
+	// Reset Jacobian
+	if (wantJac)
+		_jacC[comp].setAll(0.0);
 
-		// Add time derivative to each cell
-		if (yDot)
-		{
-			for (unsigned int col = 0; col < _disc.nCol; ++col)
-				idxr.c<ResidualType>(res, col, comp) = timeFactor * idxr.c<double>(yDot, col, comp);
-		}
-		else
-		{
-			for (unsigned int col = 0; col < _disc.nCol; ++col)
-				idxr.c<ResidualType>(res, col, comp) = 0.0;
-		}
+	// The RowIterator is always centered on the main diagonal.
+	// This means that jac[0] is the main diagonal, jac[-1] is the first lower diagonal,
+	// and jac[1] is the first upper diagonal. We can also access the rows from left to
+	// right beginning with the last lower diagonal moving towards the main diagonal and
+	// continuing to the last upper diagonal by using the native() method.
+	linalg::BandMatrix::RowIterator jac = _jacC[comp].row(_disc.nCol - 1);
 
-		// Fill stencil (left side with zeros, right side with states)
-		for (int i = -std::max(_weno.order(), 2) + 1; i < 0; ++i)
-			stencil[i] = 0.0;
-		for (int i = 0; i < std::max(_weno.order(), 2); ++i)
-			stencil[i] = idxr.c<StateType>(y, _disc.nCol - static_cast<unsigned int>(i) - 1, comp);
+	// Add time derivative to each cell
+	if (yDot)
+	{
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+			idxr.c<ResidualType>(res, col, comp) = timeFactor * idxr.c<double>(yDot, col, comp);
+	}
+	else
+	{
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+			idxr.c<ResidualType>(res, col, comp) = 0.0;
+	}
 
-		// Reset WENO output
-		StateType vm(0.0); // reconstructed value
-		if (wantJac)
-			std::fill(_wenoDerivatives, _wenoDerivatives + _weno.stencilSize(), 0.0);
+	// Fill stencil (left side with zeros, right side with states)
+	for (int i = -std::max(_weno.order(), 2) + 1; i < 0; ++i)
+		stencil[i] = 0.0;
+	for (int i = 0; i < std::max(_weno.order(), 2); ++i)
+		stencil[i] = idxr.c<StateType>(y, _disc.nCol - static_cast<unsigned int>(i) - 1, comp);
 
-		int wenoOrder = 0;
+	// Reset WENO output
+	StateType vm(0.0); // reconstructed value
+	if (wantJac)
+		std::fill(wenoDerivatives, wenoDerivatives + _weno.stencilSize(), 0.0);
 
-		// Iterate over all cells (backwards)
-		// Note that col wraps around to unsigned int's maximum value after 0
-		for (unsigned int col = _disc.nCol - 1; col < _disc.nCol; --col)
-		{
-			// ------------------- Dispersion -------------------
+	int wenoOrder = 0;
 
-			// Right side, leave out if we're in the first cell (boundary condition)
-			if (cadet_likely(col < _disc.nCol - 1))
-			{
-				idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[-1] - stencil[0]);
-				// Jacobian entries
-				if (wantJac)
-				{
-					jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
-					jac[1] -= static_cast<double>(d_c) / static_cast<double>(h2);
-				}
-			}
+	// Iterate over all cells (backwards)
+	// Note that col wraps around to unsigned int's maximum value after 0
+	for (unsigned int col = _disc.nCol - 1; col < _disc.nCol; --col)
+	{
+		// ------------------- Dispersion -------------------
 
-			// Left side, leave out if we're in the last cell (boundary condition)
-			if (cadet_likely(col > 0))
+		// Right side, leave out if we're in the first cell (boundary condition)
+		if (cadet_likely(col < _disc.nCol - 1))
+		{
+			idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[-1] - stencil[0]);
+			// Jacobian entries
+			if (wantJac)
 			{
-				idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[1] - stencil[0]);
-				// Jacobian entries
-				if (wantJac)
-				{
-					jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
-					jac[-1] -= static_cast<double>(d_c) / static_cast<double>(h2);
-				}
+				jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
+				jac[1] -= static_cast<double>(d_c) / static_cast<double>(h2);
 			}
+		}
 
-			// ------------------- Convection -------------------
-
-			// Add convection through this cell's right face
-			if (cadet_likely(col < _disc.nCol - 1))
-			{
-				// Remember that vm still contains the reconstructed value of the previous 
-				// cell's *left* face, which is identical to this cell's *right* face!
-				idxr.c<ResidualType>(res, col, comp) += u / h * vm;
-
-				// Jacobian entries
-				if (wantJac)
-				{
-					for (int i = 0; i < 2 * wenoOrder - 1; ++i)
-						// Note that we have an offset of +1 here (compared to the left cell face below), since
-						// the reconstructed value depends on the previous stencil (which has now been moved by one cell)
-						jac[wenoOrder - i] += static_cast<double>(u) / static_cast<double>(h) * _wenoDerivatives[i];					
-				}
-			}
-			else
+		// Left side, leave out if we're in the last cell (boundary condition)
+		if (cadet_likely(col > 0))
+		{
+			idxr.c<ResidualType>(res, col, comp) -= d_c / h2 * (stencil[1] - stencil[0]);
+			// Jacobian entries
+			if (wantJac)
 			{
-				// In the last cell (z = L) we need to apply the boundary condition: inflow concentration
-				idxr.c<ResidualType>(res, col, comp) += u / h * y[comp];
+				jac[0] += static_cast<double>(d_c) / static_cast<double>(h2);
+				jac[-1] -= static_cast<double>(d_c) / static_cast<double>(h2);
 			}
+		}
 
-			// Reconstruct concentration on this cell's left face
-			if (wantJac)
-				wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm, _wenoDerivatives);
-			else
-				wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm);
+		// ------------------- Convection -------------------
+
+		// Add convection through this cell's right face
+		if (cadet_likely(col < _disc.nCol - 1))
+		{
+			// Remember that vm still contains the reconstructed value of the previous 
+			// cell's *left* face, which is identical to this cell's *right* face!
+			idxr.c<ResidualType>(res, col, comp) += u / h * vm;
 
-			// Left face
-			idxr.c<ResidualType>(res, col, comp) -= u / h * vm;
 			// Jacobian entries
 			if (wantJac)
 			{
 				for (int i = 0; i < 2 * wenoOrder - 1; ++i)
-					jac[wenoOrder - i - 1] -= static_cast<double>(u) / static_cast<double>(h) * _wenoDerivatives[i];				
+					// Note that we have an offset of +1 here (compared to the left cell face below), since
+					// the reconstructed value depends on the previous stencil (which has now been moved by one cell)
+					jac[wenoOrder - i] += static_cast<double>(u) / static_cast<double>(h) * wenoDerivatives[i];					
 			}
+		}
+		else
+		{
+			// In the last cell (z = L) we need to apply the boundary condition: inflow concentration
+			idxr.c<ResidualType>(res, col, comp) += u / h * y[comp];
+		}
 
-			// Update stencil (be careful because of wrap-around, might cause reading memory very far away [although never used])
-			const unsigned int shift = std::max(_weno.order(), 2);
-			if (cadet_likely(col - shift < _disc.nCol))
-				stencil.advance(idxr.c<StateType>(y, col - shift, comp));
-			else
-				stencil.advance(0.0);
-			--jac;
+		// Reconstruct concentration on this cell's left face
+		if (wantJac)
+			wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm, wenoDerivatives, wenoMemory);
+		else
+			wenoOrder = _weno.reconstruct<StateType, StencilType>(_wenoEpsilon, col, _disc.nCol, stencil, vm, wenoMemory);
+
+		// Left face
+		idxr.c<ResidualType>(res, col, comp) -= u / h * vm;
+		// Jacobian entries
+		if (wantJac)
+		{
+			for (int i = 0; i < 2 * wenoOrder - 1; ++i)
+				jac[wenoOrder - i - 1] -= static_cast<double>(u) / static_cast<double>(h) * wenoDerivatives[i];				
 		}
+
+		// Update stencil (be careful because of wrap-around, might cause reading memory very far away [although never used])
+		const unsigned int shift = std::max(_weno.order(), 2);
+		if (cadet_likely(col - shift < _disc.nCol))
+			stencil.advance(idxr.c<StateType>(y, col - shift, comp));
+		else
+			stencil.advance(0.0);
+		--jac;
 	}
 
-	// Film diffusion with flux into beads is added in residualFlux() function
+	// Film diffusion with flux into beads is added in residualBulkFlux() function
 
 	return 0;
 }
 
-template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
+template <typename StateType, typename ResidualType, typename ParamType, bool wantJac, typename ShellLayout_t>
 int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell, unsigned int secIdx, const ParamType& timeFactor, StateType const* yBase, double const* yDotBase, ResidualType* resBase)
 {
 	Indexer idxr(_disc);
+	const ShellLayout_t layout(_disc);
 
 	// Go to the particle block of the given column cell
 	StateType const* y = yBase + idxr.offsetCp(colCell);
@@ -1149,11 +1719,11 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 	const ParamType radius = static_cast<ParamType>(_parRadius);
 	const ParamType invBetaP = 1.0 / static_cast<ParamType>(_parPorosity) - 1.0;
 
-	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
+	active const* const parDiff = getSectionDependentSlice(_parDiffusion, layout.nComp(), secIdx);
 
 	// Ordering of particle surface diffusion:
 	// bnd0comp0, bnd0comp1, bnd0comp2, bnd1comp0, bnd1comp1, bnd1comp2
-	active const* const parSurfDiff = getSectionDependentSlice(_parSurfDiffusion, idxr.strideParBound(), secIdx);
+	active const* const parSurfDiff = getSectionDependentSlice(_parSurfDiffusion, layout.strideParBound(), secIdx);
 
 	// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
 	const double z = 1.0 / static_cast<double>(_disc.nCol) * (0.5 + colCell);
@@ -1177,10 +1747,10 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 		const ParamType innerAreaPerVolume = _parInnerSurfAreaPerVolume[par] / radius;
 
 		// Mobile phase
-		for (unsigned int comp = 0; comp < _disc.nComp; ++comp, ++res, ++y, ++yDot, ++jac)
+		for (unsigned int comp = 0; comp < layout.nComp(); ++comp, ++res, ++y, ++yDot, ++jac)
 		{
 			*res = 0.0;
-			const unsigned int nBound = _disc.nBound[comp];
+			const unsigned int nBound = layout.nBound(comp);
 
 			// Add time derivatives
 			if (yDotBase)
@@ -1196,7 +1766,7 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 					//   + offsetBoundComp() jump to component (skips all bound states of previous components)
 					//   + i go to current bound state
 					// Remember this, you'll see it quite a lot ...
-					*res += yDot[idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i];
+					*res += yDot[layout.strideParLiquid() - comp + layout.offsetBoundComp(comp) + i];
 
 				// Divide by beta_p and add dcp_i / dt
 				*res = timeFactor * (yDot[0] + invBetaP * res[0]);
@@ -1205,23 +1775,23 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 			const ParamType dp = static_cast<ParamType>(parDiff[comp]);
 
 			// Add flow through outer surface
-			// Note that inflow boundary conditions are handled in residualFlux().
+			// Note that inflow boundary conditions are handled in residualParticleFlux().
 			if (cadet_likely(par != 0))
 			{
 				// Difference between two cell-centers
 				const ParamType dr = (_parCenterRadius[par - 1] - _parCenterRadius[par]) * radius;
 
 				// Molecular diffusion contribution
-				const ResidualType gradCp = (y[-idxr.strideParShell()] - y[0]) / dr;
+				const ResidualType gradCp = (y[-layout.strideParShell()] - y[0]) / dr;
 				*res -= outerAreaPerVolume * dp * gradCp;
 
 				// Surface diffusion contribution
 				for (unsigned int i = 0; i < nBound; ++i)
 				{
 					// See above for explanation of curIdx value
-					const int curIdx = idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i;
-					const ResidualType gradQ = (y[-idxr.strideParShell() + curIdx] - y[curIdx]) / dr;
-					*res -= outerAreaPerVolume * static_cast<ParamType>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) * invBetaP * gradQ;
+					const int curIdx = layout.strideParLiquid() - comp + layout.offsetBoundComp(comp) + i;
+					const ResidualType gradQ = (y[-layout.strideParShell() + curIdx] - y[curIdx]) / dr;
+					*res -= outerAreaPerVolume * static_cast<ParamType>(parSurfDiff[layout.offsetBoundComp(comp) + i]) * invBetaP * gradQ;
 				}
 
 				if (wantJac)
@@ -1232,15 +1802,15 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 
 					// Liquid phase
 					jac[0] += ouApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j)
-					jac[-idxr.strideParShell()] = -ouApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j-1)
+					jac[-layout.strideParShell()] = -ouApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j-1)
 
 					// Solid phase
 					for (unsigned int i = 0; i < nBound; ++i)
 					{
 						// See above for explanation of curIdx value
-						const int curIdx = idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i;
-						jac[curIdx] += ouApV * localInvBetaP * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j)
-						jac[-idxr.strideParShell() + curIdx] = -ouApV * localInvBetaP * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j-1)
+						const int curIdx = layout.strideParLiquid() - comp + layout.offsetBoundComp(comp) + i;
+						jac[curIdx] += ouApV * localInvBetaP * static_cast<double>(parSurfDiff[layout.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j)
+						jac[-layout.strideParShell() + curIdx] = -ouApV * localInvBetaP * static_cast<double>(parSurfDiff[layout.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j-1)
 					}
 				}
 			}
@@ -1253,16 +1823,16 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 				const ParamType dr = (_parCenterRadius[par] - _parCenterRadius[par + 1]) * radius;
 
 				// Molecular diffusion contribution
-				const ResidualType gradCp = (y[0] - y[idxr.strideParShell()]) / dr;
+				const ResidualType gradCp = (y[0] - y[layout.strideParShell()]) / dr;
 				*res += innerAreaPerVolume * dp * gradCp;
 
 				// Surface diffusion contribution
 				for (unsigned int i = 0; i < nBound; ++i)
 				{
 					// See above for explanation of curIdx value
-					const unsigned int curIdx = idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i;
-					const ResidualType gradQ = (y[curIdx] - y[idxr.strideParShell() + curIdx]) / dr;
-					*res += innerAreaPerVolume * static_cast<ParamType>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) * invBetaP * gradQ;
+					const unsigned int curIdx = layout.strideParLiquid() - comp + layout.offsetBoundComp(comp) + i;
+					const ResidualType gradQ = (y[curIdx] - y[layout.strideParShell() + curIdx]) / dr;
+					*res += innerAreaPerVolume * static_cast<ParamType>(parSurfDiff[layout.offsetBoundComp(comp) + i]) * invBetaP * gradQ;
 				}
 
 				if (wantJac)
@@ -1273,25 +1843,21 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 
 					// Liquid phase
 					jac[0] += inApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j)
-					jac[idxr.strideParShell()] = -inApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j+1)
+					jac[layout.strideParShell()] = -inApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j+1)
 
 					// Solid phase
 					for (unsigned int i = 0; i < nBound; ++i)
 					{
 						// See above for explanation of curIdx value
-						const int curIdx = idxr.strideParLiquid() - comp + idxr.offsetBoundComp(comp) + i;
-						jac[curIdx] += inApV * localInvBetaP * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j)
-						jac[idxr.strideParShell() + curIdx] = -inApV * localInvBetaP * static_cast<double>(parSurfDiff[idxr.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j-1)
+						const int curIdx = layout.strideParLiquid() - comp + layout.offsetBoundComp(comp) + i;
+						jac[curIdx] += inApV * localInvBetaP * static_cast<double>(parSurfDiff[layout.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j)
+						jac[layout.strideParShell() + curIdx] = -inApV * localInvBetaP * static_cast<double>(parSurfDiff[layout.offsetBoundComp(comp) + i]) / ldr; // dres / dq_i^(p,j-1)
 					}
 				}
 			}
 		}
 
-		// Bound phases
-		if (!yDotBase)
-			yDot = nullptr;
-
-		_binding->residual(t, z, _parCenterRadius[par], secIdx, timeFactor, y, yDot, res);
+		// Bound phases (residual is evaluated for all shells at once below)
 		if (wantJac)
 		{
 			// static_cast should be sufficient here, but this statement is also analyzed when wantJac = false
@@ -1299,91 +1865,66 @@ int GeneralRateModel::residualParticle(const ParamType& t, unsigned int colCell,
 		}
 
 		// Advance pointers over all bound states
-		y += idxr.strideParBound();
-		yDot += idxr.strideParBound();
-		res += idxr.strideParBound();
-		jac += idxr.strideParBound();
+		y += layout.strideParBound();
+		yDot += layout.strideParBound();
+		res += layout.strideParBound();
+		jac += layout.strideParBound();
 	}
-	return 0;
+
+	// Bound phases of all shells in the particle block
+	const unsigned int offsetBound = idxr.offsetCp(colCell) + layout.strideParLiquid();
+	return _binding->residualBatch(t, z, _parCenterRadius.data(), secIdx, timeFactor, _disc.nPar, layout.strideParShell(),
+		yBase + offsetBound, yDotBase ? yDotBase + offsetBound : nullptr, resBase + offsetBound);
 }
 
 template <typename StateType, typename ResidualType, typename ParamType>
-int GeneralRateModel::residualFlux(const ParamType& t, unsigned int secIdx, StateType const* yBase, double const* yDotBase, ResidualType* resBase)
+int GeneralRateModel::residualBulkFlux(unsigned int comp, const ParamType& jacCF_val, StateType const* yBase, ResidualType* resBase)
 {
 	Indexer idxr(_disc);
 
-	const ParamType invBetaC = 1.0 / static_cast<ParamType>(_colPorosity) - 1.0;
-	const ParamType epsP = static_cast<ParamType>(_parPorosity);
-	const ParamType radius = static_cast<ParamType>(_parRadius);
-
-	active const* const filmDiff = getSectionDependentSlice(_filmDiffusion, _disc.nComp, secIdx);
-	// Ordering of particle surface diffusion:
-	// bnd0comp0, bnd0comp1, bnd0comp2, bnd1comp0, bnd1comp1, bnd1comp2
-	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
-
-	const ParamType surfaceToVolumeRatio = 3.0 / radius;
-	const ParamType outerAreaPerVolume = _parOuterSurfAreaPerVolume[0] / radius;
-
-	const ParamType jacCF_val = invBetaC * surfaceToVolumeRatio;
-	const ParamType jacPF_val = -outerAreaPerVolume / epsP;
-
-	// Discretized film diffusion kf for finite volumes
-	ParamType* const kf_FV = _discParFlux.create<ParamType>(_disc.nComp);
+	ResidualType* const resCol = resBase + idxr.offsetC();
+	StateType const* const yFlux = yBase + idxr.offsetJf();
 
-	const double relOuterShellHalfRadius = 0.5 * _parCellSize[0];
-	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	// J_{0,f} block, adds flux to column void / bulk volume equations of the given component
+	for (unsigned int col = 0; col < _disc.nCol; ++col)
 	{
-		kf_FV[comp] = 1.0 / (radius * relOuterShellHalfRadius / epsP / static_cast<ParamType>(parDiff[comp]) + 1.0 / static_cast<ParamType>(filmDiff[comp]));
+		const unsigned int eq = col * idxr.strideColCell() + comp * idxr.strideColComp();
+		resCol[eq] += jacCF_val * yFlux[eq];
 	}
 
+	return 0;
+}
+
+template <typename StateType, typename ResidualType, typename ParamType>
+int GeneralRateModel::residualParticleFlux(unsigned int colCell, const ParamType& jacPF_val, ParamType const* kf_FV, StateType const* yBase, ResidualType* resBase)
+{
+	Indexer idxr(_disc);
+
 	// Get offsets
-	ResidualType* const resCol = resBase + idxr.offsetC();
-	ResidualType* const resPar = resBase + idxr.offsetCp();
+	ResidualType* const resPar = resBase + idxr.offsetCp(colCell);
 	ResidualType* const resFlux = resBase + idxr.offsetJf();
 
 	StateType const* const yCol = yBase + idxr.offsetC();
-	StateType const* const yPar = yBase + idxr.offsetCp();
+	StateType const* const yPar = yBase + idxr.offsetCp(colCell);
 	StateType const* const yFlux = yBase + idxr.offsetJf();
 
-	// J_f block (identity matrix), adds flux state to flux equation
-	for (unsigned int i = 0; i < _disc.nComp * _disc.nCol; ++i)
-		resFlux[i] = yFlux[i];
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		const unsigned int eq = colCell * idxr.strideColCell() + comp * idxr.strideColComp();
 
-	// J_{0,f} block, adds flux to column void / bulk volume equations
-	for (unsigned int i = 0; i < _disc.nCol * _disc.nComp; ++i)
-		resCol[i] += jacCF_val * yFlux[i];
+		// J_{p,f} block, implements bead boundary condition in outer bead shell equation
+		resPar[comp] += jacPF_val * yFlux[eq];
 
-	// J_{f,0} block, adds bulk volume state c_i to flux equation
-	for (unsigned int bnd = 0; bnd < _disc.nCol; ++bnd)
-	{
-		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
-		{
-			const unsigned int eq = bnd * idxr.strideColCell() + comp * idxr.strideColComp();
-			resFlux[eq] -= kf_FV[comp] * yCol[eq];
-		}
-	}
+		// J_f block (identity matrix), adds flux state to flux equation
+		resFlux[eq] = yFlux[eq];
 
-	// J_{p,f} block, implements bead boundary condition in outer bead shell equation
-	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
-	{
-		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
-		{
-			const unsigned int eq = pblk * idxr.strideColCell() + comp * idxr.strideColComp();
-			resPar[pblk * idxr.strideParBlock() + comp] += jacPF_val * yFlux[eq];
-		}
-	}
+		// J_{f,0} block, adds bulk volume state c_i to flux equation
+		resFlux[eq] -= kf_FV[comp] * yCol[eq];
 
-	// J_{f,p} block, adds outer bead shell state c_{p,i} to flux equation
-	for (unsigned int pblk = 0; pblk < _disc.nCol; pblk++)
-	{
-		for (unsigned int comp = 0; comp < _disc.nComp; comp++)
-		{
-			const unsigned int eq = pblk * idxr.strideColCell() + comp * idxr.strideColComp();
-			resFlux[eq] += kf_FV[comp] * yPar[comp + pblk * idxr.strideParBlock()];
-		}
+		// J_{f,p} block, adds outer bead shell state c_{p,i} to flux equation
+		resFlux[eq] += kf_FV[comp] * yPar[comp];
 	}
 
-	_discParFlux.destroy<ParamType>();
 	return 0;
 }
 
@@ -1498,6 +2039,10 @@ int GeneralRateModel::residualSensFwdAdOnly(const active& t, unsigned int secIdx
 
 	BENCH_SCOPE(_timerResidualSens);
 
+	// Use closed-form parameter derivatives if possible
+	if (canUseAnalyticParamDerivatives(t, timeFactor))
+		return residualWithAnalyticParamDerivatives<false>(t, secIdx, timeFactor, y, yDot, adRes);
+
 	// Evaluate residual for all parameters using AD in vector mode
 	return residualImpl<double, active, active, false>(t, secIdx, timeFactor, y, yDot, adRes); 
 }
@@ -1551,6 +2096,362 @@ int GeneralRateModel::residualSensFwdCombine(const active& timeFactor, const std
 	return 0;
 }
 
+/**
+ * @brief Determines whether the parameter derivatives of the residual can be computed analytically
+ * @details Analytic parameter derivatives have to be enabled by the user. Derivatives with respect to
+ *          section times (i.e., seeded @p t or @p timeFactor) are only available by AD. If a parameter
+ *          of the binding model is sensitive, the binding model has to provide analytic derivatives.
+ * @param [in] t Current time point
+ * @param [in] timeFactor Factor of the time derivatives that comes from time transformation
+ * @return @c true if residualWithAnalyticParamDerivatives() can be used, otherwise @c false
+ */
+bool GeneralRateModel::canUseAnalyticParamDerivatives(const active& t, const active& timeFactor) const
+{
+	if (!_analyticParamDeriv)
+		return false;
+
+	const unsigned int nDirs = ad::getDirections();
+	if ((ad::usedDirections(t, nDirs) > 0) || (ad::usedDirections(timeFactor, nDirs) > 0))
+		return false;
+
+	return !_sensBindingParams || _binding->hasAnalyticParamDerivatives();
+}
+
+/**
+ * @brief Returns the number of leading AD directions that carry parameter seeds
+ * @details Besides the parameters of this unit operation, the interstitial velocity may carry
+ *          seeds of flow rates in the network.
+ * @return Number of AD directions required for the parameter derivatives
+ */
+unsigned int GeneralRateModel::numParamSensDirs() const
+{
+	const unsigned int nDirs = ad::getDirections();
+	unsigned int usedDirs = ad::usedDirections(_curVelocity, nDirs);
+	for (active const* p : _sensParams)
+		usedDirs = std::max(usedDirs, ad::usedDirections(*p, nDirs));
+
+	return usedDirs;
+}
+
+/**
+ * @brief Computes the residual and its parameter derivatives in closed form
+ * @details The residual is evaluated without AD. Its derivatives with respect to all seeded parameters
+ *          are computed analytically and combined with the parameter seeds by the chain rule. The result
+ *          in @p adRes is identical to the one of residualImpl() with AD parameters, but the cost scales
+ *          with the number of used AD directions instead of the total number of AD directions.
+ * @param [in] t Current time point
+ * @param [in] secIdx Index of the current section
+ * @param [in] timeFactor Factor of the time derivatives that comes from time transformation
+ * @param [in] y Pointer to local state vector
+ * @param [in] yDot Pointer to local time derivative state vector or @c nullptr
+ * @param [out] adRes Pointer to local residual vector of AD datatypes
+ * @tparam wantJac Determines whether the analytic Jacobian is assembled
+ * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+ */
+template <bool wantJac>
+int GeneralRateModel::residualWithAnalyticParamDerivatives(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, active* const adRes)
+{
+	const int retCode = residualImpl<double, double, double, wantJac>(static_cast<double>(t), secIdx, static_cast<double>(timeFactor), y, yDot, _paramDerivBuffer.data());
+
+	ad::resetAd(adRes, numDofs());
+	ad::copyToAd(_paramDerivBuffer.data(), adRes, numDofs());
+
+	const unsigned int nDirs = numParamSensDirs();
+	if (nDirs == 0)
+		return retCode;
+
+	BENCH_START(_timerResidualSensPar);
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol + 1), [&](size_t pblk)
+#else
+	for (unsigned int pblk = 0; pblk < _disc.nCol + 1; ++pblk)
+#endif
+	{
+		if (cadet_unlikely(pblk == 0))
+			addBulkParamDerivatives(secIdx, y, adRes, nDirs);
+		else
+			addParticleParamDerivatives(static_cast<double>(t), pblk - 1, secIdx, static_cast<double>(timeFactor), y, yDot, adRes, nDirs);
+	} CADET_PARFOR_END;
+
+	BENCH_STOP(_timerResidualSensPar);
+
+	addFluxParamDerivatives(secIdx, y, adRes, nDirs);
+
+	return retCode;
+}
+
+/**
+ * @brief Adds the parameter derivatives of the column bulk equations
+ * @details The bulk equations are linear in the interstitial velocity @f$ u @f$ and the axial
+ *          dispersion @f$ D_{\text{ax}} @f$. Thus, the transport terms evaluated with unit coefficients
+ *          are their partial derivatives. The column length enters through the cell size
+ *          @f$ h = L / N_z @f$ as @f$ D_{\text{ax}} / h^2 @f$ and @f$ u / h @f$.
+ * 
+ *          Uses the first @f$ 2 N_z N_{\text{comp}} + N_{\text{comp}} @f$ elements of _paramDerivBuffer.
+ * @param [in] secIdx Index of the current section
+ * @param [in] y Pointer to local state vector
+ * @param [in,out] adRes Pointer to local residual vector of AD datatypes
+ * @param [in] nDirs Number of AD directions that carry parameter seeds
+ */
+void GeneralRateModel::addBulkParamDerivatives(unsigned int secIdx, double const* y, active* adRes, unsigned int nDirs)
+{
+	const active& u = _curVelocity;
+	const active& d_c = getSectionDependentScalar(_colDispersion, secIdx);
+
+	const bool uSens = ad::usedDirections(u, nDirs) > 0;
+	const bool dispSens = ad::usedDirections(d_c, nDirs) > 0;
+	const bool lenSens = ad::usedDirections(_colLength, nDirs) > 0;
+	if (!uSens && !dispSens && !lenSens)
+		return;
+
+	Indexer idxr(_disc);
+	const unsigned int nBulk = _disc.nCol * _disc.nComp;
+
+	// The bulk residual functions write to the bulk part of the given vector, which starts at offsetC()
+	double* const dispBuffer = _paramDerivBuffer.data();
+	double* const convBuffer = _paramDerivBuffer.data() + nBulk;
+	double const* const dResDdisp = dispBuffer + idxr.offsetC();
+	double const* const dResDu = convBuffer + idxr.offsetC();
+
+	const double uVal = static_cast<double>(u);
+	const double dispVal = static_cast<double>(d_c);
+
+	// Time derivatives are left out by passing yDot = nullptr
+	if (dispSens || lenSens)
+	{
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+			residualBulkForwardsFlow<double, double, double, false>(0.0, comp, secIdx, 0.0, 0.0, 1.0, y, nullptr, dispBuffer);
+	}
+
+	// Flow direction determines the upwind reconstruction, convection is evaluated with unit speed
+	if (uSens || lenSens)
+	{
+		if (uVal >= 0.0)
+		{
+			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+				residualBulkForwardsFlow<double, double, double, false>(0.0, comp, secIdx, 0.0, 1.0, 0.0, y, nullptr, convBuffer);
+		}
+		else
+		{
+			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+				residualBulkBackwardsFlow<double, double, double, false>(0.0, comp, secIdx, 0.0, -1.0, 0.0, y, nullptr, convBuffer);
+			for (unsigned int i = 0; i < nBulk; ++i)
+				convBuffer[idxr.offsetC() + i] *= -1.0;
+		}
+	}
+
+	active* const resCol = adRes + idxr.offsetC();
+	const double colLen = static_cast<double>(_colLength);
+	for (unsigned int i = 0; i < nBulk; ++i)
+	{
+		if (dispSens)
+			ad::addScaledDerivatives(resCol[i], dResDdisp[i], d_c, nDirs);
+		if (uSens)
+			ad::addScaledDerivatives(resCol[i], dResDu[i], u, nDirs);
+		if (lenSens)
+			ad::addScaledDerivatives(resCol[i], -(2.0 * dispVal * dResDdisp[i] + uVal * dResDu[i]) / colLen, _colLength, nDirs);
+	}
+}
+
+/**
+ * @brief Adds the parameter derivatives of the equations in one particle block
+ * @details Covers pore and surface diffusion, particle porosity and radius (both enter the diffusion
+ *          terms), and the binding model. The diffusion terms scale with @f$ 1 / r_p^2 @f$.
+ * @param [in] t Current time point
+ * @param [in] colCell Index of the column cell of the particle block
+ * @param [in] secIdx Index of the current section
+ * @param [in] timeFactor Factor of the time derivatives that comes from time transformation
+ * @param [in] yBase Pointer to local state vector
+ * @param [in] yDotBase Pointer to local time derivative state vector or @c nullptr
+ * @param [in,out] adResBase Pointer to local residual vector of AD datatypes
+ * @param [in] nDirs Number of AD directions that carry parameter seeds
+ */
+void GeneralRateModel::addParticleParamDerivatives(double t, unsigned int colCell, unsigned int secIdx, double timeFactor, double const* yBase, double const* yDotBase, active* adResBase, unsigned int nDirs)
+{
+	Indexer idxr(_disc);
+
+	// Go to the particle block of the given column cell
+	double const* const y = yBase + idxr.offsetCp(colCell);
+	double const* const yDot = yDotBase ? yDotBase + idxr.offsetCp(colCell) : nullptr;
+	active* const res = adResBase + idxr.offsetCp(colCell);
+
+	const double radius = static_cast<double>(_parRadius);
+	const double epsP = static_cast<double>(_parPorosity);
+	const double invBetaP = 1.0 / epsP - 1.0;
+
+	const bool radiusSens = ad::usedDirections(_parRadius, nDirs) > 0;
+	const bool epsPSens = ad::usedDirections(_parPorosity, nDirs) > 0;
+
+	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
+	active const* const parSurfDiff = getSectionDependentSlice(_parSurfDiffusion, idxr.strideParBound(), secIdx);
+
+	// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
+	const double z = 1.0 / static_cast<double>(_disc.nCol) * (0.5 + colCell);
+
+	const int strideShell = idxr.strideParShell();
+	for (unsigned int par = 0; par < _disc.nPar; ++par)
+	{
+		const double outerAreaPerVolume = _parOuterSurfAreaPerVolume[par] / radius;
+		const double innerAreaPerVolume = _parInnerSurfAreaPerVolume[par] / radius;
+		const bool hasOuter = (par != 0);
+		const bool hasInner = (par != _disc.nPar - 1);
+		const double drOuter = hasOuter ? (_parCenterRadius[par - 1] - _parCenterRadius[par]) * radius : 1.0;
+		const double drInner = hasInner ? (_parCenterRadius[par] - _parCenterRadius[par + 1]) * radius : 1.0;
+
+		const int shellOffset = par * strideShell;
+		for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+		{
+			const int idx = shellOffset + comp;
+			active& r = res[idx];
+
+			// Molecular diffusion (linear in D_p)
+			double dResDdp = 0.0;
+			if (cadet_likely(hasOuter))
+				dResDdp -= outerAreaPerVolume * (y[idx - strideShell] - y[idx]) / drOuter;
+			if (cadet_likely(hasInner))
+				dResDdp += innerAreaPerVolume * (y[idx] - y[idx + strideShell]) / drInner;
+
+			ad::addScaledDerivatives(r, dResDdp, parDiff[comp], nDirs);
+
+			// Collect all diffusion terms for the radius and all terms with 1 / beta_p for the porosity
+			double diffusion = static_cast<double>(parDiff[comp]) * dResDdp;
+			double dResDinvBetaP = 0.0;
+
+			for (unsigned int i = 0; i < _disc.nBound[comp]; ++i)
+			{
+				const int curIdx = shellOffset + idxr.strideParLiquid() + idxr.offsetBoundComp(comp) + i;
+				const active& ds = parSurfDiff[idxr.offsetBoundComp(comp) + i];
+
+				// Surface diffusion (linear in D_s / beta_p)
+				double dResDds = 0.0;
+				if (cadet_likely(hasOuter))
+					dResDds -= outerAreaPerVolume * (y[curIdx - strideShell] - y[curIdx]) / drOuter;
+				if (cadet_likely(hasInner))
+					dResDds += innerAreaPerVolume * (y[curIdx] - y[curIdx + strideShell]) / drInner;
+
+				ad::addScaledDerivatives(r, invBetaP * dResDds, ds, nDirs);
+
+				diffusion += invBetaP * static_cast<double>(ds) * dResDds;
+				dResDinvBetaP += static_cast<double>(ds) * dResDds;
+				if (yDot)
+					dResDinvBetaP += timeFactor * yDot[curIdx];
+			}
+
+			if (radiusSens)
+				ad::addScaledDerivatives(r, -2.0 * diffusion / radius, _parRadius, nDirs);
+			if (epsPSens)
+				ad::addScaledDerivatives(r, -dResDinvBetaP / (epsP * epsP), _parPorosity, nDirs);
+		}
+
+		// Bound phases
+		if (_sensBindingParams)
+			_binding->addParamDerivatives(t, z, _parCenterRadius[par], secIdx, y + shellOffset + idxr.strideParLiquid(), nDirs, res + shellOffset + idxr.strideParLiquid());
+	}
+}
+
+/**
+ * @brief Adds the parameter derivatives of the flux equations and the flux terms in bulk and particle equations
+ * @details The discretized film diffusion coefficient is given by
+ *          @f[ \frac{1}{k_{f,\text{FV}}} = \frac{r_p \Delta r / 2}{\varepsilon_p D_p} + \frac{1}{k_f}. @f]
+ * @param [in] secIdx Index of the current section
+ * @param [in] yBase Pointer to local state vector
+ * @param [in,out] adResBase Pointer to local residual vector of AD datatypes
+ * @param [in] nDirs Number of AD directions that carry parameter seeds
+ */
+void GeneralRateModel::addFluxParamDerivatives(unsigned int secIdx, double const* yBase, active* adResBase, unsigned int nDirs)
+{
+	Indexer idxr(_disc);
+
+	const double epsC = static_cast<double>(_colPorosity);
+	const double epsP = static_cast<double>(_parPorosity);
+	const double radius = static_cast<double>(_parRadius);
+
+	const bool epsCSens = ad::usedDirections(_colPorosity, nDirs) > 0;
+	const bool epsPSens = ad::usedDirections(_parPorosity, nDirs) > 0;
+	const bool radiusSens = ad::usedDirections(_parRadius, nDirs) > 0;
+
+	active const* const filmDiff = getSectionDependentSlice(_filmDiffusion, _disc.nComp, secIdx);
+	active const* const parDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp, secIdx);
+
+	const double jacCF_val = (1.0 / epsC - 1.0) * 3.0 / radius;
+	const double jacPF_val = -_parOuterSurfAreaPerVolume[0] / radius / epsP;
+	const double relOuterShellHalfRadius = 0.5 * _parCellSize[0];
+
+	active* const resCol = adResBase + idxr.offsetC();
+	active* const resPar = adResBase + idxr.offsetCp();
+	active* const resFlux = adResBase + idxr.offsetJf();
+
+	double const* const yCol = yBase + idxr.offsetC();
+	double const* const yPar = yBase + idxr.offsetCp();
+	double const* const yFlux = yBase + idxr.offsetJf();
+
+	// J_{0,f} block: (1 / eps_c - 1) * 3 / r_p * j_f
+	if (epsCSens || radiusSens)
+	{
+		for (unsigned int i = 0; i < _disc.nCol * _disc.nComp; ++i)
+		{
+			if (epsCSens)
+				ad::addScaledDerivatives(resCol[i], -3.0 / (radius * epsC * epsC) * yFlux[i], _colPorosity, nDirs);
+			if (radiusSens)
+				ad::addScaledDerivatives(resCol[i], -jacCF_val / radius * yFlux[i], _parRadius, nDirs);
+		}
+	}
+
+	// Flux equations: j_f - k_{f,FV} * (c - c_p)
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+	{
+		const bool filmSens = ad::usedDirections(filmDiff[comp], nDirs) > 0;
+		const bool parDiffSens = ad::usedDirections(parDiff[comp], nDirs) > 0;
+		if (!filmSens && !parDiffSens && !epsPSens && !radiusSens)
+			continue;
+
+		const double kf = static_cast<double>(filmDiff[comp]);
+		const double dp = static_cast<double>(parDiff[comp]);
+		const double kfFV = 1.0 / (radius * relOuterShellHalfRadius / epsP / dp + 1.0 / kf);
+
+		// d(k_{f,FV}) / dp = -k_{f,FV}^2 * d(1 / k_{f,FV}) / dp
+		const double kfFV2 = kfFV * kfFV;
+		const double dKfDfilm = kfFV2 / (kf * kf);
+		const double dKfDparDiff = kfFV2 * radius * relOuterShellHalfRadius / (epsP * dp * dp);
+		const double dKfDepsP = kfFV2 * radius * relOuterShellHalfRadius / (epsP * epsP * dp);
+		const double dKfDradius = -kfFV2 * relOuterShellHalfRadius / (epsP * dp);
+
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+		{
+			const unsigned int eq = col * idxr.strideColCell() + comp * idxr.strideColComp();
+			const double diff = yCol[eq] - yPar[col * idxr.strideParBlock() + comp];
+
+			if (filmSens)
+				ad::addScaledDerivatives(resFlux[eq], -dKfDfilm * diff, filmDiff[comp], nDirs);
+			if (parDiffSens)
+				ad::addScaledDerivatives(resFlux[eq], -dKfDparDiff * diff, parDiff[comp], nDirs);
+			if (epsPSens)
+				ad::addScaledDerivatives(resFlux[eq], -dKfDepsP * diff, _parPorosity, nDirs);
+			if (radiusSens)
+				ad::addScaledDerivatives(resFlux[eq], -dKfDradius * diff, _parRadius, nDirs);
+		}
+	}
+
+	// J_{p,f} block: -outerAreaPerVolume / (r_p * eps_p) * j_f in outer particle shell
+	if (epsPSens || radiusSens)
+	{
+		for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		{
+			for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+			{
+				const unsigned int eq = pblk * idxr.strideColCell() + comp * idxr.strideColComp();
+				active& r = resPar[pblk * idxr.strideParBlock() + comp];
+
+				if (epsPSens)
+					ad::addScaledDerivatives(r, -jacPF_val / epsP * yFlux[eq], _parPorosity, nDirs);
+				if (radiusSens)
+					ad::addScaledDerivatives(r, -jacPF_val / radius * yFlux[eq], _parRadius, nDirs);
+			}
+		}
+	}
+}
+
 /**
  * @brief Multiplies the given vector with the system Jacobian (i.e., @f$ \frac{\partial F}{\partial y} @f$)
  * @details Actually, the operation @f$ z = \alpha \frac{\partial F}{\partial y} x + \beta z @f$ is performed.
@@ -1676,6 +2577,124 @@ void GeneralRateModel::multiplyWithDerivativeJacobian(double const* sDot, double
 	std::fill_n(ret, _disc.nComp, 0.0);
 }
 
+/**
+ * @brief Multiplies the given vector with the transposed system Jacobian
+ * @details Actually, the operation @f$ z = \alpha \left(\frac{\partial F}{\partial y}\right)^T x + \beta z @f$ is performed.
+ *          The diagonal blocks are multiplied first, which applies @f$ \beta @f$ to all of @f$ z @f$. Afterwards,
+ *          the transposed off-diagonal blocks are added.
+ * @param [in] yS Vector @f$ x @f$ that is transformed by the transposed Jacobian
+ * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ \left(\frac{\partial F}{\partial y}\right)^T @f$
+ * @param [in] beta Factor @f$ \beta @f$ in front of @f$ z @f$
+ * @param [in,out] ret Vector @f$ z @f$ which stores the result of the operation
+ */
+void GeneralRateModel::multiplyWithJacobianTransposed(double const* yS, double alpha, double beta, double* ret)
+{
+	Indexer idxr(_disc);
+
+	// Handle identity matrix of inlet DOFs
+	for (unsigned int i = 0; i < _disc.nComp; ++i)
+	{
+		ret[i] = alpha * yS[i] + beta * ret[i];
+	}
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nComp), [&](size_t comp)
+#else
+	for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+#endif
+	{
+		_jacC[comp].transposedMultiplyVector(yS + comp * idxr.strideColComp() + idxr.offsetC(), alpha, beta,
+			ret + comp * idxr.strideColComp() + idxr.offsetC());
+	} CADET_PARFOR_END;
+
+	// The transposed flux equation blocks J_{f,p}^T map the fluxes to the particle blocks
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol), [&](size_t pblk)
+#else
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+#endif
+	{
+		const int localOffset = idxr.offsetCp(pblk);
+		_jacP[pblk].transposedMultiplyVector(yS + localOffset, alpha, beta, ret + localOffset);
+		_jacFP[pblk].transposedMultiplyAdd(yS + idxr.offsetJf(), ret + localOffset, alpha);
+	} CADET_PARFOR_END;
+
+	// Multiply with the transposed flux block of the flux equation
+	_jacFC.transposedMultiplyAdd(yS + idxr.offsetJf(), ret + idxr.offsetC(), alpha);
+
+	// Handle flux equation (identity matrix)
+	for (unsigned int i = idxr.offsetJf(); i < numDofs(); ++i)
+		ret[i] = alpha * yS[i] + beta * ret[i];
+
+	double* const retJf = ret + idxr.offsetJf();
+	_jacCF.transposedMultiplyAdd(yS + idxr.offsetC(), retJf, alpha);
+
+	for (unsigned int pblk = 0; pblk < _disc.nCol; ++pblk)
+		_jacPF[pblk].transposedMultiplyAdd(yS + idxr.offsetCp(pblk), retJf, alpha);
+
+	// Map the column inlet (first bulk cells) to the inlet DOFs
+	_jacInlet.transposedMultiplyAdd(yS + idxr.offsetC(), ret, alpha);
+}
+
+/**
+ * @brief Multiplies the transposed time derivative Jacobian @f$ \left(\frac{\partial F}{\partial \dot{y}}\right)^T @f$ with a given vector
+ * @details The operation @f$ z = \left(\frac{\partial F}{\partial \dot{y}}\right)^T x @f$ is performed.
+ *          The matrix-vector multiplication is transformed matrix-free (i.e., no matrix is explicitly formed).
+ *          In contrast to multiplyWithDerivativeJacobian(), the coupling of bound states to the mobile phase
+ *          equations is applied to the bound state rows.
+ * @param [in] sDot Vector @f$ x @f$ that is transformed by the transposed Jacobian
+ * @param [out] ret Vector @f$ z @f$ which stores the result of the operation
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ */
+void GeneralRateModel::multiplyWithDerivativeJacobianTransposed(double const* sDot, double* ret, double timeFactor)
+{
+	Indexer idxr(_disc);
+	const double invBetaP = (1.0 / static_cast<double>(_parPorosity) - 1.0) * timeFactor;
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol) + 1, [&](size_t pblk)
+#else
+	for (unsigned int pblk = 0; pblk < _disc.nCol + 1; ++pblk)
+#endif
+	{
+		if (cadet_unlikely(pblk == 0))
+		{
+			// Column
+			for (int i = idxr.offsetC(); i < idxr.offsetCp(0); ++i)
+				ret[i] = timeFactor * sDot[i];
+		}
+		else
+		{
+			// Particle
+			for (unsigned int shell = 0; shell < _disc.nPar; ++shell)
+			{
+				double const* const localSdot = sDot + idxr.offsetCp(pblk - 1) + shell * idxr.strideParShell();
+				double* const localRet = ret + idxr.offsetCp(pblk - 1) + shell * idxr.strideParShell();
+
+				// Solid phase (binding models have diagonal time derivative Jacobians)
+				_binding->multiplyWithDerivativeJacobian(localSdot + _disc.nComp, localRet + _disc.nComp, timeFactor);
+
+				for (unsigned int comp = 0; comp < _disc.nComp; ++comp)
+				{
+					// Mobile phase
+					localRet[comp] = timeFactor * localSdot[comp];
+
+					// Transpose of the derivative of the mobile phase equations with respect to dq / dt
+					for (unsigned int i = 0; i < _disc.nBound[comp]; ++i)
+						localRet[_disc.nComp + _disc.boundOffset[comp] + i] += invBetaP * localSdot[comp];
+				}
+			}
+		}
+	} CADET_PARFOR_END;
+
+	// Handle fluxes (all algebraic)
+	double* const dFdyDot = ret + idxr.offsetJf();
+	std::fill(dFdyDot, dFdyDot + _disc.nCol * _disc.nComp, 0.0);
+
+	// Handle inlet DOFs (all algebraic)
+	std::fill_n(ret, _disc.nComp, 0.0);
+}
+
 void GeneralRateModel::setExternalFunctions(IExternalFunction** extFuns, unsigned int size)
 {
 	if (_binding)
@@ -1708,6 +2727,37 @@ unsigned int GeneralRateModel::localInletComponentStride() const CADET_NOEXCEPT
 	return 1;
 }
 
+double GeneralRateModel::boundMass(double const* const y, unsigned int comp) const
+{
+	Indexer idx(_disc);
+
+	// The amount is given per unit cross section area if the latter is not specified
+	const double crossSection = (_crossSection > 0.0) ? static_cast<double>(_crossSection) : 1.0;
+	const double cellVolume = static_cast<double>(_colLength) * crossSection / static_cast<double>(_disc.nCol);
+	const double solidFraction = (1.0 - static_cast<double>(_colPorosity)) * (1.0 - static_cast<double>(_parPorosity));
+
+	double mass = 0.0;
+	for (unsigned int par = 0; par < _disc.nPar; ++par)
+	{
+		const double rOut = _parCenterRadius[par] + 0.5 * _parCellSize[par];
+		const double rIn = _parCenterRadius[par] - 0.5 * _parCellSize[par];
+		// Fraction of the bead volume occupied by the shell
+		const double shellFraction = rOut * rOut * rOut - rIn * rIn * rIn;
+
+		double shellMass = 0.0;
+		for (unsigned int col = 0; col < _disc.nCol; ++col)
+		{
+			double const* const q = y + idx.offsetCp(col, par) + idx.strideParLiquid() + idx.offsetBoundComp(comp);
+			for (unsigned int bnd = 0; bnd < _disc.nBound[comp]; ++bnd)
+				shellMass += q[bnd];
+		}
+
+		mass += shellFraction * shellMass;
+	}
+
+	return mass * solidFraction * cellVolume;
+}
+
 void GeneralRateModel::expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut)
 {
 	// @todo Write this function
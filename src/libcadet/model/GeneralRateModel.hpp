@@ -24,6 +24,8 @@
 #include "AutoDiff.hpp"
 #include "linalg/SparseMatrix.hpp"
 #include "linalg/Gmres.hpp"
+#include "linalg/DenseMatrix.hpp"
+#include "linalg/SparseDirectSolver.hpp"
 #include "MemoryPool.hpp"
 #include "ParamIdUtil.hpp"
 #include "Weno.hpp"
@@ -87,6 +89,7 @@ public:
 	virtual unsigned int numComponents() const CADET_NOEXCEPT { return _disc.nComp; }
 	virtual void setFlowRates(const active& in, const active& out) CADET_NOEXCEPT;
 	virtual bool canAccumulate() const CADET_NOEXCEPT { return false; }
+	virtual double boundMass(double const* const y, unsigned int comp) const;
 
 	static const char* identifier() { return "GENERAL_RATE_MODEL"; }
 	virtual const char* unitOperationName() const CADET_NOEXCEPT { return "GENERAL_RATE_MODEL"; }
@@ -126,6 +129,8 @@ public:
 
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res);
+	virtual int linearSolveTransposed(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight);
+	virtual void invalidateTransposedFactorization() { _factorizeTransposed = true; }
 
 	virtual void prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
 
@@ -157,12 +162,40 @@ public:
 
 	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut);
 
+	/**
+	 * @brief Returns the accumulated statistics of the consistent initialization of the bound states
+	 * @details Initial guesses are provided for a shell if the converged bound states of a previous
+	 *          consistent initialization in the same section are cached.
+	 * @return Statistics of all consistent initializations since configuration
+	 */
+	inline const ConsistentInitStats& consistentInitStats() const CADET_NOEXCEPT { return _consInitStats; }
+
+	/**
+	 * @brief Removes all cached bound states of previous consistent initializations
+	 */
+	inline void clearConsistentInitCache() { _consInitCache.clear(); }
+
+	/**
+	 * @brief Returns the number of factorizations of the time-discretized Jacobian in linearSolve()
+	 * @return Number of Jacobian factorizations
+	 */
+	inline unsigned int numJacobianFactorizations() const CADET_NOEXCEPT { return _numFactorizations; }
+
+	/**
+	 * @brief Returns the number of linear solves that reused the factorization of a previous Jacobian or @f$ \alpha @f$
+	 * @details Solves with a Jacobian that has not changed since its factorization are not counted.
+	 * @return Number of Jacobian factorization reuses
+	 */
+	inline unsigned int numJacobianReuses() const CADET_NOEXCEPT { return _numFactorizationReuses; }
+
 	virtual void multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret);
 	virtual void multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor);
 	inline void multiplyWithJacobian(double const* yS, double* ret)
 	{
 		multiplyWithJacobian(yS, 1.0, 0.0, ret);
 	}
+	virtual void multiplyWithJacobianTransposed(double const* yS, double alpha, double beta, double* ret);
+	virtual void multiplyWithDerivativeJacobianTransposed(double const* sDot, double* ret, double timeFactor);
 
 #ifdef CADET_BENCHMARK_MODE
 	virtual std::vector<double> benchmarkTimings() const
@@ -179,7 +212,11 @@ public:
 			_timerFactorize.totalElapsedTime(),
 			_timerFactorizePar.totalElapsedTime(),
 			_timerMatVec.totalElapsedTime(),
-			_timerGmres.totalElapsedTime()
+			_timerGmres.totalElapsedTime(),
+			_timerSchurAssemble.totalElapsedTime(),
+			_timerSparseFactorize.totalElapsedTime(),
+			static_cast<double>(_numFactorizations),
+			static_cast<double>(_numFactorizationReuses)
 		});
 	}
 
@@ -197,7 +234,11 @@ public:
 			"Factorize",
 			"FactorizePar",
 			"MatVec",
-			"Gmres"
+			"Gmres",
+			"SchurAssemble",
+			"SparseFactorize",
+			"NumFactorize",
+			"NumFactorizeReuse"
 		};
 		return desc;
 	}
@@ -213,27 +254,56 @@ protected:
 	int residualImpl(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* const y, double const* const yDot, ResidualType* const res);
 
 	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
-	int residualBulk(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res);
+	int residualBulk(const ParamType& t, unsigned int comp, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res);
 
 	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
-	int residualBulkForwardsFlow(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res);
+	int residualBulkForwardsFlow(const ParamType& t, unsigned int comp, unsigned int secIdx, const ParamType& timeFactor, const ParamType& u, const ParamType& d_c, StateType const* y, double const* yDot, ResidualType* res);
 
 	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
-	int residualBulkBackwardsFlow(const ParamType& t, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res);
+	int residualBulkBackwardsFlow(const ParamType& t, unsigned int comp, unsigned int secIdx, const ParamType& timeFactor, const ParamType& u, const ParamType& d_c, StateType const* y, double const* yDot, ResidualType* res);
 
-	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
+	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac, typename ShellLayout_t>
 	int residualParticle(const ParamType& t, unsigned int colCell, unsigned int secIdx, const ParamType& timeFactor, StateType const* y, double const* yDot, ResidualType* res);
 
 	template <typename StateType, typename ResidualType, typename ParamType>
-	int residualFlux(const ParamType& t, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res);
+	int residualBulkFlux(unsigned int comp, const ParamType& jacCF_val, StateType const* y, ResidualType* res);
+
+	template <typename StateType, typename ResidualType, typename ParamType>
+	int residualParticleFlux(unsigned int colCell, const ParamType& jacPF_val, ParamType const* kf_FV, StateType const* y, ResidualType* res);
+
+	template <bool wantJac>
+	int residualWithAnalyticParamDerivatives(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, active* const adRes);
+	bool canUseAnalyticParamDerivatives(const active& t, const active& timeFactor) const;
+	unsigned int numParamSensDirs() const;
+	void addBulkParamDerivatives(unsigned int secIdx, double const* y, active* adRes, unsigned int nDirs);
+	void addParticleParamDerivatives(double t, unsigned int colCell, unsigned int secIdx, double timeFactor, double const* yBase, double const* yDotBase, active* adResBase, unsigned int nDirs);
+	void addFluxParamDerivatives(unsigned int secIdx, double const* yBase, active* adResBase, unsigned int nDirs);
+
+	int residualWithDirectionPlanes(double t, unsigned int secIdx, double timeFactor, double const* const y, double const* const yDot, double* const res,
+		active* const adRes, active* const adY, unsigned int adDirOffset);
+	void prepareDirectionPlaneSeeds();
+	void bulkDirectionPlanes(unsigned int comp, unsigned int secIdx, double const* y);
+	void particleDirectionPlanes(unsigned int secIdx);
+	void extractParticleJacobianFromPlanes(unsigned int pblk, active const* const adRes, unsigned int adDirOffset);
 
 	void assembleOffdiagJac(double t, unsigned int secIdx);
 	void extractJacobianFromAD(active const* const adRes, unsigned int adDirOffset);
 	void prepareBulkADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
+	void setupParticleAdColoring();
+	unsigned int numJacobianAdDirs() const CADET_NOEXCEPT;
 
 	int schurComplementMatrixVector(double const* x, double* z) const;
+	bool assembleSchurComplement(const Indexer& idxr);
+	int linearSolveSparse(double timeFactor, double alpha, double* const rhs, const Indexer& idxr);
+	bool factorizeSparseJacobian(double alpha, const Indexer& idxr, double timeFactor);
+	bool needsFactorization(double alpha, double& alphaRatio);
+	void correctReusedFactorization(double alphaRatio, double* const rhs, const Indexer& idxr) const;
+	void setupSparseJacobianPattern(const Indexer& idxr);
+	void assembleSparseJacobian(double alpha, const Indexer& idxr, double timeFactor);
 	void assembleDiscretizedJacobianColumnBlock(unsigned int comp, double alpha, const Indexer& idxr, double timeFactor);
 	void assembleDiscretizedJacobianParticleBlock(unsigned int pblk, double alpha, const Indexer& idxr, double timeFactor);
+	template <typename ShellLayout_t>
+	void assembleDiscretizedJacobianParticleBlockImpl(unsigned int pblk, double alpha, double timeFactor);
 	
 	void setEquidistantRadialDisc();
 	void setEquivolumeRadialDisc();
@@ -241,8 +311,12 @@ protected:
 
 	void addTimeDerivativeToJacobianColumnBlock(linalg::FactorizableBandMatrix& fbm, const Indexer& idxr, double alpha, double timeFactor);
 	void addMobilePhaseTimeDerivativeToJacobianParticleBlock(linalg::FactorizableBandMatrix::RowIterator& jac, const Indexer& idxr, double alpha, double invBetaP, double timeFactor);
+	template <typename ShellLayout_t>
+	void addMobilePhaseTimeDerivativeToJacobianParticleBlock(linalg::FactorizableBandMatrix::RowIterator& jac, const ShellLayout_t& layout, double alpha, double invBetaP, double timeFactor);
 	void solveForFluxes(double* const vecState, const Indexer& idxr);
 
+	inline unsigned int numConsistentInitBatches() const CADET_NOEXCEPT { return (_consInitShells.size() + _consInitBatchSize - 1) / _consInitBatchSize; }
+
 #ifdef CADET_CHECK_ANALYTIC_JACOBIAN
 	void checkAnalyticJacobianAgainstAd(active const* const adRes, unsigned int adDirOffset) const;
 #endif
@@ -293,14 +367,41 @@ protected:
 
 	std::unordered_map<ParameterId, active*> _parameters; //!< Provides access to all parameters
 	bool _analyticJac; //!< Determines whether AD or analytic Jacobians are used
+	bool _analyticParamDeriv; //!< Determines whether parameter derivatives of the residual are computed analytically (with AD as fallback)
+	bool _adDirectionPlanes; //!< Determines whether the AD Jacobian of the transport terms is computed by sweeps over direction planes
 
-	ArrayPool _stencilMemory; //!< Provides memory for the stencil
-	double* _wenoDerivatives; //!< Holds derivatives of the WENO scheme
+	ArrayPool* _stencilMemory; //!< Provides memory for the stencil of each component
+	ArrayPool* _wenoMemory; //!< Provides memory for intermediate values of the WENO scheme for each component
+	double* _wenoDerivatives; //!< Holds derivatives of the WENO scheme for each component
 	Weno _weno; //!< The WENO scheme implementation
 	double _wenoEpsilon; //!< The @f$ \varepsilon @f$ of the WENO scheme (prevents division by zero)
 
 	std::unordered_set<active*> _sensParams; //!< Holds all parameters with activated AD directions
+	bool _sensBindingParams; //!< Determines whether a parameter of the binding model has activated AD directions
+	std::vector<double> _paramDerivBuffer; //!< Temporary storage with the size of the state vector for analytic parameter derivatives
 	unsigned int _jacobianAdDirs; //!< Number of AD seed vectors required for Jacobian computation
+	linalg::CompressedSparseMatrix _jacPadPattern; //!< Sparsity pattern of the particle blocks used for AD seeding (values are unused)
+	std::vector<unsigned int> _jacPadColors; //!< AD direction (color) of each column of a particle block
+	unsigned int _parAdDirs; //!< Number of AD directions (colors) required for the particle blocks
+
+	/**
+	 * @brief Storage of the direction plane sweeps (structure of arrays)
+	 * @details Each plane holds one AD direction of a contiguous part of the state or residual vector.
+	 *          Seed planes of the column bulk hold @c NCOL elements, planes of the particle blocks hold
+	 *          one particle block. The derivative planes of the particle blocks are shared by all blocks,
+	 *          since their transport terms do not depend on the state.
+	 */
+	struct DirectionPlanes
+	{
+		std::vector<double> bulkSeeds; //!< Seed planes of the column bulk (identical for all components)
+		std::vector<double> bulkDerivs; //!< Derivative planes of the column bulk, all planes of one component are stored consecutively
+		std::vector<double> particleSeeds; //!< Seed planes of the particle blocks
+		std::vector<double> particleDerivs; //!< Derivative planes of the mobile phase transport in a particle block
+		std::vector<double> wenoDerivs; //!< Derivatives of the reconstructed cell face values with respect to the stencil for each cell and component
+		std::vector<int> wenoOrder; //!< WENO order used for each cell and component
+		std::vector<double> faceDerivs; //!< Directional derivatives of the reconstructed cell face values of each component
+	};
+	DirectionPlanes _dirPlanes; //!< Storage of the direction plane sweeps (only used if _adDirectionPlanes is @c true)
 
 	std::vector<double> _parCellSize; //!< Particle cell / shell size
 	std::vector<double> _parCenterRadius; //!< Particle cell-centered position for each particle cell
@@ -310,9 +411,32 @@ protected:
 	ArrayPool _discParFlux; //!< Storage for discretized @f$ k_f @f$ value
 
 	bool _factorizeJacobian; //!< Determines whether the Jacobian needs to be factorized
-	double* _tempState; //!< Temporary storage with the size of the state vector or nCol * nPar * _binding->consistentInitializationWorkspaceSize() whichever is larger
+	double _jacReuseTol; //!< Maximum relative change of alpha for which the last factorization of the Jacobian is reused (@c 0 disables reuse)
+	double _factorizedAlpha; //!< Value of alpha the current factorization was computed with (@c 0 if there is no valid factorization)
+	unsigned int _numFactorizations; //!< Number of factorizations of the time-discretized Jacobian
+	unsigned int _numFactorizationReuses; //!< Number of linear solves that reused the factorization of a previous Jacobian or alpha
+	double* _tempState; //!< Temporary storage with the size of the state vector
+	unsigned int _shellLayout; //!< Index of the particle kernels in the dispatch tables (@c 0 for runtime sizes, otherwise number of components with one bound state each)
+	unsigned int _consInitBatchSize; //!< Number of particle shells in one batch of consistent initialization
+	std::vector<ParticleShell> _consInitShells; //!< Locations of all particle shells in the order of consistent initialization
+	std::vector<double> _consInitWorkspace; //!< Nonlinear solver workspace and dense working matrix of each consistent initialization batch
+	std::vector<lapackInt_t> _consInitPivot; //!< Pivot storage of the dense working matrix of each consistent initialization batch
+	std::vector<ConsistentInitStats> _consInitBatchStats; //!< Statistics of each consistent initialization batch
+	bool _consInitUseCache; //!< Determines whether converged bound states are cached for each section and reused as initial guesses
+	std::unordered_map<unsigned int, std::vector<double>> _consInitCache; //!< Converged bound states of all particle shells for each section
+	ConsistentInitStats _consInitStats; //!< Accumulated statistics of the consistent initialization of the bound states
 	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement in linearSolve()
 	double _schurSafety; //!< Safety factor for Schur-complement solution
+	bool _directSchur; //!< Determines whether the Schur-complement is assembled and solved directly instead of using GMRES
+	bool _schurFactorized; //!< Determines whether _schurDense holds a valid factorization of the current Schur-complement
+	linalg::DenseMatrix _schurDense; //!< Dense Schur-complement (only used if _directSchur is @c true)
+	bool _sparseSolve; //!< Determines whether the full Jacobian is assembled and solved by a sparse direct solver instead of the Schur-complement approach
+	linalg::CompressedSparseMatrix _jacSparse; //!< Full time-discretized Jacobian without inlet DOFs (only used if _sparseSolve is @c true or by linearSolveTransposed())
+	std::vector<unsigned int> _jacSparseDiag; //!< Position of the diagonal element of each row in the values array of _jacSparse
+	std::vector<unsigned int> _jacSparseOffdiag; //!< Positions of the elements of the off-diagonal blocks in the values array of _jacSparse (in assembly order)
+	linalg::SparseDirectSolver _sparseSolver; //!< Sparse LU factorization of _jacSparse
+	bool _factorizeTransposed; //!< Determines whether linearSolveTransposed() has to factorize the Jacobian again
+	double _factorizedAlphaTransposed; //!< Value of alpha _sparseSolver has been factorized with in linearSolveTransposed() (@c 0 if there is no valid factorization)
 
 	BENCH_TIMER(_timerResidual)
 	BENCH_TIMER(_timerResidualPar)
@@ -326,6 +450,8 @@ protected:
 	BENCH_TIMER(_timerFactorizePar)
 	BENCH_TIMER(_timerMatVec)
 	BENCH_TIMER(_timerGmres)
+	BENCH_TIMER(_timerSchurAssemble)
+	BENCH_TIMER(_timerSparseFactorize)
 
 	// Wrapper for calling the corresponding function in GeneralRateModel class
 	friend int schurComplementMultiplierGRM(void* userData, double const* x, double* z);
@@ -431,6 +557,58 @@ protected:
 		const Discretization& _disc;
 	};
 
+	/**
+	 * @brief Layout of a particle shell whose sizes are determined at runtime
+	 * @details Provides sizes and strides of a particle shell to the particle kernels. This is
+	 *          the generic layout that supports any number of components and bound states.
+	 */
+	class DynamicShellLayout
+	{
+	public:
+		DynamicShellLayout(const Discretization& disc) : _disc(disc) { }
+
+		inline unsigned int nComp() const CADET_NOEXCEPT { return _disc.nComp; }
+		inline unsigned int nBound(unsigned int comp) const CADET_NOEXCEPT { return _disc.nBound[comp]; }
+		inline int offsetBoundComp(unsigned int comp) const CADET_NOEXCEPT { return _disc.boundOffset[comp]; }
+		inline int strideParLiquid() const CADET_NOEXCEPT { return static_cast<int>(_disc.nComp); }
+		inline int strideParBound() const CADET_NOEXCEPT { return static_cast<int>(_disc.strideBound); }
+		inline int strideParShell() const CADET_NOEXCEPT { return strideParLiquid() + strideParBound(); }
+
+	protected:
+		const Discretization& _disc;
+	};
+
+	/**
+	 * @brief Layout of a particle shell with a fixed number of components that have exactly one bound state each
+	 * @details All sizes and strides are compile-time constants, which allows the compiler to unroll
+	 *          and vectorize the loops over the components in the particle kernels.
+	 * @tparam NComp Number of components
+	 */
+	template <unsigned int NComp>
+	class FixedShellLayout
+	{
+	public:
+		FixedShellLayout(const Discretization& disc) { }
+
+		CADET_CONSTEXPR static inline unsigned int nComp() CADET_NOEXCEPT { return NComp; }
+		CADET_CONSTEXPR static inline unsigned int nBound(unsigned int comp) CADET_NOEXCEPT { return 1; }
+		CADET_CONSTEXPR static inline int offsetBoundComp(unsigned int comp) CADET_NOEXCEPT { return static_cast<int>(comp); }
+		CADET_CONSTEXPR static inline int strideParLiquid() CADET_NOEXCEPT { return static_cast<int>(NComp); }
+		CADET_CONSTEXPR static inline int strideParBound() CADET_NOEXCEPT { return static_cast<int>(NComp); }
+		CADET_CONSTEXPR static inline int strideParShell() CADET_NOEXCEPT { return 2 * static_cast<int>(NComp); }
+	};
+
+	/**
+	 * @brief Maximum number of components for which particle kernels with compile-time sizes are instantiated
+	 */
+	CADET_CONSTEXPR static inline unsigned int maxFixedShellComponents() CADET_NOEXCEPT { return 4; }
+
+	/**
+	 * @brief Maximum number of tasks the particle blocks are split into when evaluating the residual
+	 * @details Columns with more cells assign several consecutive particle blocks to each task.
+	 */
+	CADET_CONSTEXPR static inline unsigned int maxResidualParticleTasks() CADET_NOEXCEPT { return 64; }
+
 	class Exporter : public ISolutionExporter
 	{
 	public:
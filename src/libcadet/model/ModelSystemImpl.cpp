@@ -14,6 +14,7 @@
 #include "cadet/ParameterProvider.hpp"
 #include "cadet/Exceptions.hpp"
 #include "cadet/ExternalFunction.hpp"
+#include "cadet/SolutionRecorder.hpp"
 
 #include "ConfigurationHelper.hpp"
 #include "linalg/SparseMatrix.hpp"
@@ -226,7 +227,8 @@ namespace cadet
 namespace model
 {
 
-ModelSystem::ModelSystem() : _jacNF(nullptr), _jacFN(nullptr), _jacActiveFN(nullptr), _curSwitchIndex(0), _tempState(nullptr)
+ModelSystem::ModelSystem() : _jacNF(nullptr), _jacFN(nullptr), _jacActiveFN(nullptr), _curSwitchIndex(0), _switchRestored(false), _tempState(nullptr),
+	_useSchurPrecond(false), _refreshSchurPrecond(true), _refreshSchurTransposed(true), _schurTransposedAlpha(0.0)
 {
 }
 
@@ -394,6 +396,16 @@ unsigned int ModelSystem::numPureDofs() const CADET_NOEXCEPT
 	return dofs;
 }
 
+unsigned int ModelSystem::unitOperationDofOffset(UnitOpIdx unitOpIdx) const CADET_NOEXCEPT
+{
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		if (_models[i]->unitOperationId() == unitOpIdx)
+			return _dofOffset[i];
+	}
+	return numDofs();
+}
+
 bool ModelSystem::usesAD() const CADET_NOEXCEPT
 {
 	for (IUnitOperation* m : _models)
@@ -534,6 +546,7 @@ bool ModelSystem::configure(IParameterProvider& paramProvider, IConfigHelper& he
 	_parameters.clear();
 	configureSwitches(paramProvider);
 	_curSwitchIndex = 0;
+	_switchRestored = false;
 
 	// Allocate memory to coupling matrices
 	_jacActiveFN = new linalg::SparseMatrix<active>[numModels()];
@@ -605,15 +618,40 @@ bool ModelSystem::configure(IParameterProvider& paramProvider, IConfigHelper& he
 	const int gsType = paramProvider.getInt("GS_TYPE");
 	const int maxRestarts = paramProvider.getInt("MAX_RESTARTS");
 	_schurSafety = paramProvider.getDouble("SCHUR_SAFETY");
+
+	if (paramProvider.exists("SCHUR_PRECONDITIONER"))
+		_useSchurPrecond = paramProvider.getBool("SCHUR_PRECONDITIONER");
+	else
+		_useSchurPrecond = false;
+
 	paramProvider.popScope();
 
 	// Initialize and configure GMRES for solving the Schur-complement
     _gmres.initialize(numCouplingDOF(), maxKrylov, linalg::toOrthogonalization(gsType), maxRestarts);
 
+	// The network version of the schurComplementMatrixVector function needs access to more information than the GMRES interface provides.
+	// The additional arguments are taken from the linear solver context that is set in linearSolve(). Since the lambda only captures
+	// this pointer, it is stored without heap allocation and set only once.
+	_gmres.matrixVectorMultiplier([this](void* userData, double const* x, double* z) -> int
+		{
+			const LinearSolveContext& ctx = _linSolveCtx;
+			return schurComplementMatrixVector(x, z, ctx.t, ctx.timeFactor, ctx.alpha, ctx.outerTol, ctx.weight, ctx.y, ctx.yDot, ctx.res);
+		});
+
+	// Allocate preconditioner
+	if (_useSchurPrecond)
+		_schurPrecond.resize(numCouplingDOF(), numCouplingDOF());
+	_refreshSchurPrecond = true;
+	_refreshSchurTransposed = true;
+	setupSchurPreconditioner();
+
 	// Allocate tempState vector
 	delete[] _tempState;
 	_tempState = new double[numDofs()];
 
+	// Allocate one slice of coupling DOFs per unit operation for lock-free reductions
+	_couplingBuffer.resize(numModels() * numCouplingDOF(), 0.0);
+
 //	_tempSchur = new double[*std::max_element(_dofs.begin(), _dofs.end())];
 	_totalInletFlow.resize(numModels(), 0.0);
 
@@ -664,14 +702,47 @@ bool ModelSystem::reconfigure(IParameterProvider& paramProvider)
 	const int gsType = paramProvider.getInt("GS_TYPE");
 	const int maxRestarts = paramProvider.getInt("MAX_RESTARTS");
 	_schurSafety = paramProvider.getDouble("SCHUR_SAFETY");
+
+	if (paramProvider.exists("SCHUR_PRECONDITIONER"))
+		_useSchurPrecond = paramProvider.getBool("SCHUR_PRECONDITIONER");
+
 	paramProvider.popScope();
 
 	_gmres.orthoMethod(linalg::toOrthogonalization(gsType));
 	_gmres.maxRestarts(maxRestarts);
 
+	if (_useSchurPrecond && (_schurPrecond.rows() != numCouplingDOF()))
+		_schurPrecond.resize(numCouplingDOF(), numCouplingDOF());
+	_refreshSchurPrecond = true;
+	_refreshSchurTransposed = true;
+	setupSchurPreconditioner();
+
 	return success;
 }
 
+/**
+ * @brief Hands the preconditioner of the Schur-complement over to the GMRES solver
+ * @details The preconditioner function is only created when the model is (re)configured. If the
+ *          assembly of the preconditioner fails, the preconditioner falls back to the identity.
+ */
+void ModelSystem::setupSchurPreconditioner()
+{
+	if (!_useSchurPrecond)
+	{
+		_gmres.preconditioner(nullptr);
+		return;
+	}
+
+	_gmres.preconditioner([this](void* userData, double const* r, double* z) -> int
+		{
+			std::copy_n(r, numCouplingDOF(), z);
+			if (_refreshSchurPrecond)
+				return 0;
+
+			return _schurPrecond.solve(z) ? 0 : 1;
+		});
+}
+
 /**
  * @brief Reads valve switches from the given parameter provider
  * @param [in] paramProvider Parameter provider
@@ -1021,6 +1092,10 @@ void ModelSystem::notifyDiscontinuousSectionTransition(double t, unsigned int se
 	if (secIdx == 0)
 		_curSwitchIndex = 0;
 
+	// A restored valve configuration already belongs to this section
+	const bool restored = _switchRestored;
+	_switchRestored = false;
+
 	const unsigned int wrapSec = secIdx % _switchSectionIndex.size();
 	const unsigned int prevSwitch = _curSwitchIndex;
 
@@ -1096,10 +1171,19 @@ void ModelSystem::notifyDiscontinuousSectionTransition(double t, unsigned int se
 	}
 #endif
 
-	if ((0 == secIdx) || (prevSwitch != _curSwitchIndex))
+	if ((0 == secIdx) || restored || (prevSwitch != _curSwitchIndex))
 		assembleSuperStructMatrices(secIdx);		
 }
 
+void ModelSystem::restoreSwitchIndex(unsigned int idx)
+{
+	if (idx >= _switchSectionIndex.size())
+		throw InvalidParameterException("Valve configuration index " + std::to_string(idx) + " out of range");
+
+	_curSwitchIndex = idx;
+	_switchRestored = true;
+}
+
 /**
 * @brief Rebuild the outer network connection matrices in the super structure
 * @details Rebuild NF and FN matrices. This should only be called if the connections have changed. 
@@ -1228,6 +1312,11 @@ void ModelSystem::reportSolution(ISolutionRecorder& recorder, double const* cons
 	for (unsigned int i = 0; i < _models.size(); ++i)
 	{
 		IUnitOperation* const m = _models[i];
+
+		// Skip unit operations that are not recorded
+		if (recorder.recordedFields(m->unitOperationId()) == RecordedField::None)
+			continue;
+
 		m->reportSolution(recorder, solution + _dofOffset[i]);
 	}
 }
@@ -1287,6 +1376,9 @@ int ModelSystem::residual(double t, unsigned int secIdx, double timeFactor, doub
 	// Handle connections
 	residualConnectUnitOps<double, double, double>(secIdx, y, yDot, res);
 
+	// Jacobians of the unit operations have changed
+	_refreshSchurPrecond = true;
+
 	BENCH_STOP(_timerResidual);
 	return totalErrorIndicatorFromLocal(_errorIndicator);
 }
@@ -1314,6 +1406,9 @@ int ModelSystem::residualWithJacobian(const active& t, unsigned int secIdx, cons
 
 	} CADET_PARFOR_END;
 
+	// Jacobians of the unit operations have changed
+	_refreshSchurPrecond = true;
+
 	// Handle connections
 	residualConnectUnitOps<double, double, double>(secIdx, y, yDot, res);
 
@@ -1747,8 +1842,11 @@ void ModelSystem::consistentInitialSensitivityAlgorithm(const active& t, unsigne
 	// Compute parameter sensitivities and update the Jacobian
 	dResDpFwdWithJacobian(t, secIdx, timeFactor, vecStateY, vecStateYdot, adRes, adY, vecSensY.size());
 
-	std::vector<double*> vecSensYlocal(vecSensY.size(), nullptr);
-	std::vector<double*> vecSensYdotLocal(vecSensYdot.size(), nullptr);
+	// Reuse memory of previous calls
+	std::vector<double*>& vecSensYlocal = _sensYlocal;
+	std::vector<double*>& vecSensYdotLocal = _sensYdotLocal;
+	vecSensYlocal.resize(vecSensY.size(), nullptr);
+	vecSensYdotLocal.resize(vecSensYdot.size(), nullptr);
 	for (unsigned int i = 0; i < _models.size(); ++i)
 	{
 		IUnitOperation* const m = _models[i];
@@ -2194,6 +2292,10 @@ int ModelSystem::linearSolve(double t, double timeFactor, double alpha, double o
 
 	const unsigned int finalOffset = _dofOffset[_models.size()];
 
+	const unsigned int nCoupling = numCouplingDOF();
+
+	// Solve diagonal blocks y_i = J_i^{-1} b_i and compute J_{f,i} y_i into a private slice of
+	// the coupling buffer, which avoids write conflicts on the coupling part of rhs
 #ifdef CADET_PARALLELIZE
 	tbb::parallel_for(size_t(0), _models.size(), [=](size_t i)
 #else
@@ -2203,18 +2305,15 @@ int ModelSystem::linearSolve(double t, double timeFactor, double alpha, double o
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
 		_errorIndicator[i] = m->linearSolve(t, timeFactor, alpha, outerTol, rhs + offset, weight + offset, y + offset, yDot + offset, res + offset);
+
+		double* const slice = _couplingBuffer.data() + i * nCoupling;
+		std::fill_n(slice, nCoupling, 0.0);
+		_jacFN[i].multiplyAdd(rhs + offset, slice);
 	} CADET_PARFOR_END;
 
 	// Solve last row of L with backwards substitution: y_f = b_f - \sum_{i=0}^{N_z} J_{f,i} y_i
-	// Note that we cannot easily parallelize this loop since the results of the sparse
-	// matrix-vector multiplications are added in-place to rhs. We would need one copy of rhs
-	// for each thread and later fuse them together (reduction statement).
-	for (unsigned int i = 0; i < _models.size(); ++i)
-	{
-		const unsigned int offset = _dofOffset[i];
-		_jacFN[i].multiplySubtract(rhs + offset, rhs + finalOffset);
-	}
-
+	// by reducing the slices of all unit operations
+	subtractCouplingBuffer(_models.size(), rhs + finalOffset);
 
 	// Now, rhs contains the full intermediate solution y = L^{-1} b
 
@@ -2233,21 +2332,28 @@ int ModelSystem::linearSolve(double t, double timeFactor, double alpha, double o
 	// The temporary storage is only needed to hold the right hand side of the Schur-complement
 	const double tolerance = std::sqrt(static_cast<double>(numDofs())) * outerTol * _schurSafety;
 
-	// The network version of the schurCompletmentMatrixVector function need access to more information than the current interface
-	// Instead of changing the interface a lambda function is used and closed over the additional variables
-	auto schurComplementMatrixVectorPartial = [&, this](void* userData, double const* x, double* z) -> int 
-	{
-		return ModelSystem::schurComplementMatrixVector(x, z, t, timeFactor, alpha, outerTol, weight, y, yDot, res);
-	};
+	// Provide the additional arguments of schurComplementMatrixVector() to the GMRES matrix-vector product
+	_linSolveCtx.t = t;
+	_linSolveCtx.timeFactor = timeFactor;
+	_linSolveCtx.alpha = alpha;
+	_linSolveCtx.outerTol = outerTol;
+	_linSolveCtx.weight = weight;
+	_linSolveCtx.y = y;
+	_linSolveCtx.yDot = yDot;
+	_linSolveCtx.res = res;
+
+	// Assemble preconditioner only if Jacobians have changed (on failure, the identity is used)
+	if (_useSchurPrecond && _refreshSchurPrecond)
+		_refreshSchurPrecond = !assembleSchurPreconditioner(t, timeFactor, alpha, outerTol, weight, y, yDot, res);
 
-	_gmres.matrixVectorMultiplier(schurComplementMatrixVectorPartial);
-	
 	// Reset error indicator as it is used in schurComplementMatrixVector()
 	const int curError = totalErrorIndicatorFromLocal(_errorIndicator);
 	std::fill(_errorIndicator.begin(), _errorIndicator.end(), 0);
 
 	const int gmresResult = _gmres.solve(tolerance, weight + finalOffset, _tempState + finalOffset, rhs + finalOffset);
 
+	LOG(Trace) << "Schur-complement GMRES took " << _gmres.numIterations() << " iterations";
+
 	// Set last cumulative error to all elements to restore state (in the end only total error matters)
 	std::fill(_errorIndicator.begin(), _errorIndicator.end(), updateErrorIndicator(curError, gmresResult));
 
@@ -2296,8 +2402,9 @@ S &= J_f - J_{f,0} \, J_0^{-1} \, J_{0,f} - \sum_{p=1}^{N_z}{J_{f,p} \, J_p^{-1}
 *          and @f$ J_{f,i} @f$ for @f$ i = 0, \dots, N_{z} @f$ are sparse.
 *
 *          The matrix-vector multiplication is executed in parallel as follows:
-*              -# Compute @f$ J_{f,i} \, J_i^{-1} \, J_{i,f} @f$ independently (in parallel with respect to index @f$ i @f$)
-*              -# Subtract the result from @f$ z @f$ in a critical section to avoid race conditions
+*              -# Compute @f$ J_{f,i} \, J_i^{-1} \, J_{i,f} x @f$ independently (in parallel with respect to index @f$ i @f$)
+*                 and store the result in a private slice of the coupling buffer
+*              -# Subtract the sum of all slices from @f$ z @f$
 *
 * @param [in] x Vector @f$ x @f$ the matrix @f$ S @f$ is multiplied with
 * @param [out] z Result of the matrix-vector multiplication
@@ -2308,8 +2415,10 @@ int ModelSystem::schurComplementMatrixVector(double const* x, double* z, double
 {
 	BENCH_SCOPE(_timerMatVec);
 
+	const unsigned int nCoupling = numCouplingDOF();
+
 	// Copy x over to result z, which corresponds to the application of the identity matrix
-	std::copy(x, x + numCouplingDOF(), z);
+	std::copy(x, x + nCoupling, z);
 
 	// Inlets and outlets don't participate in the Schur solver since one of NF or FN for them is always 0
 	// As a result we only have to work with items that have both an inlet and an outlet
@@ -2323,24 +2432,350 @@ int ModelSystem::schurComplementMatrixVector(double const* x, double* z, double
 		IUnitOperation* const m = _models[idxModel];
 		const unsigned int offset = _dofOffset[idxModel];
 
+		// Remove results of previous calls since J_{i,f} x only sets the inlet DOFs
+		std::fill(_tempState + offset, _tempState + _dofOffset[idxModel + 1], 0.0);
 		_jacNF[idxModel].multiplyVector(x, _tempState + offset);
 
 		// Apply N_i^{-1} to tempState_i
 		const int linSolve = m->linearSolve(t, timeFactor, alpha, outerTol, _tempState + offset, weight + offset, y + offset, yDot + offset, res + offset);
 		_errorIndicator[idxModel] = updateErrorIndicator(_errorIndicator[idxModel], linSolve);
 
-		// Apply J_{f,i} and subtract results from z
+		// Apply J_{f,i} and store results in this task's slice
+		double* const slice = _couplingBuffer.data() + i * nCoupling;
+		std::fill_n(slice, nCoupling, 0.0);
+		_jacFN[idxModel].multiplyAdd(_tempState + offset, slice);
+	} CADET_PARFOR_END;
+
+	// Subtract results from z
+	subtractCouplingBuffer(_inOutModels.size(), z);
+
+	return totalErrorIndicatorFromLocal(_errorIndicator);
+}
+
+/**
+ * @brief Subtracts the sum of the first slices of the coupling buffer from the given vector
+ * @details Reduces the partial results of the unit operations, which are computed independently
+ *          in parallel. The summation order is fixed, which makes the result independent of
+ *          the number of threads and their scheduling.
+ * @param [in] nSlices Number of slices to reduce
+ * @param [in,out] z Vector of length numCouplingDOF() the reduced sum is subtracted from
+ */
+void ModelSystem::subtractCouplingBuffer(unsigned int nSlices, double* const z) const
+{
+	const unsigned int nCoupling = numCouplingDOF();
+	for (unsigned int i = 0; i < nSlices; ++i)
+	{
+		double const* const slice = _couplingBuffer.data() + i * nCoupling;
+		for (unsigned int j = 0; j < nCoupling; ++j)
+			z[j] -= slice[j];
+	}
+}
+
+/**
+ * @brief Assembles and factorizes the Schur-complement for use as preconditioner
+ * @details The Schur-complement
+ *          @f[ S = I - \sum_{i}{J_{f,i} \, J_i^{-1} \, J_{i,f}} @f]
+ *          is assembled column by column. Since the columns of @f$ J_{i,f} @f$ correspond to the
+ *          coupling DOFs of the inlet of unit operation @f$ i @f$, each unit operation contributes
+ *          to its own columns only and the unit operations can be processed in parallel. Each
+ *          column requires one application of @f$ J_i^{-1} @f$.
+ *
+ *          The matrix is only exact up to the accuracy of the linear solvers of the unit operations.
+ *          It is used as right preconditioner in the GMRES iteration on the coupling DOFs.
+ *
+ * @param [in] t Current time point
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] outerTol Error tolerance for the solution of the linear system from outer Newton iteration
+ * @param [in] weight Vector with error weights
+ * @param [in] y Pointer to global state vector at which the Jacobian is evaluated
+ * @param [in] yDot Pointer to global time derivative state vector at which the Jacobian is evaluated
+ * @param [in] res Pointer to global residual vector at the point @p y, @p yDot
+ * @return @c true if the preconditioner has been successfully assembled and factorized, otherwise @c false
+ */
+bool ModelSystem::assembleSchurPreconditioner(double t, double timeFactor, double alpha, double outerTol, double const* const weight,
+	double const* const y, double const* const yDot, double const* const res)
+{
+	BENCH_SCOPE(_timerPrecondAssemble);
+
+	const unsigned int nCoupling = numCouplingDOF();
+
+	// Start with J_f = I
+	_schurPrecond.setAll(0.0);
+	for (unsigned int i = 0; i < nCoupling; ++i)
+		_schurPrecond.native(i, i) = 1.0;
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), _inOutModels.size(), [=](size_t i)
+#else
+	for (unsigned int i = 0; i < _inOutModels.size(); ++i)
+#endif
+	{
+		const unsigned int idxModel = _inOutModels[i];
+		IUnitOperation* const m = _models[idxModel];
+		const unsigned int offset = _dofOffset[idxModel];
+		const unsigned int offsetNext = _dofOffset[idxModel + 1];
+
+		// Use this task's slice of the coupling buffer for unit vectors and results
+		double* const slice = _couplingBuffer.data() + i * nCoupling;
+		const unsigned int firstCol = _couplingIdxMap.at(std::make_pair(idxModel, 0u));
+
+		for (unsigned int comp = 0; comp < m->numComponents(); ++comp)
 		{
+			const unsigned int col = firstCol + comp;
+
+			// Compute J_{i,f} e_col
+			std::fill_n(slice, nCoupling, 0.0);
+			slice[col] = 1.0;
+			std::fill(_tempState + offset, _tempState + offsetNext, 0.0);
+			_jacNF[idxModel].multiplyVector(slice, _tempState + offset);
+
+			// Apply J_i^{-1}
+			const int linSolve = m->linearSolve(t, timeFactor, alpha, outerTol, _tempState + offset, weight + offset, y + offset, yDot + offset, res + offset);
+			_errorIndicator[idxModel] = updateErrorIndicator(_errorIndicator[idxModel], linSolve);
+
+			// Apply J_{f,i} and subtract from column
+			std::fill_n(slice, nCoupling, 0.0);
+			_jacFN[idxModel].multiplyAdd(_tempState + offset, slice);
+
+			for (unsigned int row = 0; row < nCoupling; ++row)
+				_schurPrecond.native(row, col) -= slice[row];
+		}
+	} CADET_PARFOR_END;
+
+	if (!_schurPrecond.factorize())
+	{
+		LOG(Error) << "Factorize() failed for Schur-complement preconditioner";
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Multiplies the given vector with the transposed Jacobian of the whole system
+ * @details The transposed Jacobian consists of the transposed Jacobians of the unit operations on the
+ *          diagonal, the identity matrix of the coupling DOFs, and the transposed coupling blocks
+ *          @f$ J_{f,i}^T @f$ and @f$ J_{i,f}^T @f$.
+ * @param [in] yS Vector @f$ x @f$ that is transformed by the transposed Jacobian
+ * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ \left(\frac{\partial F}{\partial y}\right)^T @f$
+ * @param [in] beta Factor @f$ \beta @f$ in front of @f$ z @f$
+ * @param [in,out] ret Vector @f$ z @f$ which stores the result of the operation
+ */
+void ModelSystem::multiplyWithJacobianTransposed(double const* yS, double alpha, double beta, double* ret)
+{
+	const unsigned int finalOffset = _dofOffset.back();
+
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		const unsigned int offset = _dofOffset[i];
+		_models[i]->multiplyWithJacobianTransposed(yS + offset, alpha, beta, ret + offset);
+	}
+
+	// Identity matrix of the coupling DOFs
+	for (unsigned int i = finalOffset; i < numDofs(); ++i)
+		ret[i] = alpha * yS[i] + beta * ret[i];
+
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		const unsigned int offset = _dofOffset[i];
+
+		// Transposed outlet matrices N_{f,x}^T map coupling DOFs to unit operations
+		_jacFN[i].transposedMultiplyAdd(yS + finalOffset, ret + offset, alpha);
+
+		// Transposed inlet matrices N_{x,f}^T map unit operations to coupling DOFs
+		_jacNF[i].transposedMultiplyAdd(yS + offset, ret + finalOffset, alpha);
+	}
+}
+
+void ModelSystem::multiplyWithDerivativeJacobianTransposed(double const* sDot, double* ret, double timeFactor)
+{
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		const unsigned int offset = _dofOffset[i];
+		_models[i]->multiplyWithDerivativeJacobianTransposed(sDot + offset, ret + offset, timeFactor);
+	}
+
+	// Coupling DOFs are algebraic
+	std::fill(ret + _dofOffset.back(), ret + numDofs(), 0.0);
+}
+
+/**
+ * @brief Solves the linear system with the transposed Jacobian of the whole system
+ * @details The transposed Jacobian has the block structure
+ *          @f[ \begin{pmatrix} J_i^T & J_{f,i}^T \\ J_{i,f}^T & I \end{pmatrix}, @f]
+ *          which is solved by block elimination using the transposed Schur-complement
+ *          @f[ S^T = I - \sum_{i}{J_{i,f}^T \, J_i^{-T} \, J_{f,i}^T}. @f]
+ *          Since the number of coupling DOFs is small, @f$ S^T @f$ is assembled and factorized
+ *          explicitly by assembleSchurComplementTransposed() whenever @f$ \alpha @f$ has changed or
+ *          invalidateTransposedFactorization() has been called. The diagonal blocks are handled by the
+ *          unit operations.
+ * @param [in] t Current time point
+ * @param [in] timeFactor Used for time transformation (pre factor of time derivatives) and to compute parameter derivatives with respect to section length
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] outerTol Error tolerance for the solution of the linear system from outer Newton iteration
+ * @param [in,out] rhs On entry the right hand side of the linear equation system, on exit the solution
+ * @param [in] weight Vector with error weights
+ * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+ */
+int ModelSystem::linearSolveTransposed(double t, double timeFactor, double alpha, double outerTol, double* const rhs, double const* const weight)
+{
+	BENCH_SCOPE(_timerLinearSolve);
+
+	const unsigned int finalOffset = _dofOffset[_models.size()];
+	const unsigned int nCoupling = numCouplingDOF();
+
+	if (_refreshSchurTransposed || (alpha != _schurTransposedAlpha))
+	{
+		if (!assembleSchurComplementTransposed(t, timeFactor, alpha, outerTol, weight))
+			return 1;
+
+		_refreshSchurTransposed = false;
+		_schurTransposedAlpha = alpha;
+	}
+
+	// Solve diagonal blocks y_i = J_i^{-T} b_i and compute J_{i,f}^T y_i into a private slice of the coupling buffer
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), _models.size(), [=](size_t i)
+#else
+	for (unsigned int i = 0; i < _models.size(); ++i)
+#endif
+	{
+		IUnitOperation* const m = _models[i];
+		const unsigned int offset = _dofOffset[i];
+		_errorIndicator[i] = m->linearSolveTransposed(t, timeFactor, alpha, outerTol, rhs + offset, weight + offset);
+
+		double* const slice = _couplingBuffer.data() + i * nCoupling;
+		std::fill_n(slice, nCoupling, 0.0);
+		_jacNF[i].transposedMultiplyAdd(rhs + offset, slice, 1.0);
+	} CADET_PARFOR_END;
+
+	// y_f = b_f - \sum_i J_{i,f}^T y_i
+	subtractCouplingBuffer(_models.size(), rhs + finalOffset);
+
+	// x_f = S^{-T} y_f
+	if (!_schurTransposed.solve(rhs + finalOffset))
+	{
+		LOG(Error) << "Solve() failed for transposed Schur-complement";
+		return 1;
+	}
+
+	// x_i = y_i - J_i^{-T} J_{f,i}^T x_f
 #ifdef CADET_PARALLELIZE
-			SchurComplementMutex::scoped_lock l(_schurMutex);
+	tbb::parallel_for(size_t(0), _models.size(), [=](size_t idxModel)
+#else
+	for (unsigned int idxModel = 0; idxModel < _models.size(); ++idxModel)
 #endif
-			_jacFN[idxModel].multiplySubtract(_tempState + offset, z);
+	{
+		// Unit operations without outlet are not affected by the coupling DOFs
+		if (_jacFN[idxModel].numNonZero() > 0)
+		{
+			IUnitOperation* const m = _models[idxModel];
+			const unsigned int offset = _dofOffset[idxModel];
+			const unsigned int offsetNext = _dofOffset[idxModel + 1];
+
+			std::fill(_tempState + offset, _tempState + offsetNext, 0.0);
+			_jacFN[idxModel].transposedMultiplyAdd(rhs + finalOffset, _tempState + offset, 1.0);
+
+			const int linSolve = m->linearSolveTransposed(t, timeFactor, alpha, outerTol, _tempState + offset, weight + offset);
+			_errorIndicator[idxModel] = updateErrorIndicator(_errorIndicator[idxModel], linSolve);
+
+			for (unsigned int i = offset; i < offsetNext; ++i)
+				rhs[i] -= _tempState[i];
 		}
 	} CADET_PARFOR_END;
 
 	return totalErrorIndicatorFromLocal(_errorIndicator);
 }
 
+void ModelSystem::invalidateTransposedFactorization()
+{
+	_refreshSchurTransposed = true;
+	for (IUnitOperation* m : _models)
+		m->invalidateTransposedFactorization();
+}
+
+/**
+ * @brief Assembles and factorizes the transposed Schur-complement
+ * @details The transposed Schur-complement
+ *          @f[ S^T = I - \sum_{i}{J_{i,f}^T \, J_i^{-T} \, J_{f,i}^T} @f]
+ *          is assembled column by column. Column @f$ k @f$ only receives contributions from the unit operations
+ *          whose outlet is connected to coupling DOF @f$ k @f$ (i.e., row @f$ k @f$ of @f$ J_{f,i} @f$ is not empty).
+ *          Since the rows of @f$ J_{i,f}^T @f$ correspond to the coupling DOFs of the inlet of unit operation @f$ i @f$,
+ *          each unit operation writes to its own rows only and the unit operations can be processed in parallel.
+ *          Each contribution requires one application of @f$ J_i^{-T} @f$.
+ *
+ * @param [in] t Current time point
+ * @param [in] timeFactor Factor which is premultiplied to the time derivatives originating from time transformation
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] outerTol Error tolerance for the solution of the linear system from outer Newton iteration
+ * @param [in] weight Vector with error weights
+ * @return @c true if the transposed Schur-complement has been successfully assembled and factorized, otherwise @c false
+ */
+bool ModelSystem::assembleSchurComplementTransposed(double t, double timeFactor, double alpha, double outerTol, double const* const weight)
+{
+	BENCH_SCOPE(_timerPrecondAssemble);
+
+	const unsigned int nCoupling = numCouplingDOF();
+	if (_schurTransposed.rows() != nCoupling)
+		_schurTransposed.resize(nCoupling, nCoupling);
+
+	// Start with J_f = I
+	_schurTransposed.setAll(0.0);
+	for (unsigned int i = 0; i < nCoupling; ++i)
+		_schurTransposed.native(i, i) = 1.0;
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), _inOutModels.size(), [=](size_t i)
+#else
+	for (unsigned int i = 0; i < _inOutModels.size(); ++i)
+#endif
+	{
+		const unsigned int idxModel = _inOutModels[i];
+		IUnitOperation* const m = _models[idxModel];
+		const unsigned int offset = _dofOffset[idxModel];
+		const unsigned int offsetNext = _dofOffset[idxModel + 1];
+		const linalg::SparseMatrix<double>& jacFN = _jacFN[idxModel];
+
+		// Coupling DOFs connected to the outlet of this unit operation
+		std::vector<unsigned int> outletCoupling(jacFN.rows().begin(), jacFN.rows().begin() + jacFN.numNonZero());
+		std::sort(outletCoupling.begin(), outletCoupling.end());
+		outletCoupling.erase(std::unique(outletCoupling.begin(), outletCoupling.end()), outletCoupling.end());
+
+		// Use this task's slice of the coupling buffer for unit vectors and results
+		double* const slice = _couplingBuffer.data() + i * nCoupling;
+		const unsigned int firstRow = _couplingIdxMap.at(std::make_pair(idxModel, 0u));
+
+		for (unsigned int col : outletCoupling)
+		{
+			// Compute J_{f,i}^T e_col
+			std::fill_n(slice, nCoupling, 0.0);
+			slice[col] = 1.0;
+			std::fill(_tempState + offset, _tempState + offsetNext, 0.0);
+			jacFN.transposedMultiplyAdd(slice, _tempState + offset, 1.0);
+
+			// Apply J_i^{-T}
+			const int linSolve = m->linearSolveTransposed(t, timeFactor, alpha, outerTol, _tempState + offset, weight + offset);
+			_errorIndicator[idxModel] = updateErrorIndicator(_errorIndicator[idxModel], linSolve);
+
+			// Apply J_{i,f}^T and subtract from column
+			std::fill_n(slice, nCoupling, 0.0);
+			_jacNF[idxModel].transposedMultiplyAdd(_tempState + offset, slice, 1.0);
+
+			for (unsigned int row = firstRow; row < firstRow + m->numComponents(); ++row)
+				_schurTransposed.native(row, col) -= slice[row];
+		}
+	} CADET_PARFOR_END;
+
+	if (!_schurTransposed.factorize())
+	{
+		LOG(Error) << "Factorize() failed for transposed Schur-complement";
+		return false;
+	}
+
+	return true;
+}
+
 void ModelSystem::setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections)
 {
 	for (IUnitOperation* m : _models)
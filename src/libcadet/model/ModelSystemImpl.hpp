@@ -29,11 +29,8 @@
 #include <unordered_map>
 #include <unordered_set>
 
-#ifdef CADET_PARALLELIZE
-	#include <tbb/spin_mutex.h>
-#endif
-
 #include "linalg/SparseMatrix.hpp"
+#include "linalg/DenseMatrix.hpp"
 #include "linalg/Gmres.hpp"
 
 #include "Benchmark.hpp"
@@ -74,12 +71,15 @@ public:
 
 	virtual unsigned int numDofs() const CADET_NOEXCEPT;
 	virtual unsigned int numPureDofs() const CADET_NOEXCEPT;
+	virtual unsigned int unitOperationDofOffset(UnitOpIdx unitOpIdx) const CADET_NOEXCEPT;
 	virtual bool usesAD() const CADET_NOEXCEPT;
 	virtual unsigned int requiredADdirs() const CADET_NOEXCEPT;
 
 	virtual bool configure(IParameterProvider& paramProvider, IConfigHelper& helper);
 	virtual bool reconfigure(IParameterProvider& paramProvider);
 	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, active* const adRes, active* const adY, unsigned int adDirOffset);
+	virtual unsigned int currentSwitchIndex() const CADET_NOEXCEPT { return _curSwitchIndex; }
+	virtual void restoreSwitchIndex(unsigned int idx);
 	virtual bool reconfigureModel(IParameterProvider& paramProvider, unsigned int unitOpIdx);
 
 	virtual bool hasParameter(const ParameterId& pId) const;
@@ -119,6 +119,14 @@ public:
 
 	virtual int linearSolve(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res);
+	virtual int linearSolveTransposed(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight);
+	virtual void invalidateTransposedFactorization();
+
+	virtual void multiplyWithJacobianTransposed(double const* yS, double alpha, double beta, double* ret);
+	virtual void multiplyWithDerivativeJacobianTransposed(double const* sDot, double* ret, double timeFactor);
+
+	virtual int dResDpFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot,
+		active* const adRes, active* const adY, unsigned int adDirOffset);
 
 	virtual void prepareADvectors(active* const adRes, active* const adY, unsigned int adDirOffset) const;
 
@@ -144,8 +152,13 @@ public:
 	
 	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections);
 
+	void subtractCouplingBuffer(unsigned int nSlices, double* const z) const;
+	bool assembleSchurPreconditioner(double t, double timeFactor, double alpha, double outerTol, double const* const weight,
+		double const* const y, double const* const yDot, double const* const res);
+	void setupSchurPreconditioner();
 	int schurComplementMatrixVector(double const* x, double* z, double t, double timeFactor, double alpha, double outerTol, double const* const weight,
 		double const* const y, double const* const yDot, double const* const res) const;
+	bool assembleSchurComplementTransposed(double t, double timeFactor, double alpha, double outerTol, double const* const weight);
 
 	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut);
 	virtual std::vector<double> calculateErrorTolsForAdditionalDofs(double const* errorTol, unsigned int errorTolLength);
@@ -159,7 +172,9 @@ public:
 			_timerConsistentInit.totalElapsedTime(),
 			_timerLinearAssemble.totalElapsedTime(),
 			_timerLinearSolve.totalElapsedTime(),
-			_timerMatVec.totalElapsedTime()
+			_timerMatVec.totalElapsedTime(),
+			_timerPrecondAssemble.totalElapsedTime(),
+			static_cast<double>(_gmres.totalIterations())
 		});
 	}
 
@@ -171,7 +186,9 @@ public:
 			"ConsistentInit",
 			"LinearAssemble",
 			"LinearSolve",
-			"MatVec"
+			"MatVec",
+			"PrecondAssemble",
+			"GmresIter"
 		};
 		return desc;
 	}
@@ -191,8 +208,6 @@ protected:
 		multiplyWithJacobian(yS, 1.0, 0.0, ret);
 	}
 
-	int dResDpFwdWithJacobian(const active& t, unsigned int secIdx, const active& timeFactor, double const* const y, double const* const yDot, active* const adRes, active* const adY, unsigned int adDirOffset);
-
 	void rebuildInternalDataStructures();
 	void allocateSuperStructMatrices();
 	void assembleSuperStructMatrices(unsigned int secIdx);
@@ -233,6 +248,7 @@ protected:
 	util::SlicedVector<active> _flowRates; //!< Vector of connection flow rates for each section
 	std::vector<unsigned int> _switchSectionIndex; //!< Holds indices of sections where valves are switched
 	unsigned int _curSwitchIndex; //!< Current index in _switchSectionIndex list 
+	bool _switchRestored; //!< Determines whether _curSwitchIndex has been restored and matrices need to be assembled
 
 	mutable std::vector<int> _errorIndicator; //!< Storage for return value of unit operation function calls
 
@@ -242,21 +258,44 @@ protected:
 	std::vector<std::vector<const double*>> _yStemp; //!< Needed to store offsets for unit operations
 	std::vector<std::vector<const double*>> _yStempDot;  //!< Needed to store offsets for unit operations
 	std::vector<std::vector<double*>> _resSTemp;  //!< Needed to store offsets for unit operations
+	std::vector<double*> _sensYlocal; //!< Needed to store offsets for unit operations in consistent initialization of sensitivities
+	std::vector<double*> _sensYdotLocal; //!< Needed to store offsets for unit operations in consistent initialization of sensitivities
 
 	std::map<std::pair<unsigned int, unsigned int>, unsigned int> _couplingIdxMap; //!< Maps (UnitOpIdx, CompIdx) to local coupling DOF index
 
 	std::unordered_map<ParameterId, active*> _parameters; //!< Provides access to all parameters
 	std::unordered_set<active*> _sensParams; //!< Holds all parameters with activated AD directions
 
+	/**
+	 * @brief Arguments of linearSolve() required by schurComplementMatrixVector()
+	 */
+	struct LinearSolveContext
+	{
+		double t;
+		double timeFactor;
+		double alpha;
+		double outerTol;
+		double const* weight;
+		double const* y;
+		double const* yDot;
+		double const* res;
+	};
+
 	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement in linearSolve()
 	double _schurSafety; //!< Safety factor for Schur-complement solution
+	LinearSolveContext _linSolveCtx; //!< Arguments of the current linearSolve() call used by the GMRES matrix-vector product
+
+	bool _useSchurPrecond; //!< Determines whether the Schur-complement GMRES is preconditioned with the assembled Schur-complement
+	bool _refreshSchurPrecond; //!< Determines whether the preconditioner has to be assembled again due to a changed Jacobian
+	linalg::DenseMatrix _schurPrecond; //!< Explicitly assembled and factorized Schur-complement used as preconditioner
+
+	bool _refreshSchurTransposed; //!< Determines whether the transposed Schur-complement has to be assembled again (see invalidateTransposedFactorization())
+	double _schurTransposedAlpha; //!< Value of alpha the transposed Schur-complement has been assembled with
+	linalg::DenseMatrix _schurTransposed; //!< Explicitly assembled and factorized transposed Schur-complement used in linearSolveTransposed()
 
 	std::vector<unsigned int> _inOutModels; //!< Indices of unit operation models in _models that have inlet and outlet
 
-#ifdef CADET_PARALLELIZE
-	typedef tbb::spin_mutex SchurComplementMutex;
-	mutable SchurComplementMutex _schurMutex;
-#endif
+	mutable std::vector<double> _couplingBuffer; //!< Slices of length numCouplingDOF() holding partial products J_{f,i} * v_i of each unit operation before reduction
 
 	BENCH_TIMER(_timerResidual)
 	BENCH_TIMER(_timerResidualSens)
@@ -264,6 +303,7 @@ protected:
 	BENCH_TIMER(_timerLinearAssemble)
 	BENCH_TIMER(_timerLinearSolve)
 	BENCH_TIMER(_timerMatVec)
+	BENCH_TIMER(_timerPrecondAssemble)
 };
 
 } // namespace model
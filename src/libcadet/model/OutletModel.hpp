@@ -58,6 +58,7 @@ public:
 	virtual unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
 	virtual void setFlowRates(const active& in, const active& out) CADET_NOEXCEPT { }
 	virtual bool canAccumulate() const CADET_NOEXCEPT { return true; }
+	virtual double boundMass(double const* const y, unsigned int comp) const { return 0.0; }
 
 	static const char* identifier() { return "OUTLET"; }
 	virtual const char* unitOperationName() const CADET_NOEXCEPT { return "OUTLET"; }
@@ -120,6 +121,12 @@ public:
 	virtual void multiplyWithJacobian(double const* yS, double alpha, double beta, double* ret);
 	virtual void multiplyWithDerivativeJacobian(double const* sDot, double* ret, double timeFactor);
 
+	// Jacobians are symmetric and linearSolveTransposed is a null operation as for linearSolve
+	virtual void multiplyWithJacobianTransposed(double const* yS, double alpha, double beta, double* ret) { multiplyWithJacobian(yS, alpha, beta, ret); }
+	virtual void multiplyWithDerivativeJacobianTransposed(double const* sDot, double* ret, double timeFactor) { multiplyWithDerivativeJacobian(sDot, ret, timeFactor); }
+	virtual int linearSolveTransposed(double t, double timeFactor, double alpha, double tol, double* const rhs, double const* const weight) { return 0; }
+	virtual void invalidateTransposedFactorization() { }
+
 	virtual bool hasInlet() const CADET_NOEXCEPT { return true; }
 	virtual bool hasOutlet() const CADET_NOEXCEPT { return false; }
 
@@ -141,6 +141,80 @@ unsigned int BindingModelBase::consistentInitializationWorkspaceSize() const
 	return _nonlinearSolver->workspaceSize(eqSize);
 }
 
+unsigned int BindingModelBase::consistentInitializationBatchWorkspaceSize() const
+{
+	// Nonlinear solver workspace, residual of an initial guess, and backup of the best initial guess
+	return consistentInitializationWorkspaceSize() + 2 * numBoundStates(_nBoundStates, _nComp);
+}
+
+ConsistentInitStats BindingModelBase::consistentInitialStateBatch(double t, unsigned int secIdx, ParticleShell const* shells, unsigned int nShells, double* const vecStateY,
+	double const* guess, double errorTol, active* const adRes, active* const adY, unsigned int adOffset, unsigned int diagDir, unsigned int lowerBandwidth,
+	unsigned int upperBandwidth, double* const workingMemory, linalg::detail::DenseMatrixBase& workingMat) const
+{
+	const unsigned int eqSize = numBoundStates(_nBoundStates, _nComp);
+	double* const res = workingMemory + consistentInitializationWorkspaceSize();
+	double* const backup = res + eqSize;
+
+	// Initial guesses are only sensible if all bound states are determined
+	// by the nonlinear solver, that is, if all equations are algebraic
+	unsigned int algStart = 0;
+	unsigned int algLen = 0;
+	getAlgebraicBlock(algStart, algLen);
+	const bool warmStart = (eqSize > 0) && (algLen == eqSize);
+
+	ConsistentInitStats stats{ nShells, (guess && warmStart) ? nShells : 0u, 0u, 0u };
+
+	for (unsigned int i = 0; i < nShells; ++i)
+	{
+		const ParticleShell& shell = shells[i];
+		double* const q = vecStateY + shell.particleOffset + shell.shellOffset;
+
+		if (warmStart)
+		{
+			// Among the current state, the provided guess, and the converged solution of the preceding shell,
+			// start from the one with the smallest residual
+			residual(t, shell.z, shell.r, secIdx, 1.0, q, nullptr, res);
+			double bestRes = linalg::linfNorm(res, eqSize);
+
+			const auto tryCandidate = [&](double const* const candidate) -> bool
+			{
+				std::copy(q, q + eqSize, backup);
+				std::copy(candidate, candidate + eqSize, q);
+				residual(t, shell.z, shell.r, secIdx, 1.0, q, nullptr, res);
+				const double candRes = linalg::linfNorm(res, eqSize);
+
+				// Also catches NaN residuals
+				if (candRes < bestRes)
+				{
+					bestRes = candRes;
+					return true;
+				}
+
+				std::copy(backup, backup + eqSize, q);
+				return false;
+			};
+
+			const bool guessUsed = guess && tryCandidate(guess + i * eqSize);
+			const bool neighborUsed = (i > 0) && tryCandidate(vecStateY + shells[i-1].particleOffset + shells[i-1].shellOffset);
+			if (guessUsed && !neighborUsed)
+				++stats.numGuessesUsed;
+
+			// The nonlinear solver is not required if the algebraic equations are already satisfied
+			if (bestRes <= errorTol)
+			{
+				++stats.numSkipped;
+				continue;
+			}
+		}
+
+		consistentInitialState(t, shell.z, shell.r, secIdx, q, errorTol, adRes ? adRes + shell.particleOffset : nullptr,
+			adY ? adY + shell.particleOffset : nullptr, shell.shellOffset, adOffset, diagDir, lowerBandwidth, upperBandwidth,
+			workingMemory, workingMat);
+	}
+
+	return stats;
+}
+
 /*
 void BindingModelBase::timeDerivativeAlgebraicResidual(double t, double z, double r, unsigned int secIdx, double* const y, double* dResDt) const
 {
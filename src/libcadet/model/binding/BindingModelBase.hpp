@@ -73,10 +73,17 @@ public:
 	virtual bool supportsNonBinding() const CADET_NOEXCEPT { return true; }
 
 	virtual unsigned int consistentInitializationWorkspaceSize() const;
+	virtual unsigned int consistentInitializationBatchWorkspaceSize() const;
+	virtual ConsistentInitStats consistentInitialStateBatch(double t, unsigned int secIdx, ParticleShell const* shells, unsigned int nShells, double* const vecStateY,
+		double const* guess, double errorTol, active* const adRes, active* const adY, unsigned int adOffset, unsigned int diagDir, unsigned int lowerBandwidth,
+		unsigned int upperBandwidth, double* const workingMemory, linalg::detail::DenseMatrixBase& workingMat) const;
 
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { }
 
 	virtual void timeDerivativeAlgebraicResidual(double t, double z, double r, unsigned int secIdx, double const* y, double* dResDt) const { }
+
+	virtual bool hasAnalyticParamDerivatives() const CADET_NOEXCEPT { return false; }
+	virtual void addParamDerivatives(double t, double z, double r, unsigned int secIdx, double const* y, unsigned int nDirs, active* res) const { }
 protected:
 	int _nComp; //!< Number of components
 	unsigned int const* _nBoundStates; //!< Array with number of bound states for each component
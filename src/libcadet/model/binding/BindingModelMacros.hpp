@@ -79,4 +79,52 @@
 #define CADET_BINDINGMODEL_RESIDUAL_TEMPLATED_BOILERPLATE_IMPL(CLASSNAME,TEMPLATENAME)                             \
 	CADET_BINDINGMODEL_RESIDUAL_BOILERPLATE_IMPL_BASE(CLASSNAME<TEMPLATENAME>, template<typename TEMPLATENAME>)
 
+/**
+ * @brief Inserts implementations of all residualBatch() method variants which forward to residualBatchImpl() template function
+ * @details Similar to CADET_BINDINGMODEL_RESIDUAL_BOILERPLATE_IMPL_BASE, this macro provides the implementations of all
+ *          variants of residualBatch(). It assumes that the implementation provides a templatized residualBatchImpl()
+ *          function which realizes all required variants.
+ * 
+ * @param CLASSNAME Name of the IBindingModel implementation (including template)
+ * @param TEMPLATELINE Line before each function that may contain a template<typename TEMPLATENAME> modifier
+ */
+#define CADET_BINDINGMODEL_RESIDUALBATCH_BOILERPLATE_IMPL_BASE(CLASSNAME, TEMPLATELINE)                                                 \
+	TEMPLATELINE                                                                                                                        \
+	int CLASSNAME::residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,              \
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const                              \
+	{                                                                                                                                   \
+		return residualBatchImpl<active, active, active>(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);                  \
+	}                                                                                                                                   \
+	                                                                                                                                    \
+	TEMPLATELINE                                                                                                                        \
+	int CLASSNAME::residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,                           \
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const                              \
+	{                                                                                                                                   \
+		return residualBatchImpl<active, active, double>(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);                  \
+	}                                                                                                                                   \
+	                                                                                                                                    \
+	TEMPLATELINE                                                                                                                        \
+	int CLASSNAME::residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,              \
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, active* res) const                              \
+	{                                                                                                                                   \
+		return residualBatchImpl<double, active, active>(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);                  \
+	}                                                                                                                                   \
+	                                                                                                                                    \
+	TEMPLATELINE                                                                                                                        \
+	int CLASSNAME::residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,                           \
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, double* res) const                              \
+	{                                                                                                                                   \
+		return residualBatchImpl<double, double, double>(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);                  \
+	}
+
+/**
+ * @brief Inserts implementations of all residualBatch() method variants which forward to residualBatchImpl() template function
+ * @details See CADET_BINDINGMODEL_RESIDUALBATCH_BOILERPLATE_IMPL_BASE.
+ * 
+ * @param CLASSNAME Name of the IBindingModel implementation
+ * @param TEMPLATENAME Name of the template parameter that handles externally dependent binding models
+ */
+#define CADET_BINDINGMODEL_RESIDUALBATCH_TEMPLATED_BOILERPLATE_IMPL(CLASSNAME,TEMPLATENAME)                        \
+	CADET_BINDINGMODEL_RESIDUALBATCH_BOILERPLATE_IMPL_BASE(CLASSNAME<TEMPLATENAME>, template<typename TEMPLATENAME>)
+
 #endif  // LIBCADET_BINDINGMODELMACROS_HPP_
@@ -15,11 +15,13 @@
 #include "model/ModelUtils.hpp"
 #include "cadet/Exceptions.hpp"
 #include "ParamReaderHelper.hpp"
+#include "AdUtils.hpp"
 
 #include <functional>
 #include <unordered_map>
 #include <string>
 #include <vector>
+#include <algorithm>
 
 namespace cadet
 {
@@ -196,6 +198,18 @@ public:
 	virtual int residual(double t, double z, double r, unsigned int secIdx, double timeFactor,
 		double const* y, double const* yDot, double* res) const;
 
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, double* res) const;
+
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { _p.setExternalFunctions(extFuns, size); }
 	virtual bool dependsOnTime() const CADET_NOEXCEPT { return ParamHandler_t::dependsOnTime(); }
 
@@ -252,6 +266,63 @@ public:
 		}
 	}
 
+	virtual bool hasAnalyticParamDerivatives() const CADET_NOEXCEPT { return true; }
+
+	virtual void addParamDerivatives(double t, double z, double r, unsigned int secIdx, double const* y, unsigned int nDirs, active* res) const
+	{
+		_p.update(t, z, r, secIdx, _nComp, _nBoundStates);
+
+		// Pointer to first component in liquid phase
+		double const* yCp = y - _nComp;
+
+		// Protein equations: k_{d,i} * q_i - k_{a,i} * c_{p,i} * q_{max,i} * (1 - \sum_j q_j / q_{max,j})
+		double qSum = 1.0;
+		unsigned int bndIdx = 0;
+		for (int i = 0; i < _nComp; ++i)
+		{
+			// Skip components without bound states (bound state index bndIdx is not advanced)
+			if (_nBoundStates[i] == 0)
+				continue;
+
+			qSum -= y[bndIdx] / static_cast<double>(_p.qMax[i]);
+
+			// Next bound component
+			++bndIdx;
+		}
+
+		bndIdx = 0;
+		for (int i = 0; i < _nComp; ++i)
+		{
+			// Skip components without bound states (bound state index bndIdx is not advanced)
+			if (_nBoundStates[i] == 0)
+				continue;
+
+			const double ka = static_cast<double>(_p.kA[i]);
+			const double qMax = static_cast<double>(_p.qMax[i]);
+
+			ad::addScaledDerivatives(res[bndIdx], y[bndIdx], _p.kD[i], nDirs);
+			ad::addScaledDerivatives(res[bndIdx], -yCp[i] * qMax * qSum, _p.kA[i], nDirs);
+			ad::addScaledDerivatives(res[bndIdx], -ka * yCp[i] * qSum, _p.qMax[i], nDirs);
+
+			// q_{max,j} also enters through the sum: d(qSum) / d(q_{max,j}) = q_j / q_{max,j}^2
+			unsigned int bndIdx2 = 0;
+			for (int j = 0; j < _nComp; ++j)
+			{
+				// Skip components without bound states (bound state index bndIdx is not advanced)
+				if (_nBoundStates[j] == 0)
+					continue;
+
+				const double qMaxJ = static_cast<double>(_p.qMax[j]);
+				ad::addScaledDerivatives(res[bndIdx], -ka * yCp[i] * qMax * y[bndIdx2] / (qMaxJ * qMaxJ), _p.qMax[j], nDirs);
+
+				++bndIdx2;
+			}
+
+			// Next bound component
+			++bndIdx;
+		}
+	}
+
 protected:
 	ParamHandler_t _p; //!< Handles parameters and their dependence on external functions
 
@@ -321,6 +392,86 @@ protected:
 		return 0;
 	}
 
+	template <typename StateType, typename ResidualType, typename ParamType>
+	int residualBatchImpl(const ParamType& t, double z, double const* r, unsigned int secIdx, const ParamType& timeFactor,
+		unsigned int nShells, unsigned int stride, StateType const* y, double const* yDot, ResidualType* res) const
+	{
+		// Parameters may change from shell to shell if they depend on external functions
+		if (ParamHandler_t::dependsOnTime())
+		{
+			for (unsigned int s = 0; s < nShells; ++s)
+			{
+				const unsigned int offset = s * stride;
+				residualImpl<StateType, StateType, ResidualType, ParamType>(t, z, r[s], secIdx, timeFactor, y + offset, y + offset - _nComp,
+					yDot ? yDot + offset : nullptr, res + offset);
+			}
+			return 0;
+		}
+
+		_p.update(static_cast<double>(t), z, r[0], secIdx, _nComp, _nBoundStates);
+
+		// Pointer to first component in liquid phase of the first shell
+		StateType const* yCp = y - _nComp;
+
+		// Process the shells in chunks in order to keep the sums 1 - \sum_j q_j / q_{max,j} on the stack.
+		// Inside a chunk, loop over components first and over shells second such that the inner loops have no branches.
+		const unsigned int chunkSize = 16;
+		ResidualType qSum[chunkSize];
+		for (unsigned int start = 0; start < nShells; start += chunkSize)
+		{
+			const unsigned int n = std::min(chunkSize, nShells - start);
+			const unsigned int base = start * stride;
+
+			for (unsigned int s = 0; s < n; ++s)
+				qSum[s] = 1.0;
+
+			unsigned int bndIdx = 0;
+			for (int i = 0; i < _nComp; ++i)
+			{
+				// Skip components without bound states (bound state index bndIdx is not advanced)
+				if (_nBoundStates[i] == 0)
+					continue;
+
+				const ParamType qMax = static_cast<ParamType>(_p.qMax[i]);
+				for (unsigned int s = 0; s < n; ++s)
+					qSum[s] -= y[base + s * stride + bndIdx] / qMax;
+
+				// Next bound component
+				++bndIdx;
+			}
+
+			bndIdx = 0;
+			for (int i = 0; i < _nComp; ++i)
+			{
+				// Skip components without bound states (bound state index bndIdx is not advanced)
+				if (_nBoundStates[i] == 0)
+					continue;
+
+				const ParamType kA = static_cast<ParamType>(_p.kA[i]);
+				const ParamType kD = static_cast<ParamType>(_p.kD[i]);
+				const ParamType qMax = static_cast<ParamType>(_p.qMax[i]);
+
+				for (unsigned int s = 0; s < n; ++s)
+				{
+					const unsigned int offset = base + s * stride;
+					res[offset + bndIdx] = kD * y[offset + bndIdx] - kA * yCp[offset + i] * qMax * qSum[s];
+				}
+
+				// Add time derivative if necessary
+				if (_kineticBinding && yDot)
+				{
+					for (unsigned int s = 0; s < n; ++s)
+						res[base + s * stride + bndIdx] += timeFactor * yDot[base + s * stride + bndIdx];
+				}
+
+				// Next bound component
+				++bndIdx;
+			}
+		}
+
+		return 0;
+	}
+
 	template <typename RowIterator>
 	void jacobianImpl(double t, double z, double r, unsigned int secIdx, double const* y, double const* yCp, RowIterator jac) const
 	{
@@ -382,6 +533,7 @@ protected:
 };
 
 CADET_PUREBINDINGMODELBASE_TEMPLATED_BOILERPLATE_IMPL(LangmuirBindingBase, ParamHandler_t)
+CADET_BINDINGMODEL_RESIDUALBATCH_TEMPLATED_BOILERPLATE_IMPL(LangmuirBindingBase, ParamHandler_t)
 
 typedef LangmuirBindingBase<LangmuirParamHandler> LangmuirBinding;
 typedef LangmuirBindingBase<ExtLangmuirParamHandler> ExternalLangmuirBinding;
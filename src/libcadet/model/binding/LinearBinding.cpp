@@ -47,6 +47,7 @@
 #include "model/ModelUtils.hpp"
 #include "cadet/Exceptions.hpp"
 #include "ParamReaderHelper.hpp"
+#include "AdUtils.hpp"
 
 #include <vector>
 #include <unordered_map>
@@ -363,6 +364,33 @@ public:
 		return residualImpl<double, double, double>(t, z, r, secIdx, timeFactor, y, yDot, res);
 	}
 
+	// The residualBatch() implementations are usually hidden behind
+	// CADET_BINDINGMODEL_RESIDUALBATCH_TEMPLATED_BOILERPLATE_IMPL(LinearBinding,ParamHandler_t)
+
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const
+	{
+		return residualBatchImpl<active, active, active>(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);
+	}
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const
+	{
+		return residualBatchImpl<active, active, double>(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);
+	}
+
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, active* res) const
+	{
+		return residualBatchImpl<double, active, active>(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);
+	}
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, double* res) const
+	{
+		return residualBatchImpl<double, double, double>(t, z, r, secIdx, timeFactor, nShells, stride, y, yDot, res);
+	}
+
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { _p.setExternalFunctions(extFuns, size); }
 
 	virtual void analyticJacobian(double t, double z, double r, unsigned int secIdx, double const* y, linalg::BandMatrix::RowIterator jac) const
@@ -432,6 +460,31 @@ public:
 	virtual bool hasAlgebraicEquations() const CADET_NOEXCEPT { return !_kineticBinding; }
 	virtual bool dependsOnTime() const CADET_NOEXCEPT { return ParamHandler_t::dependsOnTime(); }
 
+	virtual bool hasAnalyticParamDerivatives() const CADET_NOEXCEPT { return true; }
+
+	virtual void addParamDerivatives(double t, double z, double r, unsigned int secIdx, double const* y, unsigned int nDirs, active* res) const
+	{
+		_p.update(t, z, r, secIdx, _nComp, _nBoundStates);
+
+		// Pointer to first component in liquid phase
+		double const* yCp = y - _nComp;
+
+		// Residual is linear in the parameters: -k_a * c_{p,i} + k_d * q_i
+		unsigned int bndIdx = 0;
+		for (int i = 0; i < _nComp; ++i)
+		{
+			// Skip components without bound states (bound state index bndIdx is not advanced)
+			if (_nBoundStates[i] == 0)
+				continue;
+
+			ad::addScaledDerivatives(res[bndIdx], -yCp[i], _p.kA[i], nDirs);
+			ad::addScaledDerivatives(res[bndIdx], y[bndIdx], _p.kD[i], nDirs);
+
+			// Next bound component
+			++bndIdx;
+		}
+	}
+
 protected:
 	int _nComp; //!< Number of components
 	unsigned int const* _nBoundStates; //!< Array with number of bound states for each component
@@ -475,6 +528,54 @@ protected:
 		return 0;
 	}
 
+	template <typename StateType, typename ResidualType, typename ParamType>
+	int residualBatchImpl(const ParamType& t, double z, double const* r, unsigned int secIdx, const ParamType& timeFactor,
+		unsigned int nShells, unsigned int stride, StateType const* y, double const* yDot, ResidualType* res) const
+	{
+		// Parameters may change from shell to shell if they depend on external functions
+		if (ParamHandler_t::dependsOnTime())
+		{
+			for (unsigned int s = 0; s < nShells; ++s)
+				residualImpl<StateType, ResidualType, ParamType>(t, z, r[s], secIdx, timeFactor, y + s * stride, yDot ? yDot + s * stride : nullptr, res + s * stride);
+			return 0;
+		}
+
+		_p.update(static_cast<double>(t), z, r[0], secIdx, _nComp, _nBoundStates);
+
+		// Pointer to first component in liquid phase of the first shell
+		StateType const* yCp = y - _nComp;
+
+		// Loop over components first and over shells second such that the inner loop has no branches
+		unsigned int bndIdx = 0;
+		for (int i = 0; i < _nComp; ++i)
+		{
+			// Skip components without bound states (bound state index bndIdx is not advanced)
+			if (_nBoundStates[i] == 0)
+				continue;
+
+			const ParamType kA = static_cast<ParamType>(_p.kA[i]);
+			const ParamType kD = static_cast<ParamType>(_p.kD[i]);
+
+			for (unsigned int s = 0; s < nShells; ++s)
+			{
+				const unsigned int offset = s * stride;
+				res[offset + bndIdx] = -(kA * yCp[offset + i] - kD * y[offset + bndIdx]);
+			}
+
+			// Add time derivative if necessary
+			if (_kineticBinding && yDot)
+			{
+				for (unsigned int s = 0; s < nShells; ++s)
+					res[s * stride + bndIdx] += timeFactor * yDot[s * stride + bndIdx];
+			}
+
+			// Next bound component
+			++bndIdx;
+		}
+
+		return 0;
+	}
+
 	template <typename RowIterator>
 	void jacobianImpl(double t, double z, double r, unsigned int secIdx, double const* y, RowIterator jac) const
 	{
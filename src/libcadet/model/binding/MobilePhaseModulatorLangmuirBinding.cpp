@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <string>
 #include <vector>
+#include <algorithm>
 
 namespace cadet
 {
@@ -194,6 +195,18 @@ public:
 	virtual int residual(double t, double z, double r, unsigned int secIdx, double timeFactor,
 		double const* y, double const* yDot, double* res) const;
 
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, double* res) const;
+
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { _p.setExternalFunctions(extFuns, size); }
 
 	virtual bool hasSalt() const CADET_NOEXCEPT { return true; }
@@ -288,6 +301,107 @@ protected:
 		return 0;
 	}
 
+	template <typename StateType, typename ResidualType, typename ParamType>
+	int residualBatchImpl(const ParamType& t, double z, double const* r, unsigned int secIdx, const ParamType& timeFactor,
+		unsigned int nShells, unsigned int stride, StateType const* y, double const* yDot, ResidualType* res) const
+	{
+		// Parameters may change from shell to shell if they depend on external functions
+		if (ParamHandler_t::dependsOnTime())
+		{
+			for (unsigned int s = 0; s < nShells; ++s)
+			{
+				const unsigned int offset = s * stride;
+				residualImpl<StateType, StateType, ResidualType, ParamType>(t, z, r[s], secIdx, timeFactor, y + offset, y + offset - _nComp,
+					yDot ? yDot + offset : nullptr, res + offset);
+			}
+			return 0;
+		}
+
+		_p.update(static_cast<double>(t), z, r[0], secIdx, _nComp, _nBoundStates);
+
+		// Pointer to first component in liquid phase of the first shell
+		StateType const* yCp = y - _nComp;
+		const unsigned int saltOffset = (_nBoundStates[0] == 1) ? 1 : 0;
+
+		// Process the shells in chunks in order to keep the sums 1 - \sum_j q_j / q_{max,j} on the stack.
+		// Inside a chunk, loop over components first and over shells second such that the inner loops have no branches.
+		const unsigned int chunkSize = 16;
+		ResidualType qSum[chunkSize];
+		for (unsigned int start = 0; start < nShells; start += chunkSize)
+		{
+			const unsigned int n = std::min(chunkSize, nShells - start);
+			const unsigned int base = start * stride;
+
+			for (unsigned int s = 0; s < n; ++s)
+				qSum[s] = 1.0;
+
+			unsigned int bndIdx = saltOffset;
+			for (int i = 1; i < _nComp; ++i)
+			{
+				// Skip components without bound states (bound state index bndIdx is not advanced)
+				if (_nBoundStates[i] == 0)
+					continue;
+
+				const ParamType qMax = static_cast<ParamType>(_p.qMax[i]);
+				for (unsigned int s = 0; s < n; ++s)
+					qSum[s] -= y[base + s * stride + bndIdx] / qMax;
+
+				// Next bound component
+				++bndIdx;
+			}
+
+			// Handle salt equation
+			if (saltOffset == 1)
+			{
+				for (unsigned int s = 0; s < n; ++s)
+				{
+					const unsigned int offset = base + s * stride;
+					if (_kineticBinding)
+						res[offset] = y[offset];
+					else
+						res[offset] = 0.0;
+
+					// Add time derivative if necessary
+					if (_kineticBinding && yDot)
+						res[offset] += timeFactor * yDot[offset];
+				}
+			}
+
+			// Handle protein equations
+			bndIdx = saltOffset;
+			for (int i = 1; i < _nComp; ++i)
+			{
+				// Skip components without bound states (bound state index bndIdx is not advanced)
+				if (_nBoundStates[i] == 0)
+					continue;
+
+				const ParamType kA = static_cast<ParamType>(_p.kA[i]);
+				const ParamType kD = static_cast<ParamType>(_p.kD[i]);
+				const ParamType qMax = static_cast<ParamType>(_p.qMax[i]);
+				const ParamType beta = static_cast<ParamType>(_p.beta[i]);
+				const ParamType gamma = static_cast<ParamType>(_p.gamma[i]);
+
+				for (unsigned int s = 0; s < n; ++s)
+				{
+					const unsigned int offset = base + s * stride;
+					res[offset + bndIdx] = kD * pow(yCp[offset], beta) * y[offset + bndIdx] - kA * exp(yCp[offset] * gamma) * yCp[offset + i] * qMax * qSum[s];
+				}
+
+				// Add time derivative if necessary
+				if (_kineticBinding && yDot)
+				{
+					for (unsigned int s = 0; s < n; ++s)
+						res[base + s * stride + bndIdx] += timeFactor * yDot[base + s * stride + bndIdx];
+				}
+
+				// Next bound component
+				++bndIdx;
+			}
+		}
+
+		return 0;
+	}
+
 	template <typename RowIterator>
 	void jacobianImpl(double t, double z, double r, unsigned int secIdx, double const* y, double const* yCp, RowIterator jac) const
 	{
@@ -372,6 +486,7 @@ protected:
 };
 
 CADET_PUREBINDINGMODELBASE_TEMPLATED_BOILERPLATE_IMPL(MobilePhaseModulatorLangmuirBindingBase, ParamHandler_t)
+CADET_BINDINGMODEL_RESIDUALBATCH_TEMPLATED_BOILERPLATE_IMPL(MobilePhaseModulatorLangmuirBindingBase, ParamHandler_t)
 
 typedef MobilePhaseModulatorLangmuirBindingBase<MPMLangmuirParamHandler> MobilePhaseModulatorLangmuirBinding;
 typedef MobilePhaseModulatorLangmuirBindingBase<ExtMPMLangmuirParamHandler> ExternalMobilePhaseModulatorLangmuirBinding;
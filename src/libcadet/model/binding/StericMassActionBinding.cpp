@@ -23,6 +23,7 @@
 #include <unordered_map>
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #include "AdUtils.hpp"
 #include "linalg/Norms.hpp"
@@ -321,6 +322,18 @@ public:
 	virtual int residual(double t, double z, double r, unsigned int secIdx, double timeFactor, 
 		double const* y, double const* yDot, double* res) const;
 
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		unsigned int nShells, unsigned int stride, active const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(const active& t, double z, double const* r, unsigned int secIdx, const active& timeFactor,
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, active* res) const;
+
+	virtual int residualBatch(double t, double z, double const* r, unsigned int secIdx, double timeFactor,
+		unsigned int nShells, unsigned int stride, double const* y, double const* yDot, double* res) const;
+
 	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { _p.setExternalFunctions(extFuns, size); }
 
 	virtual void analyticJacobian(double t, double z, double r, unsigned int secIdx, double const* y, linalg::BandMatrix::RowIterator jac) const
@@ -363,6 +376,85 @@ public:
 	virtual bool hasAlgebraicEquations() const CADET_NOEXCEPT { return true; }
 	virtual bool dependsOnTime() const CADET_NOEXCEPT { return ParamHandler_t::dependsOnTime(); }
 
+	virtual bool hasAnalyticParamDerivatives() const CADET_NOEXCEPT { return true; }
+
+	virtual void addParamDerivatives(double t, double z, double r, unsigned int secIdx, double const* y, unsigned int nDirs, active* res) const
+	{
+		_p.update(t, z, r, secIdx, _nComp, _nBoundStates);
+
+		// Pointer to first component in liquid phase
+		double const* yCp = y - _nComp;
+
+		// Salt equation: q_0 - Lambda + Sum[nu_j * q_j, j]
+		ad::addScaledDerivatives(res[0], -1.0, _p.lambda, nDirs);
+
+		double q0_bar = y[0];
+		unsigned int bndIdx = 1;
+		for (int j = 1; j < _nComp; ++j)
+		{
+			// Skip components without bound states (bound state index bndIdx is not advanced)
+			if (_nBoundStates[j] == 0)
+				continue;
+
+			ad::addScaledDerivatives(res[0], y[bndIdx], _p.nu[j], nDirs);
+			q0_bar -= static_cast<double>(_p.sigma[j]) * y[bndIdx];
+
+			// Next bound component
+			++bndIdx;
+		}
+
+		const double refC0 = static_cast<double>(_p.refC0);
+		const double refQ = static_cast<double>(_p.refQ);
+		const double yCp0_divRef = yCp[0] / refC0;
+		const double q0_bar_divRef = q0_bar / refQ;
+
+		// Protein equations: k_{d,i} * q_i * (c_{p,0} / c_{ref})^{nu_i} - k_{a,i} * c_{p,i} * (\bar{q}_0 / q_{ref})^{nu_i}
+		bndIdx = 1;
+		for (int i = 1; i < _nComp; ++i)
+		{
+			// Skip components without bound states (bound state index bndIdx is not advanced)
+			if (_nBoundStates[i] == 0)
+				continue;
+
+			const double ka = static_cast<double>(_p.kA[i]);
+			const double kd = static_cast<double>(_p.kD[i]);
+			const double nu = static_cast<double>(_p.nu[i]);
+
+			const double c0_pow_nu = pow(yCp0_divRef, nu);
+			const double q0_bar_pow_nu = pow(q0_bar_divRef, nu);
+			const double desorption = kd * y[bndIdx] * c0_pow_nu;
+			const double adsorption = ka * yCp[i] * q0_bar_pow_nu;
+
+			ad::addScaledDerivatives(res[bndIdx], y[bndIdx] * c0_pow_nu, _p.kD[i], nDirs);
+			ad::addScaledDerivatives(res[bndIdx], -yCp[i] * q0_bar_pow_nu, _p.kA[i], nDirs);
+
+			// Reference concentrations scale the powers
+			ad::addScaledDerivatives(res[bndIdx], -nu * desorption / refC0, _p.refC0, nDirs);
+			ad::addScaledDerivatives(res[bndIdx], nu * adsorption / refQ, _p.refQ, nDirs);
+
+			// Characteristic charge appears in the exponents, the logarithm is only evaluated if it is required
+			if (ad::usedDirections(_p.nu[i], nDirs) > 0)
+				ad::addScaledDerivatives(res[bndIdx], desorption * std::log(yCp0_divRef) - adsorption * std::log(q0_bar_divRef), _p.nu[i], nDirs);
+
+			// Steric factors enter through \bar{q}_0 = q_0 - Sum[sigma_j * q_j, j]
+			const double dResDq0bar = -ka * yCp[i] * nu * pow(q0_bar_divRef, nu - 1.0) / refQ;
+			unsigned int bndIdx2 = 1;
+			for (int j = 1; j < _nComp; ++j)
+			{
+				// Skip components without bound states (bound state index bndIdx is not advanced)
+				if (_nBoundStates[j] == 0)
+					continue;
+
+				ad::addScaledDerivatives(res[bndIdx], -dResDq0bar * y[bndIdx2], _p.sigma[j], nDirs);
+
+				++bndIdx2;
+			}
+
+			// Next bound component
+			++bndIdx;
+		}
+	}
+
 protected:
 	ParamHandler_t _p; //!< Handles parameters and their dependence on external functions
 
@@ -436,6 +528,109 @@ protected:
 		return 0;
 	}
 
+	template <typename StateType, typename ResidualType, typename ParamType>
+	int residualBatchImpl(const ParamType& t, double z, double const* r, unsigned int secIdx, const ParamType& timeFactor,
+		unsigned int nShells, unsigned int stride, StateType const* y, double const* yDot, ResidualType* res) const
+	{
+		// Parameters may change from shell to shell if they depend on external functions
+		if (ParamHandler_t::dependsOnTime())
+		{
+			for (unsigned int s = 0; s < nShells; ++s)
+			{
+				const unsigned int offset = s * stride;
+				residualImpl<StateType, StateType, ResidualType, ParamType>(t, z, r[s], secIdx, timeFactor, y + offset, y + offset - _nComp,
+					yDot ? yDot + offset : nullptr, res + offset);
+			}
+			return 0;
+		}
+
+		_p.update(static_cast<double>(t), z, r[0], secIdx, _nComp, _nBoundStates);
+
+		// Pointer to first component in liquid phase of the first shell
+		StateType const* yCp = y - _nComp;
+
+		const ParamType lambda = static_cast<ParamType>(_p.lambda);
+		const ParamType refC0 = static_cast<ParamType>(_p.refC0);
+		const ParamType refQ = static_cast<ParamType>(_p.refQ);
+
+		// Process the shells in chunks in order to keep the shielded salt concentrations \bar{q}_0 on the stack.
+		// Inside a chunk, loop over components first and over shells second such that the inner loops have no branches.
+		const unsigned int chunkSize = 16;
+		ResidualType q0_bar[chunkSize];
+		ResidualType yCp0_divRef[chunkSize];
+		for (unsigned int start = 0; start < nShells; start += chunkSize)
+		{
+			const unsigned int n = std::min(chunkSize, nShells - start);
+			const unsigned int base = start * stride;
+
+			// Salt equation: q_0 - Lambda + Sum[nu_j * q_j, j] == 0 
+			// Also compute \bar{q}_0 = q_0 - Sum[sigma_j * q_j, j]
+			for (unsigned int s = 0; s < n; ++s)
+			{
+				const unsigned int offset = base + s * stride;
+				res[offset] = y[offset] - lambda;
+				q0_bar[s] = y[offset];
+			}
+
+			unsigned int bndIdx = 1;
+			for (int j = 1; j < _nComp; ++j)
+			{
+				// Skip components without bound states (bound state index bndIdx is not advanced)
+				if (_nBoundStates[j] == 0)
+					continue;
+
+				const ParamType nu = static_cast<ParamType>(_p.nu[j]);
+				const ParamType sigma = static_cast<ParamType>(_p.sigma[j]);
+				for (unsigned int s = 0; s < n; ++s)
+				{
+					const unsigned int offset = base + s * stride;
+					res[offset] += nu * y[offset + bndIdx];
+					q0_bar[s] -= sigma * y[offset + bndIdx];
+				}
+
+				// Next bound component
+				++bndIdx;
+			}
+
+			for (unsigned int s = 0; s < n; ++s)
+			{
+				yCp0_divRef[s] = yCp[base + s * stride] / refC0;
+				q0_bar[s] = q0_bar[s] / refQ;
+			}
+
+			// Protein equations: dq_i / dt - ( k_{a,i} * c_{p,i} * \bar{q}_0^{nu_i} - k_{d,i} * q_i * c_{p,0}^{nu_i} ) == 0
+			bndIdx = 1;
+			for (int i = 1; i < _nComp; ++i)
+			{
+				// Skip components without bound states (bound state index bndIdx is not advanced)
+				if (_nBoundStates[i] == 0)
+					continue;
+
+				const ParamType nu = static_cast<ParamType>(_p.nu[i]);
+				const ParamType kA = static_cast<ParamType>(_p.kA[i]);
+				const ParamType kD = static_cast<ParamType>(_p.kD[i]);
+
+				for (unsigned int s = 0; s < n; ++s)
+				{
+					const unsigned int offset = base + s * stride;
+					res[offset + bndIdx] = kD * y[offset + bndIdx] * pow(yCp0_divRef[s], nu) - kA * yCp[offset + i] * pow(q0_bar[s], nu);
+				}
+
+				// Add time derivative if necessary
+				if (_kineticBinding && yDot)
+				{
+					for (unsigned int s = 0; s < n; ++s)
+						res[base + s * stride + bndIdx] += timeFactor * yDot[base + s * stride + bndIdx];
+				}
+
+				// Next bound component
+				++bndIdx;
+			}
+		}
+
+		return 0;
+	}
+
 	template <typename RowIterator>
 	void jacobianImpl(double t, double z, double r, unsigned int secIdx, double const* y, double const* yCp, RowIterator jac) const
 	{
@@ -524,6 +719,7 @@ protected:
 };
 
 CADET_BINDINGMODEL_RESIDUAL_TEMPLATED_BOILERPLATE_IMPL(StericMassActionBindingBase, ParamHandler_t)
+CADET_BINDINGMODEL_RESIDUALBATCH_TEMPLATED_BOILERPLATE_IMPL(StericMassActionBindingBase, ParamHandler_t)
 
 
 typedef StericMassActionBindingBase<SMAParamHandler> StericMassActionBinding;
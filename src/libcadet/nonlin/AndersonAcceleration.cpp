@@ -0,0 +1,154 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "nonlin/AndersonAcceleration.hpp"
+
+#include <algorithm>
+
+namespace cadet
+{
+
+namespace nonlin
+{
+
+AndersonAcceleration::AndersonAcceleration() : _size(0), _depth(0), _numStored(0), _nextSlot(0), _hasLast(false) { }
+
+void AndersonAcceleration::resize(unsigned int size, unsigned int depth)
+{
+	_size = size;
+	_depth = depth;
+
+	_diffRes.resize(size * depth);
+	_diffImage.resize(size * depth);
+	_lastRes.resize(size);
+	_lastImage.resize(size);
+	_coeffs.resize(depth);
+
+	reset();
+}
+
+void AndersonAcceleration::reset() CADET_NOEXCEPT
+{
+	_numStored = 0;
+	_nextSlot = 0;
+	_hasLast = false;
+}
+
+void AndersonAcceleration::update(double* const x, double const* const gx, double const* const weight)
+{
+	if (_depth == 0)
+	{
+		std::copy(gx, gx + _size, x);
+		return;
+	}
+
+	// Update history with the residual f_k = G(x_k) - x_k and the image G(x_k)
+	if (_hasLast)
+	{
+		double* const dRes = _diffRes.data() + _nextSlot * _size;
+		double* const dImage = _diffImage.data() + _nextSlot * _size;
+		for (unsigned int i = 0; i < _size; ++i)
+		{
+			const double res = gx[i] - x[i];
+			dRes[i] = res - _lastRes[i];
+			dImage[i] = gx[i] - _lastImage[i];
+			_lastRes[i] = res;
+			_lastImage[i] = gx[i];
+		}
+
+		_nextSlot = (_nextSlot + 1) % _depth;
+		_numStored = std::min(_numStored + 1, _depth);
+	}
+	else
+	{
+		for (unsigned int i = 0; i < _size; ++i)
+		{
+			_lastRes[i] = gx[i] - x[i];
+			_lastImage[i] = gx[i];
+		}
+		_hasLast = true;
+	}
+
+	if (_numStored == 0)
+	{
+		std::copy(gx, gx + _size, x);
+		return;
+	}
+
+	// Assemble normal equations of min_c || W (f_k - dRes * c) ||
+	const unsigned int m = _numStored;
+	_normalMat.resize(m, m);
+	double maxDiag = 0.0;
+	for (unsigned int a = 0; a < m; ++a)
+	{
+		double const* const dResA = _diffRes.data() + a * _size;
+		for (unsigned int b = 0; b <= a; ++b)
+		{
+			double const* const dResB = _diffRes.data() + b * _size;
+			double val = 0.0;
+			if (weight)
+			{
+				for (unsigned int i = 0; i < _size; ++i)
+					val += weight[i] * weight[i] * dResA[i] * dResB[i];
+			}
+			else
+			{
+				for (unsigned int i = 0; i < _size; ++i)
+					val += dResA[i] * dResB[i];
+			}
+
+			_normalMat.native(a, b) = val;
+			_normalMat.native(b, a) = val;
+		}
+		maxDiag = std::max(maxDiag, _normalMat.native(a, a));
+
+		double rhs = 0.0;
+		if (weight)
+		{
+			for (unsigned int i = 0; i < _size; ++i)
+				rhs += weight[i] * weight[i] * dResA[i] * _lastRes[i];
+		}
+		else
+		{
+			for (unsigned int i = 0; i < _size; ++i)
+				rhs += dResA[i] * _lastRes[i];
+		}
+		_coeffs[a] = rhs;
+	}
+
+	// Regularize nearly linearly dependent differences
+	for (unsigned int a = 0; a < m; ++a)
+		_normalMat.native(a, a) += 1e-12 * maxDiag;
+
+	if ((maxDiag <= 0.0) || !_normalMat.factorize() || !_normalMat.solve(_coeffs.data()))
+	{
+		// Restart with a plain fixed point step, the current residual and image are kept
+		_numStored = 0;
+		_nextSlot = 0;
+		std::copy(gx, gx + _size, x);
+		return;
+	}
+
+	// x_{k+1} = G(x_k) - dImage * c
+	std::copy(gx, gx + _size, x);
+	for (unsigned int a = 0; a < m; ++a)
+	{
+		double const* const dImage = _diffImage.data() + a * _size;
+		const double c = _coeffs[a];
+		for (unsigned int i = 0; i < _size; ++i)
+			x[i] -= c * dImage[i];
+	}
+}
+
+} // namespace nonlin
+
+} // namespace cadet
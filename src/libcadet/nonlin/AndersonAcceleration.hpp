@@ -0,0 +1,105 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides Anderson acceleration of fixed point iterations
+ */
+
+#ifndef LIBCADET_ANDERSONACCELERATION_HPP_
+#define LIBCADET_ANDERSONACCELERATION_HPP_
+
+#include "common/CompilerSpecific.hpp"
+#include "linalg/DenseMatrix.hpp"
+
+#include <vector>
+
+namespace cadet
+{
+
+namespace nonlin
+{
+
+	/**
+	 * @brief Accelerates the fixed point iteration @f$ x_{k+1} = G(x_k) @f$ by Anderson mixing
+	 * @details The next iterate is a combination of the last @f$ m @f$ function values @f$ G(x_i) @f$
+	 *          whose coefficients minimize the (weighted) linearized fixed point residual
+	 *          @f$ f_i = G(x_i) - x_i @f$ in a least squares sense. The small least squares
+	 *          problem is solved via its normal equations.
+	 *
+	 *          If no history is available (first iteration, depth @f$ m = 0 @f$, or singular
+	 *          least squares problem), the plain fixed point iteration is performed.
+	 */
+	class AndersonAcceleration
+	{
+	public:
+		AndersonAcceleration();
+
+		/**
+		 * @brief Allocates memory for the given problem size and history depth
+		 * @details The history is cleared.
+		 * @param [in] size Number of unknowns
+		 * @param [in] depth Maximum number of previous iterates used for extrapolation (@c 0 disables acceleration)
+		 */
+		void resize(unsigned int size, unsigned int depth);
+
+		/**
+		 * @brief Clears the history of previous iterates
+		 */
+		void reset() CADET_NOEXCEPT;
+
+		/**
+		 * @brief Computes the next iterate from the current one and its image under the fixed point map
+		 * @param [in,out] x On entry current iterate @f$ x_k @f$, on exit next iterate @f$ x_{k+1} @f$
+		 * @param [in] gx Image @f$ G(x_k) @f$ of the current iterate
+		 * @param [in] weight Weights of the unknowns in the least squares problem, may be @c nullptr for unit weights
+		 */
+		void update(double* const x, double const* const gx, double const* const weight);
+
+		/**
+		 * @brief Returns the number of unknowns
+		 * @return Number of unknowns
+		 */
+		inline unsigned int size() const CADET_NOEXCEPT { return _size; }
+
+		/**
+		 * @brief Returns the maximum number of previous iterates used for extrapolation
+		 * @return History depth
+		 */
+		inline unsigned int depth() const CADET_NOEXCEPT { return _depth; }
+
+		/**
+		 * @brief Returns the number of previous iterates used in the last update
+		 * @return Number of stored differences of previous iterates
+		 */
+		inline unsigned int numStored() const CADET_NOEXCEPT { return _numStored; }
+
+	private:
+		unsigned int _size; //!< Number of unknowns
+		unsigned int _depth; //!< Maximum number of stored differences
+		unsigned int _numStored; //!< Number of currently stored differences
+		unsigned int _nextSlot; //!< Slot in the ring buffer that is overwritten next
+		bool _hasLast; //!< Determines whether the residual and image of the last iterate are available
+
+		std::vector<double> _diffRes; //!< Ring buffer with differences of consecutive residuals @f$ f_{i+1} - f_i @f$ (@c _depth rows of length @c _size)
+		std::vector<double> _diffImage; //!< Ring buffer with differences of consecutive images @f$ G(x_{i+1}) - G(x_i) @f$ (@c _depth rows of length @c _size)
+		std::vector<double> _lastRes; //!< Residual @f$ f_{k-1} @f$ of the last iterate
+		std::vector<double> _lastImage; //!< Image @f$ G(x_{k-1}) @f$ of the last iterate
+		std::vector<double> _coeffs; //!< Coefficients of the stored differences
+		linalg::DenseMatrix _normalMat; //!< Matrix of the normal equations of the least squares problem
+	};
+
+} // namespace nonlin
+
+} // namespace cadet
+
+#endif  // LIBCADET_ANDERSONACCELERATION_HPP_
@@ -16,9 +16,12 @@
 #include <limits>
 #include <random>
 #include <chrono>
+#include <iostream>
+#include <cmath>
 
 #include "linalg/DenseMatrix.hpp"
 #include "linalg/BandMatrix.hpp"
+#include "linalg/SparseMatrix.hpp"
 #include "AdUtils.hpp"
 #include "AutoDiff.hpp"
 
@@ -169,3 +172,272 @@ TEST_CASE("Extract dense submatrix from banded Jacobian via AD", "[AD],[DenseMat
 	delete[] x;
 	delete[] res;
 }
+
+TEST_CASE("Extract sparse banded Jacobian via colored AD", "[AD],[BandMatrix]")
+{
+	// Matrix size
+	const unsigned int matSize = 40;
+	const unsigned int lowerBand = 6;
+	const unsigned int upperBand = 7;
+
+	// Create random pattern inside the band (always including the main diagonal)
+	std::default_random_engine generator(42);
+	std::uniform_int_distribution<int> diagDist(-static_cast<int>(lowerBand), static_cast<int>(upperBand));
+
+	cadet::linalg::DoubleSparseMatrix coo(matSize * 4);
+	for (unsigned int r = 0; r < matSize; ++r)
+	{
+		coo.addElement(r, r, 0.0);
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			const int c = static_cast<int>(r) + diagDist(generator);
+			if ((c >= 0) && (c < static_cast<int>(matSize)))
+				coo.addElement(r, c, 0.0);
+		}
+	}
+
+	cadet::linalg::CompressedSparseMatrix pattern;
+	pattern.assignPattern(matSize, coo);
+
+	std::vector<unsigned int> colors;
+	const unsigned int numColors = cadet::ad::computeColumnColoring(pattern, colors);
+	CHECK(numColors <= lowerBand + 1 + upperBand);
+
+	// Columns of the same color must not share a row
+	for (unsigned int r = 0; r < matSize; ++r)
+	{
+		for (unsigned int i = pattern.rowStart()[r]; i < pattern.rowStart()[r + 1]; ++i)
+		{
+			for (unsigned int j = i + 1; j < pattern.rowStart()[r + 1]; ++j)
+				CHECK(colors[pattern.columns()[i]] != colors[pattern.columns()[j]]);
+		}
+	}
+
+	// Initialize AD and allocate AD vectors
+	cadet::ad::setDirections(numColors);
+
+	cadet::active* res = new cadet::active[matSize];
+	cadet::active* x = new cadet::active[matSize];
+
+	cadet::ad::prepareAdVectorSeedsForColoring(x, 0, colors);
+
+	// Compute residual whose Jacobian has the given pattern and contains the linear index of the element (1-based)
+	for (unsigned int r = 0; r < matSize; ++r)
+	{
+		res[r] = 0.0;
+		for (unsigned int i = pattern.rowStart()[r]; i < pattern.rowStart()[r + 1]; ++i)
+			res[r] += static_cast<double>(i + 1) * x[pattern.columns()[i]];
+	}
+
+	cadet::linalg::BandMatrix bm;
+	bm.resize(matSize, lowerBand, upperBand);
+	cadet::ad::extractBandedJacobianFromColoredAd(res, 0, pattern, colors, bm);
+
+	cadet::linalg::BandMatrix ref;
+	ref.resize(matSize, lowerBand, upperBand);
+	ref.setAll(0.0);
+	for (unsigned int r = 0; r < matSize; ++r)
+	{
+		for (unsigned int i = pattern.rowStart()[r]; i < pattern.rowStart()[r + 1]; ++i)
+			ref.centered(r, static_cast<int>(pattern.columns()[i]) - static_cast<int>(r)) = static_cast<double>(i + 1);
+	}
+
+	// Compare matrices
+	const unsigned int n = ref.rows() * ref.stride();
+	double const* const adMat = bm.data();
+	double const* const refMat = ref.data();
+	for (unsigned int i = 0; i < n; ++i)
+		CHECK(refMat[i] == adMat[i]);
+
+	CHECK(cadet::ad::compareBandedJacobianWithColoredAd(res, 0, pattern, colors, ref) == 0.0);
+
+	delete[] x;
+	delete[] res;
+}
+
+TEST_CASE("Vectorized AD gradient kernels match scalar kernels", "[AD]")
+{
+	namespace scalar = sfad::detail::scalar;
+	namespace vectorized = sfad::detail::vectorized;
+
+	std::default_random_engine generator(42);
+	std::uniform_real_distribution<double> dist(-2.0, 2.0);
+
+	// Cover full vector registers as well as remainders
+	for (std::size_t n : {1u, 3u, 4u, 7u, 8u, 13u, 17u, 80u})
+	{
+		std::vector<double> a(n);
+		std::vector<double> b(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			a[i] = dist(generator);
+			b[i] = dist(generator);
+		}
+		const double alpha = dist(generator);
+		const double beta = dist(generator);
+		const double d = dist(generator) + 3.0;
+
+		std::vector<double> ref(n);
+		std::vector<double> res(n);
+		const auto compare = [&]()
+		{
+			for (std::size_t i = 0; i < n; ++i)
+				CHECK(res[i] == Approx(ref[i]).epsilon(4.0 * std::numeric_limits<double>::epsilon()).margin(0.0));
+		};
+
+		scalar::add(ref.data(), a.data(), b.data(), n);
+		vectorized::add(res.data(), a.data(), b.data(), n);
+		compare();
+
+		scalar::sub(ref.data(), a.data(), b.data(), n);
+		vectorized::sub(res.data(), a.data(), b.data(), n);
+		compare();
+
+		scalar::neg(ref.data(), a.data(), n);
+		vectorized::neg(res.data(), a.data(), n);
+		compare();
+
+		scalar::scale(ref.data(), alpha, a.data(), n);
+		vectorized::scale(res.data(), alpha, a.data(), n);
+		compare();
+
+		scalar::div(ref.data(), a.data(), d, n);
+		vectorized::div(res.data(), a.data(), d, n);
+		compare();
+
+		scalar::scaleDiv(ref.data(), alpha, a.data(), d, n);
+		vectorized::scaleDiv(res.data(), alpha, a.data(), d, n);
+		compare();
+
+		scalar::linComb(ref.data(), alpha, a.data(), beta, b.data(), n);
+		vectorized::linComb(res.data(), alpha, a.data(), beta, b.data(), n);
+		compare();
+
+		scalar::linCombDiv(ref.data(), alpha, a.data(), beta, b.data(), d, n);
+		vectorized::linCombDiv(res.data(), alpha, a.data(), beta, b.data(), d, n);
+		compare();
+
+		// In-place operation
+		ref = a;
+		scalar::linComb(ref.data(), alpha, ref.data(), beta, b.data(), n);
+		res = a;
+		vectorized::linComb(res.data(), alpha, res.data(), beta, b.data(), n);
+		compare();
+	}
+}
+
+TEST_CASE("AD arithmetic matches derivative rules", "[AD]")
+{
+	const std::size_t nDir = 13;
+	cadet::ad::setDirections(nDir);
+
+	cadet::active x(1.5);
+	cadet::active y(-0.75);
+	for (std::size_t i = 0; i < nDir; ++i)
+	{
+		x.setADValue(i, 0.5 + i);
+		y.setADValue(i, 2.0 - 0.25 * i);
+	}
+
+	const double vx = static_cast<double>(x);
+	const double vy = static_cast<double>(y);
+	const cadet::active prod = x * y;
+	const cadet::active quot = x / y;
+	const cadet::active ex = exp(x);
+	const cadet::active sq = sqrt(x);
+	cadet::active acc = x;
+	acc *= y;
+	acc -= x;
+	acc /= y;
+	cadet::active scaled = x;
+	scaled *= 3.0;
+	scaled /= 4.0;
+
+	for (std::size_t i = 0; i < nDir; ++i)
+	{
+		const double dx = x.getADValue(i);
+		const double dy = y.getADValue(i);
+		CHECK(prod.getADValue(i) == Approx(vy * dx + vx * dy));
+		CHECK(quot.getADValue(i) == Approx((dx * vy - vx * dy) / (vy * vy)));
+		CHECK(ex.getADValue(i) == Approx(std::exp(vx) * dx));
+		CHECK(sq.getADValue(i) == Approx(dx / (2.0 * std::sqrt(vx))));
+
+		const double dAcc = vy * dx + vx * dy - dx;
+		const double vAcc = vx * vy - vx;
+		CHECK(acc.getADValue(i) == Approx((dAcc * vy - vAcc * dy) / (vy * vy)));
+		CHECK(scaled.getADValue(i) == Approx(0.75 * dx));
+	}
+}
+
+namespace
+{
+	/**
+	 * @brief Measures the time per call of the given function in nanoseconds
+	 * @param [in] func Function to be benchmarked
+	 * @param [in] reps Number of calls
+	 * @return Average time per call in nanoseconds
+	 */
+	template <typename Func_t>
+	double timePerCall(Func_t func, unsigned int reps)
+	{
+		const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned int r = 0; r < reps; ++r)
+			func();
+		const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::nano>(end - start).count() / reps;
+	}
+}
+
+TEST_CASE("AD gradient kernel throughput", "[AD],[Benchmark],[.]")
+{
+	namespace scalar = sfad::detail::scalar;
+	namespace vectorized = sfad::detail::vectorized;
+
+	const unsigned int reps = 200000;
+	const std::size_t nDir = cadet::ad::getMaxDirections();
+	cadet::ad::setDirections(nDir);
+
+	std::vector<double> a(nDir, 1.25);
+	std::vector<double> b(nDir, -0.5);
+	std::vector<double> res(nDir, 0.0);
+
+	std::cout << "Gradient kernels (" << sfad::simdInstructionSet() << ", " << nDir << " directions) [ns/call scalar | vectorized]\n";
+
+	const auto report = [&](const char* name, double tScalar, double tVec)
+	{
+		std::cout << "  " << name << ": " << tScalar << " | " << tVec << " (speedup " << tScalar / tVec << ")\n";
+	};
+
+	report("add", timePerCall([&]() { scalar::add(res.data(), res.data(), a.data(), nDir); }, reps),
+		timePerCall([&]() { vectorized::add(res.data(), res.data(), a.data(), nDir); }, reps));
+	report("scale", timePerCall([&]() { scalar::scale(res.data(), 0.999, a.data(), nDir); }, reps),
+		timePerCall([&]() { vectorized::scale(res.data(), 0.999, a.data(), nDir); }, reps));
+	report("div", timePerCall([&]() { scalar::div(res.data(), a.data(), 1.001, nDir); }, reps),
+		timePerCall([&]() { vectorized::div(res.data(), a.data(), 1.001, nDir); }, reps));
+	report("linComb", timePerCall([&]() { scalar::linComb(res.data(), 0.5, res.data(), 0.25, b.data(), nDir); }, reps),
+		timePerCall([&]() { vectorized::linComb(res.data(), 0.5, res.data(), 0.25, b.data(), nDir); }, reps));
+	report("linCombDiv", timePerCall([&]() { scalar::linCombDiv(res.data(), 0.5, res.data(), 0.25, b.data(), 1.001, nDir); }, reps),
+		timePerCall([&]() { vectorized::linCombDiv(res.data(), 0.5, res.data(), 0.25, b.data(), 1.001, nDir); }, reps));
+
+	// Throughput of active operations
+	cadet::active x(1.5);
+	cadet::active y(0.75);
+	cadet::active z(0.0);
+	for (std::size_t i = 0; i < nDir; ++i)
+	{
+		x.setADValue(i, 1.0 + i);
+		y.setADValue(i, 0.5);
+	}
+
+	std::cout << "Active operations [ns/op]\n";
+	std::cout << "  operator+=: " << timePerCall([&]() { z += x; }, reps) << "\n";
+	std::cout << "  operator*=: " << timePerCall([&]() { z = x; z *= y; }, reps) << "\n";
+	std::cout << "  operator/=: " << timePerCall([&]() { z = x; z /= y; }, reps) << "\n";
+	std::cout << "  operator*: " << timePerCall([&]() { z = x * y; }, reps) << "\n";
+	std::cout << "  operator/: " << timePerCall([&]() { z = x / y; }, reps) << "\n";
+	std::cout << "  exp: " << timePerCall([&]() { z = exp(y); }, reps) << "\n";
+	std::cout << "  log: " << timePerCall([&]() { z = log(x); }, reps) << "\n";
+	std::cout << "  sqrt: " << timePerCall([&]() { z = sqrt(x); }, reps) << "\n";
+
+	CHECK(std::isfinite(z.getADValue(0)));
+}
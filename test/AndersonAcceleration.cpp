@@ -0,0 +1,111 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "nonlin/AndersonAcceleration.hpp"
+
+namespace
+{
+	/**
+	 * @brief Evaluates the slowly contracting map @f$ G(x)_i = a_i x_i + 0.1 \sin(x_{i-1}) + 1 @f$
+	 * @details The contraction factors @f$ a_i @f$ range from @f$ 0 @f$ to @f$ 0.95 @f$.
+	 * @param [in] x Point at which the map is evaluated
+	 * @param [out] gx Image of @p x
+	 */
+	void contractionMap(const std::vector<double>& x, std::vector<double>& gx)
+	{
+		const unsigned int n = x.size();
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			const double a = 0.95 * static_cast<double>(i) / static_cast<double>(n - 1);
+			gx[i] = a * x[i] + 1.0;
+			if (i > 0)
+				gx[i] += 0.1 * std::sin(x[i - 1]);
+		}
+	}
+
+	/**
+	 * @brief Runs the fixed point iteration until the change is below the tolerance
+	 * @param [in] depth History depth of the Anderson acceleration
+	 * @param [out] x Fixed point
+	 * @return Number of evaluations of the fixed point map
+	 */
+	unsigned int solveFixedPoint(unsigned int depth, std::vector<double>& x)
+	{
+		const unsigned int n = 40;
+		const unsigned int maxIter = 1000;
+
+		cadet::nonlin::AndersonAcceleration aa;
+		aa.resize(n, depth);
+
+		x.assign(n, 0.0);
+		std::vector<double> gx(n, 0.0);
+		const std::vector<double> weight(n, 2.0);
+
+		for (unsigned int iter = 1; iter <= maxIter; ++iter)
+		{
+			contractionMap(x, gx);
+
+			double change = 0.0;
+			for (unsigned int i = 0; i < n; ++i)
+				change = std::max(change, std::abs(gx[i] - x[i]));
+
+			if (change <= 1e-10)
+				return iter;
+
+			aa.update(x.data(), gx.data(), weight.data());
+		}
+		return maxIter;
+	}
+}
+
+TEST_CASE("Anderson acceleration with depth 0 is plain fixed point iteration", "[AndersonAcceleration],[NonLinAlg]")
+{
+	const unsigned int n = 40;
+	cadet::nonlin::AndersonAcceleration aa;
+	aa.resize(n, 0);
+
+	std::vector<double> x(n, 0.0);
+	std::vector<double> xPlain(n, 0.0);
+	std::vector<double> gx(n, 0.0);
+	for (unsigned int iter = 0; iter < 10; ++iter)
+	{
+		contractionMap(x, gx);
+		aa.update(x.data(), gx.data(), nullptr);
+		CHECK(aa.numStored() == 0);
+
+		contractionMap(xPlain, gx);
+		xPlain = gx;
+
+		for (unsigned int i = 0; i < n; ++i)
+			CHECK(x[i] == xPlain[i]);
+	}
+}
+
+TEST_CASE("Anderson acceleration converges faster than plain fixed point iteration", "[AndersonAcceleration],[NonLinAlg]")
+{
+	std::vector<double> xPlain;
+	std::vector<double> xAccel;
+	const unsigned int nPlain = solveFixedPoint(0, xPlain);
+	const unsigned int nAccel = solveFixedPoint(5, xAccel);
+
+	CHECK(nPlain < 1000);
+	CHECK(nAccel < nPlain / 4);
+
+	for (unsigned int i = 0; i < xPlain.size(); ++i)
+		CHECK(xAccel[i] == Approx(xPlain[i]).epsilon(1e-8));
+}
@@ -161,6 +161,43 @@ TEST_CASE("FactorizableBandMatrix solves", "[BandMatrix],[LinAlg]")
 	REQUIRE(cadet::linalg::linfNorm(y.data(), y.size()) <= 1e-10);
 }
 
+TEST_CASE("FactorizableBandMatrix solves multiple right hand sides", "[BandMatrix],[LinAlg]")
+{
+	using cadet::linalg::FactorizableBandMatrix;
+	using cadet::linalg::BandMatrix;
+
+	const BandMatrix bm = createBandMatrix<BandMatrix>(10, 2, 3);
+	FactorizableBandMatrix fbm = fromBandMatrix(bm);
+	
+	REQUIRE(fbm.factorize());
+
+	// Prepare some right hand sides stored one after another
+	const unsigned int nRhs = 4;
+	std::vector<double> y(fbm.rows() * nRhs, 0.0);
+	for (unsigned int k = 0; k < nRhs; ++k)
+	{
+		for (unsigned int i = 0; i < fbm.rows(); ++i)
+			y[i + k * fbm.rows()] = std::sin(6.283185307 * (i + k) / static_cast<double>(fbm.rows())) + k;
+	}
+
+	// Solve all at once
+	std::vector<double> x = y;
+	REQUIRE(fbm.solve(x.data(), nRhs));
+
+	for (unsigned int k = 0; k < nRhs; ++k)
+	{
+		// Compare with solution of single right hand side
+		std::vector<double> xSingle(y.begin() + k * fbm.rows(), y.begin() + (k + 1) * fbm.rows());
+		REQUIRE(fbm.solve(xSingle.data()));
+		for (unsigned int i = 0; i < fbm.rows(); ++i)
+			CHECK(x[i + k * fbm.rows()] == Approx(xSingle[i]));
+
+		// Calculate residual in y
+		bm.multiplyVector(x.data() + k * fbm.rows(), 1.0, -1.0, y.data() + k * fbm.rows());
+		CHECK(cadet::linalg::linfNorm(y.data() + k * fbm.rows(), fbm.rows()) <= 1e-10);
+	}
+}
+
 /**
  * @brief Tests the extraction of a dense submatrix via submatrixMultiplyVector()
  * @details Combines extractDenseSubMatrix() with checkMatrixAgainstLinearArray().
@@ -215,3 +252,28 @@ TEST_CASE("BandMatrix::submatrixMultiplyVector", "[BandMatrix],[LinAlg]")
 		testSubMatrixMultiply(bm, 3, -1, 1, 3, {36, 37, 38});
 	}
 }
+
+TEST_CASE("BandMatrix::transposedMultiplyVector", "[BandMatrix],[LinAlg]")
+{
+	using cadet::linalg::BandMatrix;
+
+	const BandMatrix bm = createBandMatrix<BandMatrix>(8, 2, 3);
+
+	std::vector<double> x(bm.rows(), 0.0);
+	for (unsigned int i = 0; i < bm.rows(); ++i)
+		x[i] = 0.5 * i - 1.0;
+
+	// Reference result y = 2 * A^T x - y0 with y0 = 1
+	std::vector<double> ref(bm.rows(), -1.0);
+	for (unsigned int row = 0; row < bm.rows(); ++row)
+	{
+		const int lower = std::max(-static_cast<int>(bm.lowerBandwidth()), -static_cast<int>(row));
+		const int upper = std::min(static_cast<int>(bm.upperBandwidth()), static_cast<int>(bm.rows() - row) - 1);
+		for (int diag = lower; diag <= upper; ++diag)
+			ref[row + diag] += 2.0 * bm.centered(row, diag) * x[row];
+	}
+
+	std::vector<double> y(bm.rows(), 1.0);
+	bm.transposedMultiplyVector(x.data(), 2.0, -1.0, y.data());
+	checkMatrixAgainstLinearArray(y.data(), ref);
+}
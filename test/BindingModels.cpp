@@ -0,0 +1,257 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+#include "cadet/cadet.hpp"
+
+#include "model/BindingModel.hpp"
+#include "BindingModelFactory.hpp"
+#include "AutoDiff.hpp"
+
+#include <json.hpp>
+#define CADETTEST_JSONPARAMETERPROVIDER_NOFORWARD
+#include "JsonParameterProvider.hpp"
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <iostream>
+
+using json = nlohmann::json;
+
+namespace
+{
+	const unsigned int nComp = 4;
+	const unsigned int nBound[] = {1, 1, 0, 1};
+	const unsigned int boundOffset[] = {0, 1, 2, 2};
+	const unsigned int nTotalBound = 3;
+	const unsigned int stride = nComp + nTotalBound;
+
+	/**
+	 * @brief Creates the binding model configuration of the given type
+	 * @param [in] name Name of the binding model
+	 * @param [in] kinetic Determines whether binding is kinetic
+	 * @return Configuration of the binding model
+	 */
+	json createBindingConfig(const std::string& name, bool kinetic)
+	{
+		json config;
+		config["IS_KINETIC"] = kinetic ? 1 : 0;
+
+		if (name == "LINEAR")
+		{
+			config["LIN_KA"] = {1.5, 2.0, 0.0, 3.5};
+			config["LIN_KD"] = {1.0, 0.5, 0.0, 2.0};
+		}
+		else if (name == "MULTI_COMPONENT_LANGMUIR")
+		{
+			config["MCL_KA"] = {1.5, 2.0, 0.0, 3.5};
+			config["MCL_KD"] = {1.0, 0.5, 0.0, 2.0};
+			config["MCL_QMAX"] = {10.0, 8.0, 1.0, 12.0};
+		}
+		else if (name == "MOBILE_PHASE_MODULATOR")
+		{
+			config["MPM_KA"] = {0.0, 2.0, 0.0, 3.5};
+			config["MPM_KD"] = {0.0, 0.5, 0.0, 2.0};
+			config["MPM_QMAX"] = {1.0, 8.0, 1.0, 12.0};
+			config["MPM_BETA"] = {0.0, 1.5, 0.0, 0.8};
+			config["MPM_GAMMA"] = {0.0, 0.1, 0.0, 0.05};
+		}
+		else if (name == "STERIC_MASS_ACTION")
+		{
+			config["SMA_LAMBDA"] = 1.2e3;
+			config["SMA_KA"] = {0.0, 35.5, 0.0, 7.7};
+			config["SMA_KD"] = {0.0, 1000.0, 0.0, 1000.0};
+			config["SMA_NU"] = {0.0, 4.7, 0.0, 5.29};
+			config["SMA_SIGMA"] = {0.0, 11.83, 0.0, 10.6};
+			config["SMA_REFC0"] = 50.0;
+			config["SMA_REFQ"] = 1.2e3;
+		}
+
+		return config;
+	}
+
+	/**
+	 * @brief Fills the state of all shells with smooth and positive values
+	 * @details The bound salt is set to a large value such that the number of free binding sites stays positive.
+	 * @param [out] y State vector of all shells
+	 * @param [in] nShells Number of shells
+	 */
+	void fillShellState(std::vector<double>& y, unsigned int nShells)
+	{
+		y.resize(nShells * stride);
+		for (unsigned int s = 0; s < nShells; ++s)
+		{
+			double* const yShell = y.data() + s * stride;
+			yShell[0] = 50.0 + 5.0 * std::sin(0.3 * s);
+			for (unsigned int comp = 1; comp < nComp; ++comp)
+				yShell[comp] = 1.0 + 0.5 * std::sin(0.7 * s + comp);
+
+			yShell[nComp] = 1.2e3;
+			for (unsigned int bnd = 1; bnd < nTotalBound; ++bnd)
+				yShell[nComp + bnd] = 0.5 + 0.25 * std::cos(0.4 * s + bnd);
+		}
+	}
+
+	/**
+	 * @brief Creates and configures a binding model of the given type
+	 * @param [in] name Name of the binding model
+	 * @param [in] kinetic Determines whether binding is kinetic
+	 * @return Configured binding model owned by the caller
+	 */
+	cadet::model::IBindingModel* createBindingModel(const std::string& name, bool kinetic)
+	{
+		cadet::BindingModelFactory factory;
+		cadet::model::IBindingModel* const bm = factory.create(name);
+		REQUIRE(bm);
+
+		bm->configureModelDiscretization(nComp, nBound, boundOffset);
+
+		cadet::JsonParameterProvider jpp(createBindingConfig(name, kinetic));
+		REQUIRE(bm->configure(jpp, 0));
+
+		return bm;
+	}
+
+	/**
+	 * @brief Checks that residualBatch() matches residual() for each shell
+	 * @param [in] name Name of the binding model
+	 * @param [in] kinetic Determines whether binding is kinetic
+	 */
+	void testResidualBatch(const std::string& name, bool kinetic)
+	{
+		cadet::model::IBindingModel* const bm = createBindingModel(name, kinetic);
+
+		// Use more shells than fit into one chunk of the kernels
+		const unsigned int nShells = 21;
+		std::vector<double> r(nShells);
+		for (unsigned int s = 0; s < nShells; ++s)
+			r[s] = 1.0 - (s + 0.5) / nShells;
+
+		std::vector<double> y;
+		fillShellState(y, nShells);
+
+		std::vector<double> yDot(y.size());
+		for (unsigned int i = 0; i < yDot.size(); ++i)
+			yDot[i] = 0.1 * std::cos(0.5 * i);
+
+		const unsigned int offset = nComp;
+		const double t = 1.0;
+		const double timeFactor = 2.0;
+
+		// Double variant
+		for (int withTimeDer = 0; withTimeDer < 2; ++withTimeDer)
+		{
+			double const* const yDotPtr = withTimeDer ? yDot.data() + offset : nullptr;
+
+			std::vector<double> resShell(y.size(), 0.0);
+			std::vector<double> resBatch(y.size(), 0.0);
+			for (unsigned int s = 0; s < nShells; ++s)
+				bm->residual(t, 0.5, r[s], 0, timeFactor, y.data() + offset + s * stride, yDotPtr ? yDotPtr + s * stride : nullptr, resShell.data() + offset + s * stride);
+
+			CHECK(bm->residualBatch(t, 0.5, r.data(), 0, timeFactor, nShells, stride, y.data() + offset, yDotPtr, resBatch.data() + offset) == 0);
+
+			for (unsigned int i = 0; i < y.size(); ++i)
+				CHECK(resBatch[i] == Approx(resShell[i]));
+		}
+
+		// AD variant with each shell-local state seeded in its own direction
+		cadet::ad::setDirections(stride);
+		std::vector<cadet::active> adY(y.size());
+		for (unsigned int i = 0; i < y.size(); ++i)
+		{
+			adY[i] = y[i];
+			adY[i].setADValue(i % stride, 1.0);
+		}
+
+		std::vector<cadet::active> adResShell(y.size(), 0.0);
+		std::vector<cadet::active> adResBatch(y.size(), 0.0);
+		for (unsigned int s = 0; s < nShells; ++s)
+			bm->residual(t, 0.5, r[s], 0, timeFactor, adY.data() + offset + s * stride, yDot.data() + offset + s * stride, adResShell.data() + offset + s * stride);
+
+		CHECK(bm->residualBatch(t, 0.5, r.data(), 0, timeFactor, nShells, stride, adY.data() + offset, yDot.data() + offset, adResBatch.data() + offset) == 0);
+
+		for (unsigned int i = 0; i < y.size(); ++i)
+		{
+			CHECK(adResBatch[i].getValue() == Approx(adResShell[i].getValue()));
+			for (unsigned int d = 0; d < stride; ++d)
+				CHECK(adResBatch[i].getADValue(d) == Approx(adResShell[i].getADValue(d)));
+		}
+
+		delete bm;
+	}
+}
+
+TEST_CASE("Binding model batched residual matches residual of single shells", "[BindingModel],[Residual]")
+{
+	const char* const models[] = {"LINEAR", "MULTI_COMPONENT_LANGMUIR", "MOBILE_PHASE_MODULATOR", "STERIC_MASS_ACTION"};
+	for (const char* name : models)
+	{
+		SECTION(name)
+		{
+			SECTION("Kinetic binding")
+			{
+				testResidualBatch(name, true);
+			}
+			SECTION("Quasi-stationary binding")
+			{
+				testResidualBatch(name, false);
+			}
+		}
+	}
+}
+
+TEST_CASE("Binding model batched residual throughput", "[BindingModel],[Residual],[Benchmark],[.]")
+{
+	const unsigned int nShells = 16;
+	const unsigned int nBlocks = 4096;
+	const unsigned int nRep = 20;
+
+	std::vector<double> r(nShells);
+	for (unsigned int s = 0; s < nShells; ++s)
+		r[s] = 1.0 - (s + 0.5) / nShells;
+
+	std::vector<double> y;
+	fillShellState(y, nShells);
+	std::vector<double> res(y.size(), 0.0);
+
+	std::cout << "Binding model residual of " << nBlocks << " x " << nShells << " shells [ms]\n";
+
+	const char* const models[] = {"LINEAR", "MULTI_COMPONENT_LANGMUIR", "MOBILE_PHASE_MODULATOR", "STERIC_MASS_ACTION"};
+	for (const char* name : models)
+	{
+		cadet::model::IBindingModel* const bm = createBindingModel(name, true);
+
+		double tShell = 0.0;
+		double tBatch = 0.0;
+		for (unsigned int rep = 0; rep < nRep; ++rep)
+		{
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (unsigned int blk = 0; blk < nBlocks; ++blk)
+			{
+				for (unsigned int s = 0; s < nShells; ++s)
+					bm->residual(0.0, 0.5, r[s], 0, 1.0, y.data() + nComp + s * stride, nullptr, res.data() + nComp + s * stride);
+			}
+			const auto mid = std::chrono::high_resolution_clock::now();
+			for (unsigned int blk = 0; blk < nBlocks; ++blk)
+				bm->residualBatch(0.0, 0.5, r.data(), 0, 1.0, nShells, stride, y.data() + nComp, nullptr, res.data() + nComp);
+			const auto end = std::chrono::high_resolution_clock::now();
+
+			tShell += std::chrono::duration<double, std::milli>(mid - start).count();
+			tBatch += std::chrono::duration<double, std::milli>(end - mid).count();
+		}
+
+		std::cout << "  " << name << ": per shell " << tShell / nRep << " batch " << tBatch / nRep << "\n";
+		delete bm;
+	}
+}
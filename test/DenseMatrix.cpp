@@ -167,6 +167,32 @@ TEST_CASE("DenseMatrix LU solves", "[DenseMatrix],[LinAlg]")
 	REQUIRE(cadet::linalg::linfNorm(y.data(), y.size()) <= 1e-13);
 }
 
+TEST_CASE("DenseMatrix LU solves multiple right hand sides", "[DenseMatrix],[LinAlg]")
+{
+	using cadet::linalg::DenseMatrix;
+
+	// Probability of obtaining a non-invertible random matrix is 0
+	const DenseMatrix dm = randomMatrix(8, 8);
+	DenseMatrix fdm = dm;
+	
+	REQUIRE(fdm.factorize());
+
+	// Prepare some right hand sides stored one after another
+	const unsigned int nRhs = 3;
+	std::vector<double> y = randomVector(dm.rows() * nRhs);
+
+	// Solve all at once
+	std::vector<double> x = y;
+	REQUIRE(fdm.solve(x.data(), nRhs));
+
+	// Calculate residuals in y
+	for (unsigned int k = 0; k < nRhs; ++k)
+	{
+		dm.multiplyVector(x.data() + k * dm.rows(), 1.0, -1.0, y.data() + k * dm.rows());
+		CHECK(cadet::linalg::linfNorm(y.data() + k * dm.rows(), dm.rows()) <= 1e-13);
+	}
+}
+
 TEST_CASE("DenseMatrix QR solves", "[DenseMatrix],[LinAlg]")
 {
 	using cadet::linalg::DenseMatrix;
@@ -20,7 +20,17 @@
 #include "JsonParameterProvider.hpp"
 
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include <functional>
+#include <string>
+#include <chrono>
+#include <iostream>
+
+#ifdef CADET_PARALLELIZE
+	#include <thread>
+	#include <tbb/tbb.h>
+#endif
 
 namespace
 {
@@ -40,6 +50,91 @@ namespace
 		jpp.popScope();
 		jpp.popScope();
 	}
+
+	/**
+	 * @brief Sets the number of particle shells per batch of consistent initialization in a configuration
+	 * @param [in,out] jpp ParameterProvider to change the batch size in
+	 * @param [in] batchSize Number of particle shells per batch
+	 */
+	inline void setConsistentInitBatchSize(cadet::JsonParameterProvider& jpp, int batchSize)
+	{
+		jpp.pushScope("discretization");
+		jpp.set("CONSISTENT_INIT_BATCH_SIZE", batchSize);
+		jpp.popScope();
+	}
+
+	/**
+	 * @brief Enables or disables the cache of consistently initialized bound states in a configuration
+	 * @param [in,out] jpp ParameterProvider to change the setting in
+	 * @param [in] useCache Determines whether the cache is used
+	 */
+	inline void setConsistentInitCache(cadet::JsonParameterProvider& jpp, bool useCache)
+	{
+		jpp.pushScope("discretization");
+		jpp.set("CONSISTENT_INIT_CACHE", useCache);
+		jpp.popScope();
+	}
+
+	/**
+	 * @brief Enables or disables particle kernels with compile-time sizes in a configuration
+	 * @param [in,out] jpp ParameterProvider to change the setting in
+	 * @param [in] useSpecialized Determines whether specialized kernels are used
+	 */
+	inline void setSpecializedKernels(cadet::JsonParameterProvider& jpp, bool useSpecialized)
+	{
+		jpp.pushScope("discretization");
+		jpp.set("USE_SPECIALIZED_KERNELS", useSpecialized);
+		jpp.popScope();
+	}
+
+	/**
+	 * @brief Enables or disables the direction plane sweeps of the AD Jacobian in a configuration
+	 * @param [in,out] jpp ParameterProvider to change the setting in
+	 * @param [in] usePlanes Determines whether direction planes are used
+	 */
+	inline void setAdDirectionPlanes(cadet::JsonParameterProvider& jpp, bool usePlanes)
+	{
+		jpp.pushScope("discretization");
+		jpp.set("USE_AD_DIRECTION_PLANES", usePlanes);
+		jpp.popScope();
+	}
+
+	/**
+	 * @brief Sets the threshold for reusing Jacobian factorizations in a configuration
+	 * @param [in,out] jpp ParameterProvider to change the setting in
+	 * @param [in] tol Maximum relative change of alpha for which a factorization is reused
+	 */
+	inline void setJacobianReuseTol(cadet::JsonParameterProvider& jpp, double tol)
+	{
+		jpp.pushScope("discretization");
+		jpp.set("JACOBIAN_REUSE_TOL", tol);
+		jpp.popScope();
+	}
+
+	/**
+	 * @brief Selects the linear solver of a configuration
+	 * @param [in,out] jpp ParameterProvider to change the setting in
+	 * @param [in] solver Name of the linear solver (@c SCHUR or @c SPARSE)
+	 * @param [in] schurSolver Name of the Schur-complement solver (@c GMRES or @c DIRECT)
+	 */
+	inline void setLinearSolver(cadet::JsonParameterProvider& jpp, const std::string& solver, const std::string& schurSolver)
+	{
+		jpp.pushScope("discretization");
+		jpp.set("LINEAR_SOLVER", solver);
+		jpp.set("LINEAR_SOLVER_SCHUR", schurSolver);
+		jpp.popScope();
+	}
+
+	/**
+	 * @brief Switches the binding model of a configuration to quasi-stationary binding
+	 * @param [in,out] jpp ParameterProvider to change the binding mode in
+	 */
+	inline void setQuasiStationaryBinding(cadet::JsonParameterProvider& jpp)
+	{
+		jpp.pushScope("adsorption");
+		jpp.set("IS_KINETIC", 0);
+		jpp.popScope();
+	}
 }
 
 /**
@@ -485,3 +580,1322 @@ TEST_CASE("GeneralRateModel Jacobian forward vs backward flow", "[GRM],[UnitOp],
 	for (unsigned int i = 1; i < cadet::Weno::maxOrder(); ++i)
 		testJacobianWenoForwardBackward(i);
 }
+
+TEST_CASE("GeneralRateModel AD Jacobian with SMA binding", "[GRM],[UnitOp],[Residual],[Jacobian],[AD]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithSMA();
+
+	cadet::model::GeneralRateModel* const grmAna = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+	cadet::model::GeneralRateModel* const grmAD = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	// Enable AD
+	grmAD->useAnalyticJacobian(false);
+	cadet::ad::setDirections(grmAD->requiredADdirs());
+
+	cadet::active* adRes = new cadet::active[grmAD->numDofs()];
+	cadet::active* adY = new cadet::active[grmAD->numDofs()];
+
+	grmAD->prepareADvectors(adRes, adY, 0);
+
+	// Setup matrices
+	grmAna->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+	grmAD->notifyDiscontinuousSectionTransition(0.0, 0u, adRes, adY, 0u);
+
+	// Obtain memory for state, Jacobian multiply direction, Jacobian column
+	std::vector<double> y(grmAD->numDofs(), 0.0);
+	std::vector<double> jacDir(grmAD->numDofs(), 0.0);
+	std::vector<double> jacCol1(grmAD->numDofs(), 0.0);
+	std::vector<double> jacCol2(grmAD->numDofs(), 0.0);
+
+	// Fill state vector with some values
+	fillState(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, grmAna->numDofs());
+
+	// Bound salt has to be large enough to keep the number of free binding sites positive
+	jpp.pushScope("discretization");
+	const unsigned int nCol = jpp.getInt("NCOL");
+	const unsigned int nPar = jpp.getInt("NPAR");
+	jpp.popScope();
+
+	const unsigned int nComp = grmAD->numComponents();
+	const unsigned int strideShell = 2 * nComp;
+	for (unsigned int i = 0; i < nCol * nPar; ++i)
+		y[nComp + nComp * nCol + i * strideShell + nComp] = 1.2e3;
+
+	// Compute state Jacobian
+	grmAna->residualWithJacobian(0.0, 0u, 1.0, y.data(), nullptr, jacDir.data(), nullptr, nullptr, 0u);
+	grmAD->residualWithJacobian(0.0, 0u, 1.0, y.data(), nullptr, jacDir.data(), adRes, adY, 0u);
+	std::fill(jacDir.begin(), jacDir.end(), 0.0);
+
+	// Compare Jacobians
+	compareJacobian(grmAna, grmAD, jacDir.data(), jacCol1.data(), jacCol2.data());
+
+	delete[] adY;
+	delete[] adRes;
+	mb->destroyUnitOperation(grmAna);
+	mb->destroyUnitOperation(grmAD);
+	destroyModelBuilder(mb);
+}
+
+/**
+ * @brief Fills the state vector of a GRM with SMA binding for consistent initialization
+ * @details The mobile phases are filled with varying salt and protein concentrations. The bound salt is set
+ *          to the ionic capacity of the SMA model and all other bound states are zero.
+ * @param [out] y State vector
+ * @param [in] nComp Number of components
+ * @param [in] nCol Number of column cells
+ * @param [in] nPar Number of particle shells
+ */
+void fillStateForSMAConsistentInit(std::vector<double>& y, unsigned int nComp, unsigned int nCol, unsigned int nPar)
+{
+	std::fill(y.begin(), y.end(), 0.0);
+	fillStateBulkFwd(y.data(), [](unsigned int comp, unsigned int col, unsigned int idx) { return (comp == 0) ? 50.0 + 20.0 * std::abs(std::sin(idx * 0.13)) : 0.5 * std::abs(std::sin(idx * 0.13)) + 0.1; }, nComp, nCol);
+
+	double* const yPar = y.data() + nComp + nComp * nCol;
+	for (unsigned int i = 0; i < nCol * nPar; ++i)
+	{
+		yPar[i * 2 * nComp] = 50.0 + 20.0 * std::abs(std::sin(i * 0.07));
+		for (unsigned int comp = 1; comp < nComp; ++comp)
+			yPar[i * 2 * nComp + comp] = 0.5 * std::abs(std::sin(i * 0.13 + comp)) + 0.1;
+
+		yPar[i * 2 * nComp + nComp] = 1.2e3;
+	}
+}
+
+TEST_CASE("GeneralRateModel batched consistent initialization with SMA binding", "[GRM],[UnitOp],[ConsistentInit]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithSMA();
+	setQuasiStationaryBinding(jpp);
+
+	jpp.pushScope("discretization");
+	const unsigned int nCol = jpp.getInt("NCOL");
+	const unsigned int nPar = jpp.getInt("NPAR");
+	jpp.popScope();
+
+	// Reference without reusing solutions of neighboring shells
+	setConsistentInitBatchSize(jpp, 1);
+	cadet::model::GeneralRateModel* const grmSingle = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	// All shells in one batch
+	setConsistentInitBatchSize(jpp, nCol * nPar);
+	cadet::model::GeneralRateModel* const grmBatch = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	// Batches cross column cell boundaries and AD Jacobian
+	setConsistentInitBatchSize(jpp, 3);
+	cadet::model::GeneralRateModel* const grmAD = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	grmAD->useAnalyticJacobian(false);
+	cadet::ad::setDirections(grmAD->requiredADdirs());
+
+	cadet::active* adRes = new cadet::active[grmAD->numDofs()];
+	cadet::active* adY = new cadet::active[grmAD->numDofs()];
+
+	grmAD->prepareADvectors(adRes, adY, 0);
+	grmSingle->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+	grmBatch->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+	grmAD->notifyDiscontinuousSectionTransition(0.0, 0u, adRes, adY, 0u);
+
+	const unsigned int nComp = grmSingle->numComponents();
+	std::vector<double> ySingle(grmSingle->numDofs(), 0.0);
+	fillStateForSMAConsistentInit(ySingle, nComp, nCol, nPar);
+	std::vector<double> yBatch = ySingle;
+	std::vector<double> yAD = ySingle;
+
+	grmSingle->consistentInitialState(0.0, 0u, 1.0, ySingle.data(), nullptr, nullptr, 0u, 1e-12);
+	grmBatch->consistentInitialState(0.0, 0u, 1.0, yBatch.data(), nullptr, nullptr, 0u, 1e-12);
+	grmAD->consistentInitialState(0.0, 0u, 1.0, yAD.data(), adRes, adY, 0u, 1e-12);
+
+	// Bound states have been computed and agree
+	double const* const qSingle = ySingle.data() + nComp + nComp * nCol + nComp;
+	double const* const qBatch = yBatch.data() + nComp + nComp * nCol + nComp;
+	double const* const qAD = yAD.data() + nComp + nComp * nCol + nComp;
+	for (unsigned int i = 0; i < nCol * nPar; ++i)
+	{
+		CHECK(qSingle[i * 2 * nComp + 1] > 0.0);
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+		{
+			CHECK(qBatch[i * 2 * nComp + comp] == Approx(qSingle[i * 2 * nComp + comp]).epsilon(1e-8));
+			CHECK(qAD[i * 2 * nComp + comp] == Approx(qSingle[i * 2 * nComp + comp]).epsilon(1e-8));
+		}
+	}
+
+	delete[] adY;
+	delete[] adRes;
+	mb->destroyUnitOperation(grmSingle);
+	mb->destroyUnitOperation(grmBatch);
+	mb->destroyUnitOperation(grmAD);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel batched consistent initialization throughput", "[GRM],[UnitOp],[ConsistentInit],[Benchmark],[.]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithSMA();
+	setQuasiStationaryBinding(jpp);
+
+	jpp.pushScope("discretization");
+	jpp.set("NCOL", 128);
+	jpp.set("NPAR", 16);
+	jpp.popScope();
+
+	std::cout << "GRM consistent initialization with SMA binding (128 x 16 shells) [ms]\n";
+	const unsigned int reps = 10;
+	for (int batchSize : {1, 4, 16, 128})
+	{
+		setConsistentInitBatchSize(jpp, batchSize);
+		cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+		grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+		std::vector<double> y0(grm->numDofs(), 0.0);
+		fillStateForSMAConsistentInit(y0, grm->numComponents(), 128, 16);
+		std::vector<double> y(y0.size());
+
+		double tElapsed = 0.0;
+		for (unsigned int r = 0; r < reps; ++r)
+		{
+			std::copy(y0.begin(), y0.end(), y.begin());
+			const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			grm->consistentInitialState(0.0, 0u, 1.0, y.data(), nullptr, nullptr, 0u, 1e-12);
+			const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+			tElapsed += std::chrono::duration<double, std::milli>(end - start).count();
+		}
+
+		std::cout << "  batch size " << batchSize << ": " << tElapsed / reps << "\n";
+		CHECK(std::isfinite(y.back()));
+
+		mb->destroyUnitOperation(grm);
+	}
+
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel consistent initialization reuses cached bound states", "[GRM],[UnitOp],[ConsistentInit]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithSMA();
+	setQuasiStationaryBinding(jpp);
+
+	jpp.pushScope("discretization");
+	const unsigned int nCol = jpp.getInt("NCOL");
+	const unsigned int nPar = jpp.getInt("NPAR");
+	jpp.popScope();
+	const unsigned int nShells = nCol * nPar;
+
+	setConsistentInitCache(jpp, true);
+	cadet::model::GeneralRateModel* const grmCache = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	setConsistentInitCache(jpp, false);
+	cadet::model::GeneralRateModel* const grmNoCache = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	grmCache->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+	grmNoCache->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+	const unsigned int nComp = grmCache->numComponents();
+	std::vector<double> y0(grmCache->numDofs(), 0.0);
+	fillStateForSMAConsistentInit(y0, nComp, nCol, nPar);
+
+	// First run fills the cache
+	std::vector<double> yFirst = y0;
+	grmCache->consistentInitialState(0.0, 0u, 1.0, yFirst.data(), nullptr, nullptr, 0u, 1e-12);
+	CHECK(grmCache->consistentInitStats().numShells == nShells);
+	CHECK(grmCache->consistentInitStats().numGuesses == 0);
+
+	// Second run in the same section starts from the cached solution
+	std::vector<double> ySecond = y0;
+	grmCache->consistentInitialState(0.0, 0u, 1.0, ySecond.data(), nullptr, nullptr, 0u, 1e-12);
+	const cadet::model::ConsistentInitStats& stats = grmCache->consistentInitStats();
+	CHECK(stats.numShells == 2 * nShells);
+	CHECK(stats.numGuesses == nShells);
+	CHECK(stats.numGuessesUsed > 0);
+	CHECK(stats.numSkipped > 0);
+
+	// Other sections do not use the cache
+	std::vector<double> yOtherSec = y0;
+	grmCache->consistentInitialState(0.0, 1u, 1.0, yOtherSec.data(), nullptr, nullptr, 0u, 1e-12);
+	CHECK(grmCache->consistentInitStats().numGuesses == nShells);
+
+	// Disabled cache
+	std::vector<double> yNoCache = y0;
+	grmNoCache->consistentInitialState(0.0, 0u, 1.0, yNoCache.data(), nullptr, nullptr, 0u, 1e-12);
+	grmNoCache->consistentInitialState(0.0, 0u, 1.0, y0.data(), nullptr, nullptr, 0u, 1e-12);
+	CHECK(grmNoCache->consistentInitStats().numGuesses == 0);
+
+	double const* const qFirst = yFirst.data() + nComp + nComp * nCol + nComp;
+	double const* const qSecond = ySecond.data() + nComp + nComp * nCol + nComp;
+	double const* const qNoCache = y0.data() + nComp + nComp * nCol + nComp;
+	for (unsigned int i = 0; i < nShells; ++i)
+	{
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+		{
+			CHECK(qSecond[i * 2 * nComp + comp] == Approx(qFirst[i * 2 * nComp + comp]).epsilon(1e-8));
+			CHECK(qNoCache[i * 2 * nComp + comp] == Approx(qFirst[i * 2 * nComp + comp]).epsilon(1e-8));
+		}
+	}
+
+	mb->destroyUnitOperation(grmCache);
+	mb->destroyUnitOperation(grmNoCache);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel consistent initialization cache throughput", "[GRM],[UnitOp],[ConsistentInit],[Benchmark],[.]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithSMA();
+	setQuasiStationaryBinding(jpp);
+
+	jpp.pushScope("discretization");
+	jpp.set("NCOL", 128);
+	jpp.set("NPAR", 16);
+	jpp.popScope();
+
+	// Repeated simulations (e.g., parameter estimation) initialize the same section from the same initial state
+	std::cout << "GRM repeated consistent initialization with SMA binding (128 x 16 shells) [ms]\n";
+	const unsigned int reps = 10;
+	for (bool useCache : {false, true})
+	{
+		setConsistentInitCache(jpp, useCache);
+		cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+		grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+		std::vector<double> y0(grm->numDofs(), 0.0);
+		fillStateForSMAConsistentInit(y0, grm->numComponents(), 128, 16);
+		std::vector<double> y(y0.size());
+
+		double tElapsed = 0.0;
+		for (unsigned int r = 0; r < reps; ++r)
+		{
+			std::copy(y0.begin(), y0.end(), y.begin());
+			const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			grm->consistentInitialState(0.0, 0u, 1.0, y.data(), nullptr, nullptr, 0u, 1e-12);
+			const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+			tElapsed += std::chrono::duration<double, std::milli>(end - start).count();
+		}
+
+		const cadet::model::ConsistentInitStats& stats = grm->consistentInitStats();
+		std::cout << "  " << (useCache ? "with cache: " : "without cache: ") << tElapsed / reps << " (" << stats.numGuessesUsed << " of "
+			<< stats.numGuesses << " cached guesses used, " << stats.numSkipped << " of " << stats.numShells << " shells skipped)\n";
+		CHECK(std::isfinite(y.back()));
+
+		mb->destroyUnitOperation(grm);
+	}
+
+	destroyModelBuilder(mb);
+}
+
+/**
+ * @brief Compares analytic parameter derivatives of the residual with AD for forward and backward flow
+ * @param [in] jpp Configuration of the GRM
+ * @param [in] params Sensitive parameters and their AD directions (parameters may share a direction)
+ * @param [in] nSens Number of AD directions used by the sensitive parameters
+ */
+void testAnalyticParamDerivatives(cadet::JsonParameterProvider& jpp, const std::vector<std::pair<cadet::ParameterId, unsigned int>>& params, unsigned int nSens)
+{
+	// Set AD directions before any active is created
+	cadet::ad::setDirections(cadet::ad::getMaxDirections());
+	REQUIRE(nSens <= cadet::ad::getMaxDirections());
+
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	jpp.pushScope("discretization");
+	jpp.set("USE_ANALYTIC_PARAM_DERIVATIVES", false);
+	jpp.popScope();
+	cadet::model::GeneralRateModel* const grmAD = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	jpp.pushScope("discretization");
+	jpp.set("USE_ANALYTIC_PARAM_DERIVATIVES", true);
+	jpp.popScope();
+	cadet::model::GeneralRateModel* const grmAna = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	for (const std::pair<cadet::ParameterId, unsigned int>& p : params)
+	{
+		REQUIRE(grmAD->setSensitiveParameter(p.first, p.second, 1.0));
+		REQUIRE(grmAna->setSensitiveParameter(p.first, p.second, 1.0));
+	}
+
+	const unsigned int nDof = grmAD->numDofs();
+	std::vector<cadet::active> adResAD(nDof);
+	std::vector<cadet::active> adResAna(nDof);
+
+	std::vector<double> y(nDof, 0.0);
+	std::vector<double> yDot(nDof, 0.0);
+	fillState(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, nDof);
+	fillState(yDot.data(), [](unsigned int idx) { return std::cos(idx * 0.27); }, nDof);
+
+	// Bound salt has to be large enough to keep the number of free binding sites positive
+	jpp.pushScope("discretization");
+	const unsigned int nCol = jpp.getInt("NCOL");
+	const unsigned int nPar = jpp.getInt("NPAR");
+	jpp.popScope();
+
+	const unsigned int nComp = grmAD->numComponents();
+	if (jpp.getString("ADSORPTION_MODEL") == "STERIC_MASS_ACTION")
+	{
+		for (unsigned int i = 0; i < nCol * nPar; ++i)
+			y[nComp + nComp * nCol + i * 2 * nComp + nComp] = 1.2e3;
+	}
+
+	const cadet::ParameterId velocity = cadet::makeParamId(cadet::hashString("VELOCITY"), 0, cadet::CompIndep, cadet::BoundPhaseIndep, cadet::ReactionIndep, cadet::SectionIndep);
+	for (double dir : {1.0, -1.0})
+	{
+		REQUIRE(grmAD->setParameter(velocity, dir * jpp.getDouble("VELOCITY")));
+		REQUIRE(grmAna->setParameter(velocity, dir * jpp.getDouble("VELOCITY")));
+		grmAD->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+		grmAna->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+		grmAD->residualSensFwdAdOnly(0.0, 0u, 1.0, y.data(), yDot.data(), adResAD.data());
+		grmAna->residualSensFwdAdOnly(0.0, 0u, 1.0, y.data(), yDot.data(), adResAna.data());
+
+		for (unsigned int i = 0; i < nDof; ++i)
+			CHECK(static_cast<double>(adResAna[i]) == Approx(static_cast<double>(adResAD[i])).epsilon(1e-12).margin(1e-14));
+
+		for (unsigned int d = 0; d < nSens; ++d)
+		{
+			// Derivatives span several orders of magnitude, allow for cancellation errors
+			double scale = 0.0;
+			for (unsigned int i = 0; i < nDof; ++i)
+				scale = std::max(scale, std::abs(adResAD[i].getADValue(d)));
+			CHECK(scale > 0.0);
+
+			for (unsigned int i = 0; i < nDof; ++i)
+				CHECK(adResAna[i].getADValue(d) == Approx(adResAD[i].getADValue(d)).epsilon(1e-8).margin(1e-10 * scale));
+		}
+	}
+
+	mb->destroyUnitOperation(grmAna);
+	mb->destroyUnitOperation(grmAD);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel analytic parameter derivatives match AD", "[GRM],[UnitOp],[Residual],[Sensitivity],[AD]")
+{
+	const auto unitParam = [](const char* name) { return cadet::makeParamId(cadet::hashStringRuntime(name), 0, cadet::CompIndep, cadet::BoundPhaseIndep, cadet::ReactionIndep, cadet::SectionIndep); };
+	const auto compParam = [](const char* name, unsigned int comp) { return cadet::makeParamId(cadet::hashStringRuntime(name), 0, comp, cadet::BoundPhaseIndep, cadet::ReactionIndep, cadet::SectionIndep); };
+	const auto bndParam = [](const char* name, unsigned int comp) { return cadet::makeParamId(cadet::hashStringRuntime(name), 0, comp, 0, cadet::ReactionIndep, cadet::SectionIndep); };
+
+	// Transport parameters, film diffusion of two components is fused into one direction
+	std::vector<std::pair<cadet::ParameterId, unsigned int>> params = {
+		{unitParam("COL_DISPERSION"), 0},
+		{unitParam("VELOCITY"), 1},
+		{unitParam("COL_LENGTH"), 2},
+		{unitParam("COL_POROSITY"), 3},
+		{unitParam("PAR_POROSITY"), 4},
+		{unitParam("PAR_RADIUS"), 5},
+		{compParam("FILM_DIFFUSION", 0), 6},
+		{compParam("FILM_DIFFUSION", 1), 6},
+		{compParam("PAR_DIFFUSION", 1), 7},
+		{bndParam("PAR_SURFDIFFUSION", 1), 8}
+	};
+
+	SECTION("Linear binding")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithLinear();
+		params.push_back({bndParam("LIN_KA", 0), 9});
+		params.push_back({bndParam("LIN_KD", 1), 10});
+		testAnalyticParamDerivatives(jpp, params, 11);
+	}
+
+	SECTION("Langmuir binding")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithLinear();
+		jpp.set("ADSORPTION_MODEL", std::string("MULTI_COMPONENT_LANGMUIR"));
+		jpp.pushScope("adsorption");
+		jpp.set("MCL_KA", std::vector<double>({1.14, 2.25}));
+		jpp.set("MCL_KD", std::vector<double>({0.02, 0.35}));
+		jpp.set("MCL_QMAX", std::vector<double>({9.5, 12.0}));
+		jpp.popScope();
+
+		params.push_back({bndParam("MCL_KA", 0), 9});
+		params.push_back({bndParam("MCL_KD", 1), 10});
+		params.push_back({bndParam("MCL_QMAX", 0), 11});
+		params.push_back({bndParam("MCL_QMAX", 1), 12});
+		testAnalyticParamDerivatives(jpp, params, 13);
+	}
+
+	SECTION("SMA binding")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithSMA();
+		params.push_back({unitParam("SMA_LAMBDA"), 9});
+		params.push_back({bndParam("SMA_KA", 1), 10});
+		params.push_back({bndParam("SMA_KD", 2), 11});
+		params.push_back({bndParam("SMA_NU", 3), 12});
+		params.push_back({bndParam("SMA_SIGMA", 1), 13});
+		params.push_back({unitParam("SMA_REFC0"), 14});
+		testAnalyticParamDerivatives(jpp, params, 15);
+	}
+}
+
+/**
+ * @brief Fills the state vector of a GRM with positive values
+ * @details The bound state of the first component is set to the SMA ionic capacity, which keeps
+ *          the number of free binding sites positive in case of SMA binding.
+ * @param [out] y State vector
+ * @param [in] grm Model
+ * @param [in] nCol Number of axial cells
+ * @param [in] nPar Number of particle shells
+ */
+void fillStateWithBoundSalt(std::vector<double>& y, cadet::model::GeneralRateModel* grm, unsigned int nCol, unsigned int nPar)
+{
+	const unsigned int nComp = grm->numComponents();
+	y.resize(grm->numDofs());
+	fillState(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, grm->numDofs());
+	for (unsigned int i = 0; i < nCol * nPar; ++i)
+		y[nComp + nComp * nCol + i * 2 * nComp + nComp] = 1.2e3;
+}
+
+/**
+ * @brief Checks that the specialized particle kernels produce the same results as the generic ones
+ * @details Compares residual, Jacobian, and the solution of the time-discretized linear system.
+ * @param [in] jpp Configuration of the GRM (one bound state per component)
+ */
+void testSpecializedKernels(cadet::JsonParameterProvider& jpp)
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	jpp.pushScope("discretization");
+	jpp.set("LINEAR_SOLVER", std::string("SPARSE"));
+	const unsigned int nCol = jpp.getInt("NCOL");
+	const unsigned int nPar = jpp.getInt("NPAR");
+	jpp.popScope();
+
+	setSpecializedKernels(jpp, false);
+	cadet::model::GeneralRateModel* const grmGen = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+	setSpecializedKernels(jpp, true);
+	cadet::model::GeneralRateModel* const grmSpec = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	grmGen->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+	grmSpec->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+	const unsigned int numDofs = grmGen->numDofs();
+	std::vector<double> y;
+	fillStateWithBoundSalt(y, grmGen, nCol, nPar);
+	std::vector<double> yDot(numDofs);
+	fillState(yDot.data(), [](unsigned int idx) { return 0.1 * std::cos(idx * 0.7); }, numDofs);
+
+	// Residual and Jacobian
+	std::vector<double> resGen(numDofs, 0.0);
+	std::vector<double> resSpec(numDofs, 0.0);
+	grmGen->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), resGen.data(), nullptr, nullptr, 0u);
+	grmSpec->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), resSpec.data(), nullptr, nullptr, 0u);
+
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(resSpec[i] == Approx(resGen[i]));
+
+	std::vector<double> dir(numDofs);
+	std::vector<double> colA(numDofs);
+	std::vector<double> colB(numDofs);
+	compareJacobian(grmGen, grmSpec, dir.data(), colA.data(), colB.data());
+
+	// Time-discretized linear system
+	std::vector<double> weight(numDofs, 1.0);
+	std::vector<double> rhsGen = resGen;
+	std::vector<double> rhsSpec = resGen;
+	REQUIRE(grmGen->linearSolve(0.0, 1.0, 1.5, 1e-10, rhsGen.data(), weight.data(), y.data(), yDot.data(), resGen.data()) == 0);
+	REQUIRE(grmSpec->linearSolve(0.0, 1.0, 1.5, 1e-10, rhsSpec.data(), weight.data(), y.data(), yDot.data(), resSpec.data()) == 0);
+
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(rhsSpec[i] == Approx(rhsGen[i]));
+
+	mb->destroyUnitOperation(grmGen);
+	mb->destroyUnitOperation(grmSpec);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel specialized particle kernels match generic kernels", "[GRM],[UnitOp],[Residual],[Jacobian]")
+{
+	SECTION("Linear binding with 1 component")
+	{
+		cadet::JsonParameterProvider jpp = createLinearBenchmark(true);
+		jpp.pushScope("model");
+		jpp.pushScope("unit_000");
+		jpp.pushScope("discretization");
+		jpp.set("NCOL", 16);
+		jpp.popScope();
+		testSpecializedKernels(jpp);
+	}
+
+	SECTION("Linear binding with 2 components")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithLinear();
+		testSpecializedKernels(jpp);
+	}
+
+	SECTION("SMA binding with 4 components")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithSMA();
+		testSpecializedKernels(jpp);
+	}
+}
+
+TEST_CASE("GeneralRateModel specialized particle kernels throughput", "[GRM],[UnitOp],[Residual],[Benchmark],[.]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	const auto benchmark = [&](const char* name, cadet::JsonParameterProvider& jpp)
+	{
+		jpp.pushScope("model");
+		jpp.pushScope("unit_000");
+
+		jpp.pushScope("discretization");
+		jpp.set("NCOL", 128);
+		jpp.set("NPAR", 16);
+		jpp.popScope();
+
+		setSpecializedKernels(jpp, false);
+		cadet::model::GeneralRateModel* const grmGen = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+		setSpecializedKernels(jpp, true);
+		cadet::model::GeneralRateModel* const grmSpec = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+		grmGen->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+		grmSpec->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+		std::vector<double> y;
+		fillStateWithBoundSalt(y, grmGen, 128, 16);
+		std::vector<double> yDot(y.size(), 0.0);
+		std::vector<double> res(y.size(), 0.0);
+
+		const unsigned int reps = 50;
+		const auto timePerEval = [&](cadet::model::GeneralRateModel* grm) -> double
+		{
+			const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			for (unsigned int r = 0; r < reps; ++r)
+				grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), nullptr, nullptr, 0u);
+			const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+		};
+
+		const double tGen = timePerEval(grmGen);
+		const double tSpec = timePerEval(grmSpec);
+
+		std::cout << "  " << name << " (" << grmGen->numComponents() << " components): generic " << tGen << " specialized " << tSpec << "\n";
+		CHECK(std::isfinite(res[0]));
+
+		mb->destroyUnitOperation(grmGen);
+		mb->destroyUnitOperation(grmSpec);
+	};
+
+	std::cout << "GRM residual with analytic Jacobian (128 x 16 shells) [us/eval]\n";
+
+	cadet::JsonParameterProvider jppLWE = createLWE();
+	benchmark("LWE", jppLWE);
+
+	cadet::JsonParameterProvider jppLin = createLinearBenchmark(true);
+	benchmark("Linear", jppLin);
+
+	destroyModelBuilder(mb);
+}
+
+/**
+ * @brief Checks the AD Jacobian computed by direction plane sweeps against the one computed by AD vectors
+ * @details Both Jacobians and residuals are compared for forward and backward flow.
+ * @param [in] wenoOrder WENO order
+ */
+void testAdDirectionPlanes(int wenoOrder)
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithSMA();
+
+	setAdDirectionPlanes(jpp, false);
+	cadet::model::GeneralRateModel* const grmAD = createAndConfigureGRM(*mb, jpp, wenoOrder);
+	setAdDirectionPlanes(jpp, true);
+	cadet::model::GeneralRateModel* const grmPlanes = createAndConfigureGRM(*mb, jpp, wenoOrder);
+
+	// Enable AD
+	grmAD->useAnalyticJacobian(false);
+	grmPlanes->useAnalyticJacobian(false);
+	cadet::ad::setDirections(grmAD->requiredADdirs());
+
+	const unsigned int numDofs = grmAD->numDofs();
+	std::vector<cadet::active> adResAD(numDofs);
+	std::vector<cadet::active> adYAD(numDofs);
+	std::vector<cadet::active> adResPlanes(numDofs);
+	std::vector<cadet::active> adYPlanes(numDofs);
+
+	grmAD->prepareADvectors(adResAD.data(), adYAD.data(), 0);
+	grmPlanes->prepareADvectors(adResPlanes.data(), adYPlanes.data(), 0);
+
+	// Obtain memory for state, Jacobian multiply direction, Jacobian column
+	std::vector<double> y;
+	jpp.pushScope("discretization");
+	fillStateWithBoundSalt(y, grmAD, jpp.getInt("NCOL"), jpp.getInt("NPAR"));
+	jpp.popScope();
+
+	std::vector<double> yDot(numDofs, 0.0);
+	fillState(yDot.data(), [](unsigned int idx) { return std::cos(idx * 0.27); }, numDofs);
+
+	std::vector<double> resAD(numDofs, 0.0);
+	std::vector<double> resPlanes(numDofs, 0.0);
+	std::vector<double> jacDir(numDofs, 0.0);
+	std::vector<double> jacCol1(numDofs, 0.0);
+	std::vector<double> jacCol2(numDofs, 0.0);
+
+	const auto compare = [&]()
+	{
+		grmAD->notifyDiscontinuousSectionTransition(0.0, 0u, adResAD.data(), adYAD.data(), 0u);
+		grmPlanes->notifyDiscontinuousSectionTransition(0.0, 0u, adResPlanes.data(), adYPlanes.data(), 0u);
+
+		grmAD->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), resAD.data(), adResAD.data(), adYAD.data(), 0u);
+		grmPlanes->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), resPlanes.data(), adResPlanes.data(), adYPlanes.data(), 0u);
+
+		for (unsigned int i = 0; i < numDofs; ++i)
+			CHECK(resAD[i] == Approx(resPlanes[i]));
+
+		compareJacobian(grmAD, grmPlanes, jacDir.data(), jacCol1.data(), jacCol2.data());
+	};
+
+	SECTION("Forward flow (WENO=" + std::to_string(wenoOrder) + ")")
+	{
+		compare();
+	}
+
+	SECTION("Backward flow (WENO=" + std::to_string(wenoOrder) + ")")
+	{
+		const cadet::ParameterId velocity = cadet::makeParamId(cadet::hashString("VELOCITY"), 0, cadet::CompIndep, cadet::BoundPhaseIndep, cadet::ReactionIndep, cadet::SectionIndep);
+		REQUIRE(grmAD->setParameter(velocity, -jpp.getDouble("VELOCITY")));
+		REQUIRE(grmPlanes->setParameter(velocity, -jpp.getDouble("VELOCITY")));
+		compare();
+	}
+
+	mb->destroyUnitOperation(grmAD);
+	mb->destroyUnitOperation(grmPlanes);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel AD Jacobian by direction planes matches AD vectors", "[GRM],[UnitOp],[Residual],[Jacobian],[AD]")
+{
+	for (int i = 1; i <= cadet::Weno::maxOrder(); ++i)
+		testAdDirectionPlanes(i);
+}
+
+TEST_CASE("GeneralRateModel AD Jacobian by direction planes throughput", "[GRM],[UnitOp],[Residual],[Jacobian],[AD],[Benchmark],[.]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithSMA();
+	jpp.pushScope("discretization");
+	jpp.set("NCOL", 128);
+	jpp.set("NPAR", 16);
+	jpp.popScope();
+
+	cadet::model::GeneralRateModel* const grmAna = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+	setAdDirectionPlanes(jpp, false);
+	cadet::model::GeneralRateModel* const grmAD = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+	setAdDirectionPlanes(jpp, true);
+	cadet::model::GeneralRateModel* const grmPlanes = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	grmAD->useAnalyticJacobian(false);
+	grmPlanes->useAnalyticJacobian(false);
+	cadet::ad::setDirections(grmAD->requiredADdirs());
+
+	const unsigned int numDofs = grmAD->numDofs();
+	std::vector<cadet::active> adRes(numDofs);
+	std::vector<cadet::active> adY(numDofs);
+
+	std::vector<double> y;
+	fillStateWithBoundSalt(y, grmAD, 128, 16);
+	std::vector<double> yDot(numDofs, 0.0);
+	std::vector<double> res(numDofs, 0.0);
+
+	const unsigned int reps = 20;
+	const auto timePerEval = [&](cadet::model::GeneralRateModel* grm) -> double
+	{
+		grm->prepareADvectors(adRes.data(), adY.data(), 0);
+		grm->notifyDiscontinuousSectionTransition(0.0, 0u, adRes.data(), adY.data(), 0u);
+
+		const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned int r = 0; r < reps; ++r)
+			grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), adRes.data(), adY.data(), 0u);
+		const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+	};
+
+	const double tAna = timePerEval(grmAna);
+	const double tAD = timePerEval(grmAD);
+	const double tPlanes = timePerEval(grmPlanes);
+
+	std::cout << "GRM residual with Jacobian, SMA (128 x 16 shells, " << cadet::ad::getDirections() << " AD directions, "
+		<< sizeof(cadet::active) << " bytes per active) [us/eval]\n";
+	std::cout << "  analytic " << tAna << " AD vectors " << tAD << " direction planes " << tPlanes << "\n";
+	CHECK(std::isfinite(res[0]));
+
+	mb->destroyUnitOperation(grmAna);
+	mb->destroyUnitOperation(grmAD);
+	mb->destroyUnitOperation(grmPlanes);
+	destroyModelBuilder(mb);
+}
+
+/**
+ * @brief Checks that the residual of a linear model equals the product of its Jacobian with the state
+ * @details Uses first order WENO (i.e., upwind) such that the residual is linear in the state. This checks
+ *          the task decomposition of the residual (bulk per component and particle blocks with their
+ *          flux equations) against the independently assembled Jacobian.
+ * @param [in] nCol Number of column cells
+ */
+void testResidualTaskDecomposition(unsigned int nCol)
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createGRMwithLinear();
+	jpp.pushScope("discretization");
+	jpp.set("NCOL", static_cast<int>(nCol));
+	jpp.popScope();
+
+	cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, 1);
+	grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+	const unsigned int numDofs = grm->numDofs();
+	std::vector<double> y(numDofs);
+	fillState(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, numDofs);
+
+	std::vector<double> res(numDofs, 0.0);
+	std::vector<double> jacTimesY(numDofs, 0.0);
+	grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), nullptr, res.data(), nullptr, nullptr, 0u);
+	grm->multiplyWithJacobian(y.data(), jacTimesY.data());
+
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(res[i] == Approx(jacTimesY[i]));
+
+	mb->destroyUnitOperation(grm);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel residual task decomposition matches Jacobian", "[GRM],[UnitOp],[Residual],[Jacobian]")
+{
+	SECTION("One particle block per task")
+	{
+		testResidualTaskDecomposition(8);
+	}
+
+	SECTION("Several particle blocks per task")
+	{
+		// Exceeds the maximum number of particle tasks and is not a multiple of the number of cells per task
+		testResidualTaskDecomposition(131);
+	}
+}
+
+TEST_CASE("GeneralRateModel parallel residual throughput", "[GRM],[UnitOp],[Residual],[Benchmark],[.]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createLWE();
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+
+	const int nCols[] = {8, 32, 128};
+	std::cout << "GRM residual with analytic Jacobian (LWE, 16 shells) [us/eval]\n";
+	for (int nCol : nCols)
+	{
+		jpp.pushScope("discretization");
+		jpp.set("NCOL", nCol);
+		jpp.set("NPAR", 16);
+		jpp.popScope();
+
+		cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+		grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+		std::vector<double> y;
+		fillStateWithBoundSalt(y, grm, nCol, 16);
+		std::vector<double> yDot(y.size(), 0.0);
+		std::vector<double> res(y.size(), 0.0);
+
+		const unsigned int reps = 50;
+		const auto timePerEval = [&]() -> double
+		{
+			const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			for (unsigned int r = 0; r < reps; ++r)
+				grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), nullptr, nullptr, 0u);
+			const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+		};
+
+		std::cout << "  NCOL = " << nCol << ":";
+#ifdef CADET_PARALLELIZE
+		// Speedup of the residual with respect to the number of threads
+		double tSerial = 0.0;
+		for (unsigned int nThreads = 1; nThreads <= std::max(std::thread::hardware_concurrency(), 1u); nThreads *= 2)
+		{
+			tbb::task_arena arena(nThreads);
+			double t = 0.0;
+			arena.execute([&]() { t = timePerEval(); });
+			if (nThreads == 1)
+				tSerial = t;
+
+			std::cout << " " << nThreads << " threads " << t << " (speedup " << tSerial / t << ")";
+		}
+#else
+		std::cout << " serial " << timePerEval();
+#endif
+		std::cout << "\n";
+		CHECK(std::isfinite(res[0]));
+
+		mb->destroyUnitOperation(grm);
+	}
+
+	destroyModelBuilder(mb);
+}
+
+/**
+ * @brief Checks the Jacobian reuse policy of the linear solver against a model that always factorizes
+ * @param [in] jpp Configuration of the GRM
+ */
+void testJacobianReuse(cadet::JsonParameterProvider& jpp)
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	setJacobianReuseTol(jpp, 0.0);
+	cadet::model::GeneralRateModel* const grmRef = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+	setJacobianReuseTol(jpp, 0.1);
+	cadet::model::GeneralRateModel* const grmReuse = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+
+	grmRef->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+	grmReuse->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+	const unsigned int nComp = grmRef->numComponents();
+	const unsigned int numDofs = grmRef->numDofs();
+	std::vector<double> y(numDofs);
+	fillState(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, numDofs);
+	std::vector<double> yDot(numDofs);
+	fillState(yDot.data(), [](unsigned int idx) { return 0.1 * std::cos(idx * 0.7); }, numDofs);
+	std::vector<double> res(numDofs, 0.0);
+	std::vector<double> weight(numDofs, 1.0);
+
+	// Evaluates the Jacobian in both models and solves the linear system with the residual as right hand side
+	std::vector<double> rhsRef(numDofs);
+	std::vector<double> rhsReuse(numDofs);
+	const auto solve = [&](double alpha)
+	{
+		grmRef->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), nullptr, nullptr, 0u);
+		grmReuse->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), nullptr, nullptr, 0u);
+
+		rhsRef = res;
+		rhsReuse = res;
+		REQUIRE(grmRef->linearSolve(0.0, 1.0, alpha, 1e-10, rhsRef.data(), weight.data(), y.data(), yDot.data(), res.data()) == 0);
+		REQUIRE(grmReuse->linearSolve(0.0, 1.0, alpha, 1e-10, rhsReuse.data(), weight.data(), y.data(), yDot.data(), res.data()) == 0);
+	};
+
+	// First solve always factorizes
+	solve(1.0);
+	const std::vector<double> solFirst = rhsRef;
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(rhsReuse[i] == Approx(rhsRef[i]));
+
+	CHECK(grmReuse->numJacobianFactorizations() == 1);
+	CHECK(grmReuse->numJacobianReuses() == 0);
+
+	// Small change of alpha reuses the factorization and scales the solution (except for inlet DOFs)
+	solve(1.05);
+	const double factor = 2.0 / (1.0 + 1.05);
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(rhsReuse[i] == Approx((i < nComp) ? solFirst[i] : factor * solFirst[i]));
+
+	CHECK(grmReuse->numJacobianFactorizations() == 1);
+	CHECK(grmReuse->numJacobianReuses() == 1);
+
+	// Large change of alpha triggers a new factorization
+	solve(2.0);
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(rhsReuse[i] == Approx(rhsRef[i]));
+
+	CHECK(grmReuse->numJacobianFactorizations() == 2);
+	CHECK(grmReuse->numJacobianReuses() == 1);
+
+	// Factorizations are not reused across discontinuous section transitions
+	grmReuse->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+	solve(2.0);
+	CHECK(grmReuse->numJacobianFactorizations() == 3);
+	CHECK(grmReuse->numJacobianReuses() == 1);
+
+	// Without reuse, every updated Jacobian is factorized
+	CHECK(grmRef->numJacobianFactorizations() == 4);
+	CHECK(grmRef->numJacobianReuses() == 0);
+
+	mb->destroyUnitOperation(grmRef);
+	mb->destroyUnitOperation(grmReuse);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel linear solver reuses Jacobian factorization for small changes of alpha", "[GRM],[UnitOp],[Jacobian]")
+{
+	SECTION("Sparse solver")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithLinear();
+		setLinearSolver(jpp, "SPARSE", "GMRES");
+		testJacobianReuse(jpp);
+	}
+
+	SECTION("Schur-complement solver")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithLinear();
+		setLinearSolver(jpp, "SCHUR", "DIRECT");
+		testJacobianReuse(jpp);
+	}
+}
+
+/**
+ * @brief Checks the transposed Jacobian products and the transposed linear solve against their forward counterparts
+ * @details Uses the identity @f$ \left\langle u, Av \right\rangle = \left\langle A^T u, v \right\rangle @f$. The forward
+ *          linear solver is checked after the transposed solve since both share the sparse factorization.
+ * @param [in] jpp Configuration of the GRM
+ */
+void testTransposedJacobian(cadet::JsonParameterProvider& jpp)
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+	grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+	const unsigned int numDofs = grm->numDofs();
+	std::vector<double> y(numDofs);
+	fillState(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, numDofs);
+	std::vector<double> yDot(numDofs);
+	fillState(yDot.data(), [](unsigned int idx) { return 0.1 * std::cos(idx * 0.7); }, numDofs);
+	std::vector<double> res(numDofs, 0.0);
+	grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), nullptr, nullptr, 0u);
+
+	std::vector<double> u(numDofs);
+	fillState(u.data(), [](unsigned int idx) { return std::sin(idx * 0.31 + 0.2); }, numDofs);
+	std::vector<double> v(numDofs);
+	fillState(v.data(), [](unsigned int idx) { return std::cos(idx * 0.17 - 0.4); }, numDofs);
+
+	const auto dot = [=](const std::vector<double>& a, const std::vector<double>& b)
+	{
+		double sum = 0.0;
+		for (unsigned int i = 0; i < numDofs; ++i)
+			sum += a[i] * b[i];
+		return sum;
+	};
+
+	// State Jacobian with alpha and beta
+	std::vector<double> Av(numDofs, 1.0);
+	std::vector<double> ATu(numDofs, 1.0);
+	grm->multiplyWithJacobian(v.data(), 2.0, 0.5, Av.data());
+	grm->multiplyWithJacobianTransposed(u.data(), 2.0, 0.5, ATu.data());
+
+	double sumU = 0.0;
+	double sumV = 0.0;
+	for (unsigned int i = 0; i < numDofs; ++i)
+	{
+		sumU += u[i];
+		sumV += v[i];
+	}
+	CHECK(dot(u, Av) - 0.5 * sumU == Approx(dot(ATu, v) - 0.5 * sumV));
+
+	// Time derivative Jacobian
+	grm->multiplyWithDerivativeJacobian(v.data(), Av.data(), 2.0);
+	grm->multiplyWithDerivativeJacobianTransposed(u.data(), ATu.data(), 2.0);
+	CHECK(dot(u, Av) == Approx(dot(ATu, v)));
+
+	// Transposed linear system (J + alpha * M)^T x = u
+	const double alpha = 1.5;
+	std::vector<double> x = u;
+	std::vector<double> weight(numDofs, 1.0);
+	REQUIRE(grm->linearSolveTransposed(0.0, 1.0, alpha, 1e-10, x.data(), weight.data()) == 0);
+
+	std::vector<double> check(numDofs, 0.0);
+	grm->multiplyWithDerivativeJacobianTransposed(x.data(), check.data(), 1.0);
+	grm->multiplyWithJacobianTransposed(x.data(), 1.0, alpha, check.data());
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(check[i] == Approx(u[i]).margin(1e-8));
+
+	// Forward linear system (J + alpha * M) x = u still uses a valid factorization
+	x = u;
+	REQUIRE(grm->linearSolve(0.0, 1.0, alpha, 1e-10, x.data(), weight.data(), y.data(), yDot.data(), res.data()) == 0);
+
+	grm->multiplyWithDerivativeJacobian(x.data(), check.data(), 1.0);
+	grm->multiplyWithJacobian(x.data(), 1.0, alpha, check.data());
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(check[i] == Approx(u[i]).margin(1e-8));
+
+	// Transposed solve after forward solve refactorizes
+	x = u;
+	REQUIRE(grm->linearSolveTransposed(0.0, 1.0, alpha, 1e-10, x.data(), weight.data()) == 0);
+
+	grm->multiplyWithDerivativeJacobianTransposed(x.data(), check.data(), 1.0);
+	grm->multiplyWithJacobianTransposed(x.data(), 1.0, alpha, check.data());
+	for (unsigned int i = 0; i < numDofs; ++i)
+		CHECK(check[i] == Approx(u[i]).margin(1e-8));
+
+	mb->destroyUnitOperation(grm);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel transposed Jacobian and linear solve", "[GRM],[UnitOp],[Jacobian],[Adjoint]")
+{
+	SECTION("Sparse solver")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithLinear();
+		setLinearSolver(jpp, "SPARSE", "GMRES");
+		testTransposedJacobian(jpp);
+	}
+
+	SECTION("Schur-complement solver")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithLinear();
+		setLinearSolver(jpp, "SCHUR", "DIRECT");
+		testTransposedJacobian(jpp);
+	}
+
+	SECTION("Quasi-stationary binding")
+	{
+		cadet::JsonParameterProvider jpp = createGRMwithLinear();
+		setLinearSolver(jpp, "SPARSE", "GMRES");
+		setQuasiStationaryBinding(jpp);
+		testTransposedJacobian(jpp);
+	}
+}
+
+TEST_CASE("GeneralRateModel Jacobian reuse throughput", "[GRM],[UnitOp],[Jacobian],[Benchmark],[.]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createLWE();
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+	setLinearSolver(jpp, "SPARSE", "GMRES");
+
+	std::cout << "GRM residual and linear solve with slowly varying alpha (LWE) [ms]\n";
+
+	const double tols[] = {0.0, 0.05, 0.2};
+	for (double tol : tols)
+	{
+		setJacobianReuseTol(jpp, tol);
+		cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+		grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+		jpp.pushScope("discretization");
+		const unsigned int nCol = jpp.getInt("NCOL");
+		const unsigned int nPar = jpp.getInt("NPAR");
+		jpp.popScope();
+		std::vector<double> y;
+		fillStateWithBoundSalt(y, grm, nCol, nPar);
+		std::vector<double> yDot(y.size(), 0.0);
+		std::vector<double> res(y.size(), 0.0);
+		std::vector<double> weight(y.size(), 1.0);
+
+		// Mimic the Newton iterations of a BDF integrator whose step size changes slowly
+		const unsigned int nSolves = 200;
+		const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned int k = 0; k < nSolves; ++k)
+		{
+			const double alpha = 1e2 * (1.0 + 0.1 * std::sin(0.05 * k));
+			grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), nullptr, nullptr, 0u);
+			grm->linearSolve(0.0, 1.0, alpha, 1e-10, res.data(), weight.data(), y.data(), yDot.data(), res.data());
+		}
+		const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+		std::cout << "  JACOBIAN_REUSE_TOL = " << tol << ": " << std::chrono::duration<double, std::milli>(end - start).count()
+			<< " (" << grm->numJacobianFactorizations() << " factorizations, " << grm->numJacobianReuses() << " reuses)\n";
+		CHECK(std::isfinite(res[0]));
+
+		mb->destroyUnitOperation(grm);
+	}
+
+	destroyModelBuilder(mb);
+}
+
+/**
+ * @brief Checks that consistent initialization of all sensitivity systems at once matches initializing them one by one
+ * @details The parameter derivatives of the residual are replaced by arbitrary values since the initialization
+ *          only depends on them through the right hand side.
+ * @param [in] jpp Configuration of the GRM
+ * @param [in] lean Determines whether lean consistent initialization is used
+ */
+void testBatchedConsistentInitialSensitivity(cadet::JsonParameterProvider& jpp, bool lean)
+{
+	const unsigned int nSens = 5;
+
+	// Set AD directions before any active is created
+	cadet::ad::setDirections(cadet::ad::getMaxDirections());
+	REQUIRE(nSens <= cadet::ad::getMaxDirections());
+
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+	grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+	jpp.pushScope("discretization");
+	const unsigned int nCol = jpp.getInt("NCOL");
+	const unsigned int nPar = jpp.getInt("NPAR");
+	jpp.popScope();
+
+	// Keep concentrations away from zero to obtain well-conditioned algebraic equations
+	const unsigned int numDofs = grm->numDofs();
+	std::vector<double> y;
+	fillStateWithBoundSalt(y, grm, nCol, nPar);
+	for (unsigned int i = 0; i < numDofs; ++i)
+		y[i] += 0.1;
+	std::vector<double> yDot(numDofs, 0.0);
+	std::vector<double> res(numDofs, 0.0);
+	grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), nullptr, nullptr, 0u);
+
+	// Parameter derivatives of the residual and initial sensitivities
+	std::vector<cadet::active> adRes(numDofs);
+	std::vector<std::vector<double>> sensY(nSens, std::vector<double>(numDofs));
+	std::vector<std::vector<double>> sensYdot(nSens, std::vector<double>(numDofs, 0.0));
+	for (unsigned int d = 0; d < nSens; ++d)
+	{
+		for (unsigned int i = 0; i < numDofs; ++i)
+		{
+			adRes[i].setADValue(d, std::sin(0.37 * i + d));
+			sensY[d][i] = std::cos(0.11 * i * (d + 1));
+		}
+	}
+
+	const auto initialize = [&](std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, cadet::active const* adResPtr)
+	{
+		if (lean)
+			grm->leanConsistentInitialSensitivity(0.0, 0u, 1.0, y.data(), yDot.data(), vecSensY, vecSensYdot, adResPtr);
+		else
+			grm->consistentInitialSensitivity(0.0, 0u, 1.0, y.data(), yDot.data(), vecSensY, vecSensYdot, adResPtr);
+	};
+
+	// Initialize each sensitivity system on its own using the first AD direction
+	std::vector<std::vector<double>> sensYsingle = sensY;
+	std::vector<std::vector<double>> sensYdotSingle = sensYdot;
+	std::vector<cadet::active> adResSingle(numDofs);
+	for (unsigned int d = 0; d < nSens; ++d)
+	{
+		for (unsigned int i = 0; i < numDofs; ++i)
+			adResSingle[i].setADValue(0, adRes[i].getADValue(d));
+
+		std::vector<double*> vecSensY(1, sensYsingle[d].data());
+		std::vector<double*> vecSensYdot(1, sensYdotSingle[d].data());
+		initialize(vecSensY, vecSensYdot, adResSingle.data());
+	}
+
+	// Initialize all sensitivity systems at once
+	std::vector<double*> vecSensY(nSens);
+	std::vector<double*> vecSensYdot(nSens);
+	for (unsigned int d = 0; d < nSens; ++d)
+	{
+		vecSensY[d] = sensY[d].data();
+		vecSensYdot[d] = sensYdot[d].data();
+	}
+	initialize(vecSensY, vecSensYdot, adRes.data());
+
+	for (unsigned int d = 0; d < nSens; ++d)
+	{
+		for (unsigned int i = 0; i < numDofs; ++i)
+		{
+			CHECK(sensY[d][i] == Approx(sensYsingle[d][i]));
+			CHECK(sensYdot[d][i] == Approx(sensYdotSingle[d][i]));
+		}
+	}
+
+	mb->destroyUnitOperation(grm);
+	destroyModelBuilder(mb);
+}
+
+TEST_CASE("GeneralRateModel batched consistent initialization of sensitivities", "[GRM],[UnitOp],[ConsistentInit],[Sensitivity]")
+{
+	for (int lean = 0; lean < 2; ++lean)
+	{
+		SECTION(lean ? "Lean" : "Full")
+		{
+			SECTION("Kinetic SMA binding")
+			{
+				cadet::JsonParameterProvider jpp = createGRMwithSMA();
+				testBatchedConsistentInitialSensitivity(jpp, lean);
+			}
+
+			SECTION("Quasi-stationary SMA binding")
+			{
+				cadet::JsonParameterProvider jpp = createGRMwithSMA();
+				setQuasiStationaryBinding(jpp);
+				testBatchedConsistentInitialSensitivity(jpp, lean);
+			}
+		}
+	}
+}
+
+TEST_CASE("GeneralRateModel batched consistent initialization of sensitivities throughput", "[GRM],[UnitOp],[ConsistentInit],[Sensitivity],[Benchmark],[.]")
+{
+	cadet::ad::setDirections(cadet::ad::getMaxDirections());
+
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createLWE();
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+	setQuasiStationaryBinding(jpp);
+
+	cadet::model::GeneralRateModel* const grm = createAndConfigureGRM(*mb, jpp, cadet::Weno::maxOrder());
+	grm->notifyDiscontinuousSectionTransition(0.0, 0u, nullptr, nullptr, 0u);
+
+	jpp.pushScope("discretization");
+	const unsigned int nCol = jpp.getInt("NCOL");
+	const unsigned int nPar = jpp.getInt("NPAR");
+	jpp.popScope();
+
+	const unsigned int numDofs = grm->numDofs();
+	std::vector<double> y;
+	fillStateWithBoundSalt(y, grm, nCol, nPar);
+	std::vector<double> yDot(numDofs, 0.0);
+	std::vector<double> res(numDofs, 0.0);
+	grm->residualWithJacobian(0.0, 0u, 1.0, y.data(), yDot.data(), res.data(), nullptr, nullptr, 0u);
+
+	std::vector<cadet::active> adRes(numDofs);
+	for (unsigned int i = 0; i < numDofs; ++i)
+	{
+		for (unsigned int d = 0; d < cadet::ad::getMaxDirections(); ++d)
+			adRes[i].setADValue(d, std::sin(0.37 * i + d));
+	}
+
+	std::cout << "GRM consistent initialization of sensitivities (LWE) [ms]\n";
+
+	const unsigned int nSensMax = std::min(30u, static_cast<unsigned int>(cadet::ad::getMaxDirections()));
+	for (unsigned int nSens : {1u, 10u, nSensMax})
+	{
+		std::vector<std::vector<double>> sensY(nSens, std::vector<double>(numDofs, 0.0));
+		std::vector<std::vector<double>> sensYdot(nSens, std::vector<double>(numDofs, 0.0));
+		std::vector<double*> vecSensY(nSens);
+		std::vector<double*> vecSensYdot(nSens);
+		for (unsigned int d = 0; d < nSens; ++d)
+		{
+			vecSensY[d] = sensY[d].data();
+			vecSensYdot[d] = sensYdot[d].data();
+		}
+
+		// One call per sensitivity system as opposed to one call for all of them
+		const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned int d = 0; d < nSens; ++d)
+		{
+			std::vector<double*> single(1, vecSensY[d]);
+			std::vector<double*> singleDot(1, vecSensYdot[d]);
+			grm->consistentInitialSensitivity(0.0, 0u, 1.0, y.data(), yDot.data(), single, singleDot, adRes.data());
+		}
+		const std::chrono::high_resolution_clock::time_point mid = std::chrono::high_resolution_clock::now();
+		grm->consistentInitialSensitivity(0.0, 0u, 1.0, y.data(), yDot.data(), vecSensY, vecSensYdot, adRes.data());
+		const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+		std::cout << "  " << nSens << " sensitivities: one by one " << std::chrono::duration<double, std::milli>(mid - start).count()
+			<< " batched " << std::chrono::duration<double, std::milli>(end - mid).count() << "\n";
+		CHECK(std::isfinite(sensYdot[0][0]));
+	}
+
+	mb->destroyUnitOperation(grm);
+	destroyModelBuilder(mb);
+}
@@ -17,13 +17,18 @@
 #include "Logging.hpp"
 
 #include "ModelBuilderImpl.hpp"
+
+#include <json.hpp>
+#define CADETTEST_JSONPARAMETERPROVIDER_NOFORWARD
 #include "JsonParameterProvider.hpp"
 #include "common/Driver.hpp"
 #include "Weno.hpp"
 
 #include <cmath>
+#include <algorithm>
 #include <functional>
 #include <cstdio>
+#include <iostream>
 
 namespace
 {
@@ -199,6 +204,195 @@ void testAnalyticBenchmark(bool forwardFlow, bool dynamicBinding)
 	}
 }
 
+void testSparseVsSchur(bool forwardFlow)
+{
+	SECTION(std::string("Sparse vs Schur solver with ") + (forwardFlow ? "forward" : "backward") + " flow")
+	{
+		// Use Load-Wash-Elution test case
+		cadet::JsonParameterProvider jpp = createLWE();
+		if (!forwardFlow)
+			reverseFlow(jpp);
+
+		cadet::Driver drvSchur;
+		drvSchur.configure(jpp);
+		drvSchur.run();
+
+		jpp.pushScope("model");
+		jpp.pushScope("unit_000");
+		jpp.pushScope("discretization");
+		jpp.set("LINEAR_SOLVER", std::string("SPARSE"));
+		jpp.popScope();
+		jpp.popScope();
+		jpp.popScope();
+
+		cadet::Driver drvSparse;
+		drvSparse.configure(jpp);
+		drvSparse.run();
+
+		cadet::InternalStorageUnitOpRecorder const* const schurData = drvSchur.solution()->unitOperation(0);
+		cadet::InternalStorageUnitOpRecorder const* const sparseData = drvSparse.solution()->unitOperation(0);
+		REQUIRE(schurData->numDataPoints() == sparseData->numDataPoints());
+
+		double const* schurOutlet = (forwardFlow ? schurData->outlet() : schurData->inlet());
+		double const* sparseOutlet = (forwardFlow ? sparseData->outlet() : sparseData->inlet());
+
+		for (unsigned int i = 0; i < schurData->numDataPoints() * schurData->numComponents(); ++i, ++schurOutlet, ++sparseOutlet)
+		{
+			// Compare with relative error 1e-6 and absolute error 1e-9
+			CHECK((*sparseOutlet) == makeApprox(*schurOutlet, 1e-6, 1e-9));
+		}
+	}
+}
+
+/**
+ * @brief Enables or disables dense output in a configuration
+ * @param [in,out] jpp ParameterProvider to change the dense output setting in
+ * @param [in] enabled Determines whether dense output is enabled
+ */
+void setDenseOutput(cadet::JsonParameterProvider& jpp, bool enabled)
+{
+	jpp.pushScope("solver");
+	jpp.set("USE_DENSE_OUTPUT", enabled);
+	jpp.popScope();
+}
+
+/**
+ * @brief Sets the cyclic steady state mode in a configuration
+ * @param [in,out] jpp ParameterProvider to change the cyclic steady state settings in
+ * @param [in] maxCycles Maximum number of cycles
+ * @param [in] depth History depth of the Anderson acceleration
+ */
+void setCyclicSteadyState(cadet::JsonParameterProvider& jpp, int maxCycles, int depth)
+{
+	jpp.pushScope("solver");
+	jpp.set("CSS_MAX_CYCLES", maxCycles);
+	jpp.set("CSS_TOL", 1.0);
+	jpp.set("CSS_ANDERSON_DEPTH", depth);
+	jpp.popScope();
+}
+
+/**
+ * @brief Adds sensitivities with respect to column dispersion and SMA_KA of the first protein to a configuration
+ * @param [in,out] jpp ParameterProvider to add the sensitivities to
+ * @param [in] method Method used for computing sensitivities (@c ad1 or @c adjoint)
+ */
+void setSensitivities(cadet::JsonParameterProvider& jpp, const std::string& method)
+{
+	nlohmann::json sens;
+	sens["NSENS"] = 2;
+	sens["SENS_METHOD"] = method;
+
+	const char* const names[] = {"COL_DISPERSION", "SMA_KA"};
+	const int comps[] = {-1, 1};
+	const int boundPhases[] = {-1, 0};
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		nlohmann::json param;
+		param["SENS_NAME"] = {names[i]};
+		param["SENS_UNIT"] = {0};
+		param["SENS_COMP"] = {comps[i]};
+		param["SENS_BOUNDPHASE"] = {boundPhases[i]};
+		param["SENS_REACTION"] = {-1};
+		param["SENS_SECTION"] = {-1};
+		param["SENS_ABSTOL"] = 1e-6;
+
+		sens["param_00" + std::to_string(i)] = param;
+	}
+
+	// Least squares distance of all proteins at the outlet to zero
+	nlohmann::json adj;
+	adj["UNIT"] = 0;
+	adj["WEIGHTS"] = {0.0, 1.0, 1.0, 1.0};
+	adj["TIME"] = {0.0};
+	adj["REFERENCE"] = {0.0, 0.0, 0.0, 0.0};
+	sens["adjoint"] = adj;
+
+	nlohmann::json& root = *jpp.data();
+	root["sensitivity"] = sens;
+	root["return"]["unit_000"]["WRITE_SENS_COLUMN_OUTLET"] = true;
+}
+
+/**
+ * @brief Enables checkpoints in a configuration
+ * @param [in,out] jpp ParameterProvider to change the checkpoint settings in
+ * @param [in] interval Minimum time between two checkpoints
+ * @param [in] fileName Name of the checkpoint file
+ */
+void setCheckpoints(cadet::JsonParameterProvider& jpp, double interval, const std::string& fileName)
+{
+	jpp.pushScope("solver");
+	jpp.set("CHECKPOINT_INTERVAL", interval);
+	jpp.set("CHECKPOINT_FILE", fileName);
+	jpp.popScope();
+}
+
+/**
+ * @brief Adds a stop condition to a configuration
+ * @param [in,out] jpp ParameterProvider to add the stop condition to
+ * @param [in] type Monitored quantity (@c OUTLET, @c BOUND_MASS, or @c SECTION_TIME)
+ * @param [in] comp Index of the monitored component of the GRM unit operation
+ * @param [in] threshold Value of the monitored quantity at which the condition is hit
+ * @param [in] action Action taken when the condition is hit (@c STOP or @c NEXT_SECTION)
+ */
+void addStopCondition(cadet::JsonParameterProvider& jpp, const std::string& type, int comp, double threshold, const std::string& action)
+{
+	nlohmann::json& stop = (*jpp.data())["solver"]["stop_conditions"];
+	const int idx = stop.count("NCONDITIONS") ? stop["NCONDITIONS"].get<int>() : 0;
+
+	nlohmann::json cond;
+	cond["TYPE"] = type;
+	cond["UNIT"] = 0;
+	cond["COMP"] = comp;
+	cond["THRESHOLD"] = threshold;
+	cond["DIRECTION"] = 1;
+	cond["ACTION"] = action;
+
+	stop["cond_00" + std::to_string(idx)] = cond;
+	stop["NCONDITIONS"] = idx + 1;
+}
+
+void testDenseOutput(bool forwardFlow)
+{
+	SECTION(std::string("Dense output with ") + (forwardFlow ? "forward" : "backward") + " flow")
+	{
+		// Use Load-Wash-Elution test case
+		cadet::JsonParameterProvider jpp = createLWE();
+		if (!forwardFlow)
+			reverseFlow(jpp);
+
+		cadet::Driver drvStop;
+		drvStop.configure(jpp);
+		drvStop.run();
+
+		setDenseOutput(jpp, true);
+
+		cadet::Driver drvDense;
+		drvDense.configure(jpp);
+		drvDense.run();
+
+		cadet::InternalStorageUnitOpRecorder const* const stopData = drvStop.solution()->unitOperation(0);
+		cadet::InternalStorageUnitOpRecorder const* const denseData = drvDense.solution()->unitOperation(0);
+		REQUIRE(stopData->numDataPoints() == denseData->numDataPoints());
+
+		// Dense output does not force the integrator to stop at the solution times
+		CHECK(drvDense.simulator()->lastNumTimeSteps() <= drvStop.simulator()->lastNumTimeSteps());
+
+		double const* stopTime = drvStop.solution()->time();
+		double const* denseTime = drvDense.solution()->time();
+		for (unsigned int i = 0; i < stopData->numDataPoints(); ++i)
+			CHECK(stopTime[i] == denseTime[i]);
+
+		double const* stopOutlet = (forwardFlow ? stopData->outlet() : stopData->inlet());
+		double const* denseOutlet = (forwardFlow ? denseData->outlet() : denseData->inlet());
+
+		for (unsigned int i = 0; i < stopData->numDataPoints() * stopData->numComponents(); ++i, ++stopOutlet, ++denseOutlet)
+		{
+			// Both solutions are accurate up to the integrator tolerance
+			CHECK((*denseOutlet) == makeApprox(*stopOutlet, 1e-5, 5e-5));
+		}
+	}
+}
+
 TEST_CASE("LWE forward vs backward flow", "[GRM],[Simulation]")
 {
 	// Test all WENO orders
@@ -213,3 +407,426 @@ TEST_CASE("GRM linear pulse vs analytic solution", "[GRM],[Simulation],[Analytic
 	testAnalyticBenchmark(false, true);
 	testAnalyticBenchmark(false, false);
 }
+
+TEST_CASE("LWE sparse vs Schur linear solver", "[GRM],[Simulation],[SparseMatrix]")
+{
+	testSparseVsSchur(true);
+	testSparseVsSchur(false);
+}
+
+TEST_CASE("LWE dense output vs stopping at solution times", "[GRM],[Simulation],[DenseOutput]")
+{
+	testDenseOutput(true);
+	testDenseOutput(false);
+}
+
+TEST_CASE("LWE dense output on fine solution time grid", "[GRM],[Simulation],[DenseOutput],[Benchmark],[.]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+
+	// Replace solution times by a grid of 5000 points
+	jpp.pushScope("solver");
+	const std::vector<double> coarseTimes = jpp.getDoubleArray("USER_SOLUTION_TIMES");
+	std::vector<double> solTimes(5000, 0.0);
+	for (unsigned int i = 0; i < solTimes.size(); ++i)
+		solTimes[i] = coarseTimes.back() * static_cast<double>(i) / static_cast<double>(solTimes.size() - 1);
+	jpp.set("USER_SOLUTION_TIMES", solTimes);
+	jpp.popScope();
+
+	cadet::Driver drvStop;
+	drvStop.configure(jpp);
+	drvStop.run();
+
+	setDenseOutput(jpp, true);
+
+	cadet::Driver drvDense;
+	drvDense.configure(jpp);
+	drvDense.run();
+
+	std::cout << "LWE with " << solTimes.size() << " solution times\n";
+	std::cout << "  stop at solution times: " << drvStop.simulator()->lastNumTimeSteps() << " steps, " << drvStop.simulator()->lastSimulationDuration() << " s\n";
+	std::cout << "  dense output: " << drvDense.simulator()->lastNumTimeSteps() << " steps, " << drvDense.simulator()->lastSimulationDuration() << " s\n";
+
+	CHECK(drvDense.simulator()->lastNumTimeSteps() < drvStop.simulator()->lastNumTimeSteps());
+}
+
+TEST_CASE("LWE cyclic steady state with and without Anderson acceleration", "[GRM],[Simulation],[CSS]")
+{
+	// Repeat the Load-Wash-Elution cycle until the column state is periodic
+	cadet::JsonParameterProvider jpp = createLWE();
+	setCyclicSteadyState(jpp, 50, 0);
+
+	cadet::Driver drvPlain;
+	drvPlain.configure(jpp);
+	drvPlain.run();
+
+	setCyclicSteadyState(jpp, 50, 5);
+
+	cadet::Driver drvAccel;
+	drvAccel.configure(jpp);
+	drvAccel.run();
+
+	CHECK(drvPlain.simulator()->lastCyclicSteadyStateError() <= 1.0);
+	CHECK(drvAccel.simulator()->lastCyclicSteadyStateError() <= 1.0);
+	CHECK(drvAccel.simulator()->lastNumCycles() <= drvPlain.simulator()->lastNumCycles());
+
+	// Only the final cycle is recorded
+	cadet::InternalStorageUnitOpRecorder const* const plainData = drvPlain.solution()->unitOperation(0);
+	cadet::InternalStorageUnitOpRecorder const* const accelData = drvAccel.solution()->unitOperation(0);
+	REQUIRE(plainData->numDataPoints() == accelData->numDataPoints());
+
+	double const* plainOutlet = plainData->outlet();
+	double const* accelOutlet = accelData->outlet();
+	for (unsigned int i = 0; i < plainData->numDataPoints() * plainData->numComponents(); ++i, ++plainOutlet, ++accelOutlet)
+	{
+		// Both cyclic steady states agree up to the tolerance
+		CHECK((*accelOutlet) == makeApprox(*plainOutlet, 1e-4, 5e-4));
+	}
+}
+
+TEST_CASE("Carousel cyclic steady state matches plain cycling", "[GRM],[Simulation],[CSS]")
+{
+	// Cycle the two-column carousel until its state is periodic
+	cadet::JsonParameterProvider jpp = createCarousel(1);
+	setCyclicSteadyState(jpp, 200, 0);
+
+	cadet::Driver drvPlain;
+	drvPlain.configure(jpp);
+	drvPlain.run();
+
+	setCyclicSteadyState(jpp, 200, 5);
+
+	cadet::Driver drvAccel;
+	drvAccel.configure(jpp);
+	drvAccel.run();
+
+	REQUIRE(drvPlain.simulator()->lastCyclicSteadyStateError() <= 1.0);
+	REQUIRE(drvAccel.simulator()->lastCyclicSteadyStateError() <= 1.0);
+	CHECK(drvAccel.simulator()->lastNumCycles() <= drvPlain.simulator()->lastNumCycles());
+
+	// Simulate all cycles of the fixed point iteration plus the recorded one by repeating sections and switches
+	const unsigned int numCycles = drvPlain.simulator()->lastNumCycles();
+	cadet::JsonParameterProvider jppRef = createCarousel(numCycles + 1);
+
+	cadet::Driver drvRef;
+	drvRef.configure(jppRef);
+	drvRef.run();
+
+	for (unsigned int unit = 0; unit < 2; ++unit)
+	{
+		cadet::InternalStorageUnitOpRecorder const* const plainData = drvPlain.solution()->unitOperation(unit);
+		cadet::InternalStorageUnitOpRecorder const* const accelData = drvAccel.solution()->unitOperation(unit);
+		cadet::InternalStorageUnitOpRecorder const* const refData = drvRef.solution()->unitOperation(unit);
+
+		const unsigned int numPoints = plainData->numDataPoints();
+		const unsigned int nComp = plainData->numComponents();
+		REQUIRE(accelData->numDataPoints() == numPoints);
+		REQUIRE(refData->numDataPoints() == (numCycles + 1) * (numPoints - 1) + 1);
+
+		// Compare with the last cycle of the plain simulation
+		double const* plainOutlet = plainData->outlet();
+		double const* accelOutlet = accelData->outlet();
+		double const* refOutlet = refData->outlet() + numCycles * (numPoints - 1) * nComp;
+		for (unsigned int i = 0; i < numPoints * nComp; ++i, ++plainOutlet, ++accelOutlet, ++refOutlet)
+		{
+			// Fixed point iteration reproduces the plain simulation
+			CHECK((*plainOutlet) == makeApprox(*refOutlet, 1e-6, 1e-8));
+
+			// Accelerated cyclic steady state agrees up to the tolerance
+			CHECK((*accelOutlet) == makeApprox(*refOutlet, 1e-4, 1e-6));
+		}
+	}
+}
+
+TEST_CASE("LWE adjoint gradient vs forward sensitivities", "[GRM],[Simulation],[Adjoint]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+	setSensitivities(jpp, "ad1");
+
+	cadet::Driver drvFwd;
+	drvFwd.configure(jpp);
+	drvFwd.run();
+
+	setSensitivities(jpp, "adjoint");
+
+	cadet::Driver drvAdj;
+	drvAdj.configure(jpp);
+	drvAdj.run();
+
+	unsigned int len = 0;
+	CHECK(drvFwd.simulator()->getAdjointGradient(len) == nullptr);
+	double const* const gradient = drvAdj.simulator()->getAdjointGradient(len);
+	REQUIRE(gradient);
+	REQUIRE(len == 2);
+
+	// Integrate functional and its gradient from the forward sensitivities by the trapezoidal rule
+	cadet::InternalStorageUnitOpRecorder const* const fwdData = drvFwd.solution()->unitOperation(0);
+	double const* const time = drvFwd.solution()->time();
+	const unsigned int nComp = fwdData->numComponents();
+	const double weights[] = {0.0, 1.0, 1.0, 1.0};
+
+	double objective = 0.0;
+	double fwdGradient[] = {0.0, 0.0};
+	for (unsigned int i = 1; i < fwdData->numDataPoints(); ++i)
+	{
+		const double halfDt = 0.5 * (time[i] - time[i-1]);
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+		{
+			const double cPrev = fwdData->outlet()[(i-1) * nComp + comp];
+			const double cCur = fwdData->outlet()[i * nComp + comp];
+			objective += halfDt * 0.5 * weights[comp] * (cPrev * cPrev + cCur * cCur);
+
+			for (unsigned int p = 0; p < 2; ++p)
+			{
+				double const* const sensOutlet = fwdData->sensOutlet(p);
+				fwdGradient[p] += halfDt * weights[comp] * (cPrev * sensOutlet[(i-1) * nComp + comp] + cCur * sensOutlet[i * nComp + comp]);
+			}
+		}
+	}
+
+	// Quadrature error of the trapezoidal rule dominates the difference
+	CHECK(drvAdj.simulator()->lastObjectiveValue() == makeApprox(objective, 1e-2, 1e-8));
+	for (unsigned int p = 0; p < 2; ++p)
+		CHECK(gradient[p] == makeApprox(fwdGradient[p], 1e-2, 1e-8));
+
+	// Denser checkpoints of the forward solution do not change the gradient
+	nlohmann::json& root = *jpp.data();
+	root["sensitivity"]["adjoint"]["CHECKPOINT_STEPS"] = 10;
+
+	cadet::Driver drvDense;
+	drvDense.configure(jpp);
+	drvDense.run();
+
+	double const* const denseGradient = drvDense.simulator()->getAdjointGradient(len);
+	REQUIRE(denseGradient);
+	REQUIRE(len == 2);
+	for (unsigned int p = 0; p < 2; ++p)
+		CHECK(denseGradient[p] == makeApprox(gradient[p], 1e-5, 1e-10));
+}
+
+TEST_CASE("LWE resumed from checkpoint vs uninterrupted run", "[GRM],[Simulation],[Checkpoint]")
+{
+	const std::string fileName = "LWE-resume-test.ckpt";
+
+	cadet::JsonParameterProvider jpp = createLWE();
+	setSensitivities(jpp, "ad1");
+
+	cadet::Driver drvRef;
+	drvRef.configure(jpp);
+	drvRef.run();
+
+	// Write checkpoints during a full run, the last one lies in the elution section
+	setCheckpoints(jpp, 500.0, fileName);
+
+	cadet::Driver drvCkp;
+	drvCkp.configure(jpp);
+	drvCkp.run();
+
+	cadet::Driver drvResume;
+	drvResume.configure(jpp);
+	const double tCkp = drvResume.resumeFromCheckpoint();
+	CHECK(tCkp >= 500.0);
+
+	drvResume.run();
+	drvResume.removeCheckpoint();
+
+	// Resumed run only integrates the remaining time span
+	CHECK(drvResume.simulator()->lastNumTimeSteps() < drvRef.simulator()->lastNumTimeSteps());
+
+	cadet::InternalStorageUnitOpRecorder const* const refData = drvRef.solution()->unitOperation(0);
+	cadet::InternalStorageUnitOpRecorder const* const resumeData = drvResume.solution()->unitOperation(0);
+	REQUIRE(refData->numDataPoints() == resumeData->numDataPoints());
+
+	double const* refTime = drvRef.solution()->time();
+	double const* resumeTime = drvResume.solution()->time();
+	for (unsigned int i = 0; i < refData->numDataPoints(); ++i)
+		CHECK(refTime[i] == resumeTime[i]);
+
+	for (unsigned int i = 0; i < refData->numDataPoints() * refData->numComponents(); ++i)
+	{
+		// Restarting the integrator changes the solution only up to the integrator tolerance
+		CHECK(resumeData->outlet()[i] == makeApprox(refData->outlet()[i], 1e-5, 5e-5));
+		for (unsigned int p = 0; p < 2; ++p)
+			CHECK(resumeData->sensOutlet(p)[i] == makeApprox(refData->sensOutlet(p)[i], 1e-3, 1e-5));
+	}
+}
+
+TEST_CASE("LWE streaming output rejects checkpoints", "[GRM],[Simulation],[Checkpoint]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+	setCheckpoints(jpp, 500.0, "LWE-stream-test.ckpt");
+
+	// Streamed results are not contained in checkpoints and would be lost when resuming
+	jpp.pushScope("return");
+	jpp.set("STREAM_SOLUTION", true);
+	jpp.popScope();
+
+	cadet::Driver drv;
+	CHECK_THROWS_AS(drv.configure(jpp), std::invalid_argument);
+}
+
+TEST_CASE("LWE parameter sweep with initial conditions vs fresh configuration", "[GRM],[Simulation],[Sweep]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+
+	cadet::Driver drvBase;
+	drvBase.configure(jpp);
+	drvBase.run();
+
+	cadet::Driver drvSweep;
+	drvSweep.configure(jpp);
+	drvSweep.saveInitialState(jpp);
+
+	// Change the salt concentration of the initial condition and the column dispersion
+	const cadet::ParameterId params[] = {
+		cadet::makeParamId("INIT_C", 0, 0, cadet::BoundPhaseIndep, cadet::ReactionIndep, cadet::SectionIndep),
+		cadet::makeParamId("COL_DISPERSION", 0, cadet::CompIndep, cadet::BoundPhaseIndep, cadet::ReactionIndep, cadet::SectionIndep)
+	};
+	const double variant[] = {80.0, 1e-7};
+	drvSweep.applyParameterVariant(params, variant, 2);
+	drvSweep.run();
+
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+	jpp.set("INIT_C", std::vector<double>{80.0, 0.0, 0.0, 0.0});
+	jpp.set("COL_DISPERSION", 1e-7);
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::Driver drvRef;
+	drvRef.configure(jpp);
+	drvRef.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const refData = drvRef.solution()->unitOperation(0);
+	cadet::InternalStorageUnitOpRecorder const* sweepData = drvSweep.solution()->unitOperation(0);
+	REQUIRE(refData->numDataPoints() == sweepData->numDataPoints());
+
+	for (unsigned int i = 0; i < refData->numDataPoints() * refData->numComponents(); ++i)
+		CHECK(sweepData->outlet()[i] == makeApprox(refData->outlet()[i], 1e-6, 1e-9));
+
+	// The next variant without initial conditions starts from the saved initial state again
+	const double baseVariant[] = {5.75e-8};
+	drvSweep.applyParameterVariant(params + 1, baseVariant, 1);
+	drvSweep.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const baseData = drvBase.solution()->unitOperation(0);
+	sweepData = drvSweep.solution()->unitOperation(0);
+	REQUIRE(baseData->numDataPoints() == sweepData->numDataPoints());
+
+	for (unsigned int i = 0; i < baseData->numDataPoints() * baseData->numComponents(); ++i)
+		CHECK(sweepData->outlet()[i] == makeApprox(baseData->outlet()[i], 1e-6, 1e-9));
+}
+
+TEST_CASE("LWE stopped at outlet threshold vs full run", "[GRM],[Simulation],[StopCondition]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+
+	cadet::Driver drvRef;
+	drvRef.configure(jpp);
+	drvRef.run();
+
+	// Find the first solution time at which the first protein exceeds half of its peak concentration
+	cadet::InternalStorageUnitOpRecorder const* const refData = drvRef.solution()->unitOperation(0);
+	double const* const refTime = drvRef.solution()->time();
+	const unsigned int nComp = refData->numComponents();
+
+	double peak = 0.0;
+	for (unsigned int i = 0; i < refData->numDataPoints(); ++i)
+		peak = std::max(peak, refData->outlet()[i * nComp + 1]);
+
+	const double threshold = 0.5 * peak;
+	unsigned int idxCross = 0;
+	while (refData->outlet()[idxCross * nComp + 1] < threshold)
+		++idxCross;
+	REQUIRE(idxCross > 0);
+
+	addStopCondition(jpp, "OUTLET", 1, threshold, "STOP");
+
+	cadet::Driver drvStop;
+	drvStop.configure(jpp);
+	drvStop.run();
+
+	unsigned int len = 0;
+	CHECK(drvRef.simulator()->getStopConditionHitTimes(len) == nullptr);
+
+	double const* const hitTimes = drvStop.simulator()->getStopConditionHitTimes(len);
+	REQUIRE(hitTimes);
+	REQUIRE(len == 1);
+	CHECK(drvStop.simulator()->getStopConditionHitIndices(len)[0] == 0);
+
+	// Hit time is bracketed by the solution times around the crossing of the full run
+	CHECK(hitTimes[0] >= refTime[idxCross - 1] - 1e-3);
+	CHECK(hitTimes[0] <= refTime[idxCross] + 1e-3);
+
+	// Only solution times up to the hit time are recorded
+	cadet::InternalStorageUnitOpRecorder const* const stopData = drvStop.solution()->unitOperation(0);
+	CHECK(stopData->numDataPoints() <= idxCross + 1);
+	CHECK(stopData->numDataPoints() + 1 >= idxCross);
+	CHECK(drvStop.simulator()->lastNumTimeSteps() < drvRef.simulator()->lastNumTimeSteps());
+
+	for (unsigned int i = 0; i < stopData->numDataPoints() * nComp; ++i)
+		CHECK(stopData->outlet()[i] == makeApprox(refData->outlet()[i], 1e-6, 1e-8));
+}
+
+TEST_CASE("LWE stopped at bound mass threshold", "[GRM],[Simulation],[StopCondition]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+
+	// Amount of the first protein per unit cross section area injected until the end of the load
+	const double injected = 5.75e-4 * 0.37 * 1.0 * 10.0;
+	addStopCondition(jpp, "BOUND_MASS", 1, 0.25 * injected, "STOP");
+
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	unsigned int len = 0;
+	double const* const hitTimes = drv.simulator()->getStopConditionHitTimes(len);
+	REQUIRE(hitTimes);
+	REQUIRE(len == 1);
+
+	// Bound amount cannot exceed the injected amount, which grows linearly during the load
+	CHECK(hitTimes[0] >= 2.5 - 1e-6);
+	CHECK(hitTimes[0] < 10.0);
+}
+
+TEST_CASE("LWE sections shortened by section time conditions", "[GRM],[Simulation],[StopCondition]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+	addStopCondition(jpp, "SECTION_TIME", 0, 5.5, "NEXT_SECTION");
+
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	// Each section is left 5.5s after its start, the last one ends the simulation
+	unsigned int len = 0;
+	double const* const hitTimes = drv.simulator()->getStopConditionHitTimes(len);
+	REQUIRE(hitTimes);
+	REQUIRE(len == 3);
+	CHECK(hitTimes[0] == makeApprox(5.5, 1e-6, 1e-6));
+	CHECK(hitTimes[1] == makeApprox(15.5, 1e-6, 1e-6));
+	CHECK(hitTimes[2] == makeApprox(95.5, 1e-6, 1e-6));
+
+	// All solution times are recorded
+	const unsigned int nPoints = drv.solution()->numDataPoints();
+	double const* const time = drv.solution()->time();
+	REQUIRE(nPoints == 1501);
+	for (unsigned int i = 0; i < nPoints; ++i)
+		CHECK(time[i] == static_cast<double>(i));
+
+	// State at the hit time is held over the skipped remainder of each section
+	cadet::InternalStorageUnitOpRecorder const* const data = drv.solution()->unitOperation(0);
+	const unsigned int nComp = data->numComponents();
+	double const* const outlet = data->outlet();
+	const unsigned int heldFirst[] = {6, 16, 96};
+	const unsigned int heldLast[] = {10, 90, 1500};
+	for (unsigned int s = 0; s < 3; ++s)
+	{
+		for (unsigned int i = heldFirst[s] + 1; i <= heldLast[s]; ++i)
+		{
+			for (unsigned int comp = 0; comp < nComp; ++comp)
+				CHECK(outlet[i * nComp + comp] == outlet[heldFirst[s] * nComp + comp]);
+		}
+	}
+}
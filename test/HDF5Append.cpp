@@ -0,0 +1,151 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include "io/hdf5/HDF5Writer.hpp"
+#include "io/hdf5/HDF5Reader.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const char* const testFile = "testHDF5Append.h5";
+
+	/**
+	 * @brief Reads the dimensions of a dataset in the root group
+	 * @param [in] dataSetName Name of the dataset
+	 * @return Dimensions of the dataset or empty vector if the dataset does not exist
+	 */
+	std::vector<hsize_t> dataSetDims(const std::string& dataSetName)
+	{
+		std::vector<hsize_t> dims;
+		const hid_t file = H5Fopen(testFile, H5F_ACC_RDONLY, H5P_DEFAULT);
+		REQUIRE(file >= 0);
+
+		if (H5Lexists(file, dataSetName.c_str(), H5P_DEFAULT) > 0)
+		{
+			const hid_t dataSet = H5Dopen2(file, dataSetName.c_str(), H5P_DEFAULT);
+			const hid_t dataSpace = H5Dget_space(dataSet);
+
+			dims.resize(H5Sget_simple_extent_ndims(dataSpace));
+			H5Sget_simple_extent_dims(dataSpace, dims.data(), nullptr);
+
+			H5Sclose(dataSpace);
+			H5Dclose(dataSet);
+		}
+
+		H5Fclose(file);
+		return dims;
+	}
+
+	std::vector<double> readDataSet(const std::string& dataSetName)
+	{
+		cadet::io::HDF5Reader reader;
+		reader.openFile(testFile, "r");
+		const std::vector<double> data = reader.vector<double>(dataSetName);
+		reader.closeFile();
+		return data;
+	}
+}
+
+TEST_CASE("HDF5Writer appends blocks along first dimension", "[HDF5],[Append]")
+{
+	for (int compress = 0; compress < 2; ++compress)
+	{
+		SECTION(compress ? "Compressed" : "Uncompressed")
+		{
+			{
+				cadet::io::HDF5Writer writer;
+				writer.openFile(testFile, "co");
+				writer.compressFields(compress != 0);
+
+				// Three blocks of a 3-column matrix with varying number of rows
+				const std::vector<double> data = { 0.0,  1.0,  2.0,  3.0,  4.0,  5.0,  6.0,  7.0,  8.0,  9.0, 10.0, 11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0};
+				std::size_t dims[2] = {2, 3};
+				writer.append<double>("MATRIX", 2, dims, data.data());
+				dims[0] = 1;
+				writer.append<double>("MATRIX", 2, dims, data.data() + 6);
+				dims[0] = 3;
+				writer.append<double>("MATRIX", 2, dims, data.data() + 9);
+
+				// Empty block does not change the dataset
+				dims[0] = 0;
+				writer.append<double>("MATRIX", 2, dims, data.data());
+
+				writer.closeFile();
+			}
+
+			const std::vector<hsize_t> dims = dataSetDims("MATRIX");
+			REQUIRE(dims.size() == 2);
+			CHECK(dims[0] == 6);
+			CHECK(dims[1] == 3);
+
+			const std::vector<double> values = readDataSet("MATRIX");
+			REQUIRE(values.size() == 18);
+			for (std::size_t i = 0; i < values.size(); ++i)
+				CHECK(values[i] == static_cast<double>(i));
+		}
+	}
+	std::remove(testFile);
+}
+
+TEST_CASE("HDF5Writer appends strided data", "[HDF5],[Append]")
+{
+	{
+		cadet::io::HDF5Writer writer;
+		writer.openFile(testFile, "co");
+
+		// Every other element belongs to the appended vector
+		const std::vector<double> data = {0.0, -1.0, 1.0, -1.0, 2.0, -1.0, 3.0, -1.0, 4.0};
+		std::size_t dims[1] = {3};
+		writer.append<double>("VECTOR", 1, dims, data.data(), 2);
+		dims[0] = 2;
+		writer.append<double>("VECTOR", 1, dims, data.data() + 6, 2);
+
+		writer.closeFile();
+	}
+
+	const std::vector<hsize_t> dims = dataSetDims("VECTOR");
+	REQUIRE(dims.size() == 1);
+	CHECK(dims[0] == 5);
+
+	const std::vector<double> values = readDataSet("VECTOR");
+	REQUIRE(values.size() == 5);
+	for (std::size_t i = 0; i < values.size(); ++i)
+		CHECK(values[i] == static_cast<double>(i));
+
+	std::remove(testFile);
+}
+
+TEST_CASE("HDF5Writer skips appending to datasets with empty fixed dimension", "[HDF5],[Append]")
+{
+	{
+		cadet::io::HDF5Writer writer;
+		writer.openFile(testFile, "co");
+		writer.compressFields(true);
+
+		// Unit without bound states does not have any solid phase columns
+		const double dummy = 0.0;
+		std::size_t dims[2] = {4, 0};
+		writer.append<double>("EMPTY", 2, dims, &dummy);
+		writer.append<double>("EMPTY", 2, dims, &dummy);
+
+		writer.closeFile();
+	}
+
+	CHECK(dataSetDims("EMPTY").empty());
+	std::remove(testFile);
+}
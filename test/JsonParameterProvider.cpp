@@ -15,6 +15,8 @@
 #define CADETTEST_JSONPARAMETERPROVIDER_NOFORWARD
 #include "JsonParameterProvider.hpp"
 
+#include <cstdio>
+
 using json = nlohmann::json;
 
 namespace cadet
@@ -747,3 +749,161 @@ cadet::JsonParameterProvider createLinearBenchmark(bool dynamicBinding)
 	}
 	return cadet::JsonParameterProvider(config);
 }
+
+cadet::JsonParameterProvider createCarousel(unsigned int numCycles)
+{
+	// Two columns with linear binding are cycled through the positions of a carousel,
+	// each cycle consists of a feed and a wash section that switch the column order
+	const double cycleTime = 40.0;
+	const unsigned int numSections = 2 * numCycles;
+
+	json config;
+	// Model
+	{
+		json model;
+		model["NUNITS"] = 3;
+
+		// GRM - units 000 and 001
+		{
+			json grm = createGRMwithLinearJson();
+			grm["INIT_C"] = {0.0, 0.0};
+			grm["INIT_Q"] = {0.0, 0.0};
+			grm["discretization"]["NCOL"] = 10;
+			grm["discretization"]["NPAR"] = 3;
+			grm["discretization"]["NBOUND"] = {1, 1};
+
+			model["unit_000"] = grm;
+			model["unit_001"] = grm;
+		}
+
+		// Inlet - unit 002
+		{
+			json inlet;
+
+			inlet["UNIT_TYPE"] = std::string("INLET");
+			inlet["INLET_TYPE"] = std::string("PIECEWISE_CUBIC_POLY");
+			inlet["NCOMP"] = 2;
+
+			for (unsigned int i = 0; i < numSections; ++i)
+			{
+				json sec;
+
+				// Feed in the first half of each cycle, wash in the second half
+				if (i % 2 == 0)
+					sec["CONST_COEFF"] = {1.0, 2.0};
+				else
+					sec["CONST_COEFF"] = {0.0, 0.0};
+				sec["LIN_COEFF"] = {0.0, 0.0};
+				sec["QUAD_COEFF"] = {0.0, 0.0};
+				sec["CUBE_COEFF"] = {0.0, 0.0};
+
+				char secName[8];
+				std::snprintf(secName, sizeof(secName), "sec_%03u", i);
+				inlet[secName] = sec;
+			}
+
+			model["unit_002"] = inlet;
+		}
+
+		// Valve switches
+		{
+			json con;
+			con["NSWITCHES"] = numSections;
+
+			for (unsigned int i = 0; i < numSections; ++i)
+			{
+				json sw;
+				sw["SECTION"] = i;
+
+				// Inlet feeds the front column whose outlet feeds the back column,
+				// the columns swap positions in every section
+				if (i % 2 == 0)
+					sw["CONNECTIONS"] = {2.0, 0.0, -1.0, -1.0, 1.0, 0.0, 1.0, -1.0, -1.0, 1.0};
+				else
+					sw["CONNECTIONS"] = {2.0, 1.0, -1.0, -1.0, 1.0, 1.0, 0.0, -1.0, -1.0, 1.0};
+
+				char swName[11];
+				std::snprintf(swName, sizeof(swName), "switch_%03u", i);
+				con[swName] = sw;
+			}
+			model["connections"] = con;
+		}
+
+		// Solver settings
+		{
+			json solver;
+
+			solver["MAX_KRYLOV"] = 0;
+			solver["GS_TYPE"] = 1;
+			solver["MAX_RESTARTS"] = 10;
+			solver["SCHUR_SAFETY"] = 1e-8;
+			model["solver"] = solver;
+		}
+
+		config["model"] = model;
+	}
+
+	// Return
+	{
+		json ret;
+		ret["WRITE_SOLUTION_TIMES"] = true;
+
+		json grm;
+		grm["WRITE_SOLUTION_COLUMN"] = false;
+		grm["WRITE_SOLUTION_PARTICLE"] = false;
+		grm["WRITE_SOLUTION_FLUX"] = false;
+		grm["WRITE_SOLUTION_COLUMN_INLET"] = true;
+		grm["WRITE_SOLUTION_COLUMN_OUTLET"] = true;
+
+		ret["unit_000"] = grm;
+		ret["unit_001"] = grm;
+		config["return"] = ret;
+	}
+
+	// Solver
+	{
+		json solver;
+
+		{
+			std::vector<double> solTimes;
+			solTimes.reserve(numCycles * 40 + 1);
+			for (unsigned int i = 0; i <= numCycles * 40; ++i)
+				solTimes.push_back(i * cycleTime / 40.0);
+
+			solver["USER_SOLUTION_TIMES"] = solTimes;
+		}
+
+		solver["NTHREADS"] = 1;
+
+		// Sections
+		{
+			json sec;
+
+			std::vector<double> secTimes(numSections + 1, 0.0);
+			for (unsigned int i = 0; i <= numSections; ++i)
+				secTimes[i] = i * 0.5 * cycleTime;
+
+			sec["NSEC"] = numSections;
+			sec["SECTION_TIMES"] = secTimes;
+			sec["SECTION_CONTINUITY"] = std::vector<bool>(numSections - 1, false);
+
+			solver["sections"] = sec;
+		}
+
+		// Time integrator
+		{
+			json ti;
+
+			ti["ABSTOL"] = 1e-8;
+			ti["RELTOL"] = 1e-6;
+			ti["ALGTOL"] = 1e-12;
+			ti["INIT_STEP_SIZE"] = 1e-6;
+			ti["MAX_STEPS"] = 10000;
+
+			solver["time_integrator"] = ti;
+		}
+
+		config["solver"] = solver;
+	}
+	return cadet::JsonParameterProvider(config);
+}
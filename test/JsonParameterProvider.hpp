@@ -93,5 +93,6 @@ cadet::JsonParameterProvider createGRMwithSMA();
 cadet::JsonParameterProvider createGRMwithLinear();
 cadet::JsonParameterProvider createLWE();
 cadet::JsonParameterProvider createLinearBenchmark(bool dynamicBinding);
+cadet::JsonParameterProvider createCarousel(unsigned int numCycles);
 
 #endif  // CADETTEST_JSONPARAMETERPROVIDER_HPP_
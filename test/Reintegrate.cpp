@@ -0,0 +1,53 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+#include "cadet/cadet.hpp"
+
+#ifndef CADET_LOGGING_DISABLE
+	#define CADET_LOGGING_DISABLE
+#endif
+#include "Logging.hpp"
+
+#include "JsonParameterProvider.hpp"
+#include "common/Driver.hpp"
+
+#include <vector>
+
+namespace
+{
+	inline std::vector<double> copyOutlet(const cadet::Driver& drv)
+	{
+		cadet::InternalStorageUnitOpRecorder const* const data = drv.solution()->unitOperation(0);
+		return std::vector<double>(data->outlet(), data->outlet() + data->numDataPoints() * data->numComponents());
+	}
+}
+
+TEST_CASE("Reintegrate reproduces integrate", "[GRM],[Simulation],[Reintegrate]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+	const std::vector<double> ref = copyOutlet(drv);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		drv.clearResults();
+		drv.rerun();
+
+		const std::vector<double> sol = copyOutlet(drv);
+		REQUIRE(sol.size() == ref.size());
+		for (unsigned int j = 0; j < ref.size(); ++j)
+			CHECK(sol[j] == Approx(ref[j]).epsilon(1e-10).margin(1e-12));
+	}
+}
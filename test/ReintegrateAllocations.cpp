@@ -0,0 +1,151 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+#include "cadet/cadet.hpp"
+
+#ifndef CADET_LOGGING_DISABLE
+	#define CADET_LOGGING_DISABLE
+#endif
+#include "Logging.hpp"
+
+#include "JsonParameterProvider.hpp"
+#include "common/Driver.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<bool> countAllocations(false);
+	std::atomic<std::size_t> numAllocations(0);
+	std::atomic<std::size_t> numDeallocations(0);
+
+	inline void* countedAlloc(std::size_t size)
+	{
+		if (countAllocations.load(std::memory_order_relaxed))
+			numAllocations.fetch_add(1, std::memory_order_relaxed);
+
+		void* const p = std::malloc(size == 0 ? 1 : size);
+		if (!p)
+			throw std::bad_alloc();
+		return p;
+	}
+
+	inline void countedFree(void* p) CADET_NOEXCEPT
+	{
+		if (!p)
+			return;
+
+		if (countAllocations.load(std::memory_order_relaxed))
+			numDeallocations.fetch_add(1, std::memory_order_relaxed);
+
+		std::free(p);
+	}
+
+	/**
+	 * @brief Counts heap allocations performed during its lifetime
+	 * @details Only allocations via global operator new are counted. This includes all
+	 *          allocations of LIBCADET except when it is linked as shared library on
+	 *          platforms that do not support symbol interposition (e.g., Windows).
+	 */
+	class AllocationCounter
+	{
+	public:
+		AllocationCounter()
+		{
+			numAllocations = 0;
+			numDeallocations = 0;
+			countAllocations = true;
+		}
+
+		~AllocationCounter() CADET_NOEXCEPT { countAllocations = false; }
+
+		inline std::size_t allocations() const CADET_NOEXCEPT { return numAllocations.load(); }
+		inline std::size_t deallocations() const CADET_NOEXCEPT { return numDeallocations.load(); }
+	};
+
+	/**
+	 * @brief Sets the LogLevel during its lifetime and restores the previous one afterwards
+	 * @details Log messages that pass the LogLevel filter are formatted on the heap.
+	 */
+	class ScopedLogLevel
+	{
+	public:
+		ScopedLogLevel(cadet::LogLevel lvl) : _prev(cadet::getLogLevel()) { cadet::setLogLevel(lvl); }
+		~ScopedLogLevel() CADET_NOEXCEPT { cadet::setLogLevel(_prev); }
+	private:
+		cadet::LogLevel _prev;
+	};
+}
+
+// Replacing the global allocation functions affects the whole executable, which is why
+// this test is not part of testRunner
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) CADET_NOEXCEPT
+{
+	try
+	{
+		return countedAlloc(size);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+void* operator new[](std::size_t size, const std::nothrow_t& nt) CADET_NOEXCEPT { return operator new(size, nt); }
+void operator delete(void* p) CADET_NOEXCEPT { countedFree(p); }
+void operator delete[](void* p) CADET_NOEXCEPT { countedFree(p); }
+void operator delete(void* p, std::size_t) CADET_NOEXCEPT { countedFree(p); }
+void operator delete[](void* p, std::size_t) CADET_NOEXCEPT { countedFree(p); }
+
+TEST_CASE("Reintegrate does not allocate memory", "[GRM],[Simulation],[Reintegrate]")
+{
+	cadet::JsonParameterProvider jpp = createLWE();
+	cadet::Driver drv;
+	drv.configure(jpp);
+
+	const cadet::ParameterId colDisp = cadet::makeParamId("COL_DISPERSION", 0, cadet::CompIndep, cadet::BoundPhaseIndep, cadet::ReactionIndep, cadet::SectionIndep);
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+	const double dispersion = jpp.getDouble("COL_DISPERSION");
+	jpp.popScope();
+	jpp.popScope();
+	const double factors[] = {1.0, 1.5, 0.75};
+
+	ScopedLogLevel sll(cadet::LogLevel::Warning);
+
+	// Cold run and one warm run to settle all lazily allocated buffers
+	drv.run();
+	drv.clearResults();
+	drv.rerun();
+
+	for (double f : factors)
+	{
+		drv.simulator()->setParameterValue(colDisp, dispersion * f);
+		drv.clearResults();
+
+		AllocationCounter ac;
+		drv.rerun();
+
+#ifdef CADET_PARALLELIZE
+		// TBB allocates task graphs and schedulers in each run, but has to release them again
+		CHECK(ac.allocations() == ac.deallocations());
+#else
+		CHECK(ac.allocations() == 0);
+		CHECK(ac.deallocations() == 0);
+#endif
+	}
+}
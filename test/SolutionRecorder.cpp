@@ -0,0 +1,821 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <vector>
+#include <map>
+#include <string>
+#include <iomanip>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <chrono>
+#include <iostream>
+
+#include "cadet/cadet.hpp"
+#include "common/SolutionRecorderImpl.hpp"
+#include "common/StreamingSolutionRecorder.hpp"
+#include "ParamIdUtil.hpp"
+#include "AsyncSolutionQueue.hpp"
+#include "AsyncCheckpointQueue.hpp"
+#include "ModelBuilderImpl.hpp"
+#include "SimulatableModel.hpp"
+
+#include <json.hpp>
+#define CADETTEST_JSONPARAMETERPROVIDER_NOFORWARD
+#include "JsonParameterProvider.hpp"
+
+using json = nlohmann::json;
+
+namespace
+{
+	/**
+	 * @brief Writer that keeps all datasets in memory
+	 * @details Supports writing complete datasets as well as appending to datasets.
+	 */
+	class MemoryWriter
+	{
+	public:
+
+		struct Dataset
+		{
+			std::vector<std::size_t> dims;
+			std::vector<double> values;
+		};
+
+		MemoryWriter() : compressed(false) { }
+
+		void pushGroup(const std::string& groupName) { _groups.push_back(groupName); }
+		void popGroup() { _groups.pop_back(); }
+
+		void compressFields(bool setCompression) { compressed = setCompression; }
+		bool compressFields() const { return compressed; }
+
+		template <typename T>
+		void vector(const std::string& dataSetName, const std::size_t length, const T* buffer, const std::size_t stride = 1)
+		{
+			tensor(dataSetName, 1, &length, buffer, stride);
+		}
+
+		template <typename T>
+		void matrix(const std::string& dataSetName, const std::size_t rows, const std::size_t cols, const T* buffer, const std::size_t stride = 1)
+		{
+			const std::size_t dims[2] = {rows, cols};
+			tensor(dataSetName, 2, dims, buffer, stride);
+		}
+
+		template <typename T>
+		void tensor(const std::string& dataSetName, const std::size_t rank, const std::size_t* dims, const T* buffer, const std::size_t stride = 1)
+		{
+			Dataset& ds = datasets[path(dataSetName)];
+			ds.dims.assign(dims, dims + rank);
+			ds.values.clear();
+			copy(ds, rank, dims, buffer, stride);
+		}
+
+		template <typename T>
+		void append(const std::string& dataSetName, const std::size_t rank, const std::size_t* dims, const T* buffer, const std::size_t stride = 1)
+		{
+			Dataset& ds = datasets[path(dataSetName)];
+			if (ds.dims.empty())
+			{
+				ds.dims.assign(dims, dims + rank);
+				ds.dims[0] = 0;
+			}
+
+			// Called by the writer thread of the streaming recorder, mismatches are checked by the test
+			bool match = (ds.dims.size() == rank);
+			for (std::size_t i = 1; match && (i < rank); ++i)
+				match = (ds.dims[i] == dims[i]);
+
+			if (!match)
+				appendErrors.push_back(path(dataSetName));
+
+			ds.dims[0] += dims[0];
+			copy(ds, rank, dims, buffer, stride);
+		}
+
+		std::map<std::string, Dataset> datasets;
+		std::vector<std::string> appendErrors;
+		bool compressed;
+
+	protected:
+
+		std::string path(const std::string& dataSetName) const
+		{
+			std::string p;
+			for (const std::string& g : _groups)
+				p += "/" + g;
+			return p + "/" + dataSetName;
+		}
+
+		template <typename T>
+		void copy(Dataset& ds, const std::size_t rank, const std::size_t* dims, const T* buffer, const std::size_t stride)
+		{
+			std::size_t n = 1;
+			for (std::size_t i = 0; i < rank; ++i)
+				n *= dims[i];
+
+			for (std::size_t i = 0; i < n; ++i)
+				ds.values.push_back(buffer[i * stride]);
+		}
+
+		std::vector<std::string> _groups;
+	};
+
+	/**
+	 * @brief Unit operation without particles whose solution is set from outside
+	 */
+	class DummyUnitOperation : public cadet::IModel, public cadet::ISolutionExporter
+	{
+	public:
+		DummyUnitOperation(cadet::UnitOpIdx idx, unsigned int nComp, unsigned int nCol) : _idx(idx), _nComp(nComp), _nCol(nCol), _data(nComp * nCol, 0.0) { }
+
+		// IModel
+		virtual cadet::UnitOpIdx unitOperationId() const CADET_NOEXCEPT { return _idx; }
+		virtual const char* unitOperationName() const CADET_NOEXCEPT { return "DUMMY"; }
+		virtual bool setParameter(const cadet::ParameterId& pId, int value) { return false; }
+		virtual bool setParameter(const cadet::ParameterId& pId, double value) { return false; }
+		virtual bool setParameter(const cadet::ParameterId& pId, bool value) { return false; }
+		virtual bool hasParameter(const cadet::ParameterId& pId) const { return false; }
+		virtual std::unordered_map<cadet::ParameterId, double> getAllParameterValues() const { return std::unordered_map<cadet::ParameterId, double>(); }
+		virtual void useAnalyticJacobian(const bool analyticJac) { }
+		virtual std::vector<double> benchmarkTimings() const { return std::vector<double>(); }
+		virtual char const* const* benchmarkDescriptions() const { return nullptr; }
+
+		// ISolutionExporter
+		virtual bool hasMultipleBoundStates() const CADET_NOEXCEPT { return false; }
+		virtual bool hasParticleFlux() const CADET_NOEXCEPT { return false; }
+		virtual bool hasParticleMobilePhase() const CADET_NOEXCEPT { return false; }
+		virtual bool hasNonBindingComponents() const CADET_NOEXCEPT { return false; }
+		virtual unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
+		virtual unsigned int numAxialCells() const CADET_NOEXCEPT { return _nCol; }
+		virtual unsigned int numRadialCells() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numBoundStates() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int const* numBoundStatesPerComponent() const CADET_NOEXCEPT { return nullptr; }
+		virtual unsigned int numBoundStates(unsigned int comp) const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numColumnDofs() const CADET_NOEXCEPT { return _nComp * _nCol; }
+		virtual unsigned int numParticleDofs() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numFluxDofs() const CADET_NOEXCEPT { return 0; }
+		virtual double concentration(unsigned int component, unsigned int axialCell) const { return _data[axialCell * _nComp + component]; }
+		virtual double flux(unsigned int component, unsigned int axialCell) const { return 0.0; }
+		virtual double mobilePhase(unsigned int component, unsigned int axialCell, unsigned int radialCell) const { return 0.0; }
+		virtual double solidPhase(unsigned int component, unsigned int axialCell, unsigned int radialCell, unsigned int boundState) const { return 0.0; }
+		virtual double const* concentration() const { return _data.data(); }
+		virtual double const* flux() const { return nullptr; }
+		virtual double const* mobilePhase() const { return nullptr; }
+		virtual double const* solidPhase() const { return nullptr; }
+		virtual double const* inlet(unsigned int& stride) const { stride = 1; return _data.data(); }
+		virtual double const* outlet(unsigned int& stride) const { stride = 1; return _data.data() + (_nCol - 1) * _nComp; }
+
+		virtual cadet::StateOrdering const* concentrationOrdering(unsigned int& len) const
+		{
+			len = 2;
+			return _ordering;
+		}
+
+		virtual cadet::StateOrdering const* fluxOrdering(unsigned int& len) const { len = 0; return nullptr; }
+		virtual cadet::StateOrdering const* mobilePhaseOrdering(unsigned int& len) const { len = 0; return nullptr; }
+		virtual cadet::StateOrdering const* solidPhaseOrdering(unsigned int& len) const { len = 0; return nullptr; }
+
+		inline std::vector<double>& data() CADET_NOEXCEPT { return _data; }
+
+	protected:
+		cadet::UnitOpIdx _idx;
+		unsigned int _nComp;
+		unsigned int _nCol;
+		std::vector<double> _data;
+		const cadet::StateOrdering _ordering[2] = {cadet::StateOrdering::AxialCell, cadet::StateOrdering::Component};
+	};
+
+	/**
+	 * @brief Simulates recording a time integration run in the same way as the Simulator
+	 * @param [in,out] rec Recorder
+	 * @param [in] units Unit operations
+	 * @param [in] numSens Number of sensitivities
+	 * @param [in] numTimesteps Number of time steps
+	 * @param [in] firstTimestep Index of the first recorded time step
+	 * @param [in] checkpoint Checkpoint restored before recording or @c nullptr
+	 */
+	void recordRun(cadet::ISolutionRecorder& rec, std::vector<DummyUnitOperation>& units, unsigned int numSens, unsigned int numTimesteps,
+		unsigned int firstTimestep = 0, std::vector<double> const* checkpoint = nullptr)
+	{
+		const unsigned int numDofs = 100;
+		rec.prepare(numDofs, numSens, numTimesteps);
+		rec.notifyIntegrationStart(numDofs, numSens, numTimesteps);
+		for (DummyUnitOperation& u : units)
+			rec.unitOperationStructure(u.unitOperationId(), u, u);
+
+		if (checkpoint)
+			rec.restoreCheckpoint(checkpoint->data(), checkpoint->size());
+
+		const cadet::ParameterId pId = cadet::makeParamId("DUMMY", 0, cadet::CompIndep, cadet::BoundPhaseIndep, cadet::ReactionIndep, cadet::SectionIndep);
+		const auto report = [&](double scale)
+		{
+			for (DummyUnitOperation& u : units)
+			{
+				std::vector<double>& d = u.data();
+				const std::vector<double> backup = d;
+				for (double& v : d)
+					v *= scale;
+
+				rec.beginUnitOperation(u.unitOperationId(), u, u);
+				rec.endUnitOperation();
+
+				d = backup;
+			}
+		};
+
+		for (unsigned int t = firstTimestep; t < numTimesteps; ++t)
+		{
+			for (DummyUnitOperation& u : units)
+			{
+				std::vector<double>& d = u.data();
+				for (unsigned int i = 0; i < d.size(); ++i)
+					d[i] = t * 100.0 + i + u.unitOperationId() * 0.5;
+			}
+
+			rec.beginTimestep(0.5 * t);
+
+			rec.beginSolution();
+			report(1.0);
+			rec.endSolution();
+
+			rec.beginSolutionDerivative();
+			report(-1.0);
+			rec.endSolutionDerivative();
+
+			for (unsigned int i = 0; i < numSens; ++i)
+			{
+				rec.beginSensitivity(pId, i);
+				report(2.0 + i);
+				rec.endSensitivity(pId, i);
+
+				rec.beginSensitivityDerivative(pId, i);
+				report(-2.0 - i);
+				rec.endSensitivityDerivative(pId, i);
+			}
+
+			rec.endTimestep();
+		}
+	}
+
+	void configureStorage(cadet::InternalStorageSystemRecorder& storage)
+	{
+		cadet::InternalStorageUnitOpRecorder* const recA = new cadet::InternalStorageUnitOpRecorder(0);
+		recA->solutionConfig({true, false, false, true, true});
+		recA->solutionDotConfig({true, false, false, false, false});
+		recA->sensitivityConfig({false, false, false, true, false});
+		recA->sensitivityDotConfig({true, false, false, false, false});
+		recA->splitComponents(true);
+		storage.addRecorder(recA);
+
+		cadet::InternalStorageUnitOpRecorder* const recB = new cadet::InternalStorageUnitOpRecorder(1);
+		recB->solutionConfig({true, false, false, true, false});
+		recB->solutionDotConfig({false, false, false, true, false});
+		recB->sensitivityConfig({true, false, false, true, false});
+		recB->sensitivityDotConfig({false, false, false, false, false});
+		recB->splitComponents(false);
+		storage.addRecorder(recB);
+	}
+}
+
+namespace
+{
+	/**
+	 * @brief Recorder that forwards to another recorder and counts reported unit operations
+	 * @details Optionally hides the recorded fields of the wrapped recorder, which forces
+	 *          all unit operations and systems to be reported.
+	 */
+	class CountingRecorder : public cadet::ISolutionRecorder
+	{
+	public:
+		CountingRecorder(cadet::ISolutionRecorder& rec, bool declareFields) : numReported(0), _rec(rec), _declareFields(declareFields) { }
+
+		virtual void clear() { _rec.clear(); }
+		virtual void prepare(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps) { _rec.prepare(numDofs, numSens, numTimesteps); }
+		virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps) { _rec.notifyIntegrationStart(numDofs, numSens, numTimesteps); }
+		virtual void unitOperationStructure(cadet::UnitOpIdx idx, const cadet::IModel& model, const cadet::ISolutionExporter& exporter) { _rec.unitOperationStructure(idx, model, exporter); }
+		virtual unsigned int recordedFields(cadet::UnitOpIdx idx) const CADET_NOEXCEPT { return _declareFields ? _rec.recordedFields(idx) : cadet::RecordedField::All; }
+		virtual void beginTimestep(double t) { _rec.beginTimestep(t); }
+		virtual void beginUnitOperation(cadet::UnitOpIdx idx, const cadet::IModel& model, const cadet::ISolutionExporter& exporter)
+		{
+			++numReported;
+			_rec.beginUnitOperation(idx, model, exporter);
+		}
+		virtual void endUnitOperation() { _rec.endUnitOperation(); }
+		virtual void endTimestep() { _rec.endTimestep(); }
+		virtual void beginSolution() { _rec.beginSolution(); }
+		virtual void endSolution() { _rec.endSolution(); }
+		virtual void beginSolutionDerivative() { _rec.beginSolutionDerivative(); }
+		virtual void endSolutionDerivative() { _rec.endSolutionDerivative(); }
+		virtual void beginSensitivity(const cadet::ParameterId& pId, unsigned int sensIdx) { _rec.beginSensitivity(pId, sensIdx); }
+		virtual void endSensitivity(const cadet::ParameterId& pId, unsigned int sensIdx) { _rec.endSensitivity(pId, sensIdx); }
+		virtual void beginSensitivityDerivative(const cadet::ParameterId& pId, unsigned int sensIdx) { _rec.beginSensitivityDerivative(pId, sensIdx); }
+		virtual void endSensitivityDerivative(const cadet::ParameterId& pId, unsigned int sensIdx) { _rec.endSensitivityDerivative(pId, sensIdx); }
+
+		unsigned int numReported;
+
+	protected:
+		cadet::ISolutionRecorder& _rec;
+		bool _declareFields;
+	};
+
+	/**
+	 * @brief Creates a network of inlets that are each connected to an outlet
+	 * @param [in] numPairs Number of inlet-outlet pairs
+	 * @return Model configuration with @c 2 * numPairs unit operations
+	 */
+	cadet::JsonParameterProvider createInletOutletNetwork(unsigned int numPairs)
+	{
+		json model;
+		model["NUNITS"] = 2 * numPairs;
+
+		std::vector<double> connections;
+		for (unsigned int i = 0; i < numPairs; ++i)
+		{
+			json inlet;
+			inlet["UNIT_TYPE"] = std::string("INLET");
+			inlet["INLET_TYPE"] = std::string("PIECEWISE_CUBIC_POLY");
+			inlet["NCOMP"] = 2;
+
+			json sec;
+			sec["CONST_COEFF"] = {1.0 + i, 2.0};
+			sec["LIN_COEFF"] = {0.0, 0.0};
+			sec["QUAD_COEFF"] = {0.0, 0.0};
+			sec["CUBE_COEFF"] = {0.0, 0.0};
+			inlet["sec_000"] = sec;
+
+			json outlet;
+			outlet["UNIT_TYPE"] = std::string("OUTLET");
+			outlet["NCOMP"] = 2;
+
+			std::ostringstream oss;
+			oss << "unit_" << std::setfill('0') << std::setw(3) << i;
+			model[oss.str()] = inlet;
+			oss.str("");
+			oss << "unit_" << std::setfill('0') << std::setw(3) << i + numPairs;
+			model[oss.str()] = outlet;
+
+			connections.insert(connections.end(), {static_cast<double>(i), static_cast<double>(i + numPairs), -1.0, -1.0, 1.0});
+		}
+
+		json sw;
+		sw["SECTION"] = 0;
+		sw["CONNECTIONS"] = connections;
+
+		json con;
+		con["NSWITCHES"] = 1;
+		con["switch_000"] = sw;
+		model["connections"] = con;
+
+		json solver;
+		solver["MAX_KRYLOV"] = 0;
+		solver["GS_TYPE"] = 1;
+		solver["MAX_RESTARTS"] = 10;
+		solver["SCHUR_SAFETY"] = 1e-8;
+		model["solver"] = solver;
+
+		return cadet::JsonParameterProvider(model);
+	}
+
+	/**
+	 * @brief Reports solutions of a model system in the same way as the Simulator
+	 * @param [in] sys Model system
+	 * @param [in,out] rec Recorder
+	 * @param [in] numTimesteps Number of time steps
+	 */
+	void recordModelSystem(cadet::ISimulatableModel& sys, cadet::ISolutionRecorder& rec, unsigned int numTimesteps)
+	{
+		const unsigned int numDofs = sys.numDofs();
+		std::vector<double> y(numDofs, 0.0);
+
+		rec.prepare(numDofs, 0, numTimesteps);
+		rec.notifyIntegrationStart(numDofs, 0, numTimesteps);
+		sys.reportSolutionStructure(rec);
+
+		const unsigned int fields = rec.recordedFields(cadet::UnitOpIndep);
+		for (unsigned int t = 0; t < numTimesteps; ++t)
+		{
+			for (unsigned int i = 0; i < numDofs; ++i)
+				y[i] = t * 1000.0 + i;
+
+			rec.beginTimestep(t);
+			if (fields & cadet::RecordedField::Solution)
+			{
+				rec.beginSolution();
+				sys.reportSolution(rec, y.data());
+				rec.endSolution();
+			}
+			if (fields & cadet::RecordedField::SolutionDerivative)
+			{
+				rec.beginSolutionDerivative();
+				sys.reportSolution(rec, y.data());
+				rec.endSolutionDerivative();
+			}
+			rec.endTimestep();
+		}
+	}
+
+	/**
+	 * @brief Creates a recorder that only records the outlet of one unit operation
+	 * @param [in,out] storage Recorder
+	 * @param [in] idx Index of the recorded unit operation
+	 */
+	void configureOutletOnly(cadet::InternalStorageSystemRecorder& storage, cadet::UnitOpIdx idx)
+	{
+		cadet::InternalStorageUnitOpRecorder* const rec = new cadet::InternalStorageUnitOpRecorder(idx);
+		rec->solutionConfig({false, false, false, true, false});
+		rec->solutionDotConfig({false, false, false, false, false});
+		rec->sensitivityConfig({false, false, false, false, false});
+		rec->sensitivityDotConfig({false, false, false, false, false});
+		storage.addRecorder(rec);
+	}
+}
+
+TEST_CASE("InternalStorageSystemRecorder declares recorded fields", "[SolutionRecorder]")
+{
+	cadet::InternalStorageSystemRecorder storage;
+	configureStorage(storage);
+
+	using namespace cadet::RecordedField;
+	CHECK(storage.recordedFields(0) == (Inlet | Outlet | Column | Solution | SolutionDerivative | Sensitivity | SensitivityDerivative));
+	CHECK(storage.recordedFields(1) == (Outlet | Column | Solution | SolutionDerivative | Sensitivity));
+	CHECK(storage.recordedFields(2) == None);
+	CHECK(storage.recordedFields(cadet::UnitOpIndep) == (storage.recordedFields(0) | storage.recordedFields(1)));
+
+	// Changed configuration is picked up when the integration starts
+	storage.recorder(1)->solutionConfig().storeFlux = true;
+	storage.notifyIntegrationStart(100, 0, 10);
+	CHECK(storage.recordedFields(1) == (Outlet | Column | Flux | Solution | SolutionDerivative | Sensitivity));
+}
+
+TEST_CASE("ModelSystem only reports recorded unit operations", "[SolutionRecorder]")
+{
+	const unsigned int numPairs = 25;
+	const unsigned int numTimesteps = 10;
+	const cadet::UnitOpIdx recordedUnit = 2 * numPairs - 1;
+
+	cadet::JsonParameterProvider jpp = createInletOutletNetwork(numPairs);
+	cadet::ModelBuilder builder;
+	cadet::ISimulatableModel* const sys = dynamic_cast<cadet::ISimulatableModel*>(builder.createSystem(jpp));
+	REQUIRE(sys);
+
+	cadet::InternalStorageSystemRecorder fullStorage;
+	configureOutletOnly(fullStorage, recordedUnit);
+	CountingRecorder full(fullStorage, false);
+	recordModelSystem(*sys, full, numTimesteps);
+
+	cadet::InternalStorageSystemRecorder fastStorage;
+	configureOutletOnly(fastStorage, recordedUnit);
+	CountingRecorder fast(fastStorage, true);
+	recordModelSystem(*sys, fast, numTimesteps);
+
+	// Only the recorded unit operation is reported and only the original system
+	CHECK(full.numReported == 2 * numPairs * 2 * numTimesteps);
+	CHECK(fast.numReported == numTimesteps);
+
+	cadet::InternalStorageUnitOpRecorder const* const fullRec = fullStorage.unitOperation(recordedUnit);
+	cadet::InternalStorageUnitOpRecorder const* const fastRec = fastStorage.unitOperation(recordedUnit);
+	REQUIRE(fullRec->numDataPoints() == numTimesteps);
+	REQUIRE(fastRec->numDataPoints() == numTimesteps);
+	REQUIRE(fastRec->numComponents() == 2);
+
+	for (unsigned int i = 0; i < numTimesteps * fastRec->numComponents(); ++i)
+		CHECK(fastRec->outlet()[i] == fullRec->outlet()[i]);
+}
+
+TEST_CASE("ModelSystem solution recording throughput on 50 unit network", "[SolutionRecorder],[Benchmark],[.]")
+{
+	const unsigned int numPairs = 25;
+	const unsigned int numTimesteps = 20000;
+
+	cadet::JsonParameterProvider jpp = createInletOutletNetwork(numPairs);
+	cadet::ModelBuilder builder;
+	cadet::ISimulatableModel* const sys = dynamic_cast<cadet::ISimulatableModel*>(builder.createSystem(jpp));
+	REQUIRE(sys);
+
+	const auto timeRecording = [&](bool declareFields) -> double
+	{
+		cadet::InternalStorageSystemRecorder storage;
+		for (cadet::UnitOpIdx i = 0; i < 2 * numPairs; ++i)
+			configureOutletOnly(storage, i);
+
+		// Only record the outlet of the last unit operation, but keep all recorders in the dispatch
+		for (unsigned int i = 0; i + 1 < storage.numRecorders(); ++i)
+			storage.recorder(i)->solutionConfig().storeOutlet = false;
+
+		CountingRecorder rec(storage, declareFields);
+		const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		recordModelSystem(*sys, rec, numTimesteps);
+		const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::micro>(end - start).count() / numTimesteps;
+	};
+
+	const double tFull = timeRecording(false);
+	const double tFast = timeRecording(true);
+
+	std::cout << "Recording outlet of 1 of " << 2 * numPairs << " unit operations [us/timestep]\n";
+	std::cout << "  all units and systems: " << tFull << "\n";
+	std::cout << "  declared fields: " << tFast << "\n";
+}
+
+TEST_CASE("StreamingSystemRecorder writes same output as InternalStorageSystemRecorder", "[SolutionRecorder]")
+{
+	std::vector<DummyUnitOperation> units;
+	units.push_back(DummyUnitOperation(0, 2, 3));
+	units.push_back(DummyUnitOperation(1, 3, 4));
+
+	const unsigned int numSens = 2;
+	cadet::InternalStorageSystemRecorder storage;
+	configureStorage(storage);
+
+	// Buffer everything and write once
+	recordRun(storage, units, numSens, 23);
+
+	MemoryWriter refWriter;
+	refWriter.pushGroup("output");
+	refWriter.pushGroup("solution");
+	storage.writeSolution(refWriter);
+	refWriter.popGroup();
+	refWriter.pushGroup("sensitivity");
+	storage.writeSensitivity(refWriter);
+	refWriter.popGroup();
+	refWriter.popGroup();
+
+	// Number of time steps is not divisible by block size
+	for (unsigned int blockSize : {1u, 4u, 23u, 50u})
+	{
+		SECTION("Block size " + std::to_string(blockSize))
+		{
+			MemoryWriter writer;
+			{
+				cadet::StreamingSystemRecorder<MemoryWriter> streaming(writer, blockSize, 2);
+				streaming.configure(storage);
+
+				// Run twice to check reuse of the recorder
+				for (unsigned int run = 0; run < 2; ++run)
+				{
+					writer.datasets.clear();
+					recordRun(streaming, units, numSens, 23);
+					streaming.finish();
+					CHECK(streaming.numDataPoints() == 23);
+					CHECK(writer.appendErrors.empty());
+					CHECK(writer.compressed);
+				}
+			}
+
+			// Compression setting is restored
+			CHECK_FALSE(writer.compressed);
+
+			REQUIRE(writer.datasets.size() == refWriter.datasets.size());
+			for (const std::pair<const std::string, MemoryWriter::Dataset>& ds : refWriter.datasets)
+			{
+				INFO("Dataset " << ds.first);
+				REQUIRE(writer.datasets.count(ds.first) == 1);
+
+				const MemoryWriter::Dataset& streamed = writer.datasets[ds.first];
+				CHECK(streamed.dims == ds.second.dims);
+				CHECK(streamed.values == ds.second.values);
+			}
+		}
+	}
+}
+
+TEST_CASE("AsyncSolutionQueue processes snapshots in order with bounded depth", "[SolutionRecorder]")
+{
+	const unsigned int snapshotSize = 5;
+	const unsigned int numSnapshots = 40;
+
+	cadet::AsyncSolutionQueue queue;
+	std::atomic<unsigned int> numSubmitted(0);
+	std::atomic<unsigned int> numProcessed(0);
+
+	for (unsigned int depth : {1u, 3u})
+	{
+		std::vector<double> times;
+		std::vector<double> values;
+		numSubmitted = 0;
+		numProcessed = 0;
+		unsigned int maxPending = 0;
+
+		queue.configure(snapshotSize, depth, [&](double t, double const* data)
+			{
+				times.push_back(t);
+				values.insert(values.end(), data, data + snapshotSize);
+				++numProcessed;
+			});
+		REQUIRE(queue.enabled());
+
+		for (unsigned int i = 0; i < numSnapshots; ++i)
+		{
+			double* const snapshot = queue.acquire();
+			maxPending = std::max(maxPending, numSubmitted - numProcessed);
+
+			for (unsigned int j = 0; j < snapshotSize; ++j)
+				snapshot[j] = i * snapshotSize + j;
+
+			queue.submit(static_cast<double>(i));
+			++numSubmitted;
+		}
+		queue.finish();
+
+		CHECK_FALSE(queue.enabled());
+		CHECK(maxPending < depth);
+		REQUIRE(times.size() == numSnapshots);
+		REQUIRE(values.size() == numSnapshots * snapshotSize);
+		for (unsigned int i = 0; i < numSnapshots; ++i)
+			CHECK(times[i] == static_cast<double>(i));
+		for (unsigned int i = 0; i < values.size(); ++i)
+			CHECK(values[i] == static_cast<double>(i));
+	}
+}
+
+TEST_CASE("AsyncSolutionQueue reports consumer errors on finish", "[SolutionRecorder]")
+{
+	cadet::AsyncSolutionQueue queue;
+	unsigned int numCalls = 0;
+	queue.configure(2, 2, [&](double t, double const* data)
+		{
+			++numCalls;
+			if (t >= 1.0)
+				throw std::runtime_error("Consumer failed");
+		});
+
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		double* const snapshot = queue.acquire();
+		snapshot[0] = snapshot[1] = 0.0;
+		queue.submit(static_cast<double>(i));
+	}
+
+	CHECK_THROWS_AS(queue.finish(), std::runtime_error&);
+
+	// Snapshots after the first error are dropped
+	CHECK(numCalls == 2);
+
+	// Queue can be reused after an error
+	queue.configure(2, 2, [&](double t, double const* data) { ++numCalls; });
+	queue.acquire();
+	queue.submit(0.0);
+	CHECK_NOTHROW(queue.finish());
+	CHECK(numCalls == 3);
+}
+
+TEST_CASE("InternalStorageSystemRecorder continues from checkpoint", "[SolutionRecorder],[Checkpoint]")
+{
+	std::vector<DummyUnitOperation> units;
+	units.push_back(DummyUnitOperation(0, 2, 3));
+	units.push_back(DummyUnitOperation(1, 3, 4));
+
+	const unsigned int numSens = 2;
+	const unsigned int numTimesteps = 23;
+
+	cadet::InternalStorageSystemRecorder refStorage;
+	configureStorage(refStorage);
+	recordRun(refStorage, units, numSens, numTimesteps);
+
+	// Interrupt recording and save checkpoint
+	cadet::InternalStorageSystemRecorder partStorage;
+	configureStorage(partStorage);
+	recordRun(partStorage, units, numSens, 10);
+
+	std::vector<double> checkpoint;
+	partStorage.saveCheckpoint(checkpoint);
+
+	// Resume recording in a fresh recorder
+	cadet::InternalStorageSystemRecorder storage;
+	configureStorage(storage);
+	recordRun(storage, units, numSens, numTimesteps, 10, &checkpoint);
+	CHECK(storage.numDataPoints() == numTimesteps);
+
+	const auto writeResults = [](cadet::InternalStorageSystemRecorder& rec, MemoryWriter& writer)
+	{
+		writer.pushGroup("solution");
+		rec.writeSolution(writer);
+		writer.popGroup();
+		writer.pushGroup("sensitivity");
+		rec.writeSensitivity(writer);
+		writer.popGroup();
+	};
+
+	MemoryWriter refWriter;
+	writeResults(refStorage, refWriter);
+
+	MemoryWriter writer;
+	writeResults(storage, writer);
+
+	REQUIRE(writer.datasets.size() == refWriter.datasets.size());
+	for (const std::pair<const std::string, MemoryWriter::Dataset>& ds : refWriter.datasets)
+	{
+		INFO("Dataset " << ds.first);
+		REQUIRE(writer.datasets.count(ds.first) == 1);
+		CHECK(writer.datasets[ds.first].dims == ds.second.dims);
+		CHECK(writer.datasets[ds.first].values == ds.second.values);
+	}
+
+	// Checkpoint does not fit a recorder with different sensitivities
+	cadet::InternalStorageSystemRecorder otherStorage;
+	configureStorage(otherStorage);
+	CHECK_THROWS_AS(recordRun(otherStorage, units, numSens + 1, numTimesteps, 10, &checkpoint), std::invalid_argument&);
+}
+
+TEST_CASE("AsyncCheckpointQueue does not queue checkpoints and reports errors", "[Checkpoint]")
+{
+	cadet::AsyncCheckpointQueue queue;
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool release = false;
+	std::vector<double> written;
+
+	queue.configure([&](double t, double const* data, std::size_t len)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			cv.wait(lock, [&]() { return release; });
+			written.assign(data, data + len);
+			if (t >= 2.0)
+				throw std::runtime_error("Writer failed");
+		});
+
+	CHECK(queue.idle());
+	queue.buffer().assign({1.0, 2.0, 3.0});
+	queue.submit(1.0);
+
+	// Producer keeps its own buffer while the checkpoint is being written
+	CHECK_FALSE(queue.idle());
+	queue.buffer().assign({4.0, 5.0});
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		release = true;
+	}
+	cv.notify_all();
+
+	queue.wait();
+	CHECK(queue.idle());
+	CHECK(written == std::vector<double>({1.0, 2.0, 3.0}));
+
+	queue.submit(2.0);
+	CHECK_THROWS_AS(queue.finish(), std::runtime_error&);
+	CHECK(written == std::vector<double>({4.0, 5.0}));
+
+	// Queue can be reused after an error
+	queue.configure([&](double t, double const* data, std::size_t len) { written.assign(data, data + len); });
+	queue.buffer().assign({6.0});
+	queue.submit(3.0);
+	CHECK_NOTHROW(queue.finish());
+	CHECK(written == std::vector<double>({6.0}));
+}
+
+TEST_CASE("AsyncSolutionQueue completes reserved checkpoints in order with snapshots", "[SolutionRecorder],[Checkpoint]")
+{
+	cadet::AsyncSolutionQueue output;
+	cadet::AsyncCheckpointQueue checkpoints;
+
+	std::vector<double> recorded;
+	std::vector<double> written;
+	output.configure(1, 2, [&](double t, double const* data) { recorded.push_back(data[0]); });
+	checkpoints.configure([&](double t, double const* data, std::size_t len) { written.assign(data, data + len); });
+
+	for (unsigned int i = 0; i < 6; ++i)
+	{
+		double* const snapshot = output.acquire();
+		snapshot[0] = static_cast<double>(i);
+		output.submit(static_cast<double>(i));
+
+		// Checkpoint after the third snapshot is completed by the output thread
+		if (i == 2)
+		{
+			REQUIRE(checkpoints.idle());
+			checkpoints.buffer().assign({-1.0});
+			checkpoints.reserve();
+
+			// Queue stays busy until the output thread has submitted the checkpoint
+			CHECK_FALSE(checkpoints.idle());
+			output.submitTask([&]()
+				{
+					std::vector<double>& buffer = checkpoints.buffer();
+					buffer.insert(buffer.end(), recorded.begin(), recorded.end());
+					checkpoints.submit(2.0);
+				});
+		}
+	}
+
+	output.finish();
+	checkpoints.finish();
+
+	CHECK(recorded == std::vector<double>({0.0, 1.0, 2.0, 3.0, 4.0, 5.0}));
+	CHECK(written == std::vector<double>({-1.0, 0.0, 1.0, 2.0}));
+	CHECK(checkpoints.idle());
+}
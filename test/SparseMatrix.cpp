@@ -0,0 +1,274 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2017: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+#include <random>
+
+#include "linalg/SparseMatrix.hpp"
+#include "linalg/SparseDirectSolver.hpp"
+
+/**
+ * @brief Creates a random sparse matrix with dominant diagonal
+ * @details Each row contains the main diagonal, the first upper diagonal, and a few random elements.
+ * @param [in] n Number of rows
+ * @param [in] generator Random number generator
+ * @return Random sparse matrix
+ */
+cadet::linalg::CompressedSparseMatrix randomSparseMatrix(unsigned int n, std::default_random_engine& generator)
+{
+	std::uniform_int_distribution<unsigned int> colDist(0, n - 1);
+	std::uniform_real_distribution<double> valDist(-1.0, 1.0);
+
+	cadet::linalg::DoubleSparseMatrix pattern(n * 6);
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		pattern.addElement(i, i, 0.0);
+		if (i + 1 < n)
+			pattern.addElement(i, i + 1, 0.0);
+
+		for (unsigned int j = 0; j < 4; ++j)
+			pattern.addElement(i, colDist(generator), 0.0);
+	}
+
+	cadet::linalg::CompressedSparseMatrix mat;
+	mat.assignPattern(n, pattern);
+
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		for (unsigned int k = mat.rowStart()[i]; k < mat.rowStart()[i + 1]; ++k)
+			mat.values()[k] = (mat.columns()[k] == i) ? 8.0 + valDist(generator) : valDist(generator);
+	}
+	return mat;
+}
+
+TEST_CASE("CompressedSparseMatrix pattern assignment", "[SparseMatrix],[LinAlg]")
+{
+	cadet::linalg::DoubleSparseMatrix pattern(6);
+	pattern.addElement(2, 1, 0.0);
+	pattern.addElement(0, 2, 0.0);
+	pattern.addElement(0, 0, 0.0);
+	pattern.addElement(2, 1, 0.0);
+	pattern.addElement(1, 1, 0.0);
+	pattern.addElement(2, 2, 0.0);
+
+	cadet::linalg::CompressedSparseMatrix mat;
+	mat.assignPattern(3, pattern);
+
+	// Duplicate is merged
+	REQUIRE(mat.numNonZero() == 5);
+	CHECK(mat.rowStart() == std::vector<unsigned int>({0, 2, 3, 5}));
+	CHECK(mat.columns() == std::vector<unsigned int>({0, 2, 1, 1, 2}));
+
+	CHECK(mat.findElement(2, 1) == 3);
+	CHECK(mat.findElement(1, 0) == -1);
+
+	mat(0, 0) = 1.0;
+	mat(0, 2) = 2.0;
+	mat(1, 1) = 3.0;
+	mat(2, 1) = 4.0;
+	mat(2, 2) = 5.0;
+
+	const double x[] = {1.0, 2.0, 3.0};
+	double y[] = {1.0, 1.0, 1.0};
+	mat.multiplyAdd(x, y);
+	CHECK(y[0] == 8.0);
+	CHECK(y[1] == 7.0);
+	CHECK(y[2] == 24.0);
+}
+
+TEST_CASE("SparseDirectSolver solves random systems", "[SparseMatrix],[LinAlg]")
+{
+	std::default_random_engine generator(42);
+	std::uniform_real_distribution<double> valDist(-1.0, 1.0);
+
+	for (unsigned int n : {1u, 7u, 50u, 300u})
+	{
+		cadet::linalg::CompressedSparseMatrix mat = randomSparseMatrix(n, generator);
+
+		cadet::linalg::SparseDirectSolver solver;
+		solver.analyzePattern(mat);
+		REQUIRE(solver.analyzed());
+		CHECK(solver.numFactorNonZero() >= mat.numNonZero());
+
+		// Refactorize with changed values but same pattern
+		for (unsigned int rep = 0; rep < 2; ++rep)
+		{
+			REQUIRE(solver.factorize(mat));
+			CHECK(solver.numOffDiagonalPivots() == 0);
+
+			std::vector<double> x(n, 0.0);
+			for (unsigned int i = 0; i < n; ++i)
+				x[i] = valDist(generator);
+
+			std::vector<double> rhs(n, 0.0);
+			mat.multiplyAdd(x.data(), rhs.data());
+
+			REQUIRE(solver.solve(rhs.data()));
+			for (unsigned int i = 0; i < n; ++i)
+				CHECK(rhs[i] == Approx(x[i]).epsilon(1e-10).margin(1e-12));
+
+			for (double& v : mat.values())
+				v *= 1.5;
+		}
+	}
+}
+
+TEST_CASE("SparseDirectSolver solves random transposed systems", "[SparseMatrix],[LinAlg]")
+{
+	std::default_random_engine generator(7);
+	std::uniform_real_distribution<double> valDist(-1.0, 1.0);
+
+	for (unsigned int n : {1u, 7u, 50u, 300u})
+	{
+		const cadet::linalg::CompressedSparseMatrix mat = randomSparseMatrix(n, generator);
+
+		cadet::linalg::SparseDirectSolver solver;
+		solver.analyzePattern(mat);
+		REQUIRE(solver.factorize(mat));
+
+		std::vector<double> x(n, 0.0);
+		for (unsigned int i = 0; i < n; ++i)
+			x[i] = valDist(generator);
+
+		// Compute rhs = A^T x
+		std::vector<double> rhs(n, 0.0);
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			for (unsigned int k = mat.rowStart()[i]; k < mat.rowStart()[i + 1]; ++k)
+				rhs[mat.columns()[k]] += mat.values()[k] * x[i];
+		}
+
+		REQUIRE(solver.solveTransposed(rhs.data()));
+		for (unsigned int i = 0; i < n; ++i)
+			CHECK(rhs[i] == Approx(x[i]).epsilon(1e-10).margin(1e-12));
+	}
+}
+
+TEST_CASE("SparseDirectSolver pivots on vanishing diagonal", "[SparseMatrix],[LinAlg]")
+{
+	std::default_random_engine generator(13);
+	std::uniform_real_distribution<double> valDist(-1.0, 1.0);
+
+	for (unsigned int n : {7u, 50u, 300u})
+	{
+		// Zero diagonal forces off-diagonal pivots, cyclic lower diagonal keeps the matrix regular
+		cadet::linalg::CompressedSparseMatrix mat = randomSparseMatrix(n, generator);
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			for (unsigned int k = mat.rowStart()[i]; k < mat.rowStart()[i + 1]; ++k)
+				mat.values()[k] = (mat.columns()[k] == i) ? 0.0 : 1e-3 * valDist(generator);
+		}
+
+		cadet::linalg::DoubleSparseMatrix pattern(mat.numNonZero() + n);
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			for (unsigned int k = mat.rowStart()[i]; k < mat.rowStart()[i + 1]; ++k)
+				pattern.addElement(i, mat.columns()[k], mat.values()[k]);
+			pattern.addElement(i, (i + n - 1) % n, 0.0);
+		}
+
+		cadet::linalg::CompressedSparseMatrix pivMat;
+		pivMat.assignPattern(n, pattern);
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			for (unsigned int k = mat.rowStart()[i]; k < mat.rowStart()[i + 1]; ++k)
+				pivMat(i, mat.columns()[k]) = mat.values()[k];
+			pivMat(i, (i + n - 1) % n) += 4.0 + valDist(generator);
+		}
+
+		cadet::linalg::SparseDirectSolver solver;
+		solver.analyzePattern(pivMat);
+		REQUIRE(solver.factorize(pivMat));
+		CHECK(solver.numOffDiagonalPivots() > 0);
+
+		std::vector<double> x(n, 0.0);
+		for (unsigned int i = 0; i < n; ++i)
+			x[i] = valDist(generator);
+
+		std::vector<double> rhs(n, 0.0);
+		pivMat.multiplyAdd(x.data(), rhs.data());
+
+		REQUIRE(solver.solve(rhs.data()));
+		for (unsigned int i = 0; i < n; ++i)
+			CHECK(rhs[i] == Approx(x[i]).epsilon(1e-10).margin(1e-12));
+
+		// Compute rhs = A^T x
+		std::fill(rhs.begin(), rhs.end(), 0.0);
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			for (unsigned int k = pivMat.rowStart()[i]; k < pivMat.rowStart()[i + 1]; ++k)
+				rhs[pivMat.columns()[k]] += pivMat.values()[k] * x[i];
+		}
+
+		REQUIRE(solver.solveTransposed(rhs.data()));
+		for (unsigned int i = 0; i < n; ++i)
+			CHECK(rhs[i] == Approx(x[i]).epsilon(1e-10).margin(1e-12));
+	}
+}
+
+TEST_CASE("SparseDirectSolver detects singular matrices", "[SparseMatrix],[LinAlg]")
+{
+	cadet::linalg::DoubleSparseMatrix pattern(7);
+	pattern.addElement(0, 0, 0.0);
+	pattern.addElement(0, 1, 0.0);
+	pattern.addElement(1, 0, 0.0);
+	pattern.addElement(1, 1, 0.0);
+	pattern.addElement(1, 2, 0.0);
+	pattern.addElement(2, 1, 0.0);
+	pattern.addElement(2, 2, 0.0);
+
+	cadet::linalg::CompressedSparseMatrix mat;
+	mat.assignPattern(3, pattern);
+
+	// Second row is twice the first row
+	mat(0, 0) = 1.0;
+	mat(0, 1) = 2.0;
+	mat(1, 0) = 2.0;
+	mat(1, 1) = 4.0;
+	mat(1, 2) = 0.0;
+	mat(2, 1) = 1.0;
+	mat(2, 2) = 3.0;
+
+	cadet::linalg::SparseDirectSolver solver;
+	solver.analyzePattern(mat);
+	CHECK_FALSE(solver.factorize(mat));
+
+	double rhs[] = {1.0, 2.0, 3.0};
+	CHECK_FALSE(solver.solve(rhs));
+
+	// Regular after changing values
+	mat(1, 2) = 1.0;
+	REQUIRE(solver.factorize(mat));
+	REQUIRE(solver.solve(rhs));
+	CHECK(rhs[0] + 2.0 * rhs[1] == Approx(1.0));
+	CHECK(2.0 * rhs[0] + 4.0 * rhs[1] + rhs[2] == Approx(2.0));
+	CHECK(rhs[1] + 3.0 * rhs[2] == Approx(3.0));
+}
+
+TEST_CASE("DoubleSparseMatrix transposed multiplication", "[SparseMatrix],[LinAlg]")
+{
+	cadet::linalg::DoubleSparseMatrix mat(4);
+	mat.addElement(0, 2, 2.0);
+	mat.addElement(1, 0, 3.0);
+	mat.addElement(2, 2, 4.0);
+	mat.addElement(2, 1, 5.0);
+
+	const double x[] = {1.0, 2.0, 3.0};
+	double y[] = {1.0, 1.0, 1.0};
+	mat.transposedMultiplyAdd(x, y, 2.0);
+	CHECK(y[0] == 13.0);
+	CHECK(y[1] == 31.0);
+	CHECK(y[2] == 29.0);
+}